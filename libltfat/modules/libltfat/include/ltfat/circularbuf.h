@@ -112,6 +112,78 @@ LTFAT_API int
 LTFAT_NAME(block_processor_setfirwin)(
         LTFAT_NAME(block_processor_state)* p, LTFAT_FIRWIN win, int do_prewin);
 /** @} */
+
+/** \name Threaded interface
+ *
+ * The input and output fifos are lock-free single-producer,
+ * single-consumer ring buffers. This allows running the processing
+ * on a worker thread while the audio thread only moves samples in and out
+ * and never blocks:
+ *
+ * - The audio thread calls block_processor_push() and block_processor_pull().
+ * - The worker thread calls block_processor_process() whenever new
+ *   input is available.
+ *
+ * The processing delay \a procDelay passed to the init function should
+ * include the time the worker is allowed to lag behind the audio thread.
+ * block_processor_setprehop() and block_processor_setposthop() can be
+ * called from any thread, the new hops are applied by the worker after
+ * the current batch of blocks. The remaining functions, in particular
+ * block_processor_reset(), must not be called while both threads are
+ * running.
+ * @{
+ */
+
+/** Write input samples (audio thread)
+ *
+ * \returns
+ * Status code          | Description
+ * ---------------------|--------------------------------------------
+ * LTFATERR_SUCCESS     | All samples were written
+ * LTFATERR_OVERFLOW    | Input fifo overrun, the samples that did not fit were dropped
+ * LTFATERR_NULLPOINTER | \a p or \a in is NULL
+ * LTFATERR_BADSIZE     | \a inLen or \a chanNo is negative
+ */
+LTFAT_API int
+LTFAT_NAME(block_processor_push)(
+    LTFAT_NAME(block_processor_state)* p,
+    const LTFAT_REAL** in, ltfat_int inLen, ltfat_int chanNo);
+
+/** Process all pending blocks (worker thread)
+ *
+ * Blocks are only taken from the input fifo if the output fifo can accept
+ * the processed block.
+ *
+ * \returns Number of processed blocks or a negative error code
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_process)(LTFAT_NAME(block_processor_state)* p);
+
+/** Read output samples (audio thread)
+ *
+ * \returns
+ * Status code          | Description
+ * ---------------------|--------------------------------------------
+ * LTFATERR_SUCCESS     | All samples were read
+ * LTFATERR_UNDERFLOW   | Output fifo underrun, the missing samples were set to zero
+ * LTFATERR_NULLPOINTER | \a p or \a out is NULL
+ * LTFATERR_BADSIZE     | \a outLen or \a chanNo is negative
+ */
+LTFAT_API int
+LTFAT_NAME(block_processor_pull)(
+    LTFAT_NAME(block_processor_state)* p,
+    ltfat_int outLen, ltfat_int chanNo, LTFAT_REAL** out);
+
+/** Number of block_processor_push() calls which did not fit into the input fifo
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_get_overruns)(LTFAT_NAME(block_processor_state)* p);
+
+/** Number of block_processor_pull() calls which could not be fully satisfied
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_get_underruns)(LTFAT_NAME(block_processor_state)* p);
+/** @} */
 /** @} */
 
 void
@@ -128,6 +200,10 @@ LTFAT_NAME(block_processor_advanceby)(
  * The buffer read and write pointers are initialized such that they
  * reflect the processing delay.
  *
+ * The buffer can be used from two threads, one calling analysis_fifo_write
+ * and the other one analysis_fifo_read. The read and write positions are
+ * accessed atomically and no locks are involved.
+ *
  * \param[in]  fifoLen  Ring buffer size. This should be at least winLen + max. expected
  *                      buffer length.
  *                      One more slot is actually allocated for the "one slot open" implementation.
@@ -183,6 +259,11 @@ LTFAT_NAME(analysis_fifo_write)(LTFAT_NAME(analysis_fifo_state)* p, const LTFAT_
 LTFAT_API ltfat_int
 LTFAT_NAME(analysis_fifo_read)(LTFAT_NAME(analysis_fifo_state)* p, LTFAT_REAL buf[]);
 
+/** Number of writes which did not fit into the analysis ring buffer
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(analysis_fifo_get_overruns)(LTFAT_NAME(analysis_fifo_state)* p);
+
 /** Destroy DGT analysis ring buffer
  * \param[in]  p      DGT analysis ring buffer
  */
@@ -199,6 +280,10 @@ LTFAT_NAME(analysis_fifo_done)(LTFAT_NAME(analysis_fifo_state)** p);
  *
  * The buffer read and write pointers are both initialized to the same value.
  *
+ * Like the analysis ring buffer, it is a lock-free single-producer,
+ * single-consumer queue with synthesis_fifo_write on one thread and
+ * synthesis_fifo_read on the other.
+ *
  * \param[in]  fifoLen  Ring buffer size. This should be at least winLen + max. expected
  *                      buffer length. (winLen+1) more slots are actually allocated
  *                      to accomodate the overlaps.
@@ -254,6 +339,21 @@ LTFAT_NAME(synthesis_fifo_read)(LTFAT_NAME(synthesis_fifo_state)* p,
                                 ltfat_int bufLen, ltfat_int W,
                                 LTFAT_REAL* buf[]);
 
+/** Number of blocks rejected by synthesis_fifo_write because of lack of space
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_get_overruns)(LTFAT_NAME(synthesis_fifo_state)* p);
+
+/** Number of synthesis_fifo_read calls which returned less samples than requested
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_get_underruns)(LTFAT_NAME(synthesis_fifo_state)* p);
+
+/** Free space in the synthesis ring buffer
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_freespace)(LTFAT_NAME(synthesis_fifo_state)* p);
+
 /** Destroy DGT synthesis ring buffer
  * \param[in]  p      DGT synthesis ring buffer
  */
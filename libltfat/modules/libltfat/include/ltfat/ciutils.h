@@ -507,6 +507,18 @@ LTFAT_NAME(fold_array)(const LTFAT_TYPE *in, ltfat_int Lin,
                        ltfat_int offset,
                        ltfat_int Lfold, LTFAT_TYPE *out);
 
+/* Windows the periodically extended array and folds the product
+ *
+ * out[(offset + l) mod Lfold] += in[(start + l) mod L] * g[l]  for l = 0,...,gl-1
+ *
+ * after clearing out. This is equivalent to (but faster than) periodizing in,
+ * multiplying by g and calling fold_array. The arrays must not overlap.
+ */
+LTFAT_API int
+LTFAT_NAME(windowfold_array)(const LTFAT_TYPE *in, ltfat_int L, ltfat_int start,
+                             const LTFAT_TYPE *g, ltfat_int gl,
+                             ltfat_int offset, ltfat_int Lfold, LTFAT_TYPE *out);
+
 LTFAT_API int
 LTFAT_NAME(reflect)(const LTFAT_TYPE* in, ltfat_int L, LTFAT_TYPE* out);
 
@@ -0,0 +1,273 @@
+typedef struct LTFAT_NAME(dgtreal_coefsink) LTFAT_NAME(dgtreal_coefsink);
+typedef struct LTFAT_NAME(dgtreal_coefreader) LTFAT_NAME(dgtreal_coefreader);
+
+/** \defgroup coeffile File-backed DGTREAL coefficients
+ *
+ * The coefficients of a long signal need not fit in RAM. The sink writes
+ * coefficient columns sequentially to a memory-mapped file and the reader
+ * maps such file and provides random access to its columns, e.g. for a
+ * later synthesis. The operating system pages the data in and out as
+ * needed.
+ *
+ * The first column written is stored as column 0. The columns emitted by
+ * dgtreal_fb_stream_execute and dgtreal_fb_stream_flush in the ZPD mode
+ * are exactly the N columns of dgtreal_fb of the zero-padded signal.
+ *
+ * The file consists of a 128 byte header followed by the coefficients
+ * stored as a M2 x N x W array of complex numbers (real and imaginary part
+ * interleaved) with M2 = M/2 + 1 and N = ceil(L/a). All fields are stored
+ * in the byte order of the machine which wrote the file.
+ *
+ * Offset | Type         | Field
+ * -------|--------------|----------------------------------------------------
+ * 0      | char[8]      | Magic string "LTFATCF" terminated by a zero byte
+ * 8      | uint32       | Format version, currently 1
+ * 12     | uint32       | Size of a real number in bytes, 8 for double, 4 for float
+ * 16     | int64        | Signal length L
+ * 24     | int64        | Time hop a
+ * 32     | int64        | Number of frequency channels M
+ * 40     | int64        | Number of signal channels W
+ * 48     | int64        | Number of columns per channel N
+ * 56     | int64        | Number of columns written so far
+ * 64     | int32        | Phase convention, value of ltfat_phaseconvention
+ * 68     | (60 bytes)   | Reserved, zero
+ *
+ * Columns which were not written are zero.
+ *
+ * The file-backed arrays are only available on POSIX systems.
+ * @{
+ */
+
+/** Create a coefficient file and map it for writing
+ *
+ * An existing file is overwritten. The file is created with its full
+ * size, but the space is allocated by the file system only as the
+ * columns are written.
+ *
+ * \param[in] filename   Name of the file
+ * \param[in]        L   Signal length
+ * \param[in]        a   Time hop factor
+ * \param[in]        M   Number of frequency channels
+ * \param[in]        W   Number of channels of the signal
+ * \param[in]    ptype   Phase convention
+ * \param[out]       p   Coefficient sink
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefsink_init_d(const char* filename, ltfat_int L, ltfat_int a,
+ *                               ltfat_int M, ltfat_int W,
+ *                               const ltfat_phaseconvention ptype,
+ *                               ltfat_dgtreal_coefsink_d** p);
+ *
+ * ltfat_dgtreal_coefsink_init_s(const char* filename, ltfat_int L, ltfat_int a,
+ *                               ltfat_int M, ltfat_int W,
+ *                               const ltfat_phaseconvention ptype,
+ *                               ltfat_dgtreal_coefsink_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a filename or \a p was NULL
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a L, \a a, \a M, \a W
+ * LTFATERR_CANNOTHAPPEN    | \a ptype does not have a valid value from the ltfat_phaseconvention enum
+ * LTFATERR_FAILED          | The file could not be created or mapped
+ * LTFATERR_NOTSUPPORTED    | Memory-mapped files are not supported on this platform
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_init)(const char* filename,
+                                  ltfat_int L, ltfat_int a, ltfat_int M,
+                                  ltfat_int W, const ltfat_phaseconvention ptype,
+                                  LTFAT_NAME(dgtreal_coefsink)** p);
+
+/** Append columns to the file
+ *
+ * \param[in]      p   Coefficient sink
+ * \param[in]      c   Coefficients, size M2 x ncols x W
+ * \param[in]  ncols   Number of columns
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefsink_write_d(ltfat_dgtreal_coefsink_d* p,
+ *                                const ltfat_complex_d c[], ltfat_int ncols);
+ *
+ * ltfat_dgtreal_coefsink_write_s(ltfat_dgtreal_coefsink_s* p,
+ *                                const ltfat_complex_s c[], ltfat_int ncols);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a c (only if ncols > 0) was NULL
+ * LTFATERR_BADSIZE         | \a ncols was negative
+ * LTFATERR_OVERFLOW        | The file would hold more than N columns
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_write)(LTFAT_NAME(dgtreal_coefsink)* p,
+                                   const LTFAT_COMPLEX c[], ltfat_int ncols);
+
+/** Number of columns written so far
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefsink_get_ncols_d(const ltfat_dgtreal_coefsink_d* p);
+ *
+ * ltfat_dgtreal_coefsink_get_ncols_s(const ltfat_dgtreal_coefsink_s* p);
+ * </tt>
+ * \returns Number of columns or LTFATERR_NULLPOINTER
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_coefsink_get_ncols)(const LTFAT_NAME(dgtreal_coefsink)* p);
+
+/** Flush the file to the disk, unmap it and destroy the sink
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefsink_done_d(ltfat_dgtreal_coefsink_d** p);
+ *
+ * ltfat_dgtreal_coefsink_done_s(ltfat_dgtreal_coefsink_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | p or *p was NULL.
+ * LTFATERR_FAILED          | Writing the file to the disk failed. The sink is destroyed anyway.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_done)(LTFAT_NAME(dgtreal_coefsink)** p);
+
+/** Map a coefficient file for reading
+ *
+ * \param[in] filename   Name of the file
+ * \param[out]       p   Coefficient reader
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_init_d(const char* filename,
+ *                                 ltfat_dgtreal_coefreader_d** p);
+ *
+ * ltfat_dgtreal_coefreader_init_s(const char* filename,
+ *                                 ltfat_dgtreal_coefreader_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a filename or \a p was NULL
+ * LTFATERR_FAILED          | The file could not be opened or mapped or it is not a valid coefficient file
+ * LTFATERR_BADARG          | The file holds coefficients of the other precision
+ * LTFATERR_NOTSUPPORTED    | Memory-mapped files are not supported on this platform
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_init)(const char* filename,
+                                    LTFAT_NAME(dgtreal_coefreader)** p);
+
+/** Get the parameters stored in the header
+ *
+ * Any of the output pointers can be NULL.
+ *
+ * \param[in]      p   Coefficient reader
+ * \param[out]     L   Signal length
+ * \param[out]     a   Time hop factor
+ * \param[out]     M   Number of frequency channels
+ * \param[out]     W   Number of channels of the signal
+ * \param[out] ptype   Phase convention
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_get_params_d(const ltfat_dgtreal_coefreader_d* p,
+ *                                       ltfat_int* L, ltfat_int* a, ltfat_int* M,
+ *                                       ltfat_int* W, ltfat_phaseconvention* ptype);
+ *
+ * ltfat_dgtreal_coefreader_get_params_s(const ltfat_dgtreal_coefreader_s* p,
+ *                                       ltfat_int* L, ltfat_int* a, ltfat_int* M,
+ *                                       ltfat_int* W, ltfat_phaseconvention* ptype);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_get_params)(const LTFAT_NAME(dgtreal_coefreader)* p,
+        ltfat_int* L, ltfat_int* a, ltfat_int* M,
+        ltfat_int* W, ltfat_phaseconvention* ptype);
+
+/** Number of columns the writer has written
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_get_ncols_d(const ltfat_dgtreal_coefreader_d* p);
+ *
+ * ltfat_dgtreal_coefreader_get_ncols_s(const ltfat_dgtreal_coefreader_s* p);
+ * </tt>
+ * \returns Number of columns or LTFATERR_NULLPOINTER
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_coefreader_get_ncols)(const LTFAT_NAME(dgtreal_coefreader)* p);
+
+/** Copy columns n0, ..., n0 + ncols - 1 of all channels
+ *
+ * \param[in]      p   Coefficient reader
+ * \param[in]     n0   Index of the first column
+ * \param[in]  ncols   Number of columns
+ * \param[out]     c   Coefficients, size M2 x ncols x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_read_d(const ltfat_dgtreal_coefreader_d* p,
+ *                                 ltfat_int n0, ltfat_int ncols, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_coefreader_read_s(const ltfat_dgtreal_coefreader_s* p,
+ *                                 ltfat_int n0, ltfat_int ncols, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a c was NULL
+ * LTFATERR_NOTINRANGE      | The columns are not within 0, ..., N - 1
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_read)(const LTFAT_NAME(dgtreal_coefreader)* p,
+                                    ltfat_int n0, ltfat_int ncols,
+                                    LTFAT_COMPLEX c[]);
+
+/** Get the mapped M2 x N x W coefficient array
+ *
+ * The array can be passed directly to the synthesis routines, e.g.
+ * idgtreal_fb_execute. It is valid until the reader is destroyed.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_get_array_d(const ltfat_dgtreal_coefreader_d* p);
+ *
+ * ltfat_dgtreal_coefreader_get_array_s(const ltfat_dgtreal_coefreader_s* p);
+ * </tt>
+ * \returns Pointer to the array or NULL if \a p was NULL
+ */
+LTFAT_API const LTFAT_COMPLEX*
+LTFAT_NAME(dgtreal_coefreader_get_array)(const LTFAT_NAME(dgtreal_coefreader)* p);
+
+/** Unmap the file and destroy the reader
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_coefreader_done_d(ltfat_dgtreal_coefreader_d** p);
+ *
+ * ltfat_dgtreal_coefreader_done_s(ltfat_dgtreal_coefreader_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | p or *p was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_done)(LTFAT_NAME(dgtreal_coefreader)** p);
+
+/** @}*/
@@ -169,6 +169,46 @@ LTFAT_NAME(dgt_long_execute_newarray)(LTFAT_NAME(dgt_long_plan)* plan,
 LTFAT_API int
 LTFAT_NAME(dgt_long_done)(LTFAT_NAME(dgt_long_plan)** plan);
 
+/** Set number of threads used by the DGT plan
+ *
+ * The iterations of the Walnut factorization loop (there are gcd(a,M)
+ * of them) and the final FFTs of the coefficient columns are distributed
+ * among the threads. Each thread gets its own buffers and FFT plans, which
+ * are (re)created by this function.
+ *
+ * \note Has no effect if libltfat was compiled without OpenMP.
+ * \note The FFT plans are created using the flags and the output array
+ * passed to the init function i.e. the array is overwritten when the flags
+ * are other than FFTW_ESTIMATE.
+ *
+ * \param[in]     plan  DGT plan
+ * \param[in] nthreads  Number of threads
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgt_long_setnthreads_d(ltfat_dgt_long_plan_d* plan, ltfat_int nthreads);
+ *
+ *  ltfat_dgt_long_setnthreads_s(ltfat_dgt_long_plan_s* plan, ltfat_int nthreads);
+ *
+ *  ltfat_dgt_long_setnthreads_dc(ltfat_dgt_long_plan_dc* plan, ltfat_int nthreads);
+ *
+ *  ltfat_dgt_long_setnthreads_sc(ltfat_dgt_long_plan_sc* plan, ltfat_int nthreads);
+ *  </tt>
+ *
+ * \returns
+ * Status code          |  Description
+ * ---------------------|----------------
+ * LTFATERR_SUCESS      |  No error occured
+ * LTFATERR_NULLPOINTER |  \a plan was NULL
+ * LTFATERR_NOTPOSARG   |  \a nthreads was not positive
+ * LTFATERR_NOMEM       |  Heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgt_long_setnthreads)(LTFAT_NAME(dgt_long_plan)* plan,
+                                 ltfat_int nthreads);
+
 /** @}*/
 /** @}*/
 
@@ -1,5 +1,20 @@
 typedef struct LTFAT_NAME(dgtreal_fb_plan) LTFAT_NAME(dgtreal_fb_plan);
 
+typedef struct LTFAT_NAME(dgtreal_fb_stream_state) LTFAT_NAME(dgtreal_fb_stream_state);
+
+/** Coefficient block processing function
+ *
+ * Called on consecutive blocks of freshly computed coefficients, while
+ * they are still in cache. It must write all \a len coefficients to
+ * \a cout. \a offset is the linear index of the first coefficient in
+ * the whole M2 x N x W array. A block never spans two channels.
+ * \a cin and \a cout can be equal.
+ */
+typedef void LTFAT_NAME(dgtreal_blockfunc)(void* userdata,
+                                           const LTFAT_COMPLEX cin[],
+                                           ltfat_int offset, ltfat_int len,
+                                           LTFAT_COMPLEX cout[]);
+
 /** 
  *  \addtogroup dgt
  * @{
@@ -119,6 +134,43 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
                                const LTFAT_REAL f[], ltfat_int L,
                                ltfat_int W, LTFAT_COMPLEX c[]);
 
+/** Execute the plan and pass the coefficients through a block function
+ *
+ * Same as dgtreal_fb_execute, but every block of frames transformed by
+ * a single batched FFT is written to \a c by \a blockfunc instead of being
+ * copied. This saves a pass over \a c when the coefficients are to be
+ * modified element-wise right after the transform.
+ *
+ * \param[in]      plan   DGT plan
+ * \param[in]         f   Input signal, size L x W
+ * \param[in]         L   Signal length
+ * \param[in]         W   Number of channels of the signal
+ * \param[in] blockfunc   Block processing function, plain copy if NULL
+ * \param[in]  userdata   Passed to \a blockfunc
+ * \param[out]        c   DGT coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_execute_blockfunc_d(ltfat_dgtreal_fb_plan_d* plan, const double f[],
+ *                                      ltfat_int L, ltfat_int W,
+ *                                      ltfat_dgtreal_blockfunc_d* blockfunc,
+ *                                      void* userdata, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_fb_execute_blockfunc_s(ltfat_dgtreal_fb_plan_s* plan, const float f[],
+ *                                      ltfat_int L, ltfat_int W,
+ *                                      ltfat_dgtreal_blockfunc_s* blockfunc,
+ *                                      void* userdata, ltfat_complex_s c[]);
+ * </tt>
+ *
+ * \returns Same as dgtreal_fb_execute
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_blockfunc)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                         const LTFAT_REAL f[], ltfat_int L,
+                                         ltfat_int W,
+                                         LTFAT_NAME(dgtreal_blockfunc)* blockfunc,
+                                         void* userdata, LTFAT_COMPLEX c[]);
+
 /** Destroy the plan
  *
  * \param[in]  plan   DGT plan
@@ -139,5 +191,197 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
 LTFAT_API int
 LTFAT_NAME(dgtreal_fb_done)(LTFAT_NAME(dgtreal_fb_plan)** plan);
 
+/** @}*/
+/** \name Streaming DGTREAL using filter bank algorithm
+ *
+ * The signal is passed in consecutive chunks of arbitrary lengths and
+ * every call emits the coefficient columns whose windows have been
+ * completed by the chunk. Only the samples following the start of the next
+ * window (less than \a gl) are carried between the calls, the periodic
+ * boundary of dgtreal_fb is replaced by one of
+ *
+ * Boundary | Description
+ * ---------|-------------------------------------------------------------
+ * VALID    | Column n is computed from samples n*a, ..., n*a + gl - 1 of the signal, i.e. only windows lying completely in the signal are used.
+ * ZPD      | The signal is zero-padded on both sides. Column n is centered at sample n*a as in dgtreal_fb and dgtreal_fb_stream_flush emits the columns centered up to the end of the signal.
+ *
+ * For the FREQINV phase convention, the time of a column is the absolute
+ * position of its window in the signal.
+ * @{ */
+
+/** Initialize the streaming state
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in] ptype   Phase convention
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]   ext   Boundary mode, VALID or ZPD
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   Streaming state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_init_d(const double g[], ltfat_int gl, ltfat_int a,
+ *                                ltfat_int M, const ltfat_phaseconvention ptype,
+ *                                ltfat_int W, ltfatExtType ext, unsigned flags,
+ *                                ltfat_dgtreal_fb_stream_state_d** p);
+ *
+ * ltfat_dgtreal_fb_stream_init_s(const float g[], ltfat_int gl, ltfat_int a,
+ *                                ltfat_int M, const ltfat_phaseconvention ptype,
+ *                                ltfat_int W, ltfatExtType ext, unsigned flags,
+ *                                ltfat_dgtreal_fb_stream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | Length of the window \a gl was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a a, \a M, \a W
+ * LTFATERR_BADARG          | \a ext was neither VALID nor ZPD
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_CANNOTHAPPEN    | \a ptype does not have a valid value from the ltfat_phaseconvention enum
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_init)(const LTFAT_REAL g[],
+                                   ltfat_int gl, ltfat_int a, ltfat_int M,
+                                   const ltfat_phaseconvention ptype,
+                                   ltfat_int W, ltfatExtType ext,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_fb_stream_state)** p);
+
+/** Number of columns the next call to dgtreal_fb_stream_execute will emit
+ *
+ * \param[in]     p   Streaming state
+ * \param[in]   len   Length of the next chunk
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_nextncols_d(const ltfat_dgtreal_fb_stream_state_d* p,
+ *                                     ltfat_int len);
+ *
+ * ltfat_dgtreal_fb_stream_nextncols_s(const ltfat_dgtreal_fb_stream_state_s* p,
+ *                                     ltfat_int len);
+ * </tt>
+ * \returns Number of columns or a negative error code:
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a len was negative
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_nextncols)(
+    const LTFAT_NAME(dgtreal_fb_stream_state)* p, ltfat_int len);
+
+/** Process the next chunk of the signal
+ *
+ * The chunk can have any length, including 0. The number of columns
+ * emitted is at most len/a + 1, see dgtreal_fb_stream_nextncols.
+ *
+ * \param[in]     p   Streaming state
+ * \param[in]     f   Chunk of the input signal, size len x W
+ * \param[in]   len   Chunk length
+ * \param[out]    c   DGT coefficients of the completed windows, size M2 x ncols x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_execute_d(ltfat_dgtreal_fb_stream_state_d* p,
+ *                                   const double f[], ltfat_int len,
+ *                                   ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_fb_stream_execute_s(ltfat_dgtreal_fb_stream_state_s* p,
+ *                                   const float f[], ltfat_int len,
+ *                                   ltfat_complex_s c[]);
+ * </tt>
+ * \returns Number of emitted columns ncols or a negative error code:
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a f, \a c (only if ncols > 0)
+ * LTFATERR_BADSIZE         | \a len was negative
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_execute)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                      const LTFAT_REAL f[], ltfat_int len,
+                                      LTFAT_COMPLEX c[]);
+
+/** Number of columns dgtreal_fb_stream_flush will emit
+ *
+ * It is always 0 in the VALID mode.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_flushncols_d(const ltfat_dgtreal_fb_stream_state_d* p);
+ *
+ * ltfat_dgtreal_fb_stream_flushncols_s(const ltfat_dgtreal_fb_stream_state_s* p);
+ * </tt>
+ * \returns Number of columns or LTFATERR_NULLPOINTER
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_flushncols)(
+    const LTFAT_NAME(dgtreal_fb_stream_state)* p);
+
+/** End the signal
+ *
+ * In the ZPD mode, the columns still missing are computed assuming the
+ * signal is followed by zeros. The state is reset afterwards such that
+ * a new signal can be processed.
+ *
+ * \param[in]     p   Streaming state
+ * \param[out]    c   Remaining DGT coefficients, size M2 x ncols x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_flush_d(ltfat_dgtreal_fb_stream_state_d* p,
+ *                                 ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_fb_stream_flush_s(ltfat_dgtreal_fb_stream_state_s* p,
+ *                                 ltfat_complex_s c[]);
+ * </tt>
+ * \returns Number of emitted columns ncols or a negative error code:
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_NULLPOINTER     | \a p or \a c (only if ncols > 0) was NULL
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_flush)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                    LTFAT_COMPLEX c[]);
+
+/** Discard the carried samples and start a new signal
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_reset_d(ltfat_dgtreal_fb_stream_state_d* p);
+ *
+ * ltfat_dgtreal_fb_stream_reset_s(ltfat_dgtreal_fb_stream_state_s* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_reset)(LTFAT_NAME(dgtreal_fb_stream_state)* p);
+
+/** Destroy the streaming state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_stream_done_d(ltfat_dgtreal_fb_stream_state_d** p);
+ *
+ * ltfat_dgtreal_fb_stream_done_s(ltfat_dgtreal_fb_stream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | p or *p was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_done)(LTFAT_NAME(dgtreal_fb_stream_state)** p);
+
 /** @}*/
 /** @}*/
@@ -161,6 +161,39 @@ LTFAT_NAME(dgtreal_long_execute_newarray)(LTFAT_NAME(dgtreal_long_plan)* plan,
 LTFAT_API int
 LTFAT_NAME(dgtreal_long_done)(LTFAT_NAME(dgtreal_long_plan)** plan);
 
+/** Set number of threads used by the plan
+ *
+ * The gcd(a,M) iterations of the Walnut factorization loop and the final
+ * FFTs of the coefficient columns are distributed among the threads.
+ * Each thread gets its own buffers and FFT plans.
+ *
+ * \note Has no effect if libltfat was compiled without OpenMP.
+ * \note The FFT plans are created using the flags and the output array
+ * passed to the init function.
+ *
+ * \param[in]      plan   DGT plan
+ * \param[in]  nthreads   Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_long_setnthreads_d(ltfat_dgtreal_long_plan_d* plan,
+ *                                  ltfat_int nthreads);
+ *
+ * ltfat_dgtreal_long_setnthreads_s(ltfat_dgtreal_long_plan_s* plan,
+ *                                  ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan was NULL.
+ * LTFATERR_NOTPOSARG       | nthreads was not positive.
+ * LTFATERR_NOMEM           | Heap allocation failed.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_setnthreads)(LTFAT_NAME(dgtreal_long_plan)* plan,
+                                     ltfat_int nthreads);
+
 /** @}*/
 /** @}*/
 
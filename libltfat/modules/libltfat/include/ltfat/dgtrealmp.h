@@ -29,6 +29,7 @@ typedef enum
     ltfat_dgtmp_alg_LocOMP          = 1,
     ltfat_dgtmp_alg_LocCyclicMP     = 2,
 /*    ltfat_dgtmp_alg_LocSelfProjdMP  = 3,*/
+    ltfat_dgtmp_alg_ParallelMP      = 4,
 } ltfat_dgtmp_alg;
 
 typedef struct ltfat_dgtmp_params ltfat_dgtmp_params;
@@ -83,6 +84,10 @@ LTFAT_API int
 ltfat_dgtmp_setpar_cycles(
         ltfat_dgtmp_params* params, size_t cycles);
 
+LTFAT_API int
+ltfat_dgtmp_setpar_nthreads(
+        ltfat_dgtmp_params* params, ltfat_int nthreads);
+
 // LTFAT_API int
 // ltfat_dgtmp_setpar_checkerreverynit(
 //     ltfat_dgtmp_params* p, ltfat_int itstep, double errtoldb);
@@ -101,6 +106,20 @@ ltfat_dgtmp_alg_isvalid(ltfat_dgtmp_alg in);
 /** \addtogroup multidgtrealmp  */
 /**@{*/
 
+/** Atom selected by the DGTREAL Matching Pursuit
+ *
+ * Sparse alternative to the dense coefficient arrays. The atom is the
+ * (m,n)-th atom of the w-th dictionary, \a c is its coefficient as it would
+ * appear in the dense output.
+ */
+typedef struct
+{
+    ltfat_int     w; //!< Dictionary index 0,...,P-1
+    ltfat_int     m; //!< Frequency index 0,...,M[w]/2
+    ltfat_int     n; //!< Time index 0,...,L/a[w]-1
+    LTFAT_COMPLEX c; //!< Coefficient
+} LTFAT_NAME(dgtrealmp_atom);
+
 /** Callback template to be called every iterstep iteration 
  *
  *
@@ -289,6 +308,178 @@ LTFAT_NAME(dgtrealmp_execute_synthesize)(
 
 /** @}*/
 
+/** \name Sparse atom-list interface
+ *
+ * The selected atoms are recorded in a list as they are chosen instead of
+ * being accumulated in the dense coefficient arrays of total size
+ * sum(M2[w]*N[w]). The memory required is proportional to the maximum number
+ * of atoms only.
+ */
+/**@{*/
+
+/** Perform DGTREAL Matching Pursuit decomposition into a list of atoms
+ *
+ * The atoms are stored in the order in which they were first selected.
+ * An atom selected several times appears only once with the accumulated
+ * coefficient. Atoms removed by the LocOMP or LocCyclicMP algorithms are
+ * not included. The number of atoms never exceeds the maxatoms parameter.
+ * The iterstep callback, if set, is called with \a c equal to NULL.
+ *
+ * \param[in/out]    p DGTREALMP state
+ * \param[in]        f Input signal
+ * \param[in] atomsLen Capacity of \a atoms
+ * \param[out]   atoms Selected atoms
+ * \param[out] atomsNo Number of atoms written to \a atoms
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_decompose_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                      const double f[], size_t atomsLen,
+ *                      ltfat_dgtrealmp_atom_d atoms[], size_t* atomsNo);
+ *
+ * ltfat_dgtrealmp_execute_decompose_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                      const float f[], size_t atomsLen,
+ *                      ltfat_dgtrealmp_atom_s atoms[], size_t* atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFAT_DGTREALMP_STATUS_* | Reason the iterations stopped
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a f, \a atoms, \a atomsNo
+ * LTFATERR_BADREQSIZE      | \a atomsLen is smaller than the number of atoms
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[], size_t atomsLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t* atomsNo);
+
+/** Synthesize signal directly from a list of atoms
+ *
+ * The atoms are evaluated one by one in the time domain. The cost is
+ * proportional to the number of atoms times the window length and no
+ * dense coefficient array is formed. The result equals the output of
+ * dgtrealmp_execute_synthesize() with the atoms scattered to the dense
+ * coefficient arrays. Atoms with the same position are summed.
+ *
+ * \param[in]        p DGTREALMP state
+ * \param[in]    atoms Atoms
+ * \param[in]  atomsNo Number of atoms
+ * \param[in] dict_mask Dictionaries to include, NULL includes all
+ * \param[out]       f Output signal of length L
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_synthesize_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                      const ltfat_dgtrealmp_atom_d atoms[], size_t atomsNo,
+ *                      int dict_mask[], double f[]);
+ *
+ * ltfat_dgtrealmp_execute_synthesize_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                      const ltfat_dgtrealmp_atom_s atoms[], size_t atomsNo,
+ *                      int dict_mask[], float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a atoms, \a f
+ * LTFATERR_NOTINRANGE      | Atom position is outside of the dictionaries
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atom) atoms[],
+    size_t atomsNo, int dict_mask[], LTFAT_REAL f[]);
+
+/** Serialize list of atoms to a compact byte stream
+ *
+ * The stream starts with a byte holding sizeof(LTFAT_REAL) followed by the
+ * number of atoms. Each atom is stored as differences of w, n and m to the
+ * previous atom, followed by the real and imaginary parts of the
+ * coefficient as little-endian IEEE 754 numbers. Integers are stored as
+ * zigzag LEB128 varints i.e. small differences take a single byte.
+ * Atoms sorted by dgtrealmp_atoms_sort() therefore take
+ * 3 + 2*sizeof(LTFAT_REAL) bytes in most cases.
+ *
+ * \param[in]    atoms Atoms
+ * \param[in]  atomsNo Number of atoms
+ * \param[in]   bufLen Length of \a buf in bytes
+ * \param[out]     buf Output buffer, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_serialize_d( const ltfat_dgtrealmp_atom_d atoms[],
+ *                      size_t atomsNo, size_t bufLen, unsigned char buf[]);
+ *
+ * ltfat_dgtrealmp_atoms_serialize_s( const ltfat_dgtrealmp_atom_s atoms[],
+ *                      size_t atomsNo, size_t bufLen, unsigned char buf[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * >=0                      | Number of bytes written. Required length if \a buf is NULL.
+ * LTFATERR_NULLPOINTER     | \a atoms was NULL
+ * LTFATERR_BADREQSIZE      | \a bufLen is too small
+ */
+LTFAT_API ptrdiff_t
+LTFAT_NAME(dgtrealmp_atoms_serialize)(
+    const LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo,
+    size_t bufLen, unsigned char buf[]);
+
+/** Read list of atoms from a byte stream created by dgtrealmp_atoms_serialize()
+ *
+ * \param[in]      buf Input buffer
+ * \param[in]   bufLen Length of \a buf in bytes
+ * \param[in] atomsLen Capacity of \a atoms
+ * \param[out]   atoms Atoms, can be NULL
+ * \param[out] atomsNo Number of atoms in the stream
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_deserialize_d( const unsigned char buf[], size_t bufLen,
+ *                      size_t atomsLen, ltfat_dgtrealmp_atom_d atoms[],
+ *                      size_t* atomsNo);
+ *
+ * ltfat_dgtrealmp_atoms_deserialize_s( const unsigned char buf[], size_t bufLen,
+ *                      size_t atomsLen, ltfat_dgtrealmp_atom_s atoms[],
+ *                      size_t* atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * >=0                      | Number of bytes read. Only the header is read if \a atoms is NULL.
+ * LTFATERR_NULLPOINTER     | \a buf or \a atomsNo was NULL
+ * LTFATERR_BADARG          | Stream is corrupted or was created with a different precision
+ * LTFATERR_BADREQSIZE      | \a atomsLen is smaller than the number of atoms
+ */
+LTFAT_API ptrdiff_t
+LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+    const unsigned char buf[], size_t bufLen, size_t atomsLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t* atomsNo);
+
+/** Sort atoms by dictionary, time and frequency index
+ *
+ * \param[in/out] atoms Atoms
+ * \param[in]   atomsNo Number of atoms
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_sort_d( ltfat_dgtrealmp_atom_d atoms[], size_t atomsNo);
+ *
+ * ltfat_dgtrealmp_atoms_sort_s( ltfat_dgtrealmp_atom_s atoms[], size_t atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_sort)(
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo);
+
+/** @}*/
+
 /***********************************************************************/
 
 /** \name Parameter setup struct */
@@ -757,6 +948,35 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_setparbuf_pedanticsearch)(
     LTFAT_NAME(dgtrealmp_parbuf)* parbuf, int do_pedantic);
 
+/** Set number of threads used by the ltfat_dgtmp_alg_ParallelMP algorithm
+ *
+ * ParallelMP selects several atoms with non-overlapping Gram kernel
+ * supports in each step and updates the residual around them concurrently.
+ * The selected atoms and therefore the decomposition do not depend on the
+ * number of threads. The value is ignored if libltfat was compiled without OpenMP.
+ *
+ * \param[in]     parbuf  DGTREALMP parameter buffer
+ * \param[in]   nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_nthreads_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                       ltfat_int nthreads);
+ *
+ * ltfat_dgtrealmp_setparbuf_nthreads_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                       ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ * LTFATERR_NOTPOSARG       | \a nthreads was not positive
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, ltfat_int nthreads);
+
 /* TODO:
 LTFAT_API int
 LTFAT_NAME(dgtrealmp_parbuf_mod_chirpmod)(
@@ -121,6 +121,60 @@ LTFAT_NAME(dgtreal_execute_ana_newarray)(LTFAT_NAME(dgtreal_plan)* p,
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_ana)(LTFAT_NAME(dgtreal_plan)* p);
 
+/** Perform DGTREAL analysis followed by an element-wise coefficient update
+ *
+ * The coefficients are passed through \a blockfunc. With the filter bank
+ * algorithm it is done block by block right after the FFT, otherwise
+ * it is called once per channel after the transform, in-place on \a c.
+ *
+ * \param[in]          p  Transform plan
+ * \param[in]          f  Input signal, size L x W
+ * \param[in]  blockfunc  Block processing function
+ * \param[in]   userdata  Passed to \a blockfunc
+ * \param[out]         c  Coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_execute_ana_blockfunc_d(ltfat_dgtreal_plan_d* p, const double f[],
+ *                                       ltfat_dgtreal_blockfunc_d* blockfunc,
+ *                                       void* userdata, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_execute_ana_blockfunc_s(ltfat_dgtreal_plan_s* p, const float f[],
+ *                                       ltfat_dgtreal_blockfunc_s* blockfunc,
+ *                                       void* userdata, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_blockfunc)(LTFAT_NAME(dgtreal_plan)* p,
+        const LTFAT_REAL f[], LTFAT_NAME(dgtreal_blockfunc)* blockfunc,
+        void* userdata, LTFAT_COMPLEX c[]);
+
+/** Perform DGTREAL projection followed by an element-wise coefficient update
+ *
+ * Same as dgtreal_execute_proj followed by dgtreal_execute_ana_blockfunc
+ * semantics for the analysis part. This CAN work inplace.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_execute_proj_blockfunc_d(ltfat_dgtreal_plan_d* p,
+ *                                        const ltfat_complex_d cin[], double fbuffer[],
+ *                                        ltfat_dgtreal_blockfunc_d* blockfunc,
+ *                                        void* userdata, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_execute_proj_blockfunc_s(ltfat_dgtreal_plan_s* p,
+ *                                        const ltfat_complex_s cin[], float fbuffer[],
+ *                                        ltfat_dgtreal_blockfunc_s* blockfunc,
+ *                                        void* userdata, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_proj_blockfunc)(LTFAT_NAME(dgtreal_plan)* p,
+        const LTFAT_COMPLEX cin[], LTFAT_REAL fbuffer[],
+        LTFAT_NAME(dgtreal_blockfunc)* blockfunc, void* userdata,
+        LTFAT_COMPLEX c[]);
+
 /** Destroy transform plan
  *
  * \param[in]   p  Transform plan
@@ -63,6 +63,21 @@ ltfat_dgt_setpar_fftwflags(ltfat_dgt_params* params, unsigned fftw_flags);
 LTFAT_API int
 ltfat_dgt_setpar_hint(ltfat_dgt_params* params, ltfat_dgt_hint hint);
 
+/** Set number of threads
+ *
+ * Currently only the factorization based analysis (\a ltfat_dgt_long)
+ * is multithreaded. Has no effect if libltfat was compiled without OpenMP.
+ *
+ * \returns
+ * Status code          |  Description
+ * ---------------------|----------------
+ * LTFATERR_SUCESS      |  No error occured
+ * LTFATERR_NULLPOINTER |  \a params was NULL
+ * LTFATERR_NOTPOSARG   |  \a nthreads was not positive
+ */
+LTFAT_API int
+ltfat_dgt_setpar_nthreads(ltfat_dgt_params* params, ltfat_int nthreads);
+
 LTFAT_API int
 ltfat_dgt_setpar_synoverwrites(ltfat_dgt_params* params, int do_synoverwrites);
 
@@ -77,3 +77,31 @@ LTFAT_NAME(ifftreal_execute_newarray)(LTFAT_NAME(ifftreal_plan)* p,
 
 LTFAT_API int
 LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p);
+
+/** Import FFTW wisdom from a file
+ *
+ * Plans created afterwards with e.g. FFTW_MEASURE or FFTW_PATIENT flags
+ * reuse the imported wisdom and skip the costly planning. Identical plans
+ * are shared among libltfat objects anyway, such that they are planned only
+ * once per process.
+ *
+ * \returns LTFATERR_FAILED if the file could not be read or parsed,
+ *          LTFATERR_NOTSUPPORTED if libltfat was not compiled with FFTW
+ */
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_import)(const char* filename);
+
+/** Export the accumulated FFTW wisdom to a file
+ *
+ * \returns LTFATERR_FAILED if the file could not be written,
+ *          LTFATERR_NOTSUPPORTED if libltfat was not compiled with FFTW
+ */
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_export)(const char* filename);
+
+/** Forget all accumulated FFTW wisdom
+ *
+ * \returns LTFATERR_NOTSUPPORTED if libltfat was not compiled with FFTW
+ */
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_forget)(void);
@@ -1,8 +1,38 @@
+#ifndef _ltfat_heaptype_defined
+#define _ltfat_heaptype_defined
+
+/*
+ * Priority queue backends.
+ *
+ * LTFAT_HEAP_BINARY is an exact binary max-heap with O(log n) insert and
+ * delete.
+ *
+ * LTFAT_HEAP_BUCKET is a bucketed (radix) queue. The values are quantized
+ * on a logarithmic scale to 2^LTFAT_HEAP_BUCKETBITS buckets per octave.
+ * Insert is O(1) and delete is amortized O(1). Elements whose values fall
+ * into the same bucket are returned in an arbitrary order.
+ */
+typedef enum
+{
+    LTFAT_HEAP_BINARY = 0,
+    LTFAT_HEAP_BUCKET = 1
+} ltfat_heaptype;
+
+#endif
+
 typedef struct LTFAT_NAME(heap) LTFAT_NAME(heap);
 
 LTFAT_API LTFAT_NAME(heap)*
 LTFAT_NAME(heap_init)(ltfat_int initmaxsize, const LTFAT_REAL* s);
 
+/*
+ * do_log indicates whether s contains magnitudes (do_log=0) or
+ * log-magnitudes (do_log=1). It only affects the bucket queue.
+ */
+LTFAT_API LTFAT_NAME(heap)*
+LTFAT_NAME(heap_init_gen)(ltfat_int initmaxsize, const LTFAT_REAL* s,
+                          ltfat_heaptype type, int do_log);
+
 LTFAT_API void
 LTFAT_NAME(heap_done)(LTFAT_NAME(heap)* h);
 
@@ -12,6 +42,10 @@ LTFAT_NAME(heap_grow)(LTFAT_NAME(heap)* h, int factor);
 LTFAT_API void
 LTFAT_NAME(heap_reset)(LTFAT_NAME(heap)* h, const LTFAT_REAL* news);
 
+LTFAT_API void
+LTFAT_NAME(heap_reset_gen)(LTFAT_NAME(heap)* h, const LTFAT_REAL* news,
+                           int do_log);
+
 LTFAT_API ltfat_int
 LTFAT_NAME(heap_get)(LTFAT_NAME(heap) *h);
 
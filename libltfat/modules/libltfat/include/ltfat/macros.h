@@ -61,4 +61,85 @@
 
 #define LTFAT_STRUCTINIT(s,...)  (LTFAT_STRUCT_BRACKETS(s){__VA_ARGS__})
 
+// Pointer aliasing hint. Allows the compiler to vectorize the inner loops.
+#if defined(__cplusplus)
+#define LTFAT_RESTRICT __restrict
+#else
+#define LTFAT_RESTRICT restrict
+#endif
+
+// Approximate size in bytes of a block of coefficients processed by a single
+// batched FFT. The default is chosen such that the block fits into L2 cache.
+#ifndef LTFAT_FFTBATCHBYTES
+#define LTFAT_FFTBATCHBYTES (128*1024)
+#endif
+
+// Branching factor of the max trees. Children of a node occupy at least one
+// cache line for the default value and their maximum is found using SIMD.
+#ifndef LTFAT_MAXTREE_BRANCHING
+#define LTFAT_MAXTREE_BRANCHING 16
+#endif
+
+// Number of buckets per octave of the bucket queue heap backend is
+// 2^LTFAT_HEAP_BUCKETBITS. The default gives a resolution of about 0.38 dB.
+#ifndef LTFAT_HEAP_BUCKETBITS
+#define LTFAT_HEAP_BUCKETBITS 4
+#endif
+
+// Queue backend used by the heapint and maskedheapint function families.
+#ifndef LTFAT_HEAPINT_QUEUE
+#define LTFAT_HEAPINT_QUEUE LTFAT_HEAP_BINARY
+#endif
+
+// OpenMP helpers. When the library is compiled without OpenMP, the pragmas
+// expand to nothing, the loops run serially and only one thread is used.
+#if defined(_MSC_VER)
+#define LTFAT_PRAGMA(x) __pragma(x)
+#else
+#define LTFAT_PRAGMA(x) _Pragma(#x)
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#define LTFAT_OMP(x) LTFAT_PRAGMA(omp x)
+#define LTFAT_OMP_THREADID omp_get_thread_num()
+#define LTFAT_OMP_NTHREADS(n) (n)
+#else
+#define LTFAT_OMP(x)
+#define LTFAT_OMP_THREADID 0
+#define LTFAT_OMP_NTHREADS(n) 1
+#endif
+
+// Acquire load and release store of an ltfat_int shared by exactly two
+// threads, e.g. the read and write positions of a single-producer,
+// single-consumer ring buffer. The build fails for compilers without
+// atomics, plain accesses would not order the buffer contents.
+#if defined(__GNUC__) || defined(__clang__)
+#define LTFAT_ATOMIC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LTFAT_ATOMIC_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+// The interlocked intrinsics are full barriers on all architectures
+#include <intrin.h>
+#if defined(LTFAT_LARGEARRAYS) && defined(_WIN64)
+#define LTFAT_ATOMIC_LOAD(x) \
+    ((ltfat_int) _InterlockedCompareExchange64((volatile __int64*)&(x), 0, 0))
+#define LTFAT_ATOMIC_STORE(x, v) \
+    ((void) _InterlockedExchange64((volatile __int64*)&(x), (__int64)(v)))
+#else
+#define LTFAT_ATOMIC_LOAD(x) \
+    ((ltfat_int) _InterlockedCompareExchange((volatile long*)&(x), 0, 0))
+#define LTFAT_ATOMIC_STORE(x, v) \
+    ((void) _InterlockedExchange((volatile long*)&(x), (long)(v)))
+#endif
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+      !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define LTFAT_ATOMIC_LOAD(x) \
+    atomic_load_explicit((_Atomic ltfat_int*)&(x), memory_order_acquire)
+#define LTFAT_ATOMIC_STORE(x, v) \
+    atomic_store_explicit((_Atomic ltfat_int*)&(x), (v), memory_order_release)
+#else
+#error "LTFAT_ATOMIC_LOAD and LTFAT_ATOMIC_STORE need GCC builtins, MSVC intrinsics or C11 atomics."
+#endif
+
 #endif /* _LTFAT_MACROS_H */
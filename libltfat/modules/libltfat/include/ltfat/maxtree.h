@@ -40,6 +40,12 @@ LTFAT_API int
 LTFAT_NAME(maxtree_findmax)(
     LTFAT_NAME(maxtree)* p, LTFAT_REAL* max, ltfat_int* maxPos);
 
+// Maximum of the elements start,...,end-1. The range must not wrap around.
+LTFAT_API int
+LTFAT_NAME(maxtree_findmaxinrange)(
+    LTFAT_NAME(maxtree)* p, ltfat_int start, ltfat_int end,
+    LTFAT_REAL* max, ltfat_int* maxPos);
+
 LTFAT_API int
 LTFAT_NAME(maxtree_done)(LTFAT_NAME(maxtree)** p);
 
@@ -0,0 +1,370 @@
+typedef struct LTFAT_NAME(nsdgtreal_plan) LTFAT_NAME(nsdgtreal_plan);
+typedef struct LTFAT_NAME(insdgtreal_plan) LTFAT_NAME(insdgtreal_plan);
+
+/** \defgroup nsdgt Non-stationary Discrete Gabor Transform
+ *  \addtogroup nsdgt
+ * @{
+ *
+ * The non-stationary Gabor system consists of N windows g_n of length gl_n.
+ * Window n is centered at time position
+ *
+ *     timepos_0 = 0,  timepos_n = timepos_{n-1} + a_n
+ *
+ * and it is modulated using M_n frequency channels. The length of the system
+ * is L = a_0 + a_1 + ... + a_{N-1}. The windows are expected to be
+ * in the "zero-centered" format (see ltfat_fftshift) just like in the
+ * MATLAB/Octave functions nsdgtreal, insdgtreal and nsgabdual.
+ *
+ * The coefficients of window n (M2_n = M_n/2 + 1 of them per channel)
+ * are stored contiguously and the windows follow each other i.e.
+ * the coefficients are a concatenation of arrays of size M2_n x W.
+ * The phase of each column is relative to the window center.
+ *
+ * Plans for FFTs of equal length are shared among the windows.
+ */
+
+/** \name NSDGTREAL
+ * @{ */
+
+/** Compute non-stationary Discrete Gabor Transform for real signals
+ *
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     g   Array of pointers to the windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[in]     L   Signal length, must be equal to the sum of \a a
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Coefficients, ltfat_nsdgtreal_coefsize(M, N) x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsdgtreal_d(const double f[], const double* g[], const ltfat_int gl[],
+ *                   const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                   ltfat_int L, ltfat_int W, ltfat_complex_d c[]);
+ *
+ * ltfat_nsdgtreal_s(const float f[], const float* g[], const ltfat_int gl[],
+ *                   const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                   ltfat_int L, ltfat_int W, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N, \a W or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative
+ * LTFATERR_BADTRALEN       | \a L is not equal to the sum of a_n
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal)(const LTFAT_REAL f[], const LTFAT_REAL* g[],
+                      const ltfat_int gl[], const ltfat_int a[],
+                      const ltfat_int M[], ltfat_int N,
+                      ltfat_int L, ltfat_int W, LTFAT_COMPLEX c[]);
+
+/** Initialize plan for non-stationary Discrete Gabor Transform for real signals
+ *
+ * The windows are copied i.e. \a g can be freed after the call.
+ *
+ * \param[in]     g   Array of pointers to the windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   NSDGTREAL plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsdgtreal_init_d(const double* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                        unsigned flags, ltfat_nsdgtreal_plan_d** plan);
+ *
+ * ltfat_nsdgtreal_init_s(const float* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                        unsigned flags, ltfat_nsdgtreal_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays or \a plan was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative or all of them were zero
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                           unsigned flags, LTFAT_NAME(nsdgtreal_plan)** plan);
+
+/** Execute plan for non-stationary Discrete Gabor Transform for real signals
+ *
+ * \param[in]  plan   NSDGTREAL plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length, must be equal to the sum of a_n
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Coefficients, ltfat_nsdgtreal_coefsize(M, N) x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsdgtreal_execute_d(ltfat_nsdgtreal_plan_d* plan, const double f[],
+ *                           ltfat_int L, ltfat_int W, ltfat_complex_d c[]);
+ *
+ * ltfat_nsdgtreal_execute_s(ltfat_nsdgtreal_plan_s* plan, const float f[],
+ *                           ltfat_int L, ltfat_int W, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_BADTRALEN       | \a L is not equal to the sum of a_n
+ * LTFATERR_NOTPOSARG       | \a W was not positive
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_execute)(LTFAT_NAME(nsdgtreal_plan)* plan,
+                              const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                              LTFAT_COMPLEX c[]);
+
+/** Destroy the plan
+ *
+ * \param[in]  plan   NSDGTREAL plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsdgtreal_done_d(ltfat_nsdgtreal_plan_d** plan);
+ *
+ * ltfat_nsdgtreal_done_s(ltfat_nsdgtreal_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_done)(LTFAT_NAME(nsdgtreal_plan)** plan);
+
+/** @}*/
+
+/** \name INSDGTREAL
+ * @{ */
+
+/** Compute inverse non-stationary Discrete Gabor Transform for real signals
+ *
+ * \param[in]     c   Coefficients, ltfat_nsdgtreal_coefsize(M, N) x W
+ * \param[in]     g   Array of pointers to the synthesis windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[in]     L   Signal length, must be equal to the sum of \a a
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_insdgtreal_d(const ltfat_complex_d c[], const double* g[],
+ *                    const ltfat_int gl[], const ltfat_int a[],
+ *                    const ltfat_int M[], ltfat_int N,
+ *                    ltfat_int L, ltfat_int W, double f[]);
+ *
+ * ltfat_insdgtreal_s(const ltfat_complex_s c[], const float* g[],
+ *                    const ltfat_int gl[], const ltfat_int a[],
+ *                    const ltfat_int M[], ltfat_int N,
+ *                    ltfat_int L, ltfat_int W, float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N, \a W or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative
+ * LTFATERR_BADTRALEN       | \a L is not equal to the sum of a_n
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal)(const LTFAT_COMPLEX c[], const LTFAT_REAL* g[],
+                       const ltfat_int gl[], const ltfat_int a[],
+                       const ltfat_int M[], ltfat_int N,
+                       ltfat_int L, ltfat_int W, LTFAT_REAL f[]);
+
+/** Initialize plan for inverse non-stationary Discrete Gabor Transform for real signals
+ *
+ * The windows are copied i.e. \a g can be freed after the call.
+ *
+ * \param[in]     g   Array of pointers to the synthesis windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   INSDGTREAL plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_insdgtreal_init_d(const double* g[], const ltfat_int gl[],
+ *                         const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                         unsigned flags, ltfat_insdgtreal_plan_d** plan);
+ *
+ * ltfat_insdgtreal_init_s(const float* g[], const ltfat_int gl[],
+ *                         const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                         unsigned flags, ltfat_insdgtreal_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays or \a plan was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative or all of them were zero
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                            const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                            unsigned flags, LTFAT_NAME(insdgtreal_plan)** plan);
+
+/** Execute plan for inverse non-stationary Discrete Gabor Transform for real signals
+ *
+ * \param[in]  plan   INSDGTREAL plan
+ * \param[in]     c   Coefficients, ltfat_nsdgtreal_coefsize(M, N) x W
+ * \param[in]     L   Signal length, must be equal to the sum of a_n
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_insdgtreal_execute_d(ltfat_insdgtreal_plan_d* plan, const ltfat_complex_d c[],
+ *                            ltfat_int L, ltfat_int W, double f[]);
+ *
+ * ltfat_insdgtreal_execute_s(ltfat_insdgtreal_plan_s* plan, const ltfat_complex_s c[],
+ *                            ltfat_int L, ltfat_int W, float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_BADTRALEN       | \a L is not equal to the sum of a_n
+ * LTFATERR_NOTPOSARG       | \a W was not positive
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_execute)(LTFAT_NAME(insdgtreal_plan)* plan,
+                               const LTFAT_COMPLEX c[], ltfat_int L, ltfat_int W,
+                               LTFAT_REAL f[]);
+
+/** Destroy the plan
+ *
+ * \param[in]  plan   INSDGTREAL plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_insdgtreal_done_d(ltfat_insdgtreal_plan_d** plan);
+ *
+ * ltfat_insdgtreal_done_s(ltfat_insdgtreal_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_done)(LTFAT_NAME(insdgtreal_plan)** plan);
+
+/** @}*/
+
+/** \name Dual windows of the non-stationary Gabor system
+ * @{ */
+
+/** Compute the diagonal of the frame operator of the non-stationary Gabor system
+ *
+ * \param[in]     g   Array of pointers to the windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[in]     L   Length of the system, must be equal to the sum of \a a
+ * \param[out]    d   Frame diagonal, size L x 1
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsgabframediag_d(const double* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                        ltfat_int L, double d[]);
+ *
+ * ltfat_nsgabframediag_s(const float* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                        ltfat_int L, float d[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative
+ * LTFATERR_BADTRALEN       | \a L is not equal to the sum of a_n
+ */
+LTFAT_API int
+LTFAT_NAME(nsgabframediag)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                           ltfat_int L, LTFAT_REAL d[]);
+
+/** Compute canonical dual windows for painless non-stationary Gabor system
+ *
+ * The system is painless if gl_n <= M_n for all n. The dual windows then
+ * have the same lengths as the original windows.
+ *
+ * \param[in]     g   Array of pointers to the original windows, size N x 1
+ * \param[in]    gl   Window lengths, size N x 1
+ * \param[in]     a   Time shifts, size N x 1
+ * \param[in]     M   Numbers of frequency channels, size N x 1
+ * \param[in]     N   Number of windows
+ * \param[out]   gd   Array of pointers to the dual windows, size N x 1.
+ *                    Window gd[n] must be allocated to gl[n] elements.
+ *                    Can be the same as \a g (inplace).
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_nsgabdual_painless_d(const double* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                            double* gd[]);
+ *
+ * ltfat_nsgabdual_painless_s(const float* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                            float* gd[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_BADSIZE         | Some of the window lengths was not positive or it was longer than L
+ * LTFATERR_NOTPOSARG       | \a N or some of the M_n was not positive
+ * LTFATERR_BADARG          | Some of the a_n was negative or all of them were zero
+ * LTFATERR_NOTPAINLESS     | The system is not painless
+ * LTFATERR_NOTAFRAME       | The system is not a frame i.e. the frame diagonal has zeros
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(nsgabdual_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                               LTFAT_REAL* gd[]);
+
+/** @}*/
+/** @}*/
@@ -13,6 +13,13 @@ typedef enum
     LTFAT_INVERSE
 } ltfat_transformdirection;
 
+/** Memory layout of the coefficients of multichannel frames */
+typedef enum
+{
+    LTFAT_RTDGTLAYOUT_CHANMAJOR, //!< c[m + w*M2], channels one after the other
+    LTFAT_RTDGTLAYOUT_FREQMAJOR  //!< c[w + m*W], channels interleaved
+} rtdgt_layout;
+
 #endif /* _RTDGTREAL_H */
 
 
@@ -24,6 +31,7 @@ int
 LTFAT_NAME(rtdgtreal_commoninit)(const LTFAT_REAL* g, ltfat_int gl,
                                  ltfat_int M, const rtdgt_phasetype ptype,
                                  const  ltfat_transformdirection tradir,
+                                 ltfat_int Wmax, const rtdgt_layout layout,
                                  LTFAT_NAME(rtdgtreal_plan)** p);
 
 /** Create RTDGTREAL plan
@@ -43,11 +51,35 @@ LTFAT_NAME(rtdgtreal_init)(const LTFAT_REAL g[], ltfat_int gl,
                            ltfat_int M, const rtdgt_phasetype ptype,
                            LTFAT_NAME(rtdgtreal_plan)** p);
 
+/** Create batched RTDGTREAL plan
+ *
+ * The plan transforms up to \a Wmax channels with a single batched FFT.
+ * With \a layout equal to LTFAT_RTDGTLAYOUT_FREQMAJOR, the coefficients of
+ * all channels belonging to one frequency are stored next to each other.
+ *
+ * \param[in]  g      Window
+ * \param[in]  gl     Window length
+ * \param[in]  M      Number of FFT channels
+ * \param[in]  ptype  Phase convention
+ * \param[in]  Wmax   Number of channels transformed by one FFT call
+ * \param[in]  layout Coefficient layout
+ * \param[out] p      RTDGTREAL plan
+ */
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_init_batch)(const LTFAT_REAL g[], ltfat_int gl,
+                                 ltfat_int M, const rtdgt_phasetype ptype,
+                                 ltfat_int Wmax, const rtdgt_layout layout,
+                                 LTFAT_NAME(rtdgtreal_plan)** p);
+
 /** Execute RTDGTREAL plan
+ *
+ * The channels are transformed in batches of Wmax channels.
+ *
  * \param[in]  p      RTDGTREAL plan
  * \param[in]  f      Input buffer (gl x W)
  * \param[in]  W      Number of channels
- * \param[out] c      Output DGT coefficients (M2 x W)
+ * \param[out] c      Output DGT coefficients (M2 x W or W x M2 depending
+ *                    on the layout)
  */
 LTFAT_API int
 LTFAT_NAME(rtdgtreal_execute)(const LTFAT_NAME(rtdgtreal_plan)* p,
@@ -77,9 +109,20 @@ LTFAT_NAME(rtidgtreal_init)(const LTFAT_REAL g[], ltfat_int gl,
                             ltfat_int M, const rtdgt_phasetype ptype,
                             LTFAT_NAME(rtdgtreal_plan)** p);
 
+/** Create batched RTIDGTREAL plan
+ *
+ * \see rtdgtreal_init_batch
+ */
+LTFAT_API int
+LTFAT_NAME(rtidgtreal_init_batch)(const LTFAT_REAL g[], ltfat_int gl,
+                                  ltfat_int M, const rtdgt_phasetype ptype,
+                                  ltfat_int Wmax, const rtdgt_layout layout,
+                                  LTFAT_NAME(rtdgtreal_plan)** p);
+
 /** Execute RTIDGTREAL plan
  * \param[in]  p      RTDGTREAL plan
- * \param[int] c      Input DGT coefficients (M2 x W)
+ * \param[int] c      Input DGT coefficients (M2 x W or W x M2 depending
+ *                    on the layout)
  * \param[in]  W      Number of channels
  * \param[out] f      Output buffer (gl x W)
  */
@@ -389,6 +432,24 @@ LTFAT_NAME(rtdgtreal_processor_setcallback)(LTFAT_NAME(rtdgtreal_processor_state
         LTFAT_NAME(rtdgtreal_processor_callback)* callback,
         void* userdata);
 
+/** Set coefficient layout of the DGTREAL processor
+ *
+ * By default, the callback receives the coefficients of the channels one
+ * after the other (LTFAT_RTDGTLAYOUT_CHANMAJOR), i.e. in[m + w*M2].
+ * With LTFAT_RTDGTLAYOUT_FREQMAJOR, the callback receives
+ * in[w + m*W] and it is expected to write out in the same layout. This is
+ * convenient e.g. for beamforming where all channels of one frequency are
+ * processed together.
+ *
+ * Like rtdgtreal_processor_setcallback, this is not thread safe.
+ *
+ * \param[in]            p   DGTREAL processor state
+ * \param[in]       layout   Coefficient layout
+ */
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_processor_setlayout)(LTFAT_NAME(rtdgtreal_processor_state)* p,
+        rtdgt_layout layout);
+
 /** Default processor callback
  *
  * The callback just copies data from input to the output.
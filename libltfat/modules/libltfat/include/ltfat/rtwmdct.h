@@ -0,0 +1,311 @@
+typedef struct LTFAT_NAME(rtwmdct_plan) LTFAT_NAME(rtwmdct_plan);
+// For now, the inverse plan is the same
+typedef LTFAT_NAME(rtwmdct_plan) LTFAT_NAME(rtiwmdct_plan);
+
+/** Create RTWMDCT plan
+ *
+ * The plan computes the M WMDCT coefficients of a single frame of length gl
+ * for up to \a Wmax channels at once. The WMDCT coefficients depend on the
+ * parity of the frame index and on the position of the frame modulo 4M,
+ * therefore the index of the frame is passed to the execute function.
+ *
+ * \param[in]  g      Window
+ * \param[in]  gl     Window length
+ * \param[in]  M      Number of channels
+ * \param[in]  Wmax   Number of channels transformed by one FFT call
+ * \param[out] p      RTWMDCT plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_rtwmdct_init_d(const double g[], ltfat_int gl, ltfat_int M, ltfat_int Wmax,
+ *                      ltfat_rtwmdct_plan_d** p);
+ *
+ * ltfat_rtwmdct_init_s(const float g[], ltfat_int gl, ltfat_int M, ltfat_int Wmax,
+ *                      ltfat_rtwmdct_plan_s** p);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a g or \a p was NULL
+ * LTFATERR_NOTPOSARG    |  One of the following was less or equal to zero: \a gl, \a M, \a Wmax
+ * LTFATERR_INITFAILED   |  The FFT plan creation failed
+ * LTFATERR_NOMEM        |  Heap memory allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                         ltfat_int Wmax, LTFAT_NAME(rtwmdct_plan)** p);
+
+/** Execute RTWMDCT plan
+ *
+ * The frame \a n contains the samples n*M - gl/2, ..., n*M - gl/2 + gl - 1
+ * of the stream. Only n modulo 4 matters.
+ *
+ * \param[in]  p      RTWMDCT plan
+ * \param[in]  f      Input frames, gl x W array
+ * \param[in]  n      Frame index
+ * \param[in]  W      Number of channels
+ * \param[out] c      Output WMDCT coefficients, M x W array
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_execute)(const LTFAT_NAME(rtwmdct_plan)* p,
+                            const LTFAT_REAL f[], ltfat_int n, ltfat_int W,
+                            LTFAT_REAL c[]);
+
+/** Destroy RTWMDCT plan
+ * \param[in]  p      RTWMDCT plan
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_done)(LTFAT_NAME(rtwmdct_plan)** p);
+
+/** Create RTIWMDCT plan
+ *
+ * \see rtwmdct_init
+ */
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          ltfat_int Wmax, LTFAT_NAME(rtiwmdct_plan)** p);
+
+/** Execute RTIWMDCT plan
+ *
+ * The synthesized frames are meant to be overlap-added with hop size M.
+ *
+ * \param[in]  p      RTIWMDCT plan
+ * \param[in]  c      Input WMDCT coefficients, M x W array
+ * \param[in]  n      Frame index
+ * \param[in]  W      Number of channels
+ * \param[out] f      Output frames, gl x W array
+ */
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_execute)(const LTFAT_NAME(rtiwmdct_plan)* p,
+                             const LTFAT_REAL c[], ltfat_int n, ltfat_int W,
+                             LTFAT_REAL f[]);
+
+/** Destroy RTIWMDCT plan
+ * \param[in]  p      RTIWMDCT plan
+ */
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_done)(LTFAT_NAME(rtiwmdct_plan)** p);
+
+
+typedef struct LTFAT_NAME(rtwmdct_processor_state) LTFAT_NAME(rtwmdct_processor_state);
+
+/** \defgroup rtwmdctprocessor Real-Time WMDCT Processor
+ *  \addtogroup rtwmdctprocessor
+ *  @{
+ *  The real-time WMDCT processor is the critically sampled counterpart of
+ *  the real-time DGT processor. The hop size is always equal to the number
+ *  of channels M and the callback receives M real coefficients per channel.
+ *
+ *  Example:
+ *  ~~~~~~~~~~~~~~~{.c}
+ *  void process(void *userdata, const float in[], int M, int W, float out[])
+ *  {
+ *      for(int m=0; m<M*W; m++)
+ *          out[m] = 2.0f*in[m];
+ *  }
+ *
+ *  ltfat_rtwmdct_processor_state_s* procstate = NULL;
+ *  ltfat_rtwmdct_processor_init_win_s( LTFAT_SINE, 1024, 512, maxChanNo, 1024, 1023 + 1024, &procstate);
+ *  ltfat_rtwmdct_processor_setcallback_s(procstate, &process, NULL);
+ *
+ *  // In the audio loop
+ *  ltfat_rtwmdct_processor_execute_s(procstate, data, dataLen, chanNo, data);
+ *
+ *  ltfat_rtwmdct_processor_done_s(&procstate);
+ *  ~~~~~~~~~~~~~~~
+ */
+
+/** Processor callback signature
+ *
+ * It is safe to assume that out and in are not aliased.
+ *
+ * \param[in]  userdata   User defined data
+ * \param[in]        in   Input coefficients, M x W array
+ * \param[in]         M   Number of WMDCT channels
+ * \param[in]         W   Number of channels
+ * \param[out]      out   Output coefficients, M x W array
+ *
+ *  #### Function versions #
+ *  <tt>
+ *  typedef void ltfat_rtwmdct_processor_callback_d(void* userdata, const double in[], int M,
+ *                                                  int W, double out[]);
+ *
+ *  typedef void ltfat_rtwmdct_processor_callback_s(void* userdata, const float in[], int M,
+ *                                                  int W, float out[]);
+ *  </tt>
+ */
+typedef void LTFAT_NAME(rtwmdct_processor_callback)(void* userdata,
+        const LTFAT_REAL in[], int M, int W, LTFAT_REAL out[]);
+
+/** Create WMDCT processor state struct
+ *
+ * \param[in]          ga   Analysis window
+ * \param[in]         gal   Length of the analysis window
+ * \param[in]          gs   Synthesis window
+ * \param[in]         gsl   Length of the synthesis window
+ * \param[in]           M   Number of WMDCT channels, also the hop size
+ * \param[in]        Wmax   Maximum number of channels
+ * \param[in]   bufLenMax   Maximum buffer length expected in execute
+ * \param[in]   procDelay   Processing delay, at least max(gal,gsl) - 1
+ *                          and at most that plus \a bufLenMax
+ * \param[out]       plan   WMDCT processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_rtwmdct_processor_init_d(const double ga[], ltfat_int gal, const double gs[], ltfat_int gsl,
+ *                                ltfat_int M, ltfat_int Wmax, ltfat_int bufLenMax,
+ *                                ltfat_int procDelay, ltfat_rtwmdct_processor_state_d** plan);
+ *
+ * ltfat_rtwmdct_processor_init_s(const float ga[], ltfat_int gal, const float gs[], ltfat_int gsl,
+ *                                ltfat_int M, ltfat_int Wmax, ltfat_int bufLenMax,
+ *                                ltfat_int procDelay, ltfat_rtwmdct_processor_state_s** plan);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  One of the following was NULL: \a ga, \a gs, \a plan
+ * LTFATERR_BADSIZE      |  \a gal or \a gsl was less or equal to 0 or \a procDelay was out of range
+ * LTFATERR_NOTPOSARG    |  At least one of the following was less or equal to zero: \a M, \a Wmax, \a bufLenMax
+ * LTFATERR_NOMEM        |  Heap memory allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_init)(const LTFAT_REAL ga[], ltfat_int gal,
+                                   const LTFAT_REAL gs[], ltfat_int gsl,
+                                   ltfat_int M, ltfat_int Wmax,
+                                   ltfat_int bufLenMax, ltfat_int procDelay,
+                                   LTFAT_NAME(rtwmdct_processor_state)** plan);
+
+/** Create WMDCT processor state struct
+ *
+ * The synthesis window is the canonical dual Wilson window of \a win.
+ * Therefore, \a gl must be less or equal to 2M.
+ *
+ * \param[in]         win   Analysis window
+ * \param[in]          gl   Length of the windows
+ * \param[in]           M   Number of WMDCT channels, also the hop size
+ * \param[in]        Wmax   Maximum number of channels
+ * \param[in]   bufLenMax   Maximum buffer length expected in execute
+ * \param[in]   procDelay   Processing delay
+ * \param[out]       plan   WMDCT processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_rtwmdct_processor_init_win_d(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int M, ltfat_int Wmax,
+ *                                    ltfat_int bufLenMax, ltfat_int procDelay,
+ *                                    ltfat_rtwmdct_processor_state_d** plan);
+ *
+ * ltfat_rtwmdct_processor_init_win_s(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int M, ltfat_int Wmax,
+ *                                    ltfat_int bufLenMax, ltfat_int procDelay,
+ *                                    ltfat_rtwmdct_processor_state_s** plan);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a plan was NULL.
+ * LTFATERR_BADSIZE      |  \a gl was less or equal to 0 or greater than 2M
+ * LTFATERR_NOTPOSARG    |  At least one of the following was less or equal to zero: \a M, \a Wmax
+ * LTFATERR_CANNOTHAPPEN |  \a win was not valid value from the LTFAT_FIRWIN enum.
+ * LTFATERR_NOMEM        |  Heap memory allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_init_win)(LTFAT_FIRWIN win, ltfat_int gl,
+                                       ltfat_int M, ltfat_int Wmax,
+                                       ltfat_int bufLenMax, ltfat_int procDelay,
+                                       LTFAT_NAME(rtwmdct_processor_state)** plan);
+
+/** Reset processor state
+ *
+ * \see rtdgtreal_processor_reset
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_reset)(LTFAT_NAME(rtwmdct_processor_state)* p);
+
+/** Process samples
+ *
+ * Works like rtdgtreal_processor_execute. No memory is allocated.
+ * The output is lagging behind the input by \a procDelay samples.
+ *
+ * \param[in]      p  WMDCT processor
+ * \param[in]     in  Input channels
+ * \param[in]    len  Length of the channels
+ * \param[in] chanNo  Number of channels
+ * \param[out]   out  Output channels
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_rtwmdct_processor_execute_d(ltfat_rtwmdct_processor_state_d* p, const double* in[],
+ *                                   ltfat_int len, ltfat_int chanNo, double* out[]);
+ *
+ * ltfat_rtwmdct_processor_execute_s(ltfat_rtwmdct_processor_state_s* p, const float* in[],
+ *                                   ltfat_int len, ltfat_int chanNo, float* out[]);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_OVERFLOW     |  \a len or \a chanNo exceeded the maximum
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute)(LTFAT_NAME(rtwmdct_processor_state)* p,
+                                      const LTFAT_REAL* in[],
+                                      ltfat_int len, ltfat_int chanNo,
+                                      LTFAT_REAL* out[]);
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_gen)(
+    LTFAT_NAME(rtwmdct_processor_state)* p,
+    const LTFAT_REAL** in, ltfat_int inLen, ltfat_int chanNo, ltfat_int outLen,
+    LTFAT_REAL** out);
+
+/** Process samples
+ *
+ * Works exactly like rtwmdct_processor_execute except that the multichannel
+ * buffers are stored one after the other in the memory.
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_compact)(
+    LTFAT_NAME(rtwmdct_processor_state)* p,
+    const LTFAT_REAL in[],
+    ltfat_int len, ltfat_int chanNo,
+    LTFAT_REAL out[]);
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_gen_compact)(
+    LTFAT_NAME(rtwmdct_processor_state)* p, const LTFAT_REAL* in,
+    ltfat_int inLen, ltfat_int chanNo, ltfat_int outLen, LTFAT_REAL* out);
+
+/** Destroy WMDCT processor state
+ * \param[in]  p      WMDCT processor
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_done)(LTFAT_NAME(rtwmdct_processor_state)** plan);
+
+/** Set WMDCT processor callback
+ *
+ * Like rtdgtreal_processor_setcallback, this is not thread safe.
+ *
+ * \param[in]            p   WMDCT processor state
+ * \param[in]     callback   Custom function to process the coefficients
+ * \param[in]     userdata   Custom callback data. Will be passed to the callback.
+ */
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_setcallback)(LTFAT_NAME(rtwmdct_processor_state)* p,
+        LTFAT_NAME(rtwmdct_processor_callback)* callback,
+        void* userdata);
+
+/** Default processor callback
+ *
+ * The callback just copies data from input to the output.
+ */
+LTFAT_API void
+LTFAT_NAME(default_rtwmdct_processor_callback)(void* userdata, const LTFAT_REAL in[],
+        int M, int W, LTFAT_REAL out[]);
+
+/** @}*/
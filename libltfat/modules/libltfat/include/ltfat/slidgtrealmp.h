@@ -64,6 +64,76 @@ LTFAT_NAME(slidgtrealmp_execute_compact)(
 LTFAT_API ltfat_int
 LTFAT_NAME(slidgtrealmp_getprocdelay)( LTFAT_NAME(slidgtrealmp_state)* p);
 /** @} */
+
+/** \name Streaming interface
+ *
+ * In the streaming mode, the signal is not cut into independently
+ * decomposed slices. The decomposition runs on a circular buffer of length
+ * \a L which advances by \a hop samples. Each step only computes the
+ * coefficients of the \a hop new samples and commits the \a hop oldest
+ * ones. The residual coefficients of the rest of the buffer and the atoms
+ * found so far are carried over.
+ *
+ * All memory is allocated in the init function, the memory footprint
+ * does not depend on the length of the stream.
+ *
+ * The processor callback set by slidgtrealmp_setcallback is not used in
+ * this mode.
+ * @{ */
+
+/** Initialize the streaming matching pursuit
+ *
+ * \param[in]       pb  Parameter buffer
+ * \param[in]        L  Length of the circular buffer
+ * \param[in]      hop  Number of samples processed in one step
+ * \param[in] numChans  Maximum number of channels
+ * \param[in] bufLenMax Maximum length of the input buffer
+ * \param[out]    pout  Sliding MP state
+ *
+ * The output is delayed by slidgtrealmp_getprocdelay samples, which is
+ * approximately L minus the zero padding needed to keep the atoms
+ * at the buffer edges from interacting.
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a pb or \a pout was NULL
+ * LTFATERR_NOTPOSARG       | \a hop was not positive
+ * LTFATERR_BADARG          | \a L is too short for the given windows and \a hop
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_init_streaming)(
+    LTFAT_NAME(dgtrealmp_parbuf)* pb, ltfat_int L, ltfat_int hop,
+    ltfat_int numChans, ltfat_int bufLenMax,
+    LTFAT_NAME(slidgtrealmp_state)** pout);
+
+/** Processing time of the last step in seconds
+ *
+ * In the streaming mode, a step processes \a hop samples of all channels.
+ * Otherwise, it is the processing time of the last slice.
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_lastslicetime)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, double* seconds);
+
+/** Maximum processing time of a step in seconds since init or reset
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_maxslicetime)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, double* seconds);
+
+/** Size of the signal and coefficient buffers in bytes
+ *
+ * The buffers are allocated in the init function and are never resized,
+ * the value is therefore also the peak memory used by the state.
+ * The window and kernel tables are not included.
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_memusage)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, size_t* bytes);
+/** @} */
 /** @} */
 
 /* PRIVATE */
@@ -5,6 +5,7 @@
 #include "dgt_fb.h"
 #include "idgt_fb.h"
 #include "wavelets.h"
+#include "wfbt.h"
 #include "goertzel.h"
 #include "ciutils.h"
 #include "gabdual_painless.h"
@@ -169,7 +170,7 @@ LTFAT_NAME(dwilt_long)(const LTFAT_TYPE *f,
                        ltfat_int L, ltfat_int W, ltfat_int M,
                        LTFAT_TYPE *cout);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(dwilt_fb)(const LTFAT_TYPE *f, const LTFAT_TYPE *g,
                      ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int M,
                      LTFAT_TYPE *cout);
@@ -181,7 +182,7 @@ LTFAT_NAME(dwiltiii_long)(const LTFAT_TYPE *f,
                           ltfat_int L, ltfat_int W, ltfat_int M,
                           LTFAT_TYPE *cout);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(dwiltiii_fb)(const LTFAT_TYPE *f, const LTFAT_TYPE *g,
                         ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int M,
                         LTFAT_TYPE *cout);
@@ -196,7 +197,7 @@ LTFAT_NAME(idwilt_long)(const LTFAT_TYPE *cin,
                         ltfat_int L, ltfat_int W, ltfat_int M,
                         LTFAT_TYPE *f);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(idwilt_fb)(const LTFAT_TYPE *cin, const LTFAT_TYPE *g,
                       ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int M,
                       LTFAT_TYPE *f);
@@ -207,7 +208,7 @@ LTFAT_NAME(idwiltiii_long)(const LTFAT_TYPE *cin,
                            ltfat_int L, ltfat_int W, ltfat_int M,
                            LTFAT_TYPE *f);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(idwiltiii_fb)(const LTFAT_TYPE *cin, const LTFAT_TYPE *g,
                          ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int M,
                          LTFAT_TYPE *f);
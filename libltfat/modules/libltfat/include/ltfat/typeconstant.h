@@ -45,6 +45,17 @@ ltfat_int ltfat_lcm(ltfat_int a, ltfat_int b);
  */
 LTFAT_API ltfat_int
 ltfat_dgtlength(ltfat_int Ls, ltfat_int a, ltfat_int M);
+
+/** Find length of the non-stationary Gabor system with time shifts a[0],...,a[N-1]
+ */
+LTFAT_API ltfat_int
+ltfat_nsdgtlength(const ltfat_int a[], ltfat_int N);
+
+/** Find number of coefficients (per signal channel) of the non-stationary
+ *  DGTREAL with numbers of channels M[0],...,M[N-1]
+ */
+LTFAT_API ltfat_int
+ltfat_nsdgtreal_coefsize(const ltfat_int M[], ltfat_int N);
 /** @}*/
 
 LTFAT_API ltfat_int
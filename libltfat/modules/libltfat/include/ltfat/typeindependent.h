@@ -4,6 +4,8 @@
 #include "dgtreal_long.h"
 #include "idgtreal_long.h"
 #include "dgtreal_fb.h"
+#include "wilson_fb.h"
+#include "nsdgtreal.h"
 #include "idgtreal_fb.h"
 #include "dgt_multi.h"
 #include "dgt_shear.h"
@@ -11,6 +13,8 @@
 #include "circularbuf.h"
 #include "slicingbuf.h"
 #include "rtdgtreal.h"
+#include "rtwmdct.h"
+#include "coeffile.h"
 #include "heap.h"
 #include "dgtrealwrapper.h"
 #include "dgtrealmp.h"
@@ -345,6 +349,16 @@ LTFAT_NAME(heapinttask_init)(ltfat_int height, ltfat_int N,
                              ltfat_int initheapsize,
                              const LTFAT_REAL* s, int do_real);
 
+/* Same as heapinttask_init, but allows choosing the priority queue backend.
+ * LTFAT_HEAP_BUCKET is considerably faster for large height*N, but
+ * coefficients whose magnitudes differ by less than the bucket resolution
+ * are not integrated in the strict order of decreasing magnitude. */
+LTFAT_API LTFAT_NAME(heapinttask)*
+LTFAT_NAME(heapinttask_init_gen)(ltfat_int height, ltfat_int N,
+                                 ltfat_int initheapsize,
+                                 const LTFAT_REAL* s, int do_real,
+                                 ltfat_heaptype queuetype);
+
 LTFAT_API void
 LTFAT_NAME(heapint_execute)(LTFAT_NAME(heapinttask)* hit,
                             const LTFAT_REAL* s,
@@ -554,6 +568,15 @@ typedef struct
     LTFAT_COMPLEX *buf;
     LTFAT_COMPLEX *gext;
     LTFAT_COMPLEX *cbuf;
+    // Per-thread plans and buffers, the first ones are the ones above
+    ltfat_int nthreads;
+    LTFAT_NAME_COMPLEX(dgt_long_plan)** tplan;
+    LTFAT_COMPLEX **tbuf;
+    LTFAT_COMPLEX **tcbuf;
+    // Overlaps waiting for their target block, 2 x M x b2 x W
+    LTFAT_COMPLEX *pend;
+    // Overlap carried to the next call of dgt_ola_execute_stream, M x 2*b2 x W
+    LTFAT_COMPLEX *carry;
 
 } LTFAT_NAME(dgt_ola_plan);
 
@@ -569,6 +592,40 @@ LTFAT_NAME(dgt_ola_execute)(const LTFAT_NAME(dgt_ola_plan) plan,
                             const LTFAT_COMPLEX *f, ltfat_int L,
                             LTFAT_COMPLEX *cout);
 
+/* Process blocks on several threads
+ *
+ * Each thread gets its own dgt_long plan working on a block of bl
+ * samples. Has no effect if libltfat was compiled without OpenMP. */
+LTFAT_API int
+LTFAT_NAME(dgt_ola_setnthreads)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                ltfat_int nthreads);
+
+/* Streaming version of dgt_ola_execute
+ *
+ * The signal is passed in consecutive chunks of length L, which must be a
+ * multiple of bl. The chunks are not periodized, the overlap of the last
+ * block is carried to the next call instead. cout (M x L/a x W) is therefore
+ * delayed by b2 = gl/(2a) frames, the first b2 frames of the first call
+ * belong to the time before the first sample.
+ * Nothing is allocated. */
+LTFAT_API int
+LTFAT_NAME(dgt_ola_execute_stream)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                   const LTFAT_COMPLEX *f, ltfat_int L,
+                                   LTFAT_COMPLEX *cout);
+
+/* Clears the overlap carried between dgt_ola_execute_stream calls */
+LTFAT_API int
+LTFAT_NAME(dgt_ola_reset)(LTFAT_NAME(dgt_ola_plan)* plan);
+
+/* Ends the signal of dgt_ola_execute_stream
+ *
+ * Writes the last b2 frames (M x b2 x W) held back by the delay, assuming
+ * the signal is followed by zeros, and resets the plan for a new signal.
+ * Returns b2 or a negative error code. */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgt_ola_stream_flush)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                 LTFAT_COMPLEX *cout);
+
 LTFAT_API void
 LTFAT_NAME(dgt_ola_done)(LTFAT_NAME(dgt_ola_plan) plan);
 
@@ -587,6 +644,16 @@ typedef struct
     LTFAT_REAL *buf;
     LTFAT_REAL *gext;
     LTFAT_COMPLEX *cbuf;
+    // Per-thread plans and buffers, the first ones are the ones above
+    ltfat_int nthreads;
+    LTFAT_NAME(dgtreal_long_plan)** tplan;
+    LTFAT_REAL **tbuf;
+    LTFAT_COMPLEX **tcbuf;
+    // Overlaps waiting for their target block, 2 x (M/2+1) x b2 x W
+    LTFAT_COMPLEX *pend;
+    // Overlap carried to the next call of dgtreal_ola_execute_stream,
+    // (M/2+1) x 2*b2 x W
+    LTFAT_COMPLEX *carry;
 
 } LTFAT_NAME(dgtreal_ola_plan);
 
@@ -603,6 +670,25 @@ LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
                                 const LTFAT_REAL *f, ltfat_int L,
                                 LTFAT_COMPLEX *cout);
 
+/* \see dgt_ola_setnthreads */
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_setnthreads)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                    ltfat_int nthreads);
+
+/* \see dgt_ola_execute_stream, cout is M/2+1 x L/a x W */
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_execute_stream)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                       const LTFAT_REAL *f, ltfat_int L,
+                                       LTFAT_COMPLEX *cout);
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_reset)(LTFAT_NAME(dgtreal_ola_plan)* plan);
+
+/* \see dgt_ola_stream_flush, cout is M/2+1 x b2 x W */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_ola_stream_flush)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                     LTFAT_COMPLEX *cout);
+
 LTFAT_API void
 LTFAT_NAME(dgtreal_ola_done)(LTFAT_NAME(dgtreal_ola_plan) plan);
 
@@ -13,8 +13,8 @@
 #   define ltfat_abs(x) std::abs(x)
 #   define ltfat_arg(x) std::arg(x)
 #else
-#   define ltfat_complex_d(r,i) ((float)(r) + ((float)(i))*I)
-#   define ltfat_complex_s(r,i) ((double)(r) + ((double)(i))*I)
+#   define ltfat_complex_d(r,i) ((double)(r) + ((double)(i))*I)
+#   define ltfat_complex_s(r,i) ((float)(r) + ((float)(i))*I)
 #   define ltfat_real(x) creal(x)
 #   define ltfat_imag(x) cimag(x)
 #   define ltfat_abs(x) fabs(x)
@@ -42,12 +42,14 @@ LTFAT_NAME(extend_right)(const LTFAT_TYPE *in, ltfat_int inLen, LTFAT_TYPE *buff
 
 
 
+/* c and f can be the same array (inplace), but must not overlap otherwise */
 LTFAT_API void
 LTFAT_NAME(convsub_td)(const LTFAT_TYPE *f, const LTFAT_TYPE *g,
                        ltfat_int L, ltfat_int gl, ltfat_int a, ltfat_int skip,
                        LTFAT_TYPE *c, ltfatExtType ext);
 
 
+/* The result is added to f, c and f must not overlap */
 LTFAT_API void
 LTFAT_NAME(upconv_td)(const LTFAT_TYPE *c, const LTFAT_TYPE *g,
                       ltfat_int L,  ltfat_int gl, ltfat_int a, ltfat_int skip,
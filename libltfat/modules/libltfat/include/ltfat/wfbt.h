@@ -0,0 +1,382 @@
+typedef struct LTFAT_NAME(wfbt_tree) LTFAT_NAME(wfbt_tree);
+typedef struct LTFAT_NAME(wfbt_plan) LTFAT_NAME(wfbt_plan);
+
+/** \defgroup wfbt Wavelet filterbank trees
+ *  \addtogroup wfbt
+ * @{
+ *
+ * A wavelet filterbank tree consists of nodes, each of them being a (time
+ * domain) filterbank with M filters. Every output of a node is either
+ * connected to a child node or it is a terminal output. The tree is built
+ * by adding the nodes one by one using wfbt_tree_addnode(), the first
+ * node is the root.
+ *
+ * The plans compute the whole decomposition (wfbt, wpfbt) or reconstruction
+ * (iwfbt) in a single call. All the intermediate buffers are allocated in
+ * a single block in the init function.
+ * The nodes at the same depth of the tree are independent and, if libltfat
+ * was compiled with OpenMP, they are processed in parallel.
+ *
+ * The terminal outputs are ordered in the depth-first order, outputs
+ * of a node are taken in the order of the filters. For the fwt tree
+ * (see fwt_tree_init) this gives the usual ordering of the coefficients:
+ * approximation coefficients of the coarsest level first followed by the
+ * detail coefficients from the coarsest to the finest level.
+ *
+ * The filter offsets are used only with the periodic boundary extension
+ * (ext == PER). With ext == VALID, the offset of a filter of length gl is
+ * -(gl-1) and it is -(a-1) with all the other extension types.
+ * This is the same as in the MATLAB/Octave functions fwt, wfbt and wpfbt.
+ */
+
+/** \name Wavelet filterbank tree description
+ * @{ */
+
+/** Create an empty tree
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_tree_init_d(ltfat_wfbt_tree_d** tree);
+ *
+ * ltfat_wfbt_tree_init_s(ltfat_wfbt_tree_s** tree);
+ *
+ * ltfat_wfbt_tree_init_dc(ltfat_wfbt_tree_dc** tree);
+ *
+ * ltfat_wfbt_tree_init_sc(ltfat_wfbt_tree_sc** tree);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a tree was NULL
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_tree_init)(LTFAT_NAME(wfbt_tree)** tree);
+
+/** Add node to the tree
+ *
+ * The filters are copied.
+ *
+ * \param[in]      tree  Tree
+ * \param[in]    parent  Index of the parent node or -1 for the root node
+ * \param[in] parentout  Output of the parent node the node is connected to
+ * \param[in]         g  Filters, array of M pointers
+ * \param[in]        gl  Filter lengths, size M x 1
+ * \param[in]         a  Subsampling factors, size M x 1
+ * \param[in]    offset  Filter offsets, size M x 1
+ * \param[in]         M  Number of filters
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_tree_addnode_d(ltfat_wfbt_tree_d* tree, ltfat_int parent,
+ *                           ltfat_int parentout, const double* g[],
+ *                           const ltfat_int gl[], const ltfat_int a[],
+ *                           const ltfat_int offset[], ltfat_int M);
+ *
+ * ltfat_wfbt_tree_addnode_s(ltfat_wfbt_tree_s* tree, ltfat_int parent,
+ *                           ltfat_int parentout, const float* g[],
+ *                           const ltfat_int gl[], const ltfat_int a[],
+ *                           const ltfat_int offset[], ltfat_int M);
+ *
+ * ltfat_wfbt_tree_addnode_dc(ltfat_wfbt_tree_dc* tree, ltfat_int parent,
+ *                            ltfat_int parentout, const ltfat_complex_d* g[],
+ *                            const ltfat_int gl[], const ltfat_int a[],
+ *                            const ltfat_int offset[], ltfat_int M);
+ *
+ * ltfat_wfbt_tree_addnode_sc(ltfat_wfbt_tree_sc* tree, ltfat_int parent,
+ *                            ltfat_int parentout, const ltfat_complex_s* g[],
+ *                            const ltfat_int gl[], const ltfat_int a[],
+ *                            const ltfat_int offset[], ltfat_int M);
+ * </tt>
+ * \returns
+ * Index of the new node (nonnegative number) or the following error codes:
+ *
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_NOTPOSARG       | \a M or some of the \a a or \a gl was not positive
+ * LTFATERR_BADARG          | The root already exists, \a parent is not a valid node index or \a parentout is already connected
+ * LTFATERR_NOTINRANGE      | \a parentout is not a valid output index
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_tree_addnode)(LTFAT_NAME(wfbt_tree)* tree,
+                              ltfat_int parent, ltfat_int parentout,
+                              const LTFAT_TYPE* g[], const ltfat_int gl[],
+                              const ltfat_int a[], const ltfat_int offset[],
+                              ltfat_int M);
+
+/** Create a tree of the fast wavelet transform
+ *
+ * The tree has J levels and the first output of each node is connected
+ * to the next level.
+ *
+ * \param[in]         g  Filters, array of M pointers
+ * \param[in]        gl  Filter lengths, size M x 1
+ * \param[in]         a  Subsampling factors, size M x 1
+ * \param[in]    offset  Filter offsets, size M x 1
+ * \param[in]         M  Number of filters
+ * \param[in]         J  Number of levels
+ * \param[out]     tree  Tree
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_fwt_tree_init_d(const double* g[], const ltfat_int gl[],
+ *                       const ltfat_int a[], const ltfat_int offset[],
+ *                       ltfat_int M, ltfat_int J, ltfat_wfbt_tree_d** tree);
+ *
+ * ltfat_fwt_tree_init_s(const float* g[], const ltfat_int gl[],
+ *                       const ltfat_int a[], const ltfat_int offset[],
+ *                       ltfat_int M, ltfat_int J, ltfat_wfbt_tree_s** tree);
+ *
+ * ltfat_fwt_tree_init_dc(const ltfat_complex_d* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int offset[],
+ *                        ltfat_int M, ltfat_int J, ltfat_wfbt_tree_dc** tree);
+ *
+ * ltfat_fwt_tree_init_sc(const ltfat_complex_s* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int offset[],
+ *                        ltfat_int M, ltfat_int J, ltfat_wfbt_tree_sc** tree);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arrays was NULL
+ * LTFATERR_NOTPOSARG       | \a M, \a J or some of the \a a or \a gl was not positive
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_tree_init)(const LTFAT_TYPE* g[], const ltfat_int gl[],
+                          const ltfat_int a[], const ltfat_int offset[],
+                          ltfat_int M, ltfat_int J, LTFAT_NAME(wfbt_tree)** tree);
+
+/** Destroy the tree
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_tree_done_d(ltfat_wfbt_tree_d** tree);
+ *
+ * ltfat_wfbt_tree_done_s(ltfat_wfbt_tree_s** tree);
+ *
+ * ltfat_wfbt_tree_done_dc(ltfat_wfbt_tree_dc** tree);
+ *
+ * ltfat_wfbt_tree_done_sc(ltfat_wfbt_tree_sc** tree);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | tree or *tree was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_tree_done)(LTFAT_NAME(wfbt_tree)** tree);
+
+/** @}*/
+
+/** \name Wavelet filterbank tree plans
+ * @{ */
+
+/** Initialize plan for the wavelet filterbank tree decomposition
+ *
+ * The tree is copied i.e. it can be destroyed after the call.
+ *
+ * \param[in]     tree  Analysis tree
+ * \param[in]        L  Signal length
+ * \param[in]        W  Number of signal channels
+ * \param[in]      ext  Boundary extension type
+ * \param[out]    plan  Plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_init_d(const ltfat_wfbt_tree_d* tree, ltfat_int L, ltfat_int W,
+ *                   ltfatExtType ext, ltfat_wfbt_plan_d** plan);
+ *
+ * ltfat_wfbt_init_s(const ltfat_wfbt_tree_s* tree, ltfat_int L, ltfat_int W,
+ *                   ltfatExtType ext, ltfat_wfbt_plan_s** plan);
+ *
+ * ltfat_wfbt_init_dc(const ltfat_wfbt_tree_dc* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_dc** plan);
+ *
+ * ltfat_wfbt_init_sc(const ltfat_wfbt_tree_sc* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_sc** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a tree or \a plan was NULL
+ * LTFATERR_EMPTY           | The tree has no nodes
+ * LTFATERR_NOTPOSARG       | \a L or \a W was not positive
+ * LTFATERR_BADARG          | \a ext is not a valid extension type
+ * LTFATERR_NOTINRANGE      | Some of the filter offsets is such that the zero index is outside of the filter support
+ * LTFATERR_BADTRALEN       | Some of the node outputs would be empty
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                      ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan);
+
+/** Initialize plan for the wavelet packet decomposition
+ *
+ * Same as wfbt_init, but the plan outputs all outputs of all the nodes,
+ * the nodes are taken in the order they were added to the tree.
+ * No scaling is applied to the intermediate outputs.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wpfbt_init_d(const ltfat_wfbt_tree_d* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_d** plan);
+ *
+ * ltfat_wpfbt_init_s(const ltfat_wfbt_tree_s* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_s** plan);
+ *
+ * ltfat_wpfbt_init_dc(const ltfat_wfbt_tree_dc* tree, ltfat_int L, ltfat_int W,
+ *                     ltfatExtType ext, ltfat_wfbt_plan_dc** plan);
+ *
+ * ltfat_wpfbt_init_sc(const ltfat_wfbt_tree_sc* tree, ltfat_int L, ltfat_int W,
+ *                     ltfatExtType ext, ltfat_wfbt_plan_sc** plan);
+ * </tt>
+ * \returns
+ * The same as wfbt_init
+ */
+LTFAT_API int
+LTFAT_NAME(wpfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                       ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan);
+
+/** Initialize plan for the wavelet filterbank tree reconstruction
+ *
+ * The tree must have the same structure as the analysis tree and
+ * it must contain the synthesis filters.
+ *
+ * \param[in]     tree  Synthesis tree
+ * \param[in]        L  Signal length
+ * \param[in]        W  Number of signal channels
+ * \param[in]      ext  Boundary extension type
+ * \param[out]    plan  Plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwfbt_init_d(const ltfat_wfbt_tree_d* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_d** plan);
+ *
+ * ltfat_iwfbt_init_s(const ltfat_wfbt_tree_s* tree, ltfat_int L, ltfat_int W,
+ *                    ltfatExtType ext, ltfat_wfbt_plan_s** plan);
+ *
+ * ltfat_iwfbt_init_dc(const ltfat_wfbt_tree_dc* tree, ltfat_int L, ltfat_int W,
+ *                     ltfatExtType ext, ltfat_wfbt_plan_dc** plan);
+ *
+ * ltfat_iwfbt_init_sc(const ltfat_wfbt_tree_sc* tree, ltfat_int L, ltfat_int W,
+ *                     ltfatExtType ext, ltfat_wfbt_plan_sc** plan);
+ * </tt>
+ * \returns
+ * The same as wfbt_init
+ */
+LTFAT_API int
+LTFAT_NAME(iwfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                       ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan);
+
+/** Execute the decomposition
+ *
+ * \param[in]     plan  Plan created by wfbt_init or wpfbt_init
+ * \param[in]        f  Input signal, size L x W
+ * \param[out]       c  Array of wfbt_get_outno() pointers to the coefficients,
+ *                      c[k] has size Lc[k] x W, see wfbt_get_outlens()
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_execute_d(ltfat_wfbt_plan_d* plan, const double f[], double* c[]);
+ *
+ * ltfat_wfbt_execute_s(ltfat_wfbt_plan_s* plan, const float f[], float* c[]);
+ *
+ * ltfat_wfbt_execute_dc(ltfat_wfbt_plan_dc* plan, const ltfat_complex_d f[],
+ *                       ltfat_complex_d* c[]);
+ *
+ * ltfat_wfbt_execute_sc(ltfat_wfbt_plan_sc* plan, const ltfat_complex_s f[],
+ *                       ltfat_complex_s* c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_BADARG          | \a plan was created by iwfbt_init
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_execute)(LTFAT_NAME(wfbt_plan)* plan, const LTFAT_TYPE f[],
+                         LTFAT_TYPE* c[]);
+
+/** Execute the reconstruction
+ *
+ * \param[in]     plan  Plan created by iwfbt_init
+ * \param[in]        c  Array of wfbt_get_outno() pointers to the coefficients,
+ *                      c[k] has size Lc[k] x W, see wfbt_get_outlens()
+ * \param[out]       f  Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwfbt_execute_d(ltfat_wfbt_plan_d* plan, const double* c[], double f[]);
+ *
+ * ltfat_iwfbt_execute_s(ltfat_wfbt_plan_s* plan, const float* c[], float f[]);
+ *
+ * ltfat_iwfbt_execute_dc(ltfat_wfbt_plan_dc* plan, const ltfat_complex_d* c[],
+ *                        ltfat_complex_d f[]);
+ *
+ * ltfat_iwfbt_execute_sc(ltfat_wfbt_plan_sc* plan, const ltfat_complex_s* c[],
+ *                        ltfat_complex_s f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_BADARG          | \a plan was not created by iwfbt_init
+ */
+LTFAT_API int
+LTFAT_NAME(iwfbt_execute)(LTFAT_NAME(wfbt_plan)* plan, const LTFAT_TYPE* c[],
+                          LTFAT_TYPE f[]);
+
+/** Get number of coefficient arrays
+ *
+ * \returns Number of coefficient arrays or LTFATERR_NULLPOINTER
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_get_outno)(const LTFAT_NAME(wfbt_plan)* plan);
+
+/** Get lengths of the coefficient arrays
+ *
+ * \param[in]     plan  Plan
+ * \param[out]      Lc  Lengths of the coefficient arrays, size wfbt_get_outno() x 1
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_get_outlens)(const LTFAT_NAME(wfbt_plan)* plan, ltfat_int Lc[]);
+
+/** Destroy the plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_done_d(ltfat_wfbt_plan_d** plan);
+ *
+ * ltfat_wfbt_done_s(ltfat_wfbt_plan_s** plan);
+ *
+ * ltfat_wfbt_done_dc(ltfat_wfbt_plan_dc** plan);
+ *
+ * ltfat_wfbt_done_sc(ltfat_wfbt_plan_sc** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_done)(LTFAT_NAME(wfbt_plan)** plan);
+
+/** @}*/
+/** @}*/
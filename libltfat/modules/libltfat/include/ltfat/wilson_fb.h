@@ -0,0 +1,279 @@
+typedef struct LTFAT_NAME(dwilt_fb_plan) LTFAT_NAME(dwilt_fb_plan);
+typedef struct LTFAT_NAME(idwilt_fb_plan) LTFAT_NAME(idwilt_fb_plan);
+typedef struct LTFAT_NAME(wmdct_fb_plan) LTFAT_NAME(wmdct_fb_plan);
+typedef struct LTFAT_NAME(iwmdct_fb_plan) LTFAT_NAME(iwmdct_fb_plan);
+
+/** \defgroup wilson Wilson and WMDCT bases
+ *
+ * Plans for the Discrete Wilson Transform (DWILT) and the Windowed Modified
+ * Discrete Cosine Transform (WMDCT, also known as type III Wilson transform)
+ * of real signals with FIR windows.
+ *
+ * The coefficients are identical to the ones computed by dwilt_fb and
+ * dwiltiii_fb, but the plans do not go through a DGT with 2M channels.
+ * Each frame is windowed and folded and then transformed directly:
+ * DWILT uses a single real FFT of length 2M and WMDCT uses a single
+ * real FFT of length M (a fast DCT). All buffers are allocated in the
+ * init functions, no memory is allocated in the execute functions.
+ *
+ * The coefficient array is M x N x W, N = L/M. L must be divisible by 2M
+ * and it must be greater or equal to gl.
+ *
+ * The inverse plans compute the adjoint transform, which is the inverse
+ * if the window is tight (or the dual window is passed).
+ *
+ * \addtogroup wilson
+ * @{
+ */
+
+/** Initialize DWILT plan
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   DWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_fb_init_d(const double g[], ltfat_int gl, ltfat_int M,
+ *                       unsigned flags, ltfat_dwilt_fb_plan_d** plan);
+ *
+ * ltfat_dwilt_fb_init_s(const float g[], ltfat_int gl, ltfat_int M,
+ *                       unsigned flags, ltfat_dwilt_fb_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a plan
+ * LTFATERR_BADSIZE         | Length of the window \a gl was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a M was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          unsigned flags, LTFAT_NAME(dwilt_fb_plan)** plan);
+
+/** Execute DWILT plan
+ *
+ * \param[in]  plan   DWILT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Coefficients, size M x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_fb_execute_d(ltfat_dwilt_fb_plan_d* plan, const double f[],
+ *                          ltfat_int L, ltfat_int W, double c[]);
+ *
+ * ltfat_dwilt_fb_execute_s(ltfat_dwilt_fb_plan_s* plan, const float f[],
+ *                          ltfat_int L, ltfat_int W, float c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a c, \a plan
+ * LTFATERR_BADTRALEN       | \a L must be bigger of equal to \a gl and must be divisible by 2M
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_execute)(LTFAT_NAME(dwilt_fb_plan)* plan,
+                             const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                             LTFAT_REAL c[]);
+
+/** Destroy DWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_fb_done_d(ltfat_dwilt_fb_plan_d** plan);
+ *
+ * ltfat_dwilt_fb_done_s(ltfat_dwilt_fb_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_done)(LTFAT_NAME(dwilt_fb_plan)** plan);
+
+/** Initialize inverse DWILT plan
+ *
+ * \param[in]     g   Synthesis window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   IDWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_fb_init_d(const double g[], ltfat_int gl, ltfat_int M,
+ *                        unsigned flags, ltfat_idwilt_fb_plan_d** plan);
+ *
+ * ltfat_idwilt_fb_init_s(const float g[], ltfat_int gl, ltfat_int M,
+ *                        unsigned flags, ltfat_idwilt_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_init
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                           unsigned flags, LTFAT_NAME(idwilt_fb_plan)** plan);
+
+/** Execute inverse DWILT plan
+ *
+ * \param[in]  plan   IDWILT plan
+ * \param[in]     c   Coefficients, size M x N x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_fb_execute_d(ltfat_idwilt_fb_plan_d* plan, const double c[],
+ *                           ltfat_int L, ltfat_int W, double f[]);
+ *
+ * ltfat_idwilt_fb_execute_s(ltfat_idwilt_fb_plan_s* plan, const float c[],
+ *                           ltfat_int L, ltfat_int W, float f[]);
+ * </tt>
+ * \returns Same as dwilt_fb_execute
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_execute)(LTFAT_NAME(idwilt_fb_plan)* plan,
+                              const LTFAT_REAL c[], ltfat_int L, ltfat_int W,
+                              LTFAT_REAL f[]);
+
+/** Destroy inverse DWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_fb_done_d(ltfat_idwilt_fb_plan_d** plan);
+ *
+ * ltfat_idwilt_fb_done_s(ltfat_idwilt_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_done
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_done)(LTFAT_NAME(idwilt_fb_plan)** plan);
+
+/** Initialize WMDCT plan
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   WMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_fb_init_d(const double g[], ltfat_int gl, ltfat_int M,
+ *                       unsigned flags, ltfat_wmdct_fb_plan_d** plan);
+ *
+ * ltfat_wmdct_fb_init_s(const float g[], ltfat_int gl, ltfat_int M,
+ *                       unsigned flags, ltfat_wmdct_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_init
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          unsigned flags, LTFAT_NAME(wmdct_fb_plan)** plan);
+
+/** Execute WMDCT plan
+ *
+ * \param[in]  plan   WMDCT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Coefficients, size M x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_fb_execute_d(ltfat_wmdct_fb_plan_d* plan, const double f[],
+ *                          ltfat_int L, ltfat_int W, double c[]);
+ *
+ * ltfat_wmdct_fb_execute_s(ltfat_wmdct_fb_plan_s* plan, const float f[],
+ *                          ltfat_int L, ltfat_int W, float c[]);
+ * </tt>
+ * \returns Same as dwilt_fb_execute
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_execute)(LTFAT_NAME(wmdct_fb_plan)* plan,
+                             const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                             LTFAT_REAL c[]);
+
+/** Destroy WMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_fb_done_d(ltfat_wmdct_fb_plan_d** plan);
+ *
+ * ltfat_wmdct_fb_done_s(ltfat_wmdct_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_done
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_done)(LTFAT_NAME(wmdct_fb_plan)** plan);
+
+/** Initialize inverse WMDCT plan
+ *
+ * \param[in]     g   Synthesis window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   IWMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_fb_init_d(const double g[], ltfat_int gl, ltfat_int M,
+ *                        unsigned flags, ltfat_iwmdct_fb_plan_d** plan);
+ *
+ * ltfat_iwmdct_fb_init_s(const float g[], ltfat_int gl, ltfat_int M,
+ *                        unsigned flags, ltfat_iwmdct_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_init
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                           unsigned flags, LTFAT_NAME(iwmdct_fb_plan)** plan);
+
+/** Execute inverse WMDCT plan
+ *
+ * \param[in]  plan   IWMDCT plan
+ * \param[in]     c   Coefficients, size M x N x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_fb_execute_d(ltfat_iwmdct_fb_plan_d* plan, const double c[],
+ *                           ltfat_int L, ltfat_int W, double f[]);
+ *
+ * ltfat_iwmdct_fb_execute_s(ltfat_iwmdct_fb_plan_s* plan, const float c[],
+ *                           ltfat_int L, ltfat_int W, float f[]);
+ * </tt>
+ * \returns Same as dwilt_fb_execute
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_execute)(LTFAT_NAME(iwmdct_fb_plan)* plan,
+                              const LTFAT_REAL c[], ltfat_int L, ltfat_int W,
+                              LTFAT_REAL f[]);
+
+/** Destroy inverse WMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_fb_done_d(ltfat_iwmdct_fb_plan_d** plan);
+ *
+ * ltfat_iwmdct_fb_done_s(ltfat_iwmdct_fb_plan_s** plan);
+ * </tt>
+ * \returns Same as dwilt_fb_done
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_done)(LTFAT_NAME(iwmdct_fb_plan)** plan);
+
+/** @}*/
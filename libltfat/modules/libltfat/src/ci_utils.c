@@ -279,6 +279,75 @@ error:
 }
 
 
+/* Contiguous multiply-accumulate. The complex version is written
+ * out in the real and imaginary parts explicitly such that the compiler does not
+ * have to handle the inf/nan special cases of the complex multiplication
+ * and can vectorize the loop. */
+static inline void
+LTFAT_NAME(windowfold_kernel)(const LTFAT_TYPE* LTFAT_RESTRICT in,
+                              const LTFAT_TYPE* LTFAT_RESTRICT g,
+                              ltfat_int len, LTFAT_TYPE* LTFAT_RESTRICT out)
+{
+#ifdef LTFAT_COMPLEXTYPE
+    const LTFAT_REAL* LTFAT_RESTRICT inr = (const LTFAT_REAL*) in;
+    const LTFAT_REAL* LTFAT_RESTRICT gr = (const LTFAT_REAL*) g;
+    LTFAT_REAL* LTFAT_RESTRICT outr = (LTFAT_REAL*) out;
+
+    LTFAT_OMP(simd)
+    for (ltfat_int l = 0; l < len; l++)
+    {
+        LTFAT_REAL re = inr[2 * l] * gr[2 * l] - inr[2 * l + 1] * gr[2 * l + 1];
+        LTFAT_REAL im = inr[2 * l] * gr[2 * l + 1] + inr[2 * l + 1] * gr[2 * l];
+        outr[2 * l] += re;
+        outr[2 * l + 1] += im;
+    }
+#else
+    LTFAT_OMP(simd)
+    for (ltfat_int l = 0; l < len; l++)
+        out[l] += in[l] * g[l];
+#endif
+}
+
+LTFAT_API int
+LTFAT_NAME(windowfold_array)(const LTFAT_TYPE* in, ltfat_int L, ltfat_int start,
+                             const LTFAT_TYPE* g, ltfat_int gl,
+                             ltfat_int offset, ltfat_int Lfold, LTFAT_TYPE* out)
+{
+    ltfat_int inIdx, outIdx;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(in); CHECKNULL(g); CHECKNULL(out);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl must be positive");
+    CHECK(LTFATERR_BADSIZE, Lfold > 0, "Lfold must be positive");
+
+    inIdx = ltfat_positiverem(start, L);
+    outIdx = ltfat_positiverem(offset, Lfold);
+
+    for (ltfat_int l = 0; l < Lfold; l++)
+        out[l] = 0.0;
+
+    // The window is processed in runs which neither wrap around the end
+    // of in nor around the end of out such that the inner loop is
+    // branch-free
+    for (ltfat_int l = 0; l < gl;)
+    {
+        ltfat_int run = gl - l;
+        if (L - inIdx < run) run = L - inIdx;
+        if (Lfold - outIdx < run) run = Lfold - outIdx;
+
+        LTFAT_NAME(windowfold_kernel)(in + inIdx, g + l, run, out + outIdx);
+
+        l += run;
+        inIdx += run;
+        outIdx += run;
+        if (inIdx == L) inIdx = 0;
+        if (outIdx == Lfold) outIdx = 0;
+    }
+
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(ensurecomplex_array)(const LTFAT_TYPE* in,  ltfat_int L,
                                 LTFAT_COMPLEX* out)
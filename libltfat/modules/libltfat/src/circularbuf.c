@@ -120,13 +120,69 @@ error:
     return status;
 }
 
+/* Run the callback on all complete blocks in the input fifo.
+ *
+ * With waitforspace set, a block is only taken from the input fifo if the
+ * output fifo can accept it. Otherwise it is left in place for the next call.
+ */
+static ltfat_int
+LTFAT_NAME(block_processor_processblocks)(
+    LTFAT_NAME(block_processor_state)* p, int dosynthesis, int waitforspace)
+{
+    ltfat_int blocks = 0;
+    int status = LTFATERR_FAILED, callbackstatus = 0;
+
+    while ( !(dosynthesis && waitforspace &&
+              LTFAT_NAME(synthesis_fifo_freespace)(p->backfifo) < p->backfifo->winLen) &&
+            LTFAT_NAME(analysis_fifo_read)(p->fwdfifo, p->prebuf) > 0 )
+    {
+        if (p->prewin)
+        {
+            for (ltfat_int w = 0; w < p->fwdfifo->numChans; w++)
+                for (ltfat_int l = 0; l < p->fwdfifo->winLen; l++)
+                    p->prebuf[l + w * p->fwdfifo->numChans] *= p->prewin[l];
+        }
+
+        if (dosynthesis)
+        {
+            callbackstatus =
+                p->processorCallback(p->userdata, p->prebuf, p->fwdfifo->winLen,
+                                     p->fwdfifo->numChans, p->postbuf);
+
+            if (p->postwin)
+            {
+                for (ltfat_int w = 0; w < p->fwdfifo->numChans; w++)
+                    for (ltfat_int l = 0; l < p->fwdfifo->winLen; l++)
+                        p->postbuf[l + w * p->fwdfifo->numChans] *= p->postwin[l];
+            }
+
+            LTFAT_NAME(synthesis_fifo_write)(p->backfifo, p->postbuf);
+        }
+        else
+        {
+            callbackstatus =
+                p->processorCallback(p->userdata, p->prebuf, p->fwdfifo->winLen,
+                                     p->fwdfifo->numChans, NULL);
+        }
+
+        if (callbackstatus < 0)
+            CHECKSTATUS(LTFATERR_FAILED);
+
+        blocks++;
+    }
+
+    return blocks;
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(block_processor_execute)(
     LTFAT_NAME(block_processor_state)* p,
     const LTFAT_REAL** in, ltfat_int inLen, ltfat_int chanNo,
     ltfat_int outLen, LTFAT_REAL** out)
 {
-    int status = LTFATERR_FAILED, callbackstatus = 0;
+    int status = LTFATERR_FAILED;
     ltfat_int samplesWritten = 0, samplesRead = 0;
 
     // Failing these checks prohibits execution altogether
@@ -178,41 +234,8 @@ LTFAT_NAME(block_processor_execute)(
     samplesWritten =
         LTFAT_NAME(analysis_fifo_write)(p->fwdfifo, in, inLen, chanNo);
 
-    // While there is new data in the input fifo
-    while ( LTFAT_NAME(analysis_fifo_read)(p->fwdfifo, p->prebuf) > 0 )
-    {
-        if (p->prewin)
-        {
-            for (ltfat_int w = 0; w < p->fwdfifo->numChans; w++)
-                for (ltfat_int l = 0; l < p->fwdfifo->winLen; l++)
-                    p->prebuf[l + w * p->fwdfifo->numChans] *= p->prewin[l];
-        }
-
-        if (out)
-        {
-            callbackstatus =
-                p->processorCallback(p->userdata, p->prebuf, p->fwdfifo->winLen,
-                                     p->fwdfifo->numChans, p->postbuf);
-
-            if (p->postwin)
-            {
-                for (ltfat_int w = 0; w < p->fwdfifo->numChans; w++)
-                    for (ltfat_int l = 0; l < p->fwdfifo->winLen; l++)
-                        p->postbuf[l + w * p->fwdfifo->numChans] *= p->postwin[l];
-            }
-
-            LTFAT_NAME(synthesis_fifo_write)(p->backfifo, p->postbuf);
-        }
-        else
-        {
-            callbackstatus =
-                p->processorCallback(p->userdata, p->prebuf, p->fwdfifo->winLen,
-                                     p->fwdfifo->numChans, NULL);
-        }
-
-        if (callbackstatus < 0)
-            CHECKSTATUS(LTFATERR_FAILED);
-    }
+    // Process all blocks available in the input fifo
+    CHECKSTATUS( LTFAT_NAME(block_processor_processblocks)(p, out != NULL, 0));
 
     // Read sampples for output
     if (out)
@@ -222,8 +245,8 @@ LTFAT_NAME(block_processor_execute)(
     }
 
     LTFAT_NAME(block_processor_advanceby)( p, samplesWritten, samplesRead);
-    LTFAT_NAME(analysis_fifo_sethop)(p->fwdfifo, p->prehop);
-    LTFAT_NAME(synthesis_fifo_sethop)(p->backfifo, p->posthop);
+    LTFAT_NAME(analysis_fifo_sethop)(p->fwdfifo, LTFAT_ATOMIC_LOAD(p->prehop));
+    LTFAT_NAME(synthesis_fifo_sethop)(p->backfifo, LTFAT_ATOMIC_LOAD(p->posthop));
     status = LTFATERR_SUCCESS;
 error:
     if (status != LTFATERR_SUCCESS) return status;
@@ -236,6 +259,106 @@ error:
 
 
 
+LTFAT_API int
+LTFAT_NAME(block_processor_push)(
+    LTFAT_NAME(block_processor_state)* p,
+    const LTFAT_REAL** in, ltfat_int inLen, ltfat_int chanNo)
+{
+    ltfat_int samplesWritten;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(in);
+    CHECK(LTFATERR_BADSIZE, inLen >= 0,
+          "inLen must be positive or zero (passed %td)", inLen);
+    CHECK(LTFATERR_BADSIZE, chanNo >= 0,
+          "chanNo must be positive or zero (passed %td)", chanNo);
+
+    if (chanNo == 0 || inLen == 0) return LTFATERR_SUCCESS;
+
+    if ( chanNo > p->fwdfifo->numChans ) chanNo = p->fwdfifo->numChans;
+
+    samplesWritten =
+        LTFAT_NAME(analysis_fifo_write)(p->fwdfifo, in, inLen, chanNo);
+    CHECKSTATUS(samplesWritten);
+    LTFAT_NAME(block_processor_advanceby)( p, samplesWritten, 0);
+
+    // The samples which did not fit are dropped
+    if ( samplesWritten < inLen ) return LTFATERR_OVERFLOW;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_process)(LTFAT_NAME(block_processor_state)* p)
+{
+    ltfat_int blocks;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+    CHECK(LTFATERR_CANNOTHAPPEN, p->processorCallback != NULL ||
+                                 (p->prewin != NULL && p->postwin != NULL),
+          "processor callback is not set" );
+
+    CHECKSTATUS( blocks = LTFAT_NAME(block_processor_processblocks)(p, 1, 1));
+    LTFAT_NAME(analysis_fifo_sethop)(p->fwdfifo, LTFAT_ATOMIC_LOAD(p->prehop));
+    LTFAT_NAME(synthesis_fifo_sethop)(p->backfifo, LTFAT_ATOMIC_LOAD(p->posthop));
+
+    return blocks;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(block_processor_pull)(
+    LTFAT_NAME(block_processor_state)* p,
+    ltfat_int outLen, ltfat_int chanNo, LTFAT_REAL** out)
+{
+    ltfat_int samplesRead;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(out);
+    CHECK(LTFATERR_BADSIZE, outLen >= 0,
+          "outLen must be positive or zero (passed %td)", outLen);
+    CHECK(LTFATERR_BADSIZE, chanNo >= 0,
+          "chanNo must be positive or zero (passed %td)", chanNo);
+
+    if (chanNo == 0 || outLen == 0) return LTFATERR_SUCCESS;
+
+    for (ltfat_int w = p->backfifo->numChans; w < chanNo; w++)
+        memset(out[w], 0, outLen * sizeof * out[w]);
+
+    if ( chanNo > p->backfifo->numChans ) chanNo = p->backfifo->numChans;
+
+    samplesRead =
+        LTFAT_NAME(synthesis_fifo_read)(p->backfifo, outLen, chanNo, out);
+    CHECKSTATUS(samplesRead);
+    LTFAT_NAME(block_processor_advanceby)( p, 0, samplesRead);
+
+    // Output silence for the samples which were not ready in time
+    if ( samplesRead < outLen )
+    {
+        for (ltfat_int w = 0; w < chanNo; w++)
+            memset(out[w] + samplesRead, 0,
+                   (outLen - samplesRead) * sizeof * out[w]);
+        return LTFATERR_UNDERFLOW;
+    }
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_get_overruns)(LTFAT_NAME(block_processor_state)* p)
+{
+    return LTFAT_NAME(analysis_fifo_get_overruns)(p->fwdfifo);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(block_processor_get_underruns)(LTFAT_NAME(block_processor_state)* p)
+{
+    return LTFAT_NAME(synthesis_fifo_get_underruns)(p->backfifo);
+}
+
 LTFAT_API int
 LTFAT_NAME(block_processor_reset)( LTFAT_NAME(block_processor_state)* p)
 {
@@ -253,11 +376,20 @@ error:
     return status;
 }
 
+/* The hops are changed by the thread running the callbacks, the other
+ * thread only sees the published values */
+static double
+LTFAT_NAME(block_processor_stretch)(LTFAT_NAME(block_processor_state)* p)
+{
+    return ((double) LTFAT_ATOMIC_LOAD(p->backfifo->hop)) /
+           LTFAT_ATOMIC_LOAD(p->fwdfifo->hop);
+}
+
 LTFAT_API size_t
 LTFAT_NAME(block_processor_nextinlen)(LTFAT_NAME(block_processor_state)* p,
                                       size_t Lout)
 {
-    double stretch = ((double) (p->backfifo->hop)) / p->fwdfifo->hop;
+    double stretch = LTFAT_NAME(block_processor_stretch)(p);
     return (size_t) round(Lout / stretch + p->out_in_in_offset);
 }
 
@@ -265,7 +397,7 @@ LTFAT_API size_t
 LTFAT_NAME(block_processor_nextoutlen)(LTFAT_NAME(block_processor_state)* p,
                                        size_t Lin)
 {
-    double stretch = ((double) (p->backfifo->hop)) / p->fwdfifo->hop;
+    double stretch = LTFAT_NAME(block_processor_stretch)(p);
     return (size_t) round(Lin * stretch + p->in_in_out_offset);
 }
 
@@ -274,7 +406,7 @@ LTFAT_NAME(block_processor_advanceby)(
     LTFAT_NAME(block_processor_state)* p,
     size_t Lin, size_t Lout)
 {
-    double stretch = ((double) (p->backfifo->hop)) / p->fwdfifo->hop;
+    double stretch = LTFAT_NAME(block_processor_stretch)(p);
 
     p->in_pos += Lin;
     p->out_pos += Lout;
@@ -315,7 +447,7 @@ LTFAT_NAME(block_processor_setprehop)(
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
     CHECK(LTFATERR_NOTPOSARG, hop > 0 , "Hop must be greater than 0");
-    p->prehop = hop;
+    LTFAT_ATOMIC_STORE(p->prehop, hop);
     return LTFATERR_SUCCESS;
 error:
     return status;
@@ -328,7 +460,7 @@ LTFAT_NAME(block_processor_setposthop)(
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
     CHECK(LTFATERR_NOTPOSARG, hop > 0 , "Hop must be greater than 0");
-    p->posthop = hop;
+    LTFAT_ATOMIC_STORE(p->posthop, hop);
     return LTFATERR_SUCCESS;
 error:
     return status;
@@ -488,7 +620,8 @@ LTFAT_NAME(analysis_fifo_sethop)(LTFAT_NAME(analysis_fifo_state)* p,
     CHECKNULL(p);
     CHECK(LTFATERR_NOTPOSARG, hop > 0, "hop must be positive");
 
-    p->hop = hop;
+    // Read by the other side in block_processor_advanceby
+    LTFAT_ATOMIC_STORE(p->hop, hop);
 
     return LTFATERR_SUCCESS;
 error:
@@ -518,6 +651,7 @@ LTFAT_NAME(analysis_fifo_reset)(LTFAT_NAME(analysis_fifo_state)* p)
     CHECKNULL(p);
 
     memset(p->buf, 0, p->numChans * p->bufLen * sizeof * p->buf);
+    p->overruns = 0;
 
     return LTFATERR_SUCCESS;
 error:
@@ -528,7 +662,7 @@ LTFAT_API ltfat_int
 LTFAT_NAME(analysis_fifo_write)(LTFAT_NAME(analysis_fifo_state)* p,
                                 const LTFAT_REAL** buf, ltfat_int bufLen, ltfat_int W)
 {
-    ltfat_int Wact, freeSpace, toWrite, valid, over, endWriteIdx;
+    ltfat_int Wact, freeSpace, toWrite, valid, over, endWriteIdx, writeIdx;
     int status = LTFATERR_FAILED;
     CHECKNULL(p); CHECKNULL(buf);
     CHECK(LTFATERR_NOTPOSARG, bufLen >= 0, "bufLen must be positive.");
@@ -539,23 +673,25 @@ LTFAT_NAME(analysis_fifo_write)(LTFAT_NAME(analysis_fifo_state)* p,
     for (ltfat_int w = 0; w < W; w++)
         CHECKNULL(buf[w]);
 
-
-    freeSpace = p->readIdx - p->writeIdx - 1;
+    // The producer owns writeIdx, readIdx can be moved by the consumer
+    writeIdx = p->writeIdx;
+    freeSpace = LTFAT_ATOMIC_LOAD(p->readIdx) - writeIdx - 1;
     if (freeSpace < 0) freeSpace += p->bufLen;
 
-    // CHECK(LTFATERR_OVERFLOW, freeSpace, "FIFO owerflow");
-
     Wact = p->numChans < W ? p->numChans : W;
 
     toWrite = bufLen > freeSpace ? freeSpace : bufLen;
     valid = toWrite;
     over = 0;
 
-    endWriteIdx = p->writeIdx + toWrite;
+    if (toWrite < bufLen)
+        LTFAT_ATOMIC_STORE(p->overruns, p->overruns + 1);
+
+    endWriteIdx = writeIdx + toWrite;
 
     if (endWriteIdx > p->bufLen)
     {
-        valid = p->bufLen - p->writeIdx;
+        valid = p->bufLen - writeIdx;
         over = endWriteIdx - p->bufLen;
     }
 
@@ -563,7 +699,7 @@ LTFAT_NAME(analysis_fifo_write)(LTFAT_NAME(analysis_fifo_state)* p,
     {
         for (ltfat_int w = 0; w < p->numChans; w++)
         {
-            LTFAT_REAL* pbufchan = p->buf + w * p->bufLen + p->writeIdx;
+            LTFAT_REAL* pbufchan = p->buf + w * p->bufLen + writeIdx;
             if (w < Wact)
                 memcpy(pbufchan, buf[w], valid * sizeof * p->buf );
             else
@@ -581,7 +717,8 @@ LTFAT_NAME(analysis_fifo_write)(LTFAT_NAME(analysis_fifo_state)* p,
                 memset(pbufchan, 0,  over * sizeof * p->buf);
         }
     }
-    p->writeIdx = ( p->writeIdx + toWrite ) % p->bufLen;
+    // Publish the samples
+    LTFAT_ATOMIC_STORE(p->writeIdx, ( writeIdx + toWrite ) % p->bufLen);
 
     return toWrite;
 error:
@@ -592,14 +729,15 @@ LTFAT_API ltfat_int
 LTFAT_NAME(analysis_fifo_read)(LTFAT_NAME(analysis_fifo_state)* p,
                                LTFAT_REAL* buf)
 {
-    ltfat_int available, toRead, valid, over, endReadIdx;
+    ltfat_int available, toRead, valid, over, endReadIdx, readIdx;
     int status = LTFATERR_FAILED;
     CHECKNULL(p); CHECKNULL(buf);
 
-    available = p->writeIdx - p->readIdx;
+    // The consumer owns readIdx, writeIdx can be moved by the producer
+    readIdx = p->readIdx;
+    available = LTFAT_ATOMIC_LOAD(p->writeIdx) - readIdx;
     if (available < 0) available += p->bufLen;
 
-    // CHECK(LTFATERR_UNDERFLOW, available >= p->winLen, "FIFO underflow");
     // p->hop can actually be larger than p->winLen
     if (available < p->winLen || available < p->hop) return 0;
 
@@ -608,11 +746,11 @@ LTFAT_NAME(analysis_fifo_read)(LTFAT_NAME(analysis_fifo_state)* p,
     valid = toRead;
     over = 0;
 
-    endReadIdx = p->readIdx + valid;
+    endReadIdx = readIdx + valid;
 
     if (endReadIdx > p->bufLen)
     {
-        valid = p->bufLen - p->readIdx;
+        valid = p->bufLen - readIdx;
         over = endReadIdx - p->bufLen;
     }
 
@@ -620,7 +758,7 @@ LTFAT_NAME(analysis_fifo_read)(LTFAT_NAME(analysis_fifo_state)* p,
     {
         for (ltfat_int w = 0; w < p->numChans; w++)
         {
-            LTFAT_REAL* pbufchan = p->buf + w * p->bufLen + p->readIdx;
+            LTFAT_REAL* pbufchan = p->buf + w * p->bufLen + readIdx;
             memcpy(buf + w * p->readchanstride, pbufchan, valid * sizeof * p->buf );
         }
     }
@@ -633,14 +771,20 @@ LTFAT_NAME(analysis_fifo_read)(LTFAT_NAME(analysis_fifo_state)* p,
         }
     }
 
-    // Only advance by hop
-    p->readIdx = ( p->readIdx + p->hop ) % p->bufLen;
+    // Only advance by hop. This releases the slots to the producer.
+    LTFAT_ATOMIC_STORE(p->readIdx, ( readIdx + p->hop ) % p->bufLen);
 
     return toRead;
 error:
     return status;
 }
 
+LTFAT_API ltfat_int
+LTFAT_NAME(analysis_fifo_get_overruns)(LTFAT_NAME(analysis_fifo_state)* p)
+{
+    return LTFAT_ATOMIC_LOAD(p->overruns);
+}
+
 /* BACK FIFO */
 
 
@@ -681,6 +825,7 @@ LTFAT_NAME(synthesis_fifo_reset)(LTFAT_NAME(synthesis_fifo_state)* p)
     CHECKNULL(p);
 
     memset(p->buf, 0, p->numChans * p->bufLen * sizeof * p->buf);
+    p->overruns = 0; p->underruns = 0;
 
     return LTFATERR_SUCCESS;
 error:
@@ -711,7 +856,8 @@ LTFAT_NAME(synthesis_fifo_sethop)(LTFAT_NAME(synthesis_fifo_state)* p,
     CHECKNULL(p);
     CHECK(LTFATERR_NOTPOSARG, hop > 0, "hop must be positive");
 
-    p->hop = hop;
+    // Read by the other side in block_processor_advanceby
+    LTFAT_ATOMIC_STORE(p->hop, hop);
 
     return LTFATERR_SUCCESS;
 error:
@@ -735,29 +881,52 @@ error:
     return status;
 }
 
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_get_overruns)(LTFAT_NAME(synthesis_fifo_state)* p)
+{
+    return LTFAT_ATOMIC_LOAD(p->overruns);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_get_underruns)(LTFAT_NAME(synthesis_fifo_state)* p)
+{
+    return LTFAT_ATOMIC_LOAD(p->underruns);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(synthesis_fifo_freespace)(LTFAT_NAME(synthesis_fifo_state)* p)
+{
+    ltfat_int freeSpace = LTFAT_ATOMIC_LOAD(p->readIdx) - p->writeIdx - 1;
+    if (freeSpace < 0) freeSpace += p->bufLen;
+    return freeSpace;
+}
+
 LTFAT_API ltfat_int
 LTFAT_NAME(synthesis_fifo_write)(LTFAT_NAME(synthesis_fifo_state)* p,
                                  const LTFAT_REAL* buf)
 {
-    ltfat_int freeSpace, toWrite, valid, over, endWriteIdx;
+    ltfat_int freeSpace, toWrite, valid, over, endWriteIdx, writeIdx;
     int status = LTFATERR_FAILED;
     CHECKNULL(p); CHECKNULL(buf);
 
-    freeSpace = p->readIdx - p->writeIdx - 1;
-    if (freeSpace < 0) freeSpace += p->bufLen;
+    writeIdx = p->writeIdx;
+    freeSpace = LTFAT_NAME(synthesis_fifo_freespace)(p);
 
-    // CHECK(LTFATERR_OVERFLOW, freeSpace >= p->winLen, "FIFO overflow");
-    if (freeSpace < p->winLen) return 0;
+    if (freeSpace < p->winLen)
+    {
+        LTFAT_ATOMIC_STORE(p->overruns, p->overruns + 1);
+        return 0;
+    }
 
     toWrite = p->winLen;
     valid = toWrite;
     over = 0;
 
-    endWriteIdx = p->writeIdx + toWrite;
+    endWriteIdx = writeIdx + toWrite;
 
     if (endWriteIdx > p->bufLen)
     {
-        valid = p->bufLen - p->writeIdx;
+        valid = p->bufLen - writeIdx;
         over = endWriteIdx - p->bufLen;
     }
 
@@ -765,7 +934,7 @@ LTFAT_NAME(synthesis_fifo_write)(LTFAT_NAME(synthesis_fifo_state)* p,
     {
         for (ltfat_int w = 0; w < p->numChans; w++)
         {
-            LTFAT_REAL* pbufchan = p->buf + p->writeIdx + w * p->bufLen;
+            LTFAT_REAL* pbufchan = p->buf + writeIdx + w * p->bufLen;
             const LTFAT_REAL* bufchan = buf + w * p->writechanstride;
             for (ltfat_int ii = 0; ii < valid; ii++)
                 pbufchan[ii] += bufchan[ii];
@@ -782,7 +951,8 @@ LTFAT_NAME(synthesis_fifo_write)(LTFAT_NAME(synthesis_fifo_state)* p,
         }
     }
 
-    p->writeIdx = ( p->writeIdx + p->hop ) % p->bufLen;
+    // Only the first hop samples are complete, publish them
+    LTFAT_ATOMIC_STORE(p->writeIdx, ( writeIdx + p->hop ) % p->bufLen);
 
     return toWrite;
 error:
@@ -794,7 +964,7 @@ LTFAT_NAME(synthesis_fifo_read)(LTFAT_NAME(synthesis_fifo_state)* p,
                                 ltfat_int bufLen, ltfat_int W,
                                 LTFAT_REAL** buf)
 {
-    ltfat_int available, toRead, valid, over, endReadIdx;
+    ltfat_int available, toRead, valid, over, endReadIdx, readIdx;
     int status = LTFATERR_FAILED;
     CHECKNULL(p); CHECKNULL(buf);
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive.");
@@ -803,22 +973,23 @@ LTFAT_NAME(synthesis_fifo_read)(LTFAT_NAME(synthesis_fifo_state)* p,
 
     for (ltfat_int w = 0; w < W; w++) CHECKNULL(buf[w]);
 
-
-    available = p->writeIdx - p->readIdx;
+    readIdx = p->readIdx;
+    available = LTFAT_ATOMIC_LOAD(p->writeIdx) - readIdx;
     if (available < 0) available += p->bufLen;
 
-    // CHECK(LTFATERR_UNDERFLOW, available, "FIFO underflow");
-
     toRead = available < bufLen ? available : bufLen;
 
+    if (toRead < bufLen)
+        LTFAT_ATOMIC_STORE(p->underruns, p->underruns + 1);
+
     valid = toRead;
     over = 0;
 
-    endReadIdx = p->readIdx + valid;
+    endReadIdx = readIdx + valid;
 
     if (endReadIdx > p->bufLen)
     {
-        valid = p->bufLen - p->readIdx;
+        valid = p->bufLen - readIdx;
         over = endReadIdx - p->bufLen;
     }
 
@@ -828,7 +999,7 @@ LTFAT_NAME(synthesis_fifo_read)(LTFAT_NAME(synthesis_fifo_state)* p,
     {
         for (ltfat_int w = 0; w < W; w++)
         {
-            LTFAT_REAL* pbufchan = p->buf + p->readIdx + w * p->bufLen;
+            LTFAT_REAL* pbufchan = p->buf + readIdx + w * p->bufLen;
             memcpy(buf[w], pbufchan, valid * sizeof * p->buf);
             memset(pbufchan, 0, valid * sizeof * p->buf);
         }
@@ -843,7 +1014,8 @@ LTFAT_NAME(synthesis_fifo_read)(LTFAT_NAME(synthesis_fifo_state)* p,
         }
     }
 
-    p->readIdx = ( p->readIdx + toRead ) % p->bufLen;
+    // The zeroed slots are handed back to the producer
+    LTFAT_ATOMIC_STORE(p->readIdx, ( readIdx + toRead ) % p->bufLen);
 
     return toRead;
 error:
@@ -5,9 +5,10 @@ struct LTFAT_NAME(analysis_fifo_state)
     ltfat_int hop; //!< Hop size
     LTFAT_REAL* buf; //!< Ring buffer array
     ltfat_int bufLen; //!< Length of the previous
-    ltfat_int readIdx; //!< Read pos.
-    ltfat_int writeIdx; //!< Write pos.
+    ltfat_int readIdx; //!< Read pos. Only changed by the consumer
+    ltfat_int writeIdx; //!< Write pos. Only changed by the producer
     ltfat_int numChans;
+    ltfat_int overruns; //!< Number of writes which did not fit
 };
 
 struct LTFAT_NAME(synthesis_fifo_state)
@@ -17,9 +18,11 @@ struct LTFAT_NAME(synthesis_fifo_state)
     ltfat_int hop; //!< Hop size
     LTFAT_REAL* buf; //!< Ring buffer array
     ltfat_int bufLen; //!< Length of the previous
-    ltfat_int readIdx; //!< Read pos.
-    ltfat_int writeIdx; //!< Write pos.
+    ltfat_int readIdx; //!< Read pos. Only changed by the consumer
+    ltfat_int writeIdx; //!< Write pos. Only changed by the producer
     ltfat_int numChans;
+    ltfat_int overruns; //!< Number of blocks which did not fit
+    ltfat_int underruns; //!< Number of reads which were not satisfied
 };
 
 struct LTFAT_NAME(block_processor_state)
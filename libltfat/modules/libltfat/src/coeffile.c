@@ -0,0 +1,327 @@
+#if !defined(_WIN32) && !defined(__WIN32__)
+#   ifndef _POSIX_C_SOURCE
+#       define _POSIX_C_SOURCE 200809L
+#   endif
+#   ifndef _FILE_OFFSET_BITS
+#       define _FILE_OFFSET_BITS 64
+#   endif
+#   define LTFAT_COEFFILE_MMAP
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include <stdint.h>
+
+#ifndef _LTFAT_COEFFILE_HEADER
+#define _LTFAT_COEFFILE_HEADER
+
+/* On-disk header, see coeffile.h */
+typedef struct
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t realsize;
+    int64_t  L;
+    int64_t  a;
+    int64_t  M;
+    int64_t  W;
+    int64_t  N;
+    int64_t  ncols;
+    int32_t  ptype;
+    char     reserved[60];
+} ltfat_coeffile_header;
+
+#define LTFAT_COEFFILE_MAGIC "LTFATCF"
+#define LTFAT_COEFFILE_VERSION 1
+#define LTFAT_COEFFILE_HEADERSIZE 128
+
+#endif
+
+struct LTFAT_NAME(dgtreal_coefsink)
+{
+    ltfat_coeffile_header* h;
+    LTFAT_COMPLEX* c;
+    size_t mapsize;
+};
+
+struct LTFAT_NAME(dgtreal_coefreader)
+{
+    const ltfat_coeffile_header* h;
+    const LTFAT_COMPLEX* c;
+    size_t mapsize;
+};
+
+/* Maps the whole file. When writing, the file is created with size bytes,
+ * otherwise size is set to the file size. */
+static int
+LTFAT_NAME(coeffile_map)(const char* filename, int writable, size_t* size,
+                         void** map)
+{
+    int status = LTFATERR_SUCCESS;
+#ifdef LTFAT_COEFFILE_MMAP
+    int fd = -1;
+    void* m = MAP_FAILED;
+
+    if (writable)
+    {
+        fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        CHECK(LTFATERR_FAILED, fd >= 0, "Cannot create %s.", filename);
+        CHECK(LTFATERR_FAILED, !ftruncate(fd, (off_t) * size),
+              "Cannot resize %s to %zu bytes.", filename, *size);
+    }
+    else
+    {
+        struct stat st;
+        fd = open(filename, O_RDONLY);
+        CHECK(LTFATERR_FAILED, fd >= 0, "Cannot open %s.", filename);
+        CHECK(LTFATERR_FAILED, !fstat(fd, &st), "Cannot stat %s.", filename);
+        CHECK(LTFATERR_FAILED, st.st_size >= LTFAT_COEFFILE_HEADERSIZE,
+              "%s is not a coefficient file.", filename);
+        *size = (size_t) st.st_size;
+    }
+
+    m = mmap(NULL, *size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+             MAP_SHARED, fd, 0);
+    CHECK(LTFATERR_FAILED, m != MAP_FAILED, "Cannot map %s.", filename);
+
+    *map = m;
+error:
+    // The mapping stays valid after the descriptor is closed
+    if (fd >= 0) close(fd);
+#else
+    (void) filename; (void) writable; (void) size; (void) map;
+    CHECK(LTFATERR_NOTSUPPORTED, 0,
+          "Memory-mapped files are not supported on this platform.");
+error:
+#endif
+    return status;
+}
+
+static int
+LTFAT_NAME(coeffile_unmap)(void* map, size_t size, int sync)
+{
+    int status = LTFATERR_SUCCESS;
+#ifdef LTFAT_COEFFILE_MMAP
+    int synced = sync ? !msync(map, size, MS_SYNC) : 1;
+    munmap(map, size);
+    CHECK(LTFATERR_FAILED, synced, "Writing the coefficient file failed.");
+error:
+#else
+    (void) map; (void) size; (void) sync;
+#endif
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_init)(const char* filename,
+                                  ltfat_int L, ltfat_int a, ltfat_int M,
+                                  ltfat_int W, const ltfat_phaseconvention ptype,
+                                  LTFAT_NAME(dgtreal_coefsink)** pout)
+{
+    LTFAT_NAME(dgtreal_coefsink)* p = NULL;
+    void* map = NULL;
+    ltfat_int N, M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, L > 0, "L must be positive");
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_CANNOTHAPPEN, ltfat_phaseconvention_is_valid(ptype),
+          "Invalid ltfat_phaseconvention enum value." );
+
+    M2 = M / 2 + 1;
+    N = (L + a - 1) / a;
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_coefsink)) );
+    p->mapsize = LTFAT_COEFFILE_HEADERSIZE + M2 * N * W * sizeof * p->c;
+
+    CHECKSTATUS(
+        LTFAT_NAME(coeffile_map)(filename, 1, &p->mapsize, &map));
+
+    p->h = (ltfat_coeffile_header*) map;
+    p->c = (LTFAT_COMPLEX*)((char*) map + LTFAT_COEFFILE_HEADERSIZE);
+
+    // The file was zero-filled by ftruncate
+    memcpy(p->h->magic, LTFAT_COEFFILE_MAGIC, sizeof LTFAT_COEFFILE_MAGIC);
+    p->h->version = LTFAT_COEFFILE_VERSION;
+    p->h->realsize = sizeof(LTFAT_REAL);
+    p->h->L = L;
+    p->h->a = a;
+    p->h->M = M;
+    p->h->W = W;
+    p->h->N = N;
+    p->h->ncols = 0;
+    p->h->ptype = ptype;
+
+    *pout = p;
+    return status;
+error:
+    if (p) ltfat_free(p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_write)(LTFAT_NAME(dgtreal_coefsink)* p,
+                                   const LTFAT_COMPLEX* c, ltfat_int ncols)
+{
+    ltfat_int M2, N, n0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, ncols >= 0, "ncols must be nonnegative");
+    if (ncols == 0) return status;
+    CHECKNULL(c);
+
+    M2 = p->h->M / 2 + 1;
+    N = p->h->N;
+    n0 = p->h->ncols;
+    CHECK(LTFATERR_OVERFLOW, ncols <= N - n0,
+          "The file has space for %td more columns, passed %td.", N - n0, ncols);
+
+    for (ltfat_int w = 0; w < p->h->W; w++)
+        memcpy(p->c + (w * N + n0) * M2, c + w * ncols * M2,
+               ncols * M2 * sizeof * c);
+
+    p->h->ncols = n0 + ncols;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_coefsink_get_ncols)(const LTFAT_NAME(dgtreal_coefsink)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->h->ncols;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefsink_done)(LTFAT_NAME(dgtreal_coefsink)** p)
+{
+    LTFAT_NAME(dgtreal_coefsink)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    status = LTFAT_NAME(coeffile_unmap)(pp->h, pp->mapsize, 1);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_init)(const char* filename,
+                                    LTFAT_NAME(dgtreal_coefreader)** pout)
+{
+    LTFAT_NAME(dgtreal_coefreader)* p = NULL;
+    const ltfat_coeffile_header* h;
+    void* map = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename); CHECKNULL(pout);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_coefreader)) );
+
+    CHECKSTATUS(
+        LTFAT_NAME(coeffile_map)(filename, 0, &p->mapsize, &map));
+
+    h = (const ltfat_coeffile_header*) map;
+    CHECK(LTFATERR_FAILED,
+          !memcmp(h->magic, LTFAT_COEFFILE_MAGIC, sizeof LTFAT_COEFFILE_MAGIC) &&
+          h->version == LTFAT_COEFFILE_VERSION,
+          "%s is not a coefficient file or it was written on a machine with"
+          " a different byte order.", filename);
+    CHECK(LTFATERR_BADARG, h->realsize == sizeof(LTFAT_REAL),
+          "%s holds coefficients of the other precision.", filename);
+    CHECK(LTFATERR_FAILED,
+          h->L > 0 && h->a > 0 && h->M > 0 && h->W > 0 &&
+          h->N == (h->L + h->a - 1) / h->a && h->ncols >= 0 && h->ncols <= h->N &&
+          p->mapsize == LTFAT_COEFFILE_HEADERSIZE +
+          (size_t)((h->M / 2 + 1) * h->N * h->W) * sizeof * p->c &&
+          ltfat_phaseconvention_is_valid((ltfat_phaseconvention) h->ptype),
+          "The header of %s is corrupted.", filename);
+
+    p->h = h;
+    p->c = (const LTFAT_COMPLEX*)((const char*) map + LTFAT_COEFFILE_HEADERSIZE);
+
+    *pout = p;
+    return status;
+error:
+    if (map) LTFAT_NAME(coeffile_unmap)(map, p->mapsize, 0);
+    if (p) ltfat_free(p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_get_params)(const LTFAT_NAME(dgtreal_coefreader)* p,
+        ltfat_int* L, ltfat_int* a, ltfat_int* M,
+        ltfat_int* W, ltfat_phaseconvention* ptype)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    if (L) *L = p->h->L;
+    if (a) *a = p->h->a;
+    if (M) *M = p->h->M;
+    if (W) *W = p->h->W;
+    if (ptype) *ptype = (ltfat_phaseconvention) p->h->ptype;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_coefreader_get_ncols)(const LTFAT_NAME(dgtreal_coefreader)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->h->ncols;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_read)(const LTFAT_NAME(dgtreal_coefreader)* p,
+                                    ltfat_int n0, ltfat_int ncols,
+                                    LTFAT_COMPLEX* c)
+{
+    ltfat_int M2, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c);
+    N = p->h->N;
+    CHECK(LTFATERR_NOTINRANGE, n0 >= 0 && ncols >= 0 && ncols <= N - n0,
+          "Columns %td to %td are not in range 0 to %td.",
+          n0, n0 + ncols - 1, N - 1);
+
+    M2 = p->h->M / 2 + 1;
+    for (ltfat_int w = 0; w < p->h->W; w++)
+        memcpy(c + w * ncols * M2, p->c + (w * N + n0) * M2,
+               ncols * M2 * sizeof * c);
+error:
+    return status;
+}
+
+LTFAT_API const LTFAT_COMPLEX*
+LTFAT_NAME(dgtreal_coefreader_get_array)(const LTFAT_NAME(dgtreal_coefreader)* p)
+{
+    return p ? p->c : NULL;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_coefreader_done)(LTFAT_NAME(dgtreal_coefreader)** p)
+{
+    LTFAT_NAME(dgtreal_coefreader)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_NAME(coeffile_unmap)((void*) pp->h, pp->mapsize, 0);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
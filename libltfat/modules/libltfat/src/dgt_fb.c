@@ -10,9 +10,11 @@ struct LTFAT_NAME(dgt_fb_plan)
     ltfat_int M;
     ltfat_int gl;
     ltfat_phaseconvention ptype;
+    ltfat_int blocksize;
     LTFAT_NAME_REAL(fft_plan)* p_small;
+    LTFAT_NAME_REAL(fft_plan)* p_block;
     LTFAT_COMPLEX* sbuf;
-    LTFAT_COMPLEX* fw;
+    LTFAT_TYPE* fw;
     LTFAT_TYPE* gw;
 };
 
@@ -60,13 +62,21 @@ LTFAT_NAME(dgt_fb_init)(const LTFAT_TYPE* g,
     plan->M = M;
     plan->gl = gl;
     plan->ptype = ptype;
+    // Number of frames transformed by a single batched FFT
+    plan->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / (M * sizeof(LTFAT_COMPLEX)));
 
     CHECKMEM(plan->gw  = LTFAT_NAME(malloc)(plan->gl));
-    CHECKMEM(plan->fw  = LTFAT_NAME_COMPLEX(calloc)(plan->gl));
-    CHECKMEM(plan->sbuf = LTFAT_NAME_COMPLEX(malloc)(M));
+#ifndef LTFAT_COMPLEXTYPE
+    // Real accumulator, complex products are summed directly in sbuf
+    CHECKMEM(plan->fw  = LTFAT_NAME(malloc)(M));
+#endif
+    CHECKMEM(plan->sbuf = LTFAT_NAME_COMPLEX(malloc)(plan->blocksize * M));
 
     CHECKSTATUS(
         LTFAT_NAME_REAL(fft_init)(M, 1, plan->sbuf, plan->sbuf, flags, &plan->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fft_init)(M, plan->blocksize, plan->sbuf, plan->sbuf,
+                                  flags, &plan->p_block));
     LTFAT_NAME(fftshift)(g, gl, plan->gw);
     LTFAT_NAME(conjugate_array)(plan->gw, gl, plan->gw);
 
@@ -88,27 +98,33 @@ LTFAT_NAME(dgt_fb_done)(LTFAT_NAME(dgt_fb_plan)** plan)
 
     LTFAT_SAFEFREEALL(pp->sbuf, pp->gw, pp->fw);
     if (pp->p_small) LTFAT_NAME_REAL(fft_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(fft_done)(&pp->p_block);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
-/* The following macro adds the coefficients together performing the
- * last part of the Poisson summation, executes the FFT on the summed
- * coefficients, and places the coefficients in the output array.
+/* Windows the n-th frame of a single channel signal f and sums it
+ * modulo M to sbuf, which is then ready for the FFT.
  *
- * The first summation is done in that peculiar way to obtain the
+ * The summation is done in that peculiar way to obtain the
  * correct phase for a frequency invariant Gabor transform. Summing
  * them directly would lead to a time invariant (phase-locked) Gabor
  * transform.
- *
- * The macro is called in three different places in the dgt_fb function.
  */
-#define THE_SUM { \
-LTFAT_NAME_COMPLEX(fold_array)(fw,gl,plan.ptype==LTFAT_TIMEINV?-glh:n*a-glh,M,sbuf); \
-LTFAT_NAME_REAL(fft_execute)(plan.p_small); \
-memcpy(cout + (n*M + w*M*N),sbuf,M*sizeof*cout); \
+static void
+LTFAT_NAME(dgt_fb_foldframe)(const LTFAT_NAME(dgt_fb_plan)* p,
+                             const LTFAT_TYPE* f, ltfat_int L, ltfat_int n,
+                             LTFAT_COMPLEX* sbuf)
+{
+    ltfat_int glh = p->gl / 2;
+    ltfat_int offset = p->ptype == LTFAT_TIMEINV ? -glh : n * p->a - glh;
+    LTFAT_TYPE* fw = p->fw ? p->fw : (LTFAT_TYPE*) sbuf;
+
+    LTFAT_NAME(windowfold_array)(f, L, n * p->a - glh, p->gw, p->gl,
+                                 offset, p->M, fw);
+    LTFAT_NAME(ensurecomplex_array)(fw, p->M, sbuf);
 }
 
 LTFAT_API int
@@ -116,88 +132,47 @@ LTFAT_NAME(dgt_fb_execute)(const LTFAT_NAME(dgt_fb_plan)* p,
                            const LTFAT_TYPE* f,
                            ltfat_int L, ltfat_int W,  LTFAT_COMPLEX* cout)
 {
-    ltfat_int a, M, N, gl, glh, glh_d_a;
-    LTFAT_COMPLEX* sbuf, *fw;
-    LTFAT_TYPE* fbd;
-    LTFAT_NAME(dgt_fb_plan) plan;
+    ltfat_int M, N, K;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(f); CHECKNULL(cout);
     CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % p->a) ,
           "L (passed %td) must be positive and divisible by a (passed %td).", L, p->a);
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
 
-    /*  --------- initial declarations -------------- */
-    plan = *p;
-
-    a = plan.a;
-    M = plan.M;
-    N = L / a;
-
-    gl = plan.gl;
-    sbuf = plan.sbuf;
-    fw = plan.fw;
-
-    /* This is a floor operation. */
-    glh = plan.gl / 2;
-
-    /* This is a ceil operation. */
-    glh_d_a = (ltfat_int)ceil((glh * 1.0) / (a));
-
-
-    /*  ---------- main body ----------- */
-
-    /*----- Handle the first boundary using periodic boundary conditions.*/
-    for (ltfat_int n = 0; n < glh_d_a; n++)
-    {
-        for (ltfat_int w = 0; w < W; w++)
-        {
-
-            fbd = (LTFAT_TYPE*)f + (L - (glh - n * a) + L * w);
-            for (ltfat_int l = 0; l < glh - n * a; l++)
-                fw[l] = fbd[l] * plan.gw[l];
+    M = p->M;
+    N = L / p->a;
+    K = p->blocksize;
 
-            fbd = (LTFAT_TYPE*)f -  (glh - n * a) +  L * w;
-            for (ltfat_int l = glh - n * a; l < gl; l++)
-                fw[l] = fbd[l] * plan.gw[l];
-
-            THE_SUM
-
-        }
-    }
-
-    /* ----- Handle the middle case. --------------------- */
-    for (ltfat_int n = glh_d_a; n < (L - (gl + 1) / 2) / a + 1; n++)
+    /* The frames are processed in blocks of K. Frames of a block are folded
+     * to a contiguous buffer and transformed by a single batched FFT.
+     * The frames of the last incomplete block are transformed one by one. */
+    for (ltfat_int w = 0; w < W; w++)
     {
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            fbd = (LTFAT_TYPE*)f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < gl; l++)
-                fw[l] = fbd[l] * plan.gw[l];
-
-            THE_SUM
-        }
-
-    }
+        const LTFAT_TYPE* fchan = f + L * w;
+        LTFAT_COMPLEX* cchan = cout + w * M * N;
 
-    /* Handle the last boundary using periodic boundary conditions. */
-    for (ltfat_int n = (L - (gl + 1) / 2) / a + 1; n < N; n++)
-    {
-        for (ltfat_int w = 0; w < W; w++)
+        for (ltfat_int n = 0; n < N; n += K)
         {
-            fbd = (LTFAT_TYPE*)f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < L - n * a + glh; l++)
-                fw[l] = fbd[l] * plan.gw[l];
-
-            fbd = (LTFAT_TYPE*)f - (L - n * a + glh) +  L * w;
-            for (ltfat_int l = L - n * a + glh; l < gl; l++)
-                fw[l] = fbd[l] * plan.gw[l];
-
-            THE_SUM
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(dgt_fb_foldframe)(p, fchan, L, n + k, p->sbuf + k * M);
+
+                LTFAT_NAME_REAL(fft_execute)(p->p_block);
+                memcpy(cchan + n * M, p->sbuf, K * M * sizeof * cout);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(dgt_fb_foldframe)(p, fchan, L, k, p->sbuf);
+                    LTFAT_NAME_REAL(fft_execute)(p->p_small);
+                    memcpy(cchan + k * M, p->sbuf, M * sizeof * cout);
+                }
+            }
         }
     }
 
 error:
     return status;
 }
-
-#undef THE_SUM
@@ -30,7 +30,7 @@ LTFAT_NAME(dgt_long_init)( const LTFAT_TYPE* g,
                            LTFAT_NAME(dgt_long_plan)** pout)
 {
     LTFAT_NAME(dgt_long_plan)* plan = NULL;
-    ltfat_int h_m, N, b, p, q, d, minL;
+    ltfat_int h_m, minL;
 
     int status = LTFATERR_SUCCESS;
     // CHECKNULL(f); // Can be NULL
@@ -57,19 +57,12 @@ LTFAT_NAME(dgt_long_init)( const LTFAT_TYPE* g,
     plan->L = L;
     plan->W = W;
     plan->ptype = ptype;
-    N = L / a;
-    b = L / M;
 
     plan->c = ltfat_gcd(a, M, &plan->h_a, &h_m);
-    p = a / plan->c;
-    q = M / plan->c;
-    d = b / p;
     plan->h_a = -plan->h_a;
 
-    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)(2 * d));
+    plan->flags = flags;
     CHECKMEM( plan->gf   = LTFAT_NAME_COMPLEX(malloc)(L));
-    CHECKMEM( plan->ff = LTFAT_NAME_REAL(malloc)(2 * d * p * q * W));
-    CHECKMEM( plan->cf = LTFAT_NAME_REAL(malloc)(2 * d * q * q * W));
     plan->cout = cout;
     plan->f    = f;
 
@@ -78,15 +71,7 @@ LTFAT_NAME(dgt_long_init)( const LTFAT_TYPE* g,
         LTFAT_NAME(wfac)(g, L, 1, a, M, plan->gf));
 
     CHECKSTATUS(
-        LTFAT_NAME_REAL(fft_init)(M, N * W, cout, cout, flags, &plan->p_veryend));
-
-    CHECKSTATUS(
-        LTFAT_NAME_REAL(fft_init)(d, 1, (LTFAT_COMPLEX*) plan->sbuf,
-                                  (LTFAT_COMPLEX*) plan->sbuf, flags, &plan->p_before));
-
-    CHECKSTATUS(
-        LTFAT_NAME_REAL(ifft_init)(d, 1, (LTFAT_COMPLEX*) plan->sbuf,
-                                   (LTFAT_COMPLEX*) plan->sbuf, flags, &plan->p_after));
+        LTFAT_NAME(dgt_long_setnthreads)(plan, 1));
 
     // Assign the "return" value
     *pout = plan;
@@ -96,6 +81,88 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(dgt_long_freeworkspaces)(LTFAT_NAME(dgt_long_plan)* plan)
+{
+    if (!plan->ws) return;
+
+    for (ltfat_int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME_REAL(dgt_long_workspace)* ws = &plan->ws[t];
+        if (ws->p_veryend) LTFAT_NAME_REAL(fft_done)(&ws->p_veryend);
+        if (ws->p_before) LTFAT_NAME_REAL(fft_done)(&ws->p_before);
+        if (ws->p_after) LTFAT_NAME_REAL(ifft_done)(&ws->p_after);
+        LTFAT_SAFEFREEALL(ws->sbuf, ws->ff, ws->cf);
+    }
+    ltfat_free(plan->ws);
+    plan->ws = NULL;
+    plan->nthreads = 0;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgt_long_setnthreads)(LTFAT_NAME(dgt_long_plan)* plan,
+                                 ltfat_int nthreads)
+{
+    ltfat_int N, p, q, d, ncolsall, colstep;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    LTFAT_NAME(dgt_long_freeworkspaces)(plan);
+
+    N = plan->L / plan->a;
+    p = plan->a / plan->c;
+    q = plan->M / plan->c;
+    d = N / q;
+
+    /* There is no point in having more threads than columns */
+    ncolsall = N * plan->W;
+    nthreads = ltfat_imin(LTFAT_OMP_NTHREADS(nthreads), ncolsall);
+    colstep = ltfat_idivceil(ncolsall, nthreads);
+
+    CHECKMEM( plan->ws =
+                  LTFAT_NEWARRAY(LTFAT_NAME_REAL(dgt_long_workspace), nthreads));
+    plan->nthreads = nthreads;
+
+    for (ltfat_int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME_REAL(dgt_long_workspace)* ws = &plan->ws[t];
+        LTFAT_COMPLEX* coutcols = NULL;
+
+        ws->col0 = ltfat_imin(t * colstep, ncolsall);
+        ws->ncols = ltfat_imin(colstep, ncolsall - ws->col0);
+
+        CHECKMEM( ws->sbuf = LTFAT_NAME_REAL(malloc)(2 * d));
+        CHECKMEM( ws->ff = LTFAT_NAME_REAL(malloc)(2 * d * p * q * plan->W));
+        CHECKMEM( ws->cf = LTFAT_NAME_REAL(malloc)(2 * d * q * q * plan->W));
+
+        if (ws->ncols > 0)
+        {
+            if (plan->cout) coutcols = plan->cout + ws->col0 * plan->M;
+
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(fft_init)(plan->M, ws->ncols, coutcols, coutcols,
+                                          plan->flags, &ws->p_veryend));
+        }
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft_init)(d, 1, (LTFAT_COMPLEX*) ws->sbuf,
+                                      (LTFAT_COMPLEX*) ws->sbuf, plan->flags,
+                                      &ws->p_before));
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(ifft_init)(d, 1, (LTFAT_COMPLEX*) ws->sbuf,
+                                       (LTFAT_COMPLEX*) ws->sbuf, plan->flags,
+                                       &ws->p_after));
+    }
+
+    return status;
+error:
+    if (plan) LTFAT_NAME(dgt_long_freeworkspaces)(plan);
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgt_long_done)(LTFAT_NAME(dgt_long_plan)** plan)
 {
@@ -104,16 +171,45 @@ LTFAT_NAME(dgt_long_done)(LTFAT_NAME(dgt_long_plan)** plan)
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
 
-    if (pp->p_veryend) LTFAT_NAME_REAL(fft_done)(&pp->p_veryend);
-    if (pp->p_before) LTFAT_NAME_REAL(fft_done)(&pp->p_before);
-    if (pp->p_after) LTFAT_NAME_REAL(ifft_done)(&pp->p_after);
-    LTFAT_SAFEFREEALL(pp->sbuf, pp->gf, pp->ff, pp->cf);
+    LTFAT_NAME(dgt_long_freeworkspaces)(pp);
+    ltfat_safefree(pp->gf);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
+/* Phase locking (if required) and the final FFTs along the columns.
+ * Each thread takes care of its own block of columns. */
+static void
+LTFAT_NAME(dgt_long_modulate)(LTFAT_NAME(dgt_long_plan)* plan,
+                              LTFAT_COMPLEX* cout)
+{
+    ltfat_int N = plan->L / plan->a;
+
+    LTFAT_OMP(parallel for num_threads(plan->nthreads) schedule(static, 1))
+    for (ltfat_int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME_REAL(dgt_long_workspace)* ws = &plan->ws[t];
+        LTFAT_COMPLEX* ccols = cout + ws->col0 * plan->M;
+
+        if (ws->ncols <= 0) continue;
+
+        if (LTFAT_TIMEINV == plan->ptype)
+        {
+            for (ltfat_int col = ws->col0; col < ws->col0 + ws->ncols; col++)
+            {
+                LTFAT_COMPLEX* ccol = cout + col * plan->M;
+                LTFAT_NAME_COMPLEX(circshift)(ccol, plan->M,
+                                              -plan->a * (col % N), ccol);
+            }
+        }
+
+        /* FFT to modulate the coefficients. */
+        LTFAT_NAME_REAL(fft_execute_newarray)(ws->p_veryend, ccols, ccols);
+    }
+}
+
 LTFAT_API int
 LTFAT_NAME(dgt_long_execute)(LTFAT_NAME(dgt_long_plan)* plan)
 {
@@ -122,12 +218,7 @@ LTFAT_NAME(dgt_long_execute)(LTFAT_NAME(dgt_long_plan)* plan)
 
     LTFAT_NAME(dgt_walnut_execute)(plan, plan->cout);
 
-    if (LTFAT_TIMEINV == plan->ptype)
-        LTFAT_NAME_COMPLEX(dgtphaselockhelper)(plan->cout, plan->L, plan->W,
-                                               plan->a, plan->M, plan->M, plan->cout);
-
-    /* FFT to modulate the coefficients. */
-    LTFAT_NAME_REAL(fft_execute)(plan->p_veryend);
+    LTFAT_NAME(dgt_long_modulate)(plan, plan->cout);
 
 error:
     return status;
@@ -147,15 +238,7 @@ LTFAT_NAME(dgt_long_execute_newarray)(LTFAT_NAME(dgt_long_plan)* plan,
 
     LTFAT_NAME(dgt_walnut_execute)(&plan2, c);
 
-    if (LTFAT_TIMEINV == plan->ptype)
-        LTFAT_NAME_COMPLEX(dgtphaselockhelper)(c, plan->L, plan->W,
-                                               plan->a, plan->M, plan->M, c);
-
-    /* FFT to modulate the coefficients. */
-    LTFAT_NAME_REAL(fft_execute_newarray)(plan->p_veryend, c, c);
-
-    /* LTFAT_FFTW(execute_dft)(plan->p_veryend, (LTFAT_FFTW(complex)*)c, */
-    /*                         (LTFAT_FFTW(complex)*)c); */
+    LTFAT_NAME(dgt_long_modulate)(plan, c);
 
 error:
     return status;
@@ -183,15 +266,6 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
                                LTFAT_COMPLEX* cout)
 {
 
-    /*  --------- initial declarations -------------- */
-
-    LTFAT_REAL* gbase, *fbase, *cbase;
-
-    ltfat_int rem;
-
-    LTFAT_REAL* ffp, *cfp;
-    LTFAT_TYPE* fp;
-
     /*  ----------- calculation of parameters and plans -------- */
 
     ltfat_int a = plan->a;
@@ -209,9 +283,6 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
 
     ltfat_int h_a = plan->h_a;
 
-    LTFAT_REAL* sbuf = plan->sbuf;
-    //LTFAT_COMPLEX* cout = plan->cout;
-
     /* Scaling constant needed because of FFTWs normalization. */
     const LTFAT_REAL scalconst = (const LTFAT_REAL)( 1.0 / ((double)d * sqrt((
                                      double)M)) );
@@ -223,11 +294,21 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
     ltfat_int ld3b = 2 * q * q * W;
     ltfat_int ld5c = M * N;
 
-    /* --------- main loop begins here ------------------- */
+    /* --------- main loop begins here -------------------
+     * Iterations of the r-loop are independent and write to disjoint
+     * parts of cout. Each thread works with its own buffers and plans. */
+    LTFAT_OMP(parallel for num_threads(plan->nthreads) schedule(static))
     for (ltfat_int r = 0; r < c; r++)
     {
+        LTFAT_NAME_REAL(dgt_long_workspace)* ws = &plan->ws[LTFAT_OMP_THREADID];
+        LTFAT_REAL* sbuf = ws->sbuf;
+        LTFAT_REAL* gbase, *fbase, *cbase;
+        LTFAT_REAL* ffp, *cfp;
+        LTFAT_TYPE* fp;
+        ltfat_int rem;
+
         /*  ---------- compute signal factorization ----------- */
-        ffp = plan->ff;
+        ffp = ws->ff;
         fp = f + r;
         if (p == 1)
         {
@@ -248,7 +329,7 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
 #endif
                     }
 
-                    LTFAT_NAME_REAL(fft_execute)(plan->p_before);
+                    LTFAT_NAME_REAL(fft_execute)(ws->p_before);
 
                     for (ltfat_int s = 0; s < d; s++)
                     {
@@ -265,8 +346,8 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
             for (ltfat_int s = 0; s < d; s++)
             {
                 gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * q;
-                fbase = plan->ff + 2 * s * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
+                fbase = ws->ff + 2 * s * q * W;
+                cbase = ws->cf + 2 * s * q * q * W;
 
                 for (ltfat_int nm = 0; nm < q * W; nm++)
                 {
@@ -305,7 +386,7 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
 #endif
                         }
 
-                        LTFAT_NAME_REAL(fft_execute)(plan->p_before);
+                        LTFAT_NAME_REAL(fft_execute)(ws->p_before);
 
                         for (ltfat_int s = 0; s < d; s++)
                         {
@@ -323,8 +404,8 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
             for (ltfat_int s = 0; s < d; s++)
             {
                 gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * p * q;
-                fbase = plan->ff + 2 * s * p * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
+                fbase = ws->ff + 2 * s * p * q * W;
+                cbase = ws->cf + 2 * s * q * q * W;
 
                 for (ltfat_int nm = 0; nm < q * W; nm++)
                 {
@@ -352,7 +433,7 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
         } /* end of if p==1 */
 
         /*  -------  compute inverse coefficient factorization ------- */
-        cfp = plan->cf;
+        cfp = ws->cf;
 
         /* Cover both integer and rational sampling case */
         for (ltfat_int w = 0; w < W; w++)
@@ -370,7 +451,7 @@ LTFAT_NAME(dgt_walnut_execute)(LTFAT_NAME(dgt_long_plan)* plan,
                     cfp += 2;
 
                     /* Do inverse fft of length d */
-                    LTFAT_NAME_REAL(ifft_execute)(plan->p_after);
+                    LTFAT_NAME_REAL(ifft_execute)(ws->p_after);
 
                     for (ltfat_int s = 0; s < d; s++)
                     {
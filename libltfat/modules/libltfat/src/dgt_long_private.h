@@ -4,6 +4,21 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+/* Buffers and FFT plans used by a single thread.
+ * The Walnut loop over r is split among the threads and
+ * p_veryend covers a contiguous block of ncols coefficient
+ * columns starting at col0. */
+typedef struct
+{
+    LTFAT_NAME_REAL(fft_plan)* p_before;
+    LTFAT_NAME_REAL(ifft_plan)* p_after;
+    LTFAT_NAME_REAL(fft_plan)* p_veryend;
+    LTFAT_REAL* sbuf;
+    LTFAT_REAL* ff, *cf;
+    ltfat_int col0;
+    ltfat_int ncols;
+} LTFAT_NAME_REAL(dgt_long_workspace);
+
 struct LTFAT_NAME_REAL(dgt_long_plan)
 {
     ltfat_int a;
@@ -13,14 +28,12 @@ struct LTFAT_NAME_REAL(dgt_long_plan)
     ltfat_int c;
     ltfat_int h_a;
     ltfat_phaseconvention ptype;
-    LTFAT_NAME_REAL(fft_plan)* p_before;
-    LTFAT_NAME_REAL(ifft_plan)* p_after;
-    LTFAT_NAME_REAL(fft_plan)* p_veryend;
-    LTFAT_REAL* sbuf;
+    unsigned flags;
+    ltfat_int nthreads;
+    LTFAT_NAME_REAL(dgt_long_workspace)* ws;
     const LTFAT_REAL* f;
     LTFAT_COMPLEX* gf;
     LTFAT_COMPLEX* cout;
-    LTFAT_REAL* ff, *cf;
 };
 
 struct LTFAT_NAME_COMPLEX(dgt_long_plan)
@@ -32,13 +45,11 @@ struct LTFAT_NAME_COMPLEX(dgt_long_plan)
     ltfat_int c;
     ltfat_int h_a;
     ltfat_phaseconvention ptype;
-    LTFAT_NAME_REAL(fft_plan)* p_before;
-    LTFAT_NAME_REAL(ifft_plan)* p_after;
-    LTFAT_NAME_REAL(fft_plan)* p_veryend;
-    LTFAT_REAL* sbuf;
+    unsigned flags;
+    ltfat_int nthreads;
+    LTFAT_NAME_REAL(dgt_long_workspace)* ws;
     const LTFAT_COMPLEX* f;
     LTFAT_COMPLEX* gf;
     LTFAT_COMPLEX* cout;
-    LTFAT_REAL* ff, *cf;
 };
 
@@ -1,6 +1,195 @@
 #include "dgt_long_private.h"
 #include "dgtreal_long_private.h"
 
+/* Frame bookkeeping shared by dgt_ola and dgtreal_ola.
+ *
+ * The extended block j (bl+gl samples) produces Nblocke frames which are
+ * placed to the output as
+ *
+ *   frames 0,...,Nblock-1              -> main part of block j
+ *   frames Nblock,...,Nblock+b2-1      -> first b2 frames of block j+1
+ *   frames Nblock+b2,...,Nblock+2*b2-1 -> last b2 frames of block j-1
+ *
+ * The main parts are copied, which avoids zeroing the output, and the
+ * overlaps are added afterwards. An overlap whose target block has not been
+ * copied yet is kept in pend. In the batch mode, the frames wrap around
+ * modulo Nout. In the stream mode, the output is delayed by b2 frames and
+ * the frames past the end of the output go to carry. */
+typedef struct
+{
+    ltfat_int Mr;         // Rows of the coefficients, M or M/2+1
+    ltfat_int W;
+    ltfat_int Nblock;
+    ltfat_int Nblocke;
+    ltfat_int b2;
+    ltfat_int Nb;         // Number of blocks
+    ltfat_int Nout;       // Number of frames of the output
+    LTFAT_COMPLEX* carry; // NULL in the batch mode
+} LTFAT_NAME(dgt_ola_geom);
+
+/* Transforms block j using the plan of thread t */
+typedef void LTFAT_NAME(dgt_ola_blockfn)(void* plan, ltfat_int t,
+        const void* f, ltfat_int L, ltfat_int j);
+
+/* out[ii] += in[ii], the complex arrays are added as real ones */
+static void
+LTFAT_NAME(dgt_ola_addto)(const LTFAT_COMPLEX* in, ltfat_int len,
+                          LTFAT_COMPLEX* out)
+{
+    const LTFAT_REAL* LTFAT_RESTRICT inr = (const LTFAT_REAL*) in;
+    LTFAT_REAL* LTFAT_RESTRICT outr = (LTFAT_REAL*) out;
+
+    LTFAT_OMP(simd)
+    for (ltfat_int ii = 0; ii < 2 * len; ii++)
+        outr[ii] += inr[ii];
+}
+
+/* Copies or adds nf frames of all channels of in to the output frames
+ * starting at t0 */
+static void
+LTFAT_NAME(dgt_ola_put)(const LTFAT_NAME(dgt_ola_geom)* g,
+                        const LTFAT_COMPLEX* in, ltfat_int instride,
+                        ltfat_int t0, ltfat_int nf, int doadd,
+                        LTFAT_COMPLEX* cout)
+{
+    ltfat_int Mr = g->Mr;
+
+    while (nf > 0)
+    {
+        LTFAT_COMPLEX* out;
+        ltfat_int outstride, run;
+
+        if (!g->carry)
+        {
+            t0 = ltfat_positiverem(t0, g->Nout);
+            run = ltfat_imin(nf, g->Nout - t0);
+            out = cout + t0 * Mr;
+            outstride = Mr * g->Nout;
+        }
+        else if (t0 < g->Nout)
+        {
+            run = ltfat_imin(nf, g->Nout - t0);
+            out = cout + t0 * Mr;
+            outstride = Mr * g->Nout;
+        }
+        else
+        {
+            run = nf;
+            out = g->carry + (t0 - g->Nout) * Mr;
+            outstride = Mr * 2 * g->b2;
+        }
+
+        for (ltfat_int w = 0; w < g->W; w++)
+        {
+            if (doadd)
+                LTFAT_NAME(dgt_ola_addto)(in + w * instride, run * Mr,
+                                          out + w * outstride);
+            else
+                memcpy(out + w * outstride, in + w * instride,
+                       run * Mr * sizeof * out);
+        }
+
+        in += run * Mr;
+        t0 += run;
+        nf -= run;
+    }
+}
+
+/* Copies nf frames of all channels, the strides are in frames */
+static void
+LTFAT_NAME(dgt_ola_copyframes)(ltfat_int Mr, ltfat_int W,
+                               const LTFAT_COMPLEX* in, ltfat_int instride,
+                               ltfat_int nf, LTFAT_COMPLEX* out,
+                               ltfat_int outstride)
+{
+    for (ltfat_int w = 0; w < W; w++)
+        memcpy(out + w * Mr * outstride, in + w * Mr * instride,
+               Mr * nf * sizeof * out);
+}
+
+/* Transforms all blocks and places the results. The blocks are processed
+ * in groups of nthreads blocks, each thread transforming one of them. */
+static void
+LTFAT_NAME(dgt_ola_run)(const LTFAT_NAME(dgt_ola_geom)* g, ltfat_int nthreads,
+                        LTFAT_NAME(dgt_ola_blockfn)* blockfn, void* plan,
+                        const void* f, ltfat_int L, LTFAT_COMPLEX** tcbuf,
+                        LTFAT_COMPLEX* pend, LTFAT_COMPLEX* cout)
+{
+    ltfat_int Mr = g->Mr, Nblock = g->Nblock, b2 = g->b2, Nb = g->Nb;
+    ltfat_int cstride = Mr * g->Nblocke;
+    ltfat_int off = g->carry ? b2 : 0;
+    // pend holds two overlaps: the next group's first and the wrapped one
+    LTFAT_COMPLEX* pendnext = pend;
+    LTFAT_COMPLEX* pendwrap = pend + Mr * b2 * g->W;
+    int havenext = 0, havewrap = 0;
+
+    if (g->carry)
+    {
+        // Frames carried from the previous call
+        LTFAT_NAME(dgt_ola_put)(g, g->carry, Mr * 2 * b2, 0, b2, 0, cout);
+        LTFAT_NAME(dgt_ola_copyframes)(Mr, g->W, g->carry + Mr * b2, 2 * b2,
+                                       b2, pendnext, b2);
+        havenext = 1;
+    }
+
+    for (ltfat_int g0 = 0; g0 < Nb; g0 += nthreads)
+    {
+        ltfat_int g1 = ltfat_imin(g0 + nthreads, Nb);
+
+        LTFAT_OMP(parallel for num_threads(g1 - g0) schedule(static, 1))
+        for (ltfat_int j = g0; j < g1; j++)
+        {
+            blockfn(plan, j - g0, f, L, j);
+            LTFAT_NAME(dgt_ola_put)(g, tcbuf[j - g0], cstride,
+                                    off + j * Nblock, Nblock, 0, cout);
+        }
+
+        if (havenext)
+        {
+            LTFAT_NAME(dgt_ola_put)(g, pendnext, Mr * b2, off + g0 * Nblock,
+                                    b2, 1, cout);
+            havenext = 0;
+        }
+
+        for (ltfat_int j = g0; j < g1; j++)
+        {
+            const LTFAT_COMPLEX* cplus = tcbuf[j - g0] + Mr * Nblock;
+            const LTFAT_COMPLEX* cminus = tcbuf[j - g0] + Mr * (Nblock + b2);
+
+            if (j + 1 < g1 || j + 1 == Nb)
+            {
+                // In the stream mode, the last one is the first to go to
+                // the second half of carry
+                LTFAT_NAME(dgt_ola_put)(g, cplus, cstride,
+                                        off + (j + 1) * Nblock, b2,
+                                        !(g->carry && j + 1 == Nb), cout);
+            }
+            else
+            {
+                LTFAT_NAME(dgt_ola_copyframes)(Mr, g->W, cplus, g->Nblocke,
+                                               b2, pendnext, b2);
+                havenext = 1;
+            }
+
+            if (j == 0 && !g->carry && Nb - 1 >= g1)
+            {
+                LTFAT_NAME(dgt_ola_copyframes)(Mr, g->W, cminus, g->Nblocke,
+                                               b2, pendwrap, b2);
+                havewrap = 1;
+            }
+            else
+            {
+                LTFAT_NAME(dgt_ola_put)(g, cminus, cstride,
+                                        off + j * Nblock - b2, b2, 1, cout);
+            }
+        }
+    }
+
+    if (havewrap)
+        LTFAT_NAME(dgt_ola_put)(g, pendwrap, Mr * b2, -b2, b2, 1, cout);
+}
+
+/* -------------------------- DGT_OLA ---------------------------- */
 
 LTFAT_API LTFAT_NAME(dgt_ola_plan)
 LTFAT_NAME(dgt_ola_init)(const LTFAT_COMPLEX* g, ltfat_int gl,
@@ -17,22 +206,16 @@ LTFAT_NAME(dgt_ola_init)(const LTFAT_COMPLEX* g, ltfat_int gl,
 
     ltfat_int Lext    = bl + gl;
     ltfat_int Nblocke = Lext / a;
+    ltfat_int b2      = gl / a / 2;
 
     plan.buf  = LTFAT_NAME_COMPLEX(malloc)(Lext * W);
     plan.gext = LTFAT_NAME_COMPLEX(malloc)(Lext);
     plan.cbuf = LTFAT_NAME_COMPLEX(malloc)(M * Nblocke * W);
+    plan.pend = LTFAT_NAME_COMPLEX(malloc)(2 * M * ltfat_imax(b2, 1) * W);
+    plan.carry = LTFAT_NAME_COMPLEX(calloc)(2 * M * ltfat_imax(b2, 1) * W);
 
     LTFAT_NAME_COMPLEX(fir2long)(g, gl, Lext, plan.gext);
 
-    /* Zero the last part of the buffer, it will always be zero. */
-    for (ltfat_int w = 0; w < W; w++)
-    {
-        for (ltfat_int jj = bl; jj < Lext; jj++)
-        {
-            plan.buf[jj + w * Lext] = (LTFAT_COMPLEX) 0.0;
-        }
-    }
-
     /* plan.plan = */
     /*     LTFAT_NAME(dgt_long_init)((const LTFAT_COMPLEX*)plan.buf, */
     /*                               (const LTFAT_COMPLEX*)plan.gext, */
@@ -45,105 +228,215 @@ LTFAT_NAME(dgt_ola_init)(const LTFAT_COMPLEX* g, ltfat_int gl,
                                       plan.buf, plan.cbuf, ptype, flags,
                                       &plan.plan);
 
+    /* Zero the last part of the buffer, it will always be zero. */
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        for (ltfat_int jj = bl; jj < Lext; jj++)
+        {
+            plan.buf[jj + w * Lext] = (LTFAT_COMPLEX) 0.0;
+        }
+    }
+
+    plan.nthreads = 1;
+    plan.tplan = LTFAT_NEWARRAY(LTFAT_NAME_COMPLEX(dgt_long_plan)*, 1);
+    plan.tbuf  = LTFAT_NEWARRAY(LTFAT_COMPLEX*, 1);
+    plan.tcbuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, 1);
+    plan.tplan[0] = plan.plan;
+    plan.tbuf[0]  = plan.buf;
+    plan.tcbuf[0] = plan.cbuf;
+
     return (plan);
 
 }
 
-LTFAT_API void
-LTFAT_NAME(dgt_ola_execute)(const LTFAT_NAME(dgt_ola_plan) plan,
-                            const LTFAT_COMPLEX* f, ltfat_int L,
-                            LTFAT_COMPLEX* cout)
-
+/* Frees all threads but the first one, which uses the base plan and buffers */
+static void
+LTFAT_NAME(dgt_ola_freethreads)(LTFAT_NAME(dgt_ola_plan)* plan)
 {
-    ltfat_int bl      = plan.bl;
-    ltfat_int gl      = plan.gl;
-    ltfat_int a       = plan.plan->a;
-    ltfat_int M       = plan.plan->M;
-    ltfat_int N       = L / a;
-    ltfat_int Lext    = bl + gl;
-    ltfat_int Nb      = L / bl;
-    ltfat_int b2      = gl / a / 2;
-    ltfat_int Nblock  = bl / a;
-    ltfat_int Nblocke = Lext / a;
-    ltfat_int W       = plan.W;
-
-
-    /* Zero the output array, as we will be adding to it */
-    for (ltfat_int ii = 0; ii < M * N * W; ii++)
+    for (ltfat_int t = 1; t < plan->nthreads; t++)
     {
-        cout[ii] = (LTFAT_COMPLEX) 0.0;
+        if (plan->tplan[t]) LTFAT_NAME_COMPLEX(dgt_long_done)(&plan->tplan[t]);
+        LTFAT_SAFEFREEALL(plan->tbuf[t], plan->tcbuf[t]);
     }
+    plan->nthreads = 1;
+}
 
-    for (ltfat_int ii = 0; ii < Nb; ii++)
+LTFAT_API int
+LTFAT_NAME(dgt_ola_setnthreads)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                ltfat_int nthreads)
+{
+    ltfat_int Lext, Nblocke, a, M, W;
+    LTFAT_NAME_COMPLEX(dgt_long_plan)** tplan = NULL;
+    LTFAT_COMPLEX** tbuf = NULL;
+    LTFAT_COMPLEX** tcbuf = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    nthreads = LTFAT_OMP_NTHREADS(nthreads);
+    a = plan->plan->a;
+    M = plan->plan->M;
+    W = plan->W;
+    Lext = plan->bl + plan->gl;
+    Nblocke = Lext / a;
+
+    CHECKMEM( tplan =
+                  LTFAT_NEWARRAY(LTFAT_NAME_COMPLEX(dgt_long_plan)*, nthreads));
+    CHECKMEM( tbuf  = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nthreads));
+    CHECKMEM( tcbuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nthreads));
+
+    LTFAT_NAME(dgt_ola_freethreads)(plan);
+    LTFAT_SAFEFREEALL(plan->tplan, plan->tbuf, plan->tcbuf);
+    plan->tplan = tplan;
+    plan->tbuf  = tbuf;
+    plan->tcbuf = tcbuf;
+    plan->nthreads = nthreads;
+    plan->tplan[0] = plan->plan;
+    plan->tbuf[0]  = plan->buf;
+    plan->tcbuf[0] = plan->cbuf;
+
+    for (ltfat_int t = 1; t < nthreads; t++)
     {
-        ltfat_int s_ii;
+        CHECKMEM( plan->tbuf[t] = LTFAT_NAME_COMPLEX(calloc)(Lext * W));
+        CHECKMEM( plan->tcbuf[t] = LTFAT_NAME_COMPLEX(malloc)(M * Nblocke * W));
+        CHECKSTATUS(
+            LTFAT_NAME_COMPLEX(dgt_long_init)(plan->gext, Lext, W, a, M,
+                                              plan->tbuf[t], plan->tcbuf[t],
+                                              plan->plan->ptype,
+                                              plan->plan->flags,
+                                              &plan->tplan[t]));
+
+        /* The planner might have used the buffer */
+        for (ltfat_int l = 0; l < Lext * W; l++)
+            plan->tbuf[t][l] = 0.0;
+    }
 
-        /* Copy to working buffer. */
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            memcpy(plan.buf + Lext * w, f + ii * bl + w * L, sizeof(LTFAT_COMPLEX)*bl);
-        }
+    return status;
+error:
+    // Fall back to the single thread, the plan stays usable
+    if (plan && plan->tplan == tplan)
+        LTFAT_NAME(dgt_ola_freethreads)(plan);
+    else
+        LTFAT_SAFEFREEALL(tplan, tbuf, tcbuf);
+    return status;
+}
 
-        /* Execute the short DGT */
-        LTFAT_NAME_COMPLEX(dgt_long_execute)(plan.plan);
+static void
+LTFAT_NAME(dgt_ola_block)(void* userdata, ltfat_int t, const void* fv,
+                          ltfat_int L, ltfat_int j)
+{
+    LTFAT_NAME(dgt_ola_plan)* plan = (LTFAT_NAME(dgt_ola_plan)*) userdata;
+    const LTFAT_COMPLEX* f = (const LTFAT_COMPLEX*) fv;
+    ltfat_int Lext = plan->bl + plan->gl;
 
-        /* Place the results */
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            LTFAT_COMPLEX* cout_p;
-            LTFAT_COMPLEX* cbuf_p;
+    /* Copy to working buffer. */
+    for (ltfat_int w = 0; w < plan->W; w++)
+        memcpy(plan->tbuf[t] + Lext * w, f + j * plan->bl + w * L,
+               sizeof(LTFAT_COMPLEX)*plan->bl);
 
-            /* Place large block */
-            cout_p = cout + ii * M * Nblock + w * M * N ;
-            cbuf_p = plan.cbuf +             w * M * Nblocke;
-            for (ltfat_int m = 0; m < M; m++)
-            {
-                for (ltfat_int n = 0; n < Nblock; n++)
-                {
-                    cout_p[m + n * M] += cbuf_p[m + n * M];
-                }
-            }
+    /* Execute the short DGT */
+    LTFAT_NAME_COMPLEX(dgt_long_execute)(plan->tplan[t]);
+}
 
-            /* Small block + */
-            s_ii = ltfat_positiverem(ii + 1, Nb);
-            cout_p = cout + s_ii * M * Nblock + w * M * N ;
-            cbuf_p = plan.cbuf +      M * Nblock + w * M * Nblocke;
-            for (ltfat_int m = 0; m < M; m++)
-            {
-                for (ltfat_int n = 0; n < b2; n++)
-                {
-                    cout_p[m + n * M] += cbuf_p[m + n * M];
-                }
-            }
+static LTFAT_NAME(dgt_ola_geom)
+LTFAT_NAME(dgt_ola_getgeom)(const LTFAT_NAME(dgt_ola_plan)* plan,
+                            ltfat_int L, LTFAT_COMPLEX* carry)
+{
+    LTFAT_NAME(dgt_ola_geom) g;
+    ltfat_int a = plan->plan->a;
+    g.Mr      = plan->plan->M;
+    g.W       = plan->W;
+    g.Nblock  = plan->bl / a;
+    g.Nblocke = (plan->bl + plan->gl) / a;
+    g.b2      = plan->gl / a / 2;
+    g.Nb      = L / plan->bl;
+    g.Nout    = L / a;
+    g.carry   = carry;
+    return g;
+}
 
+LTFAT_API void
+LTFAT_NAME(dgt_ola_execute)(const LTFAT_NAME(dgt_ola_plan) plan,
+                            const LTFAT_COMPLEX* f, ltfat_int L,
+                            LTFAT_COMPLEX* cout)
 
-            /* Small block - */
-            s_ii = ltfat_positiverem(ii - 1, Nb) + 1;
-            cout_p = cout + M * (s_ii * Nblock - b2) + w * M * N ;
-            cbuf_p = plan.cbuf + M * (Nblock + b2)     + w * M * Nblocke;
-            for (ltfat_int m = 0; m < M; m++)
-            {
-                for (ltfat_int n = 0; n < b2; n++)
-                {
-                    cout_p[m + n * M] += cbuf_p[m + n * M];
-                }
-            }
+{
+    LTFAT_NAME(dgt_ola_plan) p = plan;
+    LTFAT_NAME(dgt_ola_geom) g = LTFAT_NAME(dgt_ola_getgeom)(&p, L, NULL);
 
-        }
+    LTFAT_NAME(dgt_ola_run)(&g, p.nthreads, &LTFAT_NAME(dgt_ola_block), &p,
+                            f, L, p.tcbuf, p.pend, cout);
+}
 
-    }
+LTFAT_API int
+LTFAT_NAME(dgt_ola_execute_stream)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                   const LTFAT_COMPLEX* f, ltfat_int L,
+                                     LTFAT_COMPLEX* cout)
+{
+    LTFAT_NAME(dgt_ola_geom) g;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(f); CHECKNULL(cout);
+    CHECK(LTFATERR_BADTRALEN, L > 0 && !(L % plan->bl),
+          "L (passed %td) must be positive and divisible by bl (passed %td).",
+          L, plan->bl);
+
+    g = LTFAT_NAME(dgt_ola_getgeom)(plan, L, plan->carry);
+
+    LTFAT_NAME(dgt_ola_run)(&g, plan->nthreads, &LTFAT_NAME(dgt_ola_block),
+                            plan, f, L, plan->tcbuf, plan->pend, cout);
+error:
+    return status;
+}
 
+LTFAT_API int
+LTFAT_NAME(dgt_ola_reset)(LTFAT_NAME(dgt_ola_plan)* plan)
+{
+    ltfat_int b2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+
+    b2 = plan->gl / plan->plan->a / 2;
+    for (ltfat_int l = 0; l < 2 * plan->plan->M * b2 * plan->W; l++)
+        plan->carry[l] = 0.0;
+error:
+    return status;
+}
 
+LTFAT_API ltfat_int
+LTFAT_NAME(dgt_ola_stream_flush)(LTFAT_NAME(dgt_ola_plan)* plan,
+                                 LTFAT_COMPLEX* cout)
+{
+    ltfat_int b2, Mr;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+
+    b2 = plan->gl / plan->plan->a / 2;
+    Mr = plan->plan->M;
+    if (b2 > 0)
+    {
+        CHECKNULL(cout);
+        // The first half of carry is complete if the signal ends with zeros
+        LTFAT_NAME(dgt_ola_copyframes)(Mr, plan->W, plan->carry, 2 * b2, b2,
+                                       cout, b2);
+    }
+
+    LTFAT_NAME(dgt_ola_reset)(plan);
+    return b2;
+error:
+    return status;
 }
 
 LTFAT_API void
 LTFAT_NAME(dgt_ola_done)(LTFAT_NAME(dgt_ola_plan) plan)
 {
+    LTFAT_NAME(dgt_ola_freethreads)(&plan);
+    LTFAT_SAFEFREEALL(plan.tplan, plan.tbuf, plan.tcbuf);
     LTFAT_NAME_COMPLEX(dgt_long_done)(&plan.plan);
-    LTFAT_SAFEFREEALL(plan.cbuf, plan.gext, plan.buf);
+    LTFAT_SAFEFREEALL(plan.cbuf, plan.gext, plan.buf, plan.pend, plan.carry);
 }
 
-
+/* ------------------------ DGTREAL_OLA -------------------------- */
 
 LTFAT_API LTFAT_NAME(dgtreal_ola_plan)
 LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL* g, ltfat_int gl,
@@ -161,14 +454,21 @@ LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL* g, ltfat_int gl,
 
     ltfat_int Lext    = bl + gl;
     ltfat_int Nblocke = Lext / a;
+    ltfat_int b2      = gl / a / 2;
 
     plan.buf  = (LTFAT_REAL*) ltfat_malloc(Lext * W * sizeof(LTFAT_REAL));
     plan.gext = (LTFAT_REAL*) ltfat_malloc(Lext * sizeof(LTFAT_REAL));
     plan.cbuf = (LTFAT_COMPLEX*) ltfat_malloc(M2 * Nblocke * W * sizeof(
                     LTFAT_COMPLEX));
+    plan.pend = LTFAT_NAME_COMPLEX(malloc)(2 * M2 * ltfat_imax(b2, 1) * W);
+    plan.carry = LTFAT_NAME_COMPLEX(calloc)(2 * M2 * ltfat_imax(b2, 1) * W);
 
     LTFAT_NAME_REAL(fir2long)(g, gl, Lext, plan.gext);
 
+    LTFAT_NAME(dgtreal_long_init)( (const LTFAT_REAL*)plan.gext,
+                                   Lext, W, a, M, (const LTFAT_REAL*)plan.buf,
+                                   plan.cbuf, ptype, flags, &plan.plan);
+
     /* Zero the last part of the buffer, it will always be zero. */
     for (ltfat_int w = 0; w < W; w++)
     {
@@ -178,19 +478,124 @@ LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL* g, ltfat_int gl,
         }
     }
 
-    LTFAT_NAME(dgtreal_long_init)( (const LTFAT_REAL*)plan.gext,
-                                   Lext, W, a, M, (const LTFAT_REAL*)plan.buf,
-                                   plan.cbuf, ptype, flags, &plan.plan);
+    plan.nthreads = 1;
+    plan.tplan = LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_long_plan)*, 1);
+    plan.tbuf  = LTFAT_NEWARRAY(LTFAT_REAL*, 1);
+    plan.tcbuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, 1);
+    plan.tplan[0] = plan.plan;
+    plan.tbuf[0]  = plan.buf;
+    plan.tcbuf[0] = plan.cbuf;
 
     return (plan);
 
 }
 
+/* Frees all threads but the first one, which uses the base plan and buffers */
+static void
+LTFAT_NAME(dgtreal_ola_freethreads)(LTFAT_NAME(dgtreal_ola_plan)* plan)
+{
+    for (ltfat_int t = 1; t < plan->nthreads; t++)
+    {
+        if (plan->tplan[t]) LTFAT_NAME(dgtreal_long_done)(&plan->tplan[t]);
+        LTFAT_SAFEFREEALL(plan->tbuf[t], plan->tcbuf[t]);
+    }
+    plan->nthreads = 1;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_setnthreads)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                    ltfat_int nthreads)
+{
+    ltfat_int Lext, Nblocke, a, M, M2, W;
+    LTFAT_NAME(dgtreal_long_plan)** tplan = NULL;
+    LTFAT_REAL** tbuf = NULL;
+    LTFAT_COMPLEX** tcbuf = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    nthreads = LTFAT_OMP_NTHREADS(nthreads);
+    a = plan->plan->a;
+    M = plan->plan->M;
+    M2 = M / 2 + 1;
+    W = plan->W;
+    Lext = plan->bl + plan->gl;
+    Nblocke = Lext / a;
+
+    CHECKMEM( tplan =
+                  LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_long_plan)*, nthreads));
+    CHECKMEM( tbuf  = LTFAT_NEWARRAY(LTFAT_REAL*, nthreads));
+    CHECKMEM( tcbuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nthreads));
+
+    LTFAT_NAME(dgtreal_ola_freethreads)(plan);
+    LTFAT_SAFEFREEALL(plan->tplan, plan->tbuf, plan->tcbuf);
+    plan->tplan = tplan;
+    plan->tbuf  = tbuf;
+    plan->tcbuf = tcbuf;
+    plan->nthreads = nthreads;
+    plan->tplan[0] = plan->plan;
+    plan->tbuf[0]  = plan->buf;
+    plan->tcbuf[0] = plan->cbuf;
+
+    for (ltfat_int t = 1; t < nthreads; t++)
+    {
+        CHECKMEM( plan->tbuf[t] = LTFAT_NAME_REAL(calloc)(Lext * W));
+        CHECKMEM( plan->tcbuf[t] = LTFAT_NAME_COMPLEX(malloc)(M2 * Nblocke * W));
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_long_init)(plan->gext, Lext, W, a, M,
+                                          plan->tbuf[t], plan->tcbuf[t],
+                                          plan->plan->ptype, plan->plan->flags,
+                                          &plan->tplan[t]));
+
+        /* The planner might have used the buffer */
+        for (ltfat_int l = 0; l < Lext * W; l++)
+            plan->tbuf[t][l] = 0.0;
+    }
 
+    return status;
+error:
+    // Fall back to the single thread, the plan stays usable
+    if (plan && plan->tplan == tplan)
+        LTFAT_NAME(dgtreal_ola_freethreads)(plan);
+    else
+        LTFAT_SAFEFREEALL(tplan, tbuf, tcbuf);
+    return status;
+}
 
+static void
+LTFAT_NAME(dgtreal_ola_block)(void* userdata, ltfat_int t, const void* fv,
+                              ltfat_int L, ltfat_int j)
+{
+    LTFAT_NAME(dgtreal_ola_plan)* plan = (LTFAT_NAME(dgtreal_ola_plan)*) userdata;
+    const LTFAT_REAL* f = (const LTFAT_REAL*) fv;
+    ltfat_int Lext = plan->bl + plan->gl;
 
+    /* Copy to working buffer. */
+    for (ltfat_int w = 0; w < plan->W; w++)
+        memcpy(plan->tbuf[t] + Lext * w, f + j * plan->bl + w * L,
+               sizeof(LTFAT_REAL)*plan->bl);
 
+    /* Execute the short DGTREAL */
+    LTFAT_NAME(dgtreal_long_execute)(plan->tplan[t]);
+}
 
+static LTFAT_NAME(dgt_ola_geom)
+LTFAT_NAME(dgtreal_ola_getgeom)(const LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                ltfat_int L, LTFAT_COMPLEX* carry)
+{
+    LTFAT_NAME(dgt_ola_geom) g;
+    ltfat_int a = plan->plan->a;
+    g.Mr      = plan->plan->M / 2 + 1;
+    g.W       = plan->W;
+    g.Nblock  = plan->bl / a;
+    g.Nblocke = (plan->bl + plan->gl) / a;
+    g.b2      = plan->gl / a / 2;
+    g.Nb      = L / plan->bl;
+    g.Nout    = L / a;
+    g.carry   = carry;
+    return g;
+}
 
 LTFAT_API void
 LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
@@ -198,90 +603,76 @@ LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
                                 LTFAT_COMPLEX* cout)
 
 {
-    ltfat_int bl      = plan.bl;
-    ltfat_int gl      = plan.gl;
-    ltfat_int a       = plan.plan->a;
-    ltfat_int M       = plan.plan->M;
-    ltfat_int N       = L / a;
-    ltfat_int Lext    = bl + gl;
-    ltfat_int Nb      = L / bl;
-    ltfat_int b2      = gl / a / 2;
-    ltfat_int Nblock  = bl / a;
-    ltfat_int Nblocke = Lext / a;
-    ltfat_int W       = plan.W;
-    ltfat_int M2      = M / 2 + 1;
-
-    /* Zero the output array, as we will be adding to it */
-    for (ltfat_int ii = 0; ii < M2 * N * W; ii++)
-    {
-        cout[ii] = (LTFAT_COMPLEX) 0.0;
-    }
+    LTFAT_NAME(dgtreal_ola_plan) p = plan;
+    LTFAT_NAME(dgt_ola_geom) g = LTFAT_NAME(dgtreal_ola_getgeom)(&p, L, NULL);
 
+    LTFAT_NAME(dgt_ola_run)(&g, p.nthreads, &LTFAT_NAME(dgtreal_ola_block), &p,
+                            f, L, p.tcbuf, p.pend, cout);
+}
 
-    for (ltfat_int ii = 0; ii < Nb; ii++)
-    {
-        ltfat_int s_ii;
-
-        /* Copy to working buffer. */
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            memcpy(plan.buf + Lext * w, f + ii * bl + w * L, sizeof(LTFAT_REAL)*bl);
-        }
-
-        /* Execute the short DGTREAL */
-        LTFAT_NAME(dgtreal_long_execute)(plan.plan);
-
-        /* Place the results */
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            LTFAT_COMPLEX* cout_p;
-            LTFAT_COMPLEX* cbuf_p;
-
-            /* Place large block */
-            cout_p = cout + ii * M2 * Nblock + w * M2 * N ;
-            cbuf_p = plan.cbuf +             w * M2 * Nblocke;
-            for (ltfat_int m = 0; m < M2; m++)
-            {
-                for (ltfat_int n = 0; n < Nblock; n++)
-                {
-                    cout_p[m + n * M2] += cbuf_p[m + n * M2];
-                }
-            }
-
-            /* Small block + */
-            s_ii = ltfat_positiverem(ii + 1, Nb);
-            cout_p = cout + s_ii * M2 * Nblock + w * M2 * N ;
-            cbuf_p = plan.cbuf +      M2 * Nblock + w * M2 * Nblocke;
-            for (ltfat_int m = 0; m < M2; m++)
-            {
-                for (ltfat_int n = 0; n < b2; n++)
-                {
-                    cout_p[m + n * M2] += cbuf_p[m + n * M2];
-                }
-            }
-
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_execute_stream)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                       const LTFAT_REAL* f, ltfat_int L,
+                                       LTFAT_COMPLEX* cout)
+{
+    LTFAT_NAME(dgt_ola_geom) g;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(f); CHECKNULL(cout);
+    CHECK(LTFATERR_BADTRALEN, L > 0 && !(L % plan->bl),
+          "L (passed %td) must be positive and divisible by bl (passed %td).",
+          L, plan->bl);
+
+    g = LTFAT_NAME(dgtreal_ola_getgeom)(plan, L, plan->carry);
+
+    LTFAT_NAME(dgt_ola_run)(&g, plan->nthreads, &LTFAT_NAME(dgtreal_ola_block),
+                            plan, f, L, plan->tcbuf, plan->pend, cout);
+error:
+    return status;
+}
 
-            /* Small block - */
-            s_ii = ltfat_positiverem(ii - 1, Nb) + 1;
-            cout_p = cout + M2 * (s_ii * Nblock - b2) + w * M2 * N ;
-            cbuf_p = plan.cbuf + M2 * (     Nblock + b2) + w * M2 * Nblocke;
-            for (ltfat_int m = 0; m < M2; m++)
-            {
-                for (ltfat_int n = 0; n < b2; n++)
-                {
-                    cout_p[m + n * M2] += cbuf_p[m + n * M2];
-                }
-            }
+LTFAT_API int
+LTFAT_NAME(dgtreal_ola_reset)(LTFAT_NAME(dgtreal_ola_plan)* plan)
+{
+    ltfat_int b2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+
+    b2 = plan->gl / plan->plan->a / 2;
+    for (ltfat_int l = 0; l < 2 * (plan->plan->M / 2 + 1) * b2 * plan->W; l++)
+        plan->carry[l] = 0.0;
+error:
+    return status;
+}
 
-        }
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_ola_stream_flush)(LTFAT_NAME(dgtreal_ola_plan)* plan,
+                                     LTFAT_COMPLEX* cout)
+{
+    ltfat_int b2, Mr;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
 
+    b2 = plan->gl / plan->plan->a / 2;
+    Mr = plan->plan->M / 2 + 1;
+    if (b2 > 0)
+    {
+        CHECKNULL(cout);
+        // The first half of carry is complete if the signal ends with zeros
+        LTFAT_NAME(dgt_ola_copyframes)(Mr, plan->W, plan->carry, 2 * b2, b2,
+                                       cout, b2);
     }
-}
 
+    LTFAT_NAME(dgtreal_ola_reset)(plan);
+    return b2;
+error:
+    return status;
+}
 
 LTFAT_API void
 LTFAT_NAME(dgtreal_ola_done)(LTFAT_NAME(dgtreal_ola_plan) plan)
 {
+    LTFAT_NAME(dgtreal_ola_freethreads)(&plan);
+    LTFAT_SAFEFREEALL(plan.tplan, plan.tbuf, plan.tcbuf);
     LTFAT_NAME(dgtreal_long_done)(&plan.plan);
-    LTFAT_SAFEFREEALL(plan.cbuf, plan.gext, plan.buf);
+    LTFAT_SAFEFREEALL(plan.cbuf, plan.gext, plan.buf, plan.pend, plan.carry);
 }
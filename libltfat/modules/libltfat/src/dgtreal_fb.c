@@ -10,10 +10,11 @@ struct LTFAT_NAME(dgtreal_fb_plan)
     ltfat_int M;
     ltfat_int gl;
     ltfat_phaseconvention ptype;
+    ltfat_int blocksize;
     LTFAT_NAME_REAL(fftreal_plan)* p_small;
+    LTFAT_NAME_REAL(fftreal_plan)* p_block;
     LTFAT_REAL*    sbuf;
     LTFAT_COMPLEX* cbuf;
-    LTFAT_REAL* fw;
     LTFAT_REAL* gw;
     LTFAT_COMPLEX* cout;
 };
@@ -62,15 +63,19 @@ LTFAT_NAME(dgtreal_fb_init)(const LTFAT_REAL* g,
     M2 = M / 2 + 1;
     plan->gl = gl;
     plan->ptype = ptype;
+    // Number of frames transformed by a single batched FFT
+    plan->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / (M2 * sizeof(LTFAT_COMPLEX)));
 
     CHECKMEM( plan->gw   = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( plan->fw   = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)(M));
-    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(M2));
+    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)(plan->blocksize * M));
+    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(plan->blocksize * M2));
 
     CHECKSTATUS(
         LTFAT_NAME_REAL(fftreal_init)(M, 1, plan->sbuf, plan->cbuf, flags,
                                       &plan->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(M, plan->blocksize, plan->sbuf, plan->cbuf,
+                                      flags, &plan->p_block));
 
     LTFAT_NAME(fftshift)(g, gl, plan->gw);
 
@@ -88,41 +93,27 @@ LTFAT_NAME(dgtreal_fb_done)(LTFAT_NAME(dgtreal_fb_plan)** plan)
     int status = LTFATERR_SUCCESS;
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
-    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->gw, pp->fw);
+    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->gw);
     if (pp->p_small) LTFAT_NAME_REAL(fftreal_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(fftreal_done)(&pp->p_block);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
-/* #define THE_SUM_REAL { \ */
-/* ltfat_int premarg = plan.ptype?-glh:n*a-glh; \ */
-/* for (ltfat_int m=0;m<M;m++) \ */
-/* { \ */
-/*    rem = ltfat_positiverem(m+(premarg), M); \ */
-/*    sbuf[rem]=0.0; \ */
-/*    fbd=fw+m; \ */
-/*    for (ltfat_int k=0;k<gl/M;k++) \ */
-/*    { \ */
-/*      sbuf[rem]+=(*fbd);         \ */
-/*       fbd+=M; \ */
-/*    } \ */
-/* } \ */
-/* \ */
-/*  LTFAT_FFTW(execute)(plan.p_small);         \ */
-/* \ */
-/* coefsum=(LTFAT_REAL*)cout+2*(n*M2+w*M2*N); \ */
-/* for (ltfat_int m=0;m<M2;m++) \ */
-/* { \ */
-/*    coefsum[2*m]   = CH(creal)(cbuf[m]); \ */
-/*    coefsum[2*m+1] = CH(cimag)(cbuf[m]); \ */
-/* }} */
-
-#define THE_SUM_REAL { \
-LTFAT_NAME(fold_array)(fw,gl,plan->ptype==LTFAT_TIMEINV?-glh:n*a-glh,M,sbuf); \
-LTFAT_NAME_REAL(fftreal_execute)(plan->p_small); \
-memcpy(cout+(n*M2+w*M2*N),cbuf,M2*sizeof*cbuf); \
+/* Windows the n-th frame of a single channel signal f and sums it
+ * modulo M to sbuf, see dgt_fb_foldframe */
+static void
+LTFAT_NAME(dgtreal_fb_foldframe)(const LTFAT_NAME(dgtreal_fb_plan)* p,
+                                 const LTFAT_REAL* f, ltfat_int L, ltfat_int n,
+                                 LTFAT_REAL* sbuf)
+{
+    ltfat_int glh = p->gl / 2;
+    ltfat_int offset = p->ptype == LTFAT_TIMEINV ? -glh : n * p->a - glh;
+
+    LTFAT_NAME(windowfold_array)(f, L, n * p->a - glh, p->gw, p->gl,
+                                 offset, p->M, sbuf);
 }
 
 LTFAT_API int
@@ -131,10 +122,18 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
                                ltfat_int L, ltfat_int W,
                                LTFAT_COMPLEX* cout)
 {
-    ltfat_int a, M, M2, N, gl, glh, glh_d_a;
-    LTFAT_REAL* sbuf, *fw;
-    const LTFAT_REAL* fbd;
-    LTFAT_COMPLEX* cbuf;
+    return LTFAT_NAME(dgtreal_fb_execute_blockfunc)(plan, f, L, W, NULL, NULL,
+            cout);
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_blockfunc)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+        const LTFAT_REAL* f,
+        ltfat_int L, ltfat_int W,
+        LTFAT_NAME(dgtreal_blockfunc)* blockfunc,
+        void* userdata, LTFAT_COMPLEX* cout)
+{
+    ltfat_int M, M2, N, K;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(plan); CHECKNULL(f); CHECKNULL(cout);
     CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
@@ -143,75 +142,318 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
           L, plan->a);
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
 
-    /*  --------- initial declarations -------------- */
-    a = plan->a;
     M = plan->M;
-    N = L / a;
+    M2 = M / 2 + 1;
+    N = L / plan->a;
+    K = plan->blocksize;
 
-    gl = plan->gl;
-    sbuf = plan->sbuf;
-    cbuf = plan->cbuf;
-    fw = plan->fw;
+    /* Frames are processed in blocks of K, see dgt_fb_execute */
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* fchan = f + L * w;
+        LTFAT_COMPLEX* cchan = cout + w * M2 * N;
 
-    /* These are floor operations. */
-    glh = plan->gl / 2;
-    M2 = M / 2 + 1;
+        for (ltfat_int n = 0; n < N; n += K)
+        {
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(dgtreal_fb_foldframe)(plan, fchan, L, n + k,
+                                                     plan->sbuf + k * M);
+
+                LTFAT_NAME_REAL(fftreal_execute)(plan->p_block);
+                if (blockfunc)
+                    blockfunc(userdata, plan->cbuf, w * M2 * N + n * M2, K * M2,
+                              cchan + n * M2);
+                else
+                    memcpy(cchan + n * M2, plan->cbuf, K * M2 * sizeof * cout);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(dgtreal_fb_foldframe)(plan, fchan, L, k, plan->sbuf);
+                    LTFAT_NAME_REAL(fftreal_execute)(plan->p_small);
+                    if (blockfunc)
+                        blockfunc(userdata, plan->cbuf, w * M2 * N + k * M2, M2,
+                                  cchan + k * M2);
+                    else
+                        memcpy(cchan + k * M2, plan->cbuf, M2 * sizeof * cout);
+                }
+            }
+        }
+    }
 
-    /* This is a ceil operation. */
-    glh_d_a = (ltfat_int)ceil((glh * 1.0) / (a));
+error:
+    return status;
+}
 
-    /*  ---------- main body ----------- */
+struct LTFAT_NAME(dgtreal_fb_stream_state)
+{
+    LTFAT_NAME(dgtreal_fb_plan)* fb;
+    ltfatExtType ext;
+    ltfat_int W;
+    LTFAT_REAL* tail;    // Unconsumed samples, gl x W
+    ltfat_int tl;        // Number of valid samples in tail
+    ltfat_int skip;      // Samples to drop before the next window starts
+    LTFAT_REAL* fbuf;    // A single window straddling tail and chunk, gl
+    LTFAT_REAL* zeros;   // gl zeros used by flush
+    ltfat_int ncols;     // Number of columns emitted so far
+    ltfat_int phase;     // Window start of the next column mod M
+    ltfat_int flen;      // Number of signal samples consumed so far
+};
 
-    /*----- Handle the first boundary using periodic boundary conditions.*/
-    for (ltfat_int n = 0; n < glh_d_a; n++)
-    {
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            fbd = f + L - (glh - n * a) + L * w;
-            for (ltfat_int l = 0; l < glh - n * a; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_init)(const LTFAT_REAL* g,
+                                   ltfat_int gl, ltfat_int a, ltfat_int M,
+                                   const ltfat_phaseconvention ptype,
+                                   ltfat_int W, ltfatExtType ext,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_fb_stream_state)** pout)
+{
+    LTFAT_NAME(dgtreal_fb_stream_state)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, ext == VALID || ext == ZPD,
+          "Only VALID and ZPD boundary modes are supported.");
 
-            fbd = f - (glh - n * a) + L * w;
-            for (ltfat_int l = glh - n * a; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_fb_stream_state)) );
 
-            THE_SUM_REAL
-        }
-    }
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_fb_init)(g, gl, a, M, ptype, flags, &p->fb));
+
+    p->ext = ext;
+    p->W = W;
+    CHECKMEM( p->tail  = LTFAT_NAME_REAL(malloc)(gl * W));
+    CHECKMEM( p->fbuf  = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->zeros = LTFAT_NAME_REAL(calloc)(gl));
 
-    /* ----- Handle the middle case. --------------------- */
-    for (ltfat_int n = glh_d_a; n < (L - (gl + 1) / 2) / a + 1; n++)
+    LTFAT_NAME(dgtreal_fb_stream_reset)(p);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(dgtreal_fb_stream_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_reset)(LTFAT_NAME(dgtreal_fb_stream_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    p->skip = 0;
+    p->ncols = 0;
+    p->flen = 0;
+
+    if (p->ext == ZPD)
     {
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            fbd = f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+        // The signal is preceded by gl/2 zeros such that the n-th column
+        // is centered at sample n*a, like in dgtreal_fb
+        p->tl = p->fb->gl / 2;
+        for (ltfat_int w = 0; w < p->W; w++)
+            memset(p->tail + w * p->fb->gl, 0, p->tl * sizeof * p->tail);
+        p->phase = ltfat_positiverem(-p->tl, p->fb->M);
+    }
+    else
+    {
+        p->tl = 0;
+        p->phase = 0;
+    }
+error:
+    return status;
+}
 
-            THE_SUM_REAL
-        }
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_stream_done)(LTFAT_NAME(dgtreal_fb_stream_state)** p)
+{
+    LTFAT_NAME(dgtreal_fb_stream_state)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    if (pp->fb) LTFAT_NAME(dgtreal_fb_done)(&pp->fb);
+    LTFAT_SAFEFREEALL(pp->tail, pp->fbuf, pp->zeros);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
 
+/* Number of windows completed by appending len samples */
+static ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_count)(const LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                    ltfat_int len)
+{
+    ltfat_int avail = p->tl + len - p->skip;
+    if (avail < p->fb->gl) return 0;
+    return (avail - p->fb->gl) / p->fb->a + 1;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_nextncols)(
+    const LTFAT_NAME(dgtreal_fb_stream_state)* p, ltfat_int len)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, len >= 0, "len must be nonnegative");
+    return LTFAT_NAME(dgtreal_fb_stream_count)(p, len);
+error:
+    return status;
+}
+
+/* Windows and folds the k-th complete window of the concatenation of the
+ * tail and the chunk f of the w-th channel */
+static void
+LTFAT_NAME(dgtreal_fb_stream_foldframe)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                        const LTFAT_REAL* f, ltfat_int len,
+                                        ltfat_int w, ltfat_int k,
+                                        LTFAT_REAL* sbuf)
+{
+    LTFAT_NAME(dgtreal_fb_plan)* fb = p->fb;
+    ltfat_int gl = fb->gl;
+    ltfat_int start = p->skip + k * fb->a;
+    ltfat_int offset = fb->ptype == LTFAT_TIMEINV ? -(gl / 2) :
+                       p->phase + k * fb->a;
+
+    if (start >= p->tl)
+    {
+        LTFAT_NAME(windowfold_array)(f, len, start - p->tl, fb->gw, gl,
+                                     offset, fb->M, sbuf);
+    }
+    else
+    {
+        ltfat_int ntail = p->tl - start;
+        memcpy(p->fbuf, p->tail + w * gl + start, ntail * sizeof * f);
+        memcpy(p->fbuf + ntail, f, (gl - ntail) * sizeof * f);
+        LTFAT_NAME(windowfold_array)(p->fbuf, gl, 0, fb->gw, gl,
+                                     offset, fb->M, sbuf);
     }
+}
+
+/* Common part of execute and flush. f is len x W with the channel stride
+ * ldf, N windows are complete. */
+static void
+LTFAT_NAME(dgtreal_fb_stream_run)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                  const LTFAT_REAL* f, ltfat_int len,
+                                  ltfat_int ldf, ltfat_int N, LTFAT_COMPLEX* c)
+{
+    LTFAT_NAME(dgtreal_fb_plan)* fb = p->fb;
+    ltfat_int M = fb->M, M2 = M / 2 + 1, K = fb->blocksize, gl = fb->gl;
+    ltfat_int next, total;
 
-    /* Handle the last boundary using periodic boundary conditions. */
-    for (ltfat_int n = (L - (gl + 1) / 2) / a + 1; n < N; n++)
+    for (ltfat_int w = 0; w < p->W; w++)
     {
-        for (ltfat_int w = 0; w < W; w++)
+        const LTFAT_REAL* fchan = f + w * ldf;
+        LTFAT_COMPLEX* cchan = c + w * M2 * N;
+
+        for (ltfat_int n = 0; n < N; n += K)
         {
-            fbd = f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < L - n * a + glh; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(dgtreal_fb_stream_foldframe)(p, fchan, len, w, n + k,
+                                                            fb->sbuf + k * M);
+
+                LTFAT_NAME_REAL(fftreal_execute)(fb->p_block);
+                memcpy(cchan + n * M2, fb->cbuf, K * M2 * sizeof * c);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(dgtreal_fb_stream_foldframe)(p, fchan, len, w, k,
+                                                            fb->sbuf);
+                    LTFAT_NAME_REAL(fftreal_execute)(fb->p_small);
+                    memcpy(cchan + k * M2, fb->cbuf, M2 * sizeof * c);
+                }
+            }
+        }
+    }
 
-            fbd = f - (L - n * a + glh) + L * w;
-            for (ltfat_int l = L - n * a + glh; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+    // Keep the samples from the start of the next window on. There are
+    // always less than gl of them.
+    next = p->skip + N * fb->a;
+    total = p->tl + len;
 
-            THE_SUM_REAL
+    if (next >= total)
+    {
+        p->skip = next - total;
+        p->tl = 0;
+    }
+    else
+    {
+        ltfat_int ntail = next < p->tl ? p->tl - next : 0;
+        for (ltfat_int w = 0; w < p->W; w++)
+        {
+            LTFAT_REAL* tchan = p->tail + w * gl;
+            memmove(tchan, tchan + next, ntail * sizeof * tchan);
+            memcpy(tchan + ntail, f + w * ldf + (next + ntail - p->tl),
+                   (total - next - ntail) * sizeof * tchan);
         }
+        p->skip = 0;
+        p->tl = total - next;
     }
 
+    p->ncols += N;
+    p->phase = ltfat_positiverem(p->phase + N * fb->a, M);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_execute)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                      const LTFAT_REAL* f, ltfat_int len,
+                                      LTFAT_COMPLEX* c)
+{
+    ltfat_int N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, len >= 0, "len must be nonnegative");
+    if (len == 0) return 0;
+    CHECKNULL(f);
+
+    N = LTFAT_NAME(dgtreal_fb_stream_count)(p, len);
+    if (N > 0) CHECKNULL(c);
+
+    LTFAT_NAME(dgtreal_fb_stream_run)(p, f, len, len, N, c);
+    p->flen += len;
+    return N;
 error:
     return status;
 }
 
-#undef THE_SUM_REAL
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_flushncols)(
+    const LTFAT_NAME(dgtreal_fb_stream_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    if (p->ext != ZPD) return 0;
+    // All columns centered within the signal, see dgtreal_fb_stream_reset
+    return (p->flen + p->fb->a - 1) / p->fb->a - p->ncols;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_fb_stream_flush)(LTFAT_NAME(dgtreal_fb_stream_state)* p,
+                                    LTFAT_COMPLEX* c)
+{
+    ltfat_int N, nzeros;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    N = LTFAT_NAME(dgtreal_fb_stream_flushncols)(p);
+    if (N > 0)
+    {
+        CHECKNULL(c);
+        // Zeros needed to complete the last column, always less than gl
+        nzeros = p->skip + (N - 1) * p->fb->a + p->fb->gl - p->tl;
+        LTFAT_NAME(dgtreal_fb_stream_run)(p, p->zeros, nzeros, 0, N, c);
+    }
+
+    LTFAT_NAME(dgtreal_fb_stream_reset)(p);
+    return N;
+error:
+    return status;
+}
@@ -33,7 +33,7 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
                                unsigned flags, LTFAT_NAME(dgtreal_long_plan)** pout)
 {
     LTFAT_NAME(dgtreal_long_plan)* plan = NULL;
-    ltfat_int minL, N, h_m, b, p, q, d, d2, wfs;
+    ltfat_int minL, h_m, wfs;
 
     int status = LTFATERR_SUCCESS;
     CHECK(LTFATERR_NULLPOINTER, (flags & FFTW_ESTIMATE) || cout != NULL,
@@ -59,41 +59,24 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
     plan->L = L;
     plan->W = W;
     plan->ptype = ptype;
-    N = L / a;
+    plan->flags = flags;
 
     plan->c = ltfat_gcd(a, M, &plan->h_a, &h_m);
-    b = L / M;
-    p = a / plan->c;
-    q = M / plan->c;
-    d = b / p;
     plan->h_a = -plan->h_a;
 
-    d2 = d / 2 + 1;
     wfs = wfacreal_size(L, a, M);
 
     plan->cout = cout;
     plan->f    = f;
-    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)( d ));
-    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(d2));
-    CHECKMEM( plan->ff = LTFAT_NAME_REAL(malloc)(2 * d2 * p * q * W));
-    CHECKMEM( plan->cf = LTFAT_NAME_REAL(malloc)(2 * d2 * q * q * W));
     CHECKMEM( plan->gf = LTFAT_NAME_COMPLEX(malloc)(wfs));
     //CHECKMEM( plan->cwork = (LTFAT_REAL*) LTFAT_NAME_COMPLEX(malloc)(M2 * N * W));
 
     /* Get factorization of window */
     LTFAT_NAME(wfacreal)(g, L, 1, a, M, plan->gf);
 
-    /* Create plans. In-place. */
-
-    CHECKSTATUS(
-        LTFAT_NAME(fftreal_init)(M, N * W,
-                                 (LTFAT_REAL*) cout, cout, flags, &plan->p_veryend));
-
+    /* Create buffers and plans. In-place. */
     CHECKSTATUS(
-        LTFAT_NAME(fftreal_init)(d, 1, plan->sbuf, plan->cbuf, flags, &plan->p_before));
-
-    CHECKSTATUS(
-        LTFAT_NAME(ifftreal_init)(d, 1, plan->cbuf, plan->sbuf, flags, &plan->p_after));
+        LTFAT_NAME(dgtreal_long_setnthreads)(plan, 1));
 
     *pout = plan;
     return status;
@@ -102,6 +85,123 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(dgtreal_long_freeworkspaces)(LTFAT_NAME(dgtreal_long_plan)* plan)
+{
+    if (!plan->ws) return;
+
+    for (ltfat_int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_long_workspace)* ws = &plan->ws[t];
+        if (ws->p_veryend) LTFAT_NAME(fftreal_done)(&ws->p_veryend);
+        if (ws->p_before)  LTFAT_NAME(fftreal_done)(&ws->p_before);
+        if (ws->p_after)   LTFAT_NAME(ifftreal_done)(&ws->p_after);
+        LTFAT_SAFEFREEALL(ws->sbuf, ws->cbuf, ws->ff, ws->cf);
+    }
+    ltfat_free(plan->ws);
+    plan->ws = NULL;
+    plan->nthreads = 0;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_setnthreads)(LTFAT_NAME(dgtreal_long_plan)* plan,
+                                     ltfat_int nthreads)
+{
+    ltfat_int N, M2, p, q, d, d2, ncolsall, colstep;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    LTFAT_NAME(dgtreal_long_freeworkspaces)(plan);
+
+    N = plan->L / plan->a;
+    M2 = plan->M / 2 + 1;
+    p = plan->a / plan->c;
+    q = plan->M / plan->c;
+    d = N / q;
+    d2 = d / 2 + 1;
+
+    /* There is no point in having more threads than columns */
+    ncolsall = N * plan->W;
+    nthreads = ltfat_imin(LTFAT_OMP_NTHREADS(nthreads), ncolsall);
+    colstep = ltfat_idivceil(ncolsall, nthreads);
+
+    CHECKMEM( plan->ws =
+                  LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_long_workspace), nthreads));
+    plan->nthreads = nthreads;
+
+    for (ltfat_int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_long_workspace)* ws = &plan->ws[t];
+        LTFAT_COMPLEX* coutcols = NULL;
+
+        ws->col0 = ltfat_imin(t * colstep, ncolsall);
+        ws->ncols = ltfat_imin(colstep, ncolsall - ws->col0);
+
+        CHECKMEM( ws->sbuf = LTFAT_NAME_REAL(malloc)( d ));
+        CHECKMEM( ws->cbuf = LTFAT_NAME_COMPLEX(malloc)(d2));
+        CHECKMEM( ws->ff = LTFAT_NAME_REAL(malloc)(2 * d2 * p * q * plan->W));
+        CHECKMEM( ws->cf = LTFAT_NAME_REAL(malloc)(2 * d2 * q * q * plan->W));
+
+        if (ws->ncols > 0)
+        {
+            if (plan->cout) coutcols = plan->cout + ws->col0 * M2;
+
+            CHECKSTATUS(
+                LTFAT_NAME(fftreal_init)(plan->M, ws->ncols,
+                                         (LTFAT_REAL*) coutcols, coutcols,
+                                         plan->flags, &ws->p_veryend));
+        }
+
+        CHECKSTATUS(
+            LTFAT_NAME(fftreal_init)(d, 1, ws->sbuf, ws->cbuf,
+                                     plan->flags, &ws->p_before));
+
+        CHECKSTATUS(
+            LTFAT_NAME(ifftreal_init)(d, 1, ws->cbuf, ws->sbuf,
+                                      plan->flags, &ws->p_after));
+    }
+
+    return status;
+error:
+    if (plan) LTFAT_NAME(dgtreal_long_freeworkspaces)(plan);
+    return status;
+}
+
+/* Phase locking (if required) and the final FFTs along the columns.
+ * Each thread takes care of its own block of columns. */
+static void
+LTFAT_NAME(dgtreal_long_modulate)(LTFAT_NAME(dgtreal_long_plan)* plan,
+                                  LTFAT_COMPLEX* cout)
+{
+    ltfat_int N = plan->L / plan->a;
+    ltfat_int M2 = plan->M / 2 + 1;
+
+    LTFAT_OMP(parallel for num_threads(plan->nthreads) schedule(static, 1))
+    for (ltfat_int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_long_workspace)* ws = &plan->ws[t];
+        LTFAT_COMPLEX* ccols = cout + ws->col0 * M2;
+
+        if (ws->ncols <= 0) continue;
+
+        if (LTFAT_TIMEINV == plan->ptype)
+        {
+            for (ltfat_int col = ws->col0; col < ws->col0 + ws->ncols; col++)
+            {
+                LTFAT_REAL* ccol = (LTFAT_REAL*) (cout + col * M2);
+                LTFAT_NAME_REAL(circshift)(ccol, plan->M,
+                                           -plan->a * (col % N), ccol);
+            }
+        }
+
+        /* FFT to modulate the coefficients. */
+        LTFAT_NAME(fftreal_execute_newarray)(ws->p_veryend,
+                                             (LTFAT_REAL*) ccols, ccols);
+    }
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_long_done)(LTFAT_NAME(dgtreal_long_plan)** plan)
 {
@@ -109,11 +209,8 @@ LTFAT_NAME(dgtreal_long_done)(LTFAT_NAME(dgtreal_long_plan)** plan)
     int status = LTFATERR_SUCCESS;
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
-    if (pp->p_veryend) LTFAT_NAME(fftreal_done)(&pp->p_veryend);
-    if (pp->p_before)  LTFAT_NAME(fftreal_done)(&pp->p_before);
-    if (pp->p_after)   LTFAT_NAME(ifftreal_done)(&pp->p_after);
-    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf,// pp->cwork,
-                      pp->gf, pp->ff, pp->cf);
+    LTFAT_NAME(dgtreal_long_freeworkspaces)(pp);
+    LTFAT_SAFEFREEALL(pp->gf);// pp->cwork
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -124,18 +221,11 @@ LTFAT_API int
 LTFAT_NAME(dgtreal_long_execute)(LTFAT_NAME(dgtreal_long_plan)* plan)
 {
     int status = LTFATERR_SUCCESS;
-    ltfat_int M2;
     CHECKNULL(plan); CHECKNULL(plan->f); CHECKNULL(plan->cout);
-    M2 = plan->M / 2 + 1;
 
     LTFAT_NAME(dgtreal_walnut_plan)(plan);
 
-    if (plan->ptype == LTFAT_TIMEINV)
-        LTFAT_NAME_REAL(dgtphaselockhelper)((LTFAT_REAL*) plan->cout, plan->L, plan->W,
-                                            plan->a, 2 * M2, plan->M, (LTFAT_REAL*) plan->cout);
-
-    /* FFT to modulate the coefficients. */
-    LTFAT_NAME(fftreal_execute)(plan->p_veryend);
+    LTFAT_NAME(dgtreal_long_modulate)(plan, plan->cout);
 
 error:
     return status;
@@ -147,10 +237,8 @@ LTFAT_NAME(dgtreal_long_execute_newarray)(LTFAT_NAME(dgtreal_long_plan)* plan,
 {
     int status = LTFATERR_SUCCESS;
     LTFAT_NAME(dgtreal_long_plan) plan2;
-    ltfat_int M2;
 
     CHECKNULL(plan); CHECKNULL(f); CHECKNULL(c);
-    M2 = plan->M / 2 + 1;
 
     // Make a shallow copy of the plan and overwrite f
     plan2 = *plan;
@@ -159,12 +247,7 @@ LTFAT_NAME(dgtreal_long_execute_newarray)(LTFAT_NAME(dgtreal_long_plan)* plan,
 
     LTFAT_NAME(dgtreal_walnut_plan)(&plan2);
 
-    if (plan->ptype == LTFAT_TIMEINV)
-        LTFAT_NAME_REAL(dgtphaselockhelper)((LTFAT_REAL*)c, plan->L, plan->W, plan->a,
-                                            2 * M2, plan->M, (LTFAT_REAL*) c);
-
-    /* FFTW new array execute function */
-    LTFAT_NAME(fftreal_execute_newarray)(plan->p_veryend, (LTFAT_REAL*)c, c);
+    LTFAT_NAME(dgtreal_long_modulate)(plan, c);
 
 error:
     return status;
@@ -209,18 +292,8 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
 
     ltfat_int h_a = plan->h_a;
 
-    LTFAT_REAL* sbuf = plan->sbuf;
-    LTFAT_COMPLEX* cbuf = plan->cbuf;
-
     LTFAT_REAL* cout = (LTFAT_REAL*) plan->cout;
 
-
-    LTFAT_REAL* gbase, *fbase, *cbase;
-
-    LTFAT_REAL* ffp;
-
-    const LTFAT_REAL* fp;
-
     /* Scaling constant needed because of FFTWs normalization. */
     const LTFAT_REAL scalconst = (const LTFAT_REAL) ( 1.0 / ((double)d * sqrt((
                                      double)M)));
@@ -231,11 +304,21 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
     /* Leading dimensions of cf */
     ltfat_int ld3b = 2 * q * q * W;
 
-    /* --------- main loop begins here ------------------- */
+    /* --------- main loop begins here -------------------
+     * Iterations of the r-loop are independent and write to disjoint
+     * parts of cout. Each thread works with its own buffers and plans. */
+    LTFAT_OMP(parallel for num_threads(plan->nthreads) schedule(static))
     for (ltfat_int r = 0; r < c; r++)
     {
+        LTFAT_NAME(dgtreal_long_workspace)* ws = &plan->ws[LTFAT_OMP_THREADID];
+        LTFAT_REAL* sbuf = ws->sbuf;
+        LTFAT_COMPLEX* cbuf = ws->cbuf;
+        LTFAT_REAL* gbase, *fbase, *cbase;
+        LTFAT_REAL* ffp;
+        const LTFAT_REAL* fp;
+
         /*  ---------- compute signal factorization ----------- */
-        ffp = plan->ff;
+        ffp = ws->ff;
         fp = f + r;
         if (p == 1)
         {
@@ -249,7 +332,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                         sbuf[s]   = fp[(s * M + l * a) % L];
                     }
 
-                    LTFAT_NAME(fftreal_execute)(plan->p_before);
+                    LTFAT_NAME(fftreal_execute)(ws->p_before);
 
                     for (ltfat_int s = 0; s < d2; s++)
                     {
@@ -277,7 +360,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                             sbuf[s]   = fp[ ltfat_positiverem(k * M + s * p * M - l * h_a * a, L) ];
                         }
 
-                        LTFAT_NAME(fftreal_execute)(plan->p_before);
+                        LTFAT_NAME(fftreal_execute)(ws->p_before);
 
                         for (ltfat_int s = 0; s < d2; s++)
                         {
@@ -304,8 +387,8 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
             for (ltfat_int s = 0; s < d2; s++)
             {
                 gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * q;
-                fbase = plan->ff + 2 * s * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
+                fbase = ws->ff + 2 * s * q * W;
+                cbase = ws->cf + 2 * s * q * q * W;
 
                 for (ltfat_int nm = 0; nm < q * W; nm++)
                 {
@@ -330,8 +413,8 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
             for (ltfat_int s = 0; s < d2; s++)
             {
                 gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * p * q;
-                fbase = plan->ff + 2 * s * p * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
+                fbase = ws->ff + 2 * s * p * q * W;
+                cbase = ws->cf + 2 * s * q * q * W;
 
                 for (ltfat_int nm = 0; nm < q * W; nm++)
                 {
@@ -360,7 +443,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
 
 
         /*  -------  compute inverse coefficient factorization ------- */
-        LTFAT_REAL* cfp = plan->cf;
+        LTFAT_REAL* cfp = ws->cf;
         ltfat_int ld5c = 2 * M2 * N;
 
         /* Cover both integer and rational sampling case */
@@ -380,7 +463,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                     cfp += 2;
 
                     /* Do inverse fft of length d */
-                    LTFAT_NAME(ifftreal_execute)(plan->p_after);
+                    LTFAT_NAME(ifftreal_execute)(ws->p_after);
 
                     for (ltfat_int s = 0; s < d; s++)
                     {
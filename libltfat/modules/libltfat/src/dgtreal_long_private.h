@@ -4,6 +4,20 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+/* Buffers and FFT plans used by a single thread.
+ * p_veryend covers ncols coefficient columns starting at col0. */
+typedef struct
+{
+    LTFAT_NAME(fftreal_plan)* p_before;
+    LTFAT_NAME(ifftreal_plan)* p_after;
+    LTFAT_NAME(fftreal_plan)* p_veryend;
+    LTFAT_REAL* sbuf;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL* ff, *cf;
+    ltfat_int col0;
+    ltfat_int ncols;
+} LTFAT_NAME(dgtreal_long_workspace);
+
 struct LTFAT_NAME(dgtreal_long_plan)
 {
     ltfat_int a;
@@ -13,14 +27,11 @@ struct LTFAT_NAME(dgtreal_long_plan)
     ltfat_int c;
     ltfat_int h_a;
     ltfat_phaseconvention ptype;
-    LTFAT_NAME(fftreal_plan)* p_before;
-    LTFAT_NAME(ifftreal_plan)* p_after;
-    LTFAT_NAME(fftreal_plan)* p_veryend;
-    LTFAT_REAL* sbuf;
-    LTFAT_COMPLEX* cbuf;
+    unsigned flags;
+    ltfat_int nthreads;
+    LTFAT_NAME(dgtreal_long_workspace)* ws;
     const LTFAT_REAL* f;
     LTFAT_COMPLEX* gf;
     LTFAT_REAL* cwork;
     LTFAT_COMPLEX* cout;
-    LTFAT_REAL* ff, *cf;
 };
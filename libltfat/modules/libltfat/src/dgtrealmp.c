@@ -124,6 +124,8 @@ LTFAT_NAME(dgtrealmp_init_gen)(
     CHECKMEM( p->N  = LTFAT_NEWARRAY( ltfat_int, P));
     CHECKMEM( p->chanmask  = LTFAT_NEWARRAY( int, P));
     CHECKMEM( p->couttmp = LTFAT_NEWARRAY( LTFAT_COMPLEX*, P));
+    CHECKMEM( p->g  = LTFAT_NEWARRAY( LTFAT_REAL*, P));
+    CHECKMEM( p->gl = LTFAT_NEWARRAY( ltfat_int, P));
 
     for (ltfat_int k = 0; k < P; k++)
     {
@@ -134,6 +136,13 @@ LTFAT_NAME(dgtrealmp_init_gen)(
 
     p->P = P; p->L = L;
 
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        CHECKMEM( p->g[k] = LTFAT_NAME_REAL(malloc)( gl[k]));
+        memcpy(p->g[k], g[k], gl[k] * sizeof * p->g[k]);
+        p->gl[k] = gl[k];
+    }
+
     CHECKMEM( dgtparams = ltfat_dgt_params_allocdef());
     ltfat_dgt_setpar_phaseconv(dgtparams, p->params->ptype);
     ltfat_dgt_setpar_synoverwrites(dgtparams, 0);
@@ -221,17 +230,57 @@ LTFAT_NAME(dgtrealmp_init_gen)(
                       LTFAT_NEWARRAY( kpoint, p->params->maxatoms) );
     }
 
-    if (p->params->ptype == LTFAT_FREQINV)
+    p->iterstate->nthreads = 1;
+
+    if (p->params->alg == ltfat_dgtmp_alg_ParallelMP)
     {
-        CHECKMEM(p->iterstate->cvalModBuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, P * P));
+        LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+        ltfat_int reach = 0;
+
+        s->nthreads = LTFAT_OMP_NTHREADS(p->params->nthreads);
+
+        /* Conservative distance (in samples) from the atom time position
+         * beyond which the residual is not modified in any of the
+         * dictionaries. */
         for (ltfat_int k1 = 0; k1 < P; k1++)
         {
             for (ltfat_int k2 = 0; k2 < P; k2++)
             {
                 LTFAT_NAME(kerns)* currkern = p->gramkerns[k1 + k2 * P];
-                ltfat_int h2 = ltfat_idivceil( currkern->size.height , currkern->Mstep);
-                CHECKMEM(p->iterstate->cvalModBuf[k1 + k2 * P] =
-                             LTFAT_NAME_COMPLEX(malloc)( h2));
+                ltfat_int halfwidth = 1 + ltfat_imax(currkern->mid.wmid,
+                                          currkern->size.width - 1 - currkern->mid.wmid);
+                reach = ltfat_imax(reach,
+                                   halfwidth * ltfat_imin(p->a[k1], p->a[k2]) +
+                                   ltfat_imax(p->a[k1], p->a[k2]));
+            }
+        }
+        s->parReach = 2 * reach + 1;
+
+        s->parBufSize = LTFAT_DGTREALMP_PARATOMS;
+        CHECKMEM( s->parBuf = LTFAT_NEWARRAY( kpoint, s->parBufSize) );
+        CHECKMEM( s->parCvalBuf = LTFAT_NAME_COMPLEX(malloc)( s->parBufSize) );
+        CHECKMEM( s->parInts = LTFAT_NEWARRAY( krange, s->parBufSize + 1) );
+        CHECKMEM( s->parIntVals = LTFAT_NAME_REAL(malloc)( s->parBufSize + 1) );
+        CHECKMEM( s->parIntPos = LTFAT_NEWARRAY( kpoint, s->parBufSize + 1) );
+        CHECKMEM( s->parIntTimes = LTFAT_NEWARRAY( ltfat_int, s->parBufSize + 1) );
+    }
+
+    if (p->params->ptype == LTFAT_FREQINV)
+    {
+        /* Every thread needs its own set of buffers */
+        ltfat_int nbufs = P * P * p->iterstate->nthreads;
+        CHECKMEM(p->iterstate->cvalModBuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nbufs));
+        for (ltfat_int t = 0; t < p->iterstate->nthreads; t++)
+        {
+            for (ltfat_int k1 = 0; k1 < P; k1++)
+            {
+                for (ltfat_int k2 = 0; k2 < P; k2++)
+                {
+                    LTFAT_NAME(kerns)* currkern = p->gramkerns[k1 + k2 * P];
+                    ltfat_int h2 = ltfat_idivceil( currkern->size.height , currkern->Mstep);
+                    CHECKMEM(p->iterstate->cvalModBuf[k1 + k2 * P + t * P * P] =
+                                 LTFAT_NAME_COMPLEX(malloc)( h2));
+                }
             }
         }
     }
@@ -361,6 +410,14 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
         case ltfat_dgtmp_alg_LocCyclicMP:
             status  = LTFAT_NAME(dgtrealmp_execute_cyclicmp)( p, origpos, cout);
             break;
+        case ltfat_dgtmp_alg_ParallelMP:
+        {
+            size_t curritstart = s->currit;
+            status  = LTFAT_NAME(dgtrealmp_execute_parmp)(
+                          p, origpos, itno - iter - 1, cout);
+            iter += s->currit - curritstart;
+            break;
+        }
         }
 
         if (s->err < 0)
@@ -479,7 +536,23 @@ LTFAT_NAME(dgtrealmp_done)( LTFAT_NAME(dgtrealmp_state)** p)
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
 
-    LTFAT_SAFEFREEALL(pp->a,pp->M,pp->M2,pp->N,pp->chanmask,pp->couttmp);
+    if (pp->g)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->g[k]);
+    }
+
+    if (pp->exptabs)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->exptabs[k]);
+    }
+
+    if (pp->atomlist)
+        LTFAT_NAME(dgtrealmp_atomlist_done)(&pp->atomlist);
+
+    LTFAT_SAFEFREEALL(pp->a,pp->M,pp->M2,pp->N,pp->chanmask,pp->couttmp,
+                      pp->g,pp->gl,pp->exptabs);
 
 
     if (pp->params)
@@ -643,7 +716,7 @@ LTFAT_NAME(dgtrealmpiter_done)(LTFAT_NAME(dgtrealmpiter_state)** state)
 
     if (s->cvalModBuf)
     {
-        for (ltfat_int p = 0; p < s->P * s->P; p++)
+        for (ltfat_int p = 0; p < s->P * s->P * s->nthreads; p++)
             ltfat_safefree(s->cvalModBuf[p]);
 
         ltfat_free(s->cvalModBuf);
@@ -654,6 +727,8 @@ LTFAT_NAME(dgtrealmpiter_done)(LTFAT_NAME(dgtrealmpiter_state)** state)
     ltfat_safefree(s->cvalinvBuf);
     ltfat_safefree(s->cvalBufPos);
     ltfat_safefree(s->pBuf);
+    LTFAT_SAFEFREEALL(s->parBuf, s->parCvalBuf, s->parInts, s->parIntVals,
+                      s->parIntPos, s->parIntTimes);
     if (s->hplan) LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&s->hplan);
     ltfat_safefree(s->N);
     ltfat_free(s);
@@ -0,0 +1,442 @@
+#include "dgtrealmp_private.h"
+#include <stdint.h>
+
+/* Atom list */
+
+static size_t
+LTFAT_NAME(dgtrealmp_atomlist_hashfn)(ltfat_int m, ltfat_int n, ltfat_int w)
+{
+    uint64_t key = ((uint64_t) n << 32) ^ ((uint64_t) m << 8) ^ (uint64_t) w;
+    return (size_t) ((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+static void
+LTFAT_NAME(dgtrealmp_atomlist_rehash)(LTFAT_NAME(dgtrealmp_atomlist)* l)
+{
+    memset(l->hash, 0, (l->hashMask + 1) * sizeof * l->hash);
+
+    for (size_t ii = 0; ii < l->atomsNo; ii++)
+    {
+        LTFAT_NAME(dgtrealmp_atom)* at = &l->atoms[ii];
+        size_t h = LTFAT_NAME(dgtrealmp_atomlist_hashfn)(at->m, at->n, at->w)
+                   & l->hashMask;
+
+        while (l->hash[h]) h = (h + 1) & l->hashMask;
+
+        l->hash[h] = ii + 1;
+    }
+}
+
+static int
+LTFAT_NAME(dgtrealmp_atomlist_init)(
+    size_t atomsSize, LTFAT_NAME(dgtrealmp_atomlist)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmp_atomlist)* l = NULL;
+    size_t hashSize = 2;
+
+    // Keep the load factor of the hash table below 1/2
+    while (hashSize < 2 * atomsSize) hashSize *= 2;
+
+    CHECKMEM( l = LTFAT_NEW( LTFAT_NAME(dgtrealmp_atomlist)) );
+    CHECKMEM( l->atoms = LTFAT_NEWARRAY( LTFAT_NAME(dgtrealmp_atom), atomsSize));
+    CHECKMEM( l->hash = LTFAT_NEWARRAY( ltfat_int, hashSize));
+    l->atomsSize = atomsSize;
+    l->hashMask = hashSize - 1;
+
+    *pout = l;
+    return status;
+error:
+    if (l) LTFAT_NAME(dgtrealmp_atomlist_done)(&l);
+    *pout = NULL;
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_atomlist_grow)(LTFAT_NAME(dgtrealmp_atomlist)* l)
+{
+    int status = LTFATERR_SUCCESS;
+    size_t hashSize = 2 * (l->hashMask + 1);
+    LTFAT_NAME(dgtrealmp_atom)* atoms = NULL;
+    ltfat_int* hash = NULL;
+
+    CHECKMEM( hash = LTFAT_NEWARRAY( ltfat_int, hashSize));
+    CHECKMEM( atoms = (LTFAT_NAME(dgtrealmp_atom)*) ltfat_realloc(
+                          l->atoms, l->atomsSize * sizeof * atoms,
+                          2 * l->atomsSize * sizeof * atoms));
+    l->atoms = atoms;
+    l->atomsSize *= 2;
+
+    ltfat_free(l->hash);
+    l->hash = hash;
+    l->hashMask = hashSize - 1;
+
+    LTFAT_NAME(dgtrealmp_atomlist_rehash)(l);
+    return status;
+error:
+    ltfat_safefree(hash);
+    return status;
+}
+
+LTFAT_COMPLEX*
+LTFAT_NAME(dgtrealmp_atomlist_get)(
+    LTFAT_NAME(dgtrealmp_atomlist)* l, kpoint pos)
+{
+    size_t h = LTFAT_NAME(dgtrealmp_atomlist_hashfn)(pos.m, pos.n, pos.w)
+               & l->hashMask;
+
+    for (; l->hash[h]; h = (h + 1) & l->hashMask)
+    {
+        LTFAT_NAME(dgtrealmp_atom)* at = &l->atoms[l->hash[h] - 1];
+        if (at->m == pos.m && at->n == pos.n && at->w == pos.w)
+            return &at->c;
+    }
+
+    if (l->atomsNo == l->atomsSize)
+    {
+        if (LTFAT_NAME(dgtrealmp_atomlist_grow)(l) != LTFATERR_SUCCESS)
+        {
+            l->overflow = 1;
+            return &l->sink;
+        }
+        return LTFAT_NAME(dgtrealmp_atomlist_get)(l, pos);
+    }
+
+    LTFAT_NAME(dgtrealmp_atom)* at = &l->atoms[l->atomsNo];
+    at->w = pos.w; at->m = pos.m; at->n = pos.n;
+    at->c = LTFAT_COMPLEX(0.0, 0.0);
+    l->hash[h] = ++l->atomsNo;
+    return &at->c;
+}
+
+int
+LTFAT_NAME(dgtrealmp_atomlist_done)(LTFAT_NAME(dgtrealmp_atomlist)** l)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(l); CHECKNULL(*l);
+
+    LTFAT_SAFEFREEALL((*l)->atoms, (*l)->hash);
+    ltfat_free(*l);
+    *l = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[], size_t atomsLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t* atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    int status2 = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmp_atomlist)* l;
+    size_t nonzeroNo = 0;
+
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(atoms); CHECKNULL(atomsNo);
+
+    *atomsNo = 0;
+
+    if (p->atomlist && p->atomlist->atomsSize < p->params->maxatoms)
+        LTFAT_NAME(dgtrealmp_atomlist_done)(&p->atomlist);
+
+    if (!p->atomlist)
+        CHECKSTATUS( LTFAT_NAME(dgtrealmp_atomlist_init)(
+                         p->params->maxatoms, &p->atomlist));
+
+    l = p->atomlist;
+    l->atomsNo = 0; l->overflow = 0;
+    memset(l->hash, 0, (l->hashMask + 1) * sizeof * l->hash);
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_reset)( p, f));
+
+    while ( LTFAT_DGTREALMP_STATUS_CANCONTINUE ==
+            ( status2 = LTFAT_NAME(dgtrealmp_execute_niters)(
+                            p, p->params->iterstep, NULL)))
+    {
+        if (p->callback)
+            p->callback(p->userdata, p, NULL);
+    }
+
+    CHECKSTATUS(status2);
+    CHECK(LTFATERR_NOMEM, !l->overflow, "Out of memory.");
+
+    /* Atoms removed by LocOMP or LocCyclicMP are kept in the list with
+     * zero coefficient */
+    for (size_t ii = 0; ii < l->atomsNo; ii++)
+        if (ltfat_norm(l->atoms[ii].c) > 0) nonzeroNo++;
+
+    *atomsNo = nonzeroNo;
+    CHECK(LTFATERR_BADREQSIZE, nonzeroNo <= atomsLen,
+          "atomsLen is too small. Passed %zu, required %zu.", atomsLen, nonzeroNo);
+
+    nonzeroNo = 0;
+    for (size_t ii = 0; ii < l->atomsNo; ii++)
+        if (ltfat_norm(l->atoms[ii].c) > 0)
+            atoms[nonzeroNo++] = l->atoms[ii];
+
+    return status2;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atom) atoms[],
+    size_t atomsNo, int dict_mask[], LTFAT_REAL f[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(atoms); CHECKNULL(f);
+
+    if (!p->exptabs)
+    {
+        CHECKMEM( p->exptabs = LTFAT_NEWARRAY( LTFAT_COMPLEX*, p->P));
+        for (ltfat_int w = 0; w < p->P; w++)
+        {
+            CHECKMEM( p->exptabs[w] = LTFAT_NAME_COMPLEX(malloc)( p->M[w]));
+            for (ltfat_int k = 0; k < p->M[w]; k++)
+            {
+                double arg = 2.0 * M_PI * k / p->M[w];
+                p->exptabs[w][k] = LTFAT_COMPLEX( cos(arg), sin(arg));
+            }
+        }
+    }
+
+    memset(f, 0, p->L * sizeof * f);
+
+    for (size_t ii = 0; ii < atomsNo; ii++)
+    {
+        const LTFAT_NAME(dgtrealmp_atom)* at = &atoms[ii];
+        ltfat_int w = at->w, m = at->m;
+
+        CHECK(LTFATERR_NOTINRANGE, w >= 0 && w < p->P,
+              "atoms[%zu].w=%td is out of range", ii, w);
+        CHECK(LTFATERR_NOTINRANGE, m >= 0 && m < p->M2[w],
+              "atoms[%zu].m=%td is out of range", ii, m);
+        CHECK(LTFATERR_NOTINRANGE, at->n >= 0 && at->n < p->N[w],
+              "atoms[%zu].n=%td is out of range", ii, at->n);
+
+        if (dict_mask && !dict_mask[w]) continue;
+
+        const LTFAT_REAL* g = p->g[w];
+        const LTFAT_COMPLEX* E = p->exptabs[w];
+        ltfat_int gl = p->gl[w], M = p->M[w], L = p->L;
+        ltfat_int gl2 = gl / 2;
+        ltfat_int t0 = at->n * p->a[w];
+        // Negative frequencies are implicit
+        LTFAT_REAL scal = m == 0 || 2 * m == M ? 1.0 : 2.0;
+        LTFAT_REAL cr = scal * ltfat_real(at->c);
+        LTFAT_REAL ci = scal * ltfat_imag(at->c);
+        // The window is in the FIR format i.e. g[0] is the center
+        ltfat_int l = ltfat_positiverem( t0 - gl2, L);
+        ltfat_int k = ltfat_positiverem(
+                          m * (p->params->ptype == LTFAT_FREQINV ? t0 - gl2 : -gl2), M);
+
+        for (ltfat_int j = -gl2; j < gl - gl2; j++)
+        {
+            LTFAT_REAL gval = g[j < 0 ? gl + j : j];
+            f[l] += gval * (cr * ltfat_real(E[k]) - ci * ltfat_imag(E[k]));
+            if (++l == L) l = 0;
+            k += m; if (k >= M) k -= M;
+        }
+    }
+
+error:
+    return status;
+}
+
+/* Serialization */
+
+static size_t
+LTFAT_NAME(dgtrealmp_putvarint)(uint64_t v, unsigned char* buf)
+{
+    size_t len = 1;
+    for (; v >= 0x80; v >>= 7, len++)
+        if (buf) *buf++ = (unsigned char) (v | 0x80);
+
+    if (buf) *buf = (unsigned char) v;
+    return len;
+}
+
+static size_t
+LTFAT_NAME(dgtrealmp_getvarint)(
+    const unsigned char* buf, size_t bufLen, uint64_t* v)
+{
+    *v = 0;
+    for (size_t len = 0; len < bufLen && len < 10; len++)
+    {
+        *v |= (uint64_t) (buf[len] & 0x7F) << (7 * len);
+        if (!(buf[len] & 0x80)) return len + 1;
+    }
+    return 0;
+}
+
+// Zigzag mapping of signed to unsigned integers 0,-1,1,-2,... -> 0,1,2,3,...
+static uint64_t
+LTFAT_NAME(dgtrealmp_zigzag)(ltfat_int v)
+{
+    return v < 0 ? ~((uint64_t) v << 1) : (uint64_t) v << 1;
+}
+
+static ltfat_int
+LTFAT_NAME(dgtrealmp_unzigzag)(uint64_t v)
+{
+    return (ltfat_int) (v >> 1) ^ -(ltfat_int) (v & 1);
+}
+
+static void
+LTFAT_NAME(dgtrealmp_putreal)(LTFAT_REAL x, unsigned char* buf)
+{
+    const uint16_t one = 1;
+    memcpy(buf, &x, sizeof x);
+
+    if (!*(const unsigned char*) &one)
+        for (size_t ii = 0; ii < sizeof x / 2; ii++)
+        {
+            unsigned char tmp = buf[ii];
+            buf[ii] = buf[sizeof x - 1 - ii];
+            buf[sizeof x - 1 - ii] = tmp;
+        }
+}
+
+static LTFAT_REAL
+LTFAT_NAME(dgtrealmp_getreal)(const unsigned char* buf)
+{
+    const uint16_t one = 1;
+    unsigned char tmp[sizeof(LTFAT_REAL)];
+    LTFAT_REAL x;
+
+    for (size_t ii = 0; ii < sizeof x; ii++)
+        tmp[ii] = *(const unsigned char*) &one ? buf[ii] : buf[sizeof x - 1 - ii];
+
+    memcpy(&x, tmp, sizeof x);
+    return x;
+}
+
+static size_t
+LTFAT_NAME(dgtrealmp_atoms_write)(
+    const LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo, unsigned char* buf)
+{
+    size_t len = 1;
+    ltfat_int wprev = 0, nprev = 0, mprev = 0;
+
+    if (buf) buf[0] = (unsigned char) sizeof(LTFAT_REAL);
+
+    len += LTFAT_NAME(dgtrealmp_putvarint)(atomsNo, buf ? buf + len : NULL);
+
+    for (size_t ii = 0; ii < atomsNo; ii++)
+    {
+        const LTFAT_NAME(dgtrealmp_atom)* at = &atoms[ii];
+        len += LTFAT_NAME(dgtrealmp_putvarint)(
+                   LTFAT_NAME(dgtrealmp_zigzag)(at->w - wprev), buf ? buf + len : NULL);
+        len += LTFAT_NAME(dgtrealmp_putvarint)(
+                   LTFAT_NAME(dgtrealmp_zigzag)(at->n - nprev), buf ? buf + len : NULL);
+        len += LTFAT_NAME(dgtrealmp_putvarint)(
+                   LTFAT_NAME(dgtrealmp_zigzag)(at->m - mprev), buf ? buf + len : NULL);
+
+        if (buf)
+        {
+            LTFAT_NAME(dgtrealmp_putreal)(ltfat_real(at->c), buf + len);
+            LTFAT_NAME(dgtrealmp_putreal)(ltfat_imag(at->c), buf + len + sizeof(LTFAT_REAL));
+        }
+        len += 2 * sizeof(LTFAT_REAL);
+
+        wprev = at->w; nprev = at->n; mprev = at->m;
+    }
+
+    return len;
+}
+
+LTFAT_API ptrdiff_t
+LTFAT_NAME(dgtrealmp_atoms_serialize)(
+    const LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo,
+    size_t bufLen, unsigned char buf[])
+{
+    ptrdiff_t status = LTFATERR_SUCCESS;
+    size_t len;
+    CHECKNULL(atoms);
+
+    len = LTFAT_NAME(dgtrealmp_atoms_write)(atoms, atomsNo, NULL);
+    if (!buf) return len;
+
+    CHECK(LTFATERR_BADREQSIZE, bufLen >= len,
+          "bufLen is too small. Passed %zu, required %zu.", bufLen, len);
+
+    return LTFAT_NAME(dgtrealmp_atoms_write)(atoms, atomsNo, buf);
+error:
+    return status;
+}
+
+LTFAT_API ptrdiff_t
+LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+    const unsigned char buf[], size_t bufLen, size_t atomsLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t* atomsNo)
+{
+    ptrdiff_t status = LTFATERR_SUCCESS;
+    size_t len = 1, vlen;
+    uint64_t v;
+    ltfat_int prev[3] = {0, 0, 0};
+    CHECKNULL(buf); CHECKNULL(atomsNo);
+
+    CHECK(LTFATERR_BADARG, bufLen > 0 && buf[0] == sizeof(LTFAT_REAL),
+          "The stream was not created with %zu-byte reals.", sizeof(LTFAT_REAL));
+
+    vlen = LTFAT_NAME(dgtrealmp_getvarint)(buf + len, bufLen - len, &v);
+    CHECK(LTFATERR_BADARG, vlen > 0, "The stream is corrupted.");
+    len += vlen;
+    *atomsNo = (size_t) v;
+
+    if (!atoms) return len;
+
+    CHECK(LTFATERR_BADREQSIZE, *atomsNo <= atomsLen,
+          "atomsLen is too small. Passed %zu, required %zu.", atomsLen, *atomsNo);
+
+    for (size_t ii = 0; ii < *atomsNo; ii++)
+    {
+        // w, n, m
+        for (int d = 0; d < 3; d++)
+        {
+            vlen = LTFAT_NAME(dgtrealmp_getvarint)(buf + len, bufLen - len, &v);
+            CHECK(LTFATERR_BADARG, vlen > 0, "The stream is corrupted.");
+            len += vlen;
+            prev[d] += LTFAT_NAME(dgtrealmp_unzigzag)(v);
+            CHECK(LTFATERR_BADARG, prev[d] >= 0, "The stream is corrupted.");
+        }
+
+        CHECK(LTFATERR_BADARG, bufLen - len >= 2 * sizeof(LTFAT_REAL),
+              "The stream is corrupted.");
+
+        atoms[ii].w = prev[0]; atoms[ii].n = prev[1]; atoms[ii].m = prev[2];
+        atoms[ii].c = LTFAT_COMPLEX(
+                          LTFAT_NAME(dgtrealmp_getreal)(buf + len),
+                          LTFAT_NAME(dgtrealmp_getreal)(buf + len + sizeof(LTFAT_REAL)));
+        len += 2 * sizeof(LTFAT_REAL);
+    }
+
+    return len;
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_atoms_cmp)(const void* a, const void* b)
+{
+    const LTFAT_NAME(dgtrealmp_atom)* at1 = (const LTFAT_NAME(dgtrealmp_atom)*) a;
+    const LTFAT_NAME(dgtrealmp_atom)* at2 = (const LTFAT_NAME(dgtrealmp_atom)*) b;
+
+    if (at1->w != at2->w) return at1->w < at2->w ? -1 : 1;
+    if (at1->n != at2->n) return at1->n < at2->n ? -1 : 1;
+    if (at1->m != at2->m) return at1->m < at2->m ? -1 : 1;
+    return 0;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_sort)(
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms);
+
+    qsort(atoms, atomsNo, sizeof * atoms, LTFAT_NAME(dgtrealmp_atoms_cmp));
+error:
+    return status;
+}
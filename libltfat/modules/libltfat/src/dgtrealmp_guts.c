@@ -3,6 +3,75 @@
 #include "ltfat/macros.h"
 #include "dgtrealmp_private.h"
 
+static int
+LTFAT_NAME(dgtrealmp_execute_updateresiduum_gen)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
+    int do_substract, LTFAT_COMPLEX** cvalModBuf, int do_refreshmax);
+
+/* c[l] += cval*k[l*kstep] for l=0,...,len-1
+ *
+ * The complex arithmetic is written out on the interleaved real arrays such
+ * that the compiler does not have to care about inf/nan special cases of the
+ * complex multiplication and can vectorize the loop. */
+static inline void
+LTFAT_NAME(dgtrealmp_kernmac)(const LTFAT_COMPLEX* LTFAT_RESTRICT k,
+                              ltfat_int kstep, LTFAT_COMPLEX cval,
+                              ltfat_int len, LTFAT_COMPLEX* LTFAT_RESTRICT c)
+{
+    const LTFAT_REAL* LTFAT_RESTRICT kr = (const LTFAT_REAL*) k;
+    LTFAT_REAL* LTFAT_RESTRICT cr = (LTFAT_REAL*) c;
+    const LTFAT_REAL vr = ltfat_real(cval);
+    const LTFAT_REAL vi = ltfat_imag(cval);
+
+    if (kstep == 1)
+    {
+        LTFAT_OMP(simd)
+        for (ltfat_int l = 0; l < len; l++)
+        {
+            cr[2 * l]     += vr * kr[2 * l] - vi * kr[2 * l + 1];
+            cr[2 * l + 1] += vr * kr[2 * l + 1] + vi * kr[2 * l];
+        }
+    }
+    else
+    {
+        for (ltfat_int l = 0, kl = 0; l < len; l++, kl += 2 * kstep)
+        {
+            cr[2 * l]     += vr * kr[kl] - vi * kr[kl + 1];
+            cr[2 * l + 1] += vr * kr[kl + 1] + vi * kr[kl];
+        }
+    }
+}
+
+/* c[l] += v[l]*k[l*kstep] for l=0,...,len-1 */
+static inline void
+LTFAT_NAME(dgtrealmp_kernmodmac)(const LTFAT_COMPLEX* LTFAT_RESTRICT k,
+                                 ltfat_int kstep,
+                                 const LTFAT_COMPLEX* LTFAT_RESTRICT v,
+                                 ltfat_int len, LTFAT_COMPLEX* LTFAT_RESTRICT c)
+{
+    const LTFAT_REAL* LTFAT_RESTRICT kr = (const LTFAT_REAL*) k;
+    const LTFAT_REAL* LTFAT_RESTRICT vr = (const LTFAT_REAL*) v;
+    LTFAT_REAL* LTFAT_RESTRICT cr = (LTFAT_REAL*) c;
+
+    if (kstep == 1)
+    {
+        LTFAT_OMP(simd)
+        for (ltfat_int l = 0; l < len; l++)
+        {
+            cr[2 * l]     += vr[2 * l] * kr[2 * l] - vr[2 * l + 1] * kr[2 * l + 1];
+            cr[2 * l + 1] += vr[2 * l] * kr[2 * l + 1] + vr[2 * l + 1] * kr[2 * l];
+        }
+    }
+    else
+    {
+        for (ltfat_int l = 0, kl = 0; l < len; l++, kl += 2 * kstep)
+        {
+            cr[2 * l]     += vr[2 * l] * kr[kl] - vr[2 * l + 1] * kr[kl + 1];
+            cr[2 * l + 1] += vr[2 * l] * kr[kl + 1] + vr[2 * l + 1] * kr[kl];
+        }
+    }
+}
+
 #define NLOOP \
     for ( ltfat_int nidx = n2start, knidx = kstart2.n; \
           knidx < k->size.width; \
@@ -25,45 +94,54 @@ for ( ltfat_int nidx = n2start, knidx = kstart2.n; \
           midx = ++midx>=p->M[w2]? midx - p->M[w2]: midx, kmidx += k->Mstep)
 
 
+/* Executes body for the (at most two) contiguous runs of rows of a column.
+ * The run starts at row midx of the coefficients, row kmidx of the
+ * kernel and row mmidx of the decimated kernel and it is mlen rows long. */
 #define  MLOOPBOTH(body){\
 ltfat_int movertmp = ltfat_imin(mover - k->srange[knidx].end, p->M2[w2]);\
-for ( ltfat_int midx = 0, mmidx = (kdim2.height-moverM2), kmidx = kstart2.m + mmidx*k->Mstep; \
-    midx < movertmp; midx++, mmidx++, kmidx+=k->Mstep ) {body}\
+if ( movertmp > 0 ){\
+    ltfat_int midx = 0, mmidx = kdim2.height - moverM2, mlen = movertmp;\
+    ltfat_int kmidx = kstart2.m + mmidx*k->Mstep; body}\
 \
 ltfat_int m2endtmp = ltfat_imin(m2end - k->srange[knidx].end, p->M2[w2]);\
-for ( ltfat_int mmidx = k->srange[knidx].start, midx = m2start + mmidx, kmidx = kstart2.m + mmidx*k->Mstep; \
-    midx < m2endtmp; midx++, mmidx++, kmidx+=k->Mstep ) {body}}\
+ltfat_int mmidx = k->srange[knidx].start, midx = m2start + mmidx;\
+if ( m2endtmp > midx ){\
+    ltfat_int mlen = m2endtmp - midx, kmidx = kstart2.m + mmidx*k->Mstep; body}}
 
+/* The phase convention and the sign branches are resolved once per kernel,
+ * the rows are processed by the vectorized helpers. */
 #define LTFAT_DGTREALMP_APPLYKERNEL(ctmp){\
-LTFAT_COMPLEX cvaltmp = ctmp;\
-if (do_substract){ LTFAT_DGTREALMP_APPLYKERNEL_SIGN(cvaltmp, -) }\
-else{              LTFAT_DGTREALMP_APPLYKERNEL_SIGN(cvaltmp, +) }}
-
-#define LTFAT_DGTREALMP_APPLYKERNEL_SIGN(ctmp, SIGN){\
+LTFAT_COMPLEX cvaltmp = do_substract ? -(ctmp) : (ctmp);\
 if (p->params->ptype == LTFAT_TIMEINV){\
 NLOOPBOTH(\
     LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
     LTFAT_COMPLEX* kcurrCol = k->kval + knidx * k->size.height;\
-    LTFAT_COMPLEX  cvaltmp2 = ctmp * kexp[knidx];\
+    LTFAT_COMPLEX  cvaltmp2 = cvaltmp * kexp[knidx];\
 MLOOPBOTH(\
-    currcCol[midx] = currcCol[midx] SIGN (cvaltmp2) * kcurrCol[kmidx]; ))}\
+    LTFAT_NAME(dgtrealmp_kernmac)(kcurrCol + kmidx, k->Mstep, cvaltmp2,\
+                                  mlen, currcCol + midx); ))}\
 else if (p->params->ptype == LTFAT_FREQINV){\
     for(ltfat_int kmidx = kstart2.m, mmidx = 0; kmidx < k->size.height;\
         kmidx += k->Mstep, mmidx++){\
-        s->cvalModBuf[kIdx][mmidx] = ctmp * kexp[kmidx];}\
+        cvalModBuf[kIdx][mmidx] = cvaltmp * kexp[kmidx];}\
 NLOOPBOTH(\
     LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
     LTFAT_COMPLEX* kcurrCol = k->kval + knidx * k->size.height;\
 MLOOPBOTH(\
-    currcCol[midx] = currcCol[midx] SIGN s->cvalModBuf[kIdx][mmidx] * kcurrCol[kmidx]; \
-    /* currsCol[midx] = ltfat_norm( currcCol[midx]); */ ))}}
+    LTFAT_NAME(dgtrealmp_kernmodmac)(kcurrCol + kmidx, k->Mstep,\
+                                     cvalModBuf[kIdx] + mmidx,\
+                                     mlen, currcCol + midx); ))}}
 
 #define LTFAT_DGTREALMP_MARKMODIFIED \
 NLOOPBOTH(\
     LTFAT_NAME(maxtree_setdirty)(s->fmaxtree[w2][nidx],\
                                  m2start + k->srange[knidx].start,\
-                                 m2start + kdim2.height - k->srange[knidx].end);)\
-    LTFAT_NAME(maxtree_setdirty)(s->tmaxtree[w2],       n2start, n2start + kdim2.width);
+                                 m2start + kdim2.height - k->srange[knidx].end);)
+
+#define LTFAT_DGTREALMP_REFRESHMAX \
+NLOOPBOTH(\
+    LTFAT_NAME(maxtree_findmax)(s->fmaxtree[w2][nidx],\
+                                &s->maxcols[w2][nidx], &s->maxcolspos[w2][nidx]);)
 
 int
 LTFAT_NAME(dgtrealmp_execute_locomp)(
@@ -347,6 +425,176 @@ LTFAT_NAME(dgtrealmp_execute_cyclicmp)(
     return LTFAT_DGTREALMP_STATUS_CANCONTINUE;
 }
 
+/* Finds the maximum over atoms with time positions (in samples) in range
+ * start,...,end. The positions are not reduced modulo L, but end - start < L.
+ * pos->n is the column index and *t the time position within the range. */
+static void
+LTFAT_NAME(dgtrealmp_execute_parfindmax)(
+    LTFAT_NAME(dgtrealmp_state)* p, ltfat_int start, ltfat_int end,
+    LTFAT_REAL* val, kpoint* pos, ltfat_int* t)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    *val = -1.0;
+
+    for (ltfat_int w = 0; w < s->P; w++)
+    {
+        ltfat_int N = p->N[w];
+        ltfat_int nfirst = ltfat_idivceil(start, p->a[w]);
+        ltfat_int nNo = end / p->a[w] - nfirst + 1;
+        if (nNo <= 0) continue;
+
+        ltfat_int nstart = nfirst % N;
+        ltfat_int nend   = ltfat_imin(nstart + nNo, N);
+        ltfat_int nover  = nstart + nNo - nend;
+
+        LTFAT_REAL valTmp; ltfat_int nTmp;
+
+        LTFAT_NAME(maxtree_findmaxinrange)(s->tmaxtree[w], nstart, nend,
+                                           &valTmp, &nTmp);
+        if ( valTmp > *val )
+        {
+            *val = valTmp; *pos = kpoint_init(s->maxcolspos[w][nTmp], nTmp, w);
+            *t = (nfirst + nTmp - nstart) * p->a[w];
+        }
+
+        if ( nover > 0 )
+        {
+            LTFAT_NAME(maxtree_findmaxinrange)(s->tmaxtree[w], 0, nover,
+                                               &valTmp, &nTmp);
+            if ( valTmp > *val )
+            {
+                *val = valTmp; *pos = kpoint_init(s->maxcolspos[w][nTmp], nTmp, w);
+                *t = (nfirst + N - nstart + nTmp) * p->a[w];
+            }
+        }
+    }
+}
+
+int
+LTFAT_NAME(dgtrealmp_execute_parmp)(
+    LTFAT_NAME(dgtrealmp_state)* p,
+    kpoint origpos, ltfat_int maxextra, LTFAT_COMPLEX** cout)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    ltfat_dgtmp_params* params = p->params;
+    ltfat_int reach = s->parReach;
+    ltfat_int intNo = 0;
+    size_t atNo = 0;
+    LTFAT_REAL projenergy;
+    LTFAT_REAL valthr =
+        LTFAT_DGTREALMP_PARRELTHR * s->maxcols[origpos.w][origpos.n];
+
+    LTFAT_NAME(dgtrealmp_execute_dualprodandprojenergy)(
+        p, origpos, s->c[PTOI(origpos)], &s->parCvalBuf[atNo], &projenergy);
+    s->parBuf[atNo++] = origpos;
+    s->err -= projenergy;
+
+    /* The residual is not modified farther than reach/2 from the atom
+     * position. Atoms more than reach apart can be therefore processed
+     * independently. Keep a list of time intervals where such atoms
+     * can be and greedily pick the largest one. */
+    if ( p->L > 2 * reach )
+    {
+        ltfat_int t0 = origpos.n * p->a[origpos.w];
+        s->parInts[intNo].start = t0 + reach;
+        s->parInts[intNo].end   = t0 + p->L - reach;
+        LTFAT_NAME(dgtrealmp_execute_parfindmax)(
+            p, s->parInts[intNo].start, s->parInts[intNo].end,
+            &s->parIntVals[intNo], &s->parIntPos[intNo], &s->parIntTimes[intNo]);
+        intNo++;
+    }
+
+    while ( atNo < s->parBufSize && (ltfat_int) atNo <= maxextra &&
+            s->err > params->errtoladj && s->currit < params->maxit &&
+            s->curratoms < params->maxatoms && intNo > 0 )
+    {
+        ltfat_int intIdx = 0;
+        for (ltfat_int ii = 1; ii < intNo; ii++)
+            if ( s->parIntVals[ii] > s->parIntVals[intIdx] )
+                intIdx = ii;
+
+        if ( s->parIntVals[intIdx] < valthr || s->parIntVals[intIdx] <= 0 )
+            break;
+
+        kpoint pos = s->parIntPos[intIdx];
+        ltfat_int t = s->parIntTimes[intIdx];
+        krange currint = s->parInts[intIdx];
+
+        s->currit++;
+        if ( !s->suppind[PTOI(pos)] ) s->curratoms++;
+
+        LTFAT_NAME(dgtrealmp_execute_dualprodandprojenergy)(
+            p, pos, s->c[PTOI(pos)], &s->parCvalBuf[atNo], &projenergy);
+        s->parBuf[atNo++] = pos;
+        s->err -= projenergy;
+
+        /* Split the interval */
+        intNo--;
+        s->parInts[intIdx]    = s->parInts[intNo];
+        s->parIntVals[intIdx] = s->parIntVals[intNo];
+        s->parIntPos[intIdx]  = s->parIntPos[intNo];
+        s->parIntTimes[intIdx] = s->parIntTimes[intNo];
+
+        if ( t - reach >= currint.start )
+        {
+            s->parInts[intNo].start = currint.start;
+            s->parInts[intNo].end = t - reach;
+            LTFAT_NAME(dgtrealmp_execute_parfindmax)(
+                p, s->parInts[intNo].start, s->parInts[intNo].end,
+                &s->parIntVals[intNo], &s->parIntPos[intNo], &s->parIntTimes[intNo]);
+            intNo++;
+        }
+
+        if ( t + reach <= currint.end )
+        {
+            s->parInts[intNo].start = t + reach;
+            s->parInts[intNo].end = currint.end;
+            LTFAT_NAME(dgtrealmp_execute_parfindmax)(
+                p, s->parInts[intNo].start, s->parInts[intNo].end,
+                &s->parIntVals[intNo], &s->parIntPos[intNo], &s->parIntTimes[intNo]);
+            intNo++;
+        }
+    }
+
+    LTFAT_OMP(parallel for num_threads(s->nthreads) schedule(dynamic) if(atNo > 1))
+    for (ltfat_int atIdx = 0; atIdx < (ltfat_int) atNo; atIdx++)
+    {
+        kpoint pos = s->parBuf[atIdx];
+        LTFAT_COMPLEX** cvalModBuf = s->cvalModBuf ?
+                                     s->cvalModBuf + s->P * s->P * LTFAT_OMP_THREADID : NULL;
+
+        LTFAT_NAME(dgtrealmp_execute_updateresiduum_gen)(
+            p, pos, s->parCvalBuf[atIdx], 1, cvalModBuf, 1);
+
+        s->suppind[PTOI(pos)]++;
+    }
+
+    /* The sparse output is not thread safe */
+    for (size_t atIdx = 0; atIdx < atNo; atIdx++)
+        *LTFAT_NAME(dgtrealmp_coutref)(p, cout, s->parBuf[atIdx]) +=
+            s->parCvalBuf[atIdx];
+
+    /* The column maxima were refreshed, propagate them to the time maxtrees */
+    for (size_t atIdx = 0; atIdx < atNo; atIdx++)
+    {
+        for (ltfat_int w2 = 0; w2 < s->P; w2++)
+        {
+            ltfat_int m2start, n2start;
+            ksize   kdim2; kanchor kmid2; kpoint  kstart2;
+            kpoint pos; pos.w = w2;
+
+            LTFAT_NAME(dgtrealmp_execute_indices)(
+                p, s->parBuf[atIdx], &pos, &m2start, &n2start,
+                &kdim2, &kmid2, &kstart2);
+
+            LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[w2], n2start,
+                                            n2start + kdim2.width);
+        }
+    }
+
+    return LTFAT_DGTREALMP_STATUS_CANCONTINUE;
+}
+
 LTFAT_REAL
 LTFAT_NAME(dgtrealmp_execute_mp)(
     LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX cval,
@@ -360,7 +608,7 @@ LTFAT_NAME(dgtrealmp_execute_mp)(
     LTFAT_NAME(dgtrealmp_execute_updateresiduum)( p, pos, cvaldual, 1);
 
     p->iterstate->suppind[PTOI(pos)]++;
-    cout[PTOI(pos)] += cvaldual;
+    *LTFAT_NAME(dgtrealmp_coutref)(p, cout, pos) += cvaldual;
     return projenergy;
 }
 
@@ -374,8 +622,9 @@ LTFAT_NAME(dgtrealmp_execute_invmp)(
     int uniquenyquest = p->M[pos.w] % 2 == 0;
     int do_conj = !( pos.m == 0 || (pos.m == p->M2[pos.w] - 1
                                     && uniquenyquest));
-    LTFAT_COMPLEX coutval = cout[PTOI(pos)];
-    cout[PTOI(pos)] = LTFAT_COMPLEX(0.0, 0.0);
+    LTFAT_COMPLEX* coutref = LTFAT_NAME(dgtrealmp_coutref)(p, cout, pos);
+    LTFAT_COMPLEX coutval = *coutref;
+    *coutref = LTFAT_COMPLEX(0.0, 0.0);
     LTFAT_COMPLEX cresval = s->c[PTOI(pos)];
     s->suppind[PTOI(pos)] = 0;
 
@@ -537,7 +786,19 @@ LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
     LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
     int do_substract)
 {
+    return LTFAT_NAME(dgtrealmp_execute_updateresiduum_gen)(
+               p, origpos, cval, do_substract, p->iterstate->cvalModBuf, 0);
+}
 
+/* With do_refreshmax, the maxima of the modified columns are recomputed
+ * right away and the time maxtree is left untouched. Updates around atoms
+ * with disjoint supports can then run concurrently, each with its own
+ * cvalModBuf set. */
+static int
+LTFAT_NAME(dgtrealmp_execute_updateresiduum_gen)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
+    int do_substract, LTFAT_COMPLEX** cvalModBuf, int do_refreshmax)
+{
 
     int uniquenyquest = p->M[origpos.w] % 2 == 0;
     int do_conj = !( origpos.m == 0 ||
@@ -587,6 +848,9 @@ LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
 
         LTFAT_DGTREALMP_MARKMODIFIED
 
+        if (!do_refreshmax)
+            LTFAT_NAME(maxtree_setdirty)(s->tmaxtree[w2], n2start, n2start + kdim2.width);
+
         ltfat_int posinkern  = kmid2.hmid - 2 * pos.m;
         ltfat_int posinkern2 = kmid2.hmid + 2 * (p->M2[w2] - 1 - pos.m) + 1 -
                                uniquenyquest ;
@@ -615,6 +879,8 @@ LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
             }
         }
 
+        if (do_refreshmax)
+            LTFAT_DGTREALMP_REFRESHMAX
     }
     return 0;
 }
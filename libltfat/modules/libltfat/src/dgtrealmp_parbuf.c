@@ -329,3 +329,13 @@ LTFAT_NAME(dgtrealmp_setparbuf_pedanticsearch)(
 error:
     return status;
 }
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, ltfat_int nthreads)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_nthreads(p->params, nthreads);
+error:
+    return status;
+}
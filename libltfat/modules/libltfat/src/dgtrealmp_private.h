@@ -33,8 +33,16 @@ struct ltfat_dgtmp_params
     size_t                cycles;
     ltfat_phaseconvention ptype;
     int                   do_pedantic;
+    ltfat_int             nthreads;
 };
 
+// ParallelMP: an atom is selected together with the globally maximal one only
+// if its energy is at least this fraction of the maximum.
+#define LTFAT_DGTREALMP_PARRELTHR 0.5
+// ParallelMP: maximum number of atoms selected in one step. It does not depend
+// on the number of threads so that the decomposition does not either.
+#define LTFAT_DGTREALMP_PARATOMS 32
+
 typedef struct
 {
     ltfat_int height;
@@ -114,6 +122,16 @@ typedef struct
     kpoint*                pBuf;
     size_t                 pBufSize;
     size_t                 pBufNo;
+    // ParallelMP related
+    kpoint*                parBuf;
+    LTFAT_COMPLEX*         parCvalBuf;
+    krange*                parInts;
+    LTFAT_REAL*            parIntVals;
+    kpoint*                parIntPos;
+    ltfat_int*             parIntTimes;
+    size_t                 parBufSize;
+    ltfat_int              parReach;
+    ltfat_int              nthreads;
 } LTFAT_NAME(dgtrealmpiter_state);
 
 
@@ -124,6 +142,19 @@ typedef struct
     LTFAT_NAME(dgtrealmp_state)* state;
 } LTFAT_NAME(dgtrealmp_state_closure);
 
+// Sparse output. Atoms are kept in the order of selection, the hash table
+// with linear probing maps atom positions to indices in the list.
+typedef struct
+{
+    LTFAT_NAME(dgtrealmp_atom)* atoms;
+    size_t                      atomsNo;
+    size_t                      atomsSize;
+    ltfat_int*                  hash;    // Index+1, 0 marks an empty slot
+    size_t                      hashMask;
+    LTFAT_COMPLEX               sink;    // Target of writes if growing failed
+    int                         overflow;
+} LTFAT_NAME(dgtrealmp_atomlist);
+
 struct LTFAT_NAME(dgtrealmp_state)
 {
     LTFAT_NAME(dgtrealmpiter_state)* iterstate;
@@ -141,6 +172,11 @@ struct LTFAT_NAME(dgtrealmp_state)
     LTFAT_NAME(dgtrealmp_state_closure)** closures;
     LTFAT_NAME(dgtrealmp_iterstep_callback)* callback;
     void* userdata;
+    // Sparse output
+    LTFAT_REAL**      g;
+    ltfat_int*       gl;
+    LTFAT_COMPLEX** exptabs; // exp(2*pi*i*k/M[w]), k=0,...,M[w]-1
+    LTFAT_NAME(dgtrealmp_atomlist)* atomlist;
 };
 
 static inline LTFAT_REAL
@@ -168,6 +204,19 @@ LTFAT_NAME(dgtrealmp_execute_dualprojenergy)(
     return LTFAT_NAME(dgtrealmp_execute_projenergy)( atinprod, cvaldual);
 }
 
+LTFAT_COMPLEX*
+LTFAT_NAME(dgtrealmp_atomlist_get)(
+    LTFAT_NAME(dgtrealmp_atomlist)* l, kpoint pos);
+
+// Output coefficient at pos. The dense arrays are used unless cout is NULL.
+static inline LTFAT_COMPLEX*
+LTFAT_NAME(dgtrealmp_coutref)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX** cout, kpoint pos)
+{
+    if (cout) return &cout[PTOI(pos)];
+    return LTFAT_NAME(dgtrealmp_atomlist_get)(p->atomlist, pos);
+}
+
 /* BEGIN_C_DECLS */
 #ifdef __cplusplus
 extern "C" {
@@ -181,6 +230,9 @@ LTFAT_NAME(dgtrealmpiter_init)(
 int
 LTFAT_NAME(dgtrealmpiter_done)(LTFAT_NAME(dgtrealmpiter_state)** state);
 
+int
+LTFAT_NAME(dgtrealmp_atomlist_done)(LTFAT_NAME(dgtrealmp_atomlist)** l);
+
 int
 LTFAT_NAME(dgtrealmp_kernel_cloneconj)(
     LTFAT_NAME(kerns)* kin, LTFAT_NAME(kerns)** kout);
@@ -289,6 +341,11 @@ LTFAT_NAME(dgtrealmp_execute_locomp)(
     LTFAT_NAME(dgtrealmp_state)* p,
     kpoint origpos, LTFAT_COMPLEX** cout);
 
+int
+LTFAT_NAME(dgtrealmp_execute_parmp)(
+    LTFAT_NAME(dgtrealmp_state)* p,
+    kpoint origpos, ltfat_int maxextra, LTFAT_COMPLEX** cout);
+
 LTFAT_REAL
 LTFAT_NAME(dgtrealmp_execute_invmp)(
     LTFAT_NAME(dgtrealmp_state)* p,
@@ -19,6 +19,7 @@ ltfat_dgtmp_params_defaults(ltfat_dgtmp_params* params)
     params->treelevels = 10;
     params->cycles = 1;
     params->ptype = LTFAT_TIMEINV;
+    params->nthreads = 1;
 error:
     return status;
 }
@@ -130,6 +131,21 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgtmp_setpar_nthreads(
+    ltfat_dgtmp_params* params, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    params->nthreads = nthreads;
+
+error:
+    return status;
+}
+
 LTFAT_API int
 ltfat_dgtmp_setpar_errtoldb(
     ltfat_dgtmp_params* params, double errtoldb)
@@ -207,6 +223,7 @@ ltfat_dgtmp_alg_isvalid(ltfat_dgtmp_alg in)
     case ltfat_dgtmp_alg_MP:
     case ltfat_dgtmp_alg_LocOMP:
     case ltfat_dgtmp_alg_LocCyclicMP:
+    case ltfat_dgtmp_alg_ParallelMP:
         isvalid = 1;
     }
 
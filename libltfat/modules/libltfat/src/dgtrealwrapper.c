@@ -117,6 +117,52 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_blockfunc)(
+    LTFAT_NAME(dgtreal_plan)* p, const LTFAT_REAL f[],
+    LTFAT_NAME(dgtreal_blockfunc)* blockfunc, void* userdata,
+    LTFAT_COMPLEX c[])
+{
+    ltfat_int M2N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(blockfunc);
+
+    // The filter bank algorithm calls blockfunc while the block is in cache
+    if (p->fwdtra == &LTFAT_NAME(dgtreal_fb_execute_wrapper))
+        return LTFAT_NAME(dgtreal_fb_execute_blockfunc)(
+                   (LTFAT_NAME(dgtreal_fb_plan)*) p->fwdtra_userdata,
+                   f, p->L, p->W, blockfunc, userdata, c);
+
+    CHECKSTATUS( p->fwdtra(p->fwdtra_userdata, f, p->L, p->W, c));
+
+    M2N = (p->M / 2 + 1) * (p->L / p->a);
+    for (ltfat_int w = 0; w < p->W; w++)
+        blockfunc(userdata, c + w * M2N, w * M2N, M2N, c + w * M2N);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_proj_blockfunc)(
+    LTFAT_NAME(dgtreal_plan)* p, const LTFAT_COMPLEX cin[],
+    LTFAT_REAL fbuffer[], LTFAT_NAME(dgtreal_blockfunc)* blockfunc,
+    void* userdata, LTFAT_COMPLEX cout[])
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_REAL* ftmp;
+
+    CHECKNULL(p);
+    ftmp = fbuffer != NULL ? fbuffer : p->f;
+    CHECK(LTFATERR_NULLPOINTER, ftmp != NULL,
+          "fbuffer cannot be NULL when the plan was created without f");
+
+    CHECKSTATUS( p->backtra(p->backtra_userdata, cin, p->L, p->W, ftmp));
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_blockfunc)(p, ftmp, blockfunc,
+                 userdata, cout));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_syn_newarray)(
     LTFAT_NAME(dgtreal_plan)* p, const LTFAT_COMPLEX c[], LTFAT_REAL f[])
@@ -279,6 +325,11 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
                                            paramsLoc.fftw_flags,
                                            (LTFAT_NAME(dgtreal_long_plan)**)&p->fwdtra_userdata));
 
+        if (paramsLoc.nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_long_setnthreads)(
+                    (LTFAT_NAME(dgtreal_long_plan)*) p->fwdtra_userdata, paramsLoc.nthreads));
+
         ltfat_safefree(g2);
     }
     else if ( ltfat_dgt_fb == paramsLoc.hint )
@@ -365,6 +416,11 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
                                            paramsLoc.fftw_flags,
                                            (LTFAT_NAME(dgtreal_long_plan)**)&p->fwdtra_userdata);
 
+            if (p->fwdtra_userdata && paramsLoc.nthreads > 1)
+                CHECKSTATUS(
+                    LTFAT_NAME(dgtreal_long_setnthreads)(
+                        (LTFAT_NAME(dgtreal_long_plan)*) p->fwdtra_userdata, paramsLoc.nthreads));
+
             ltfat_safefree(g2);
         }
     }
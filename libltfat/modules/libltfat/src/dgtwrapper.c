@@ -281,6 +281,11 @@ LTFAT_NAME(dgt_init_gen)(const LTFAT_TYPE ga[], ltfat_int gal,
                                        paramsLoc.fftw_flags,
                                        (LTFAT_NAME(dgt_long_plan)**)&p->fwdtra_userdata));
 
+        if (paramsLoc.nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(dgt_long_setnthreads)(
+                    (LTFAT_NAME(dgt_long_plan)*) p->fwdtra_userdata, paramsLoc.nthreads));
+
         ltfat_safefree(g2);
     }
     else if ( ltfat_dgt_fb == paramsLoc.hint )
@@ -354,6 +359,11 @@ LTFAT_NAME(dgt_init_gen)(const LTFAT_TYPE ga[], ltfat_int gal,
                                        paramsLoc.ptype, paramsLoc.fftw_flags,
                                        (LTFAT_NAME(dgt_long_plan)**)&p->fwdtra_userdata);
 
+            if (p->fwdtra_userdata && paramsLoc.nthreads > 1)
+                CHECKSTATUS(
+                    LTFAT_NAME(dgt_long_setnthreads)(
+                        (LTFAT_NAME(dgt_long_plan)*) p->fwdtra_userdata, paramsLoc.nthreads));
+
             ltfat_safefree(g2);
         }
     }
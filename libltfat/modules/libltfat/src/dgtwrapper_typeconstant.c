@@ -14,6 +14,7 @@ ltfat_dgt_params_defaults(ltfat_dgt_params* params)
     params->fftw_flags = FFTW_ESTIMATE;
     params->hint = ltfat_dgt_auto;
     params->do_synoverwrites = 1;
+    params->nthreads = 1;
 error:
     return status;
 }
@@ -70,6 +71,18 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgt_setpar_nthreads(ltfat_dgt_params* params, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    params->nthreads = nthreads;
+error:
+    return status;
+}
+
 LTFAT_API int
 ltfat_dgt_setpar_hint(ltfat_dgt_params* params,
                               ltfat_dgt_hint hint)
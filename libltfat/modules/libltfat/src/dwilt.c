@@ -2,6 +2,8 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+#include "ltfat/thirdparty/fftw3.h"
+
 
 #define CH(name) LTFAT_COMPLEXH(name)
 
@@ -101,7 +103,7 @@ LTFAT_NAME_REAL(dwilt_long)(const LTFAT_REAL* f, const LTFAT_REAL* g,
 
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_COMPLEX(dwilt_fb)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
                              ltfat_int L, ltfat_int gl,
                              ltfat_int W, ltfat_int M,
@@ -115,39 +117,41 @@ LTFAT_NAME_COMPLEX(dwilt_fb)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
     LTFAT_COMPLEX* coef2 = LTFAT_NAME_COMPLEX(malloc)(2 * M * N * W);
 
     /* coef2=comp_dgt(f,g,a,2*M,L); */
-    LTFAT_NAME_COMPLEX(dgt_fb)(f, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
+    int status =
+        LTFAT_NAME_COMPLEX(dgt_fb)(f, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
 
     ltfat_int nyquestadd = (M % 2) * M2;
 
     LTFAT_COMPLEX* pcoef  = cout;
     LTFAT_COMPLEX* pcoef2 = coef2;
 
-    POSTPROC_COMPLEX
+    if (status == LTFATERR_SUCCESS)
+    {
+        POSTPROC_COMPLEX
+    }
 
     ltfat_free(coef2);
-
+    return status;
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_REAL(dwilt_fb)(const LTFAT_REAL* f, const LTFAT_REAL* g,
                           ltfat_int L, ltfat_int gl,
                           ltfat_int W, ltfat_int M,
                           LTFAT_REAL* cout)
 {
-    ltfat_int N = L / M;
-    ltfat_int coef2_ld = M + 1;
-    ltfat_int nyquestadd = (M % 2) * coef2_ld;
-    const LTFAT_REAL scalconst = (LTFAT_REAL) sqrt(2.0);
+    LTFAT_NAME(dwilt_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_COMPLEX* coef2 = LTFAT_NAME_COMPLEX(malloc)((M + 1) * N * W);
-    LTFAT_NAME(dgtreal_fb)(f, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
+    CHECKSTATUS(
+        LTFAT_NAME(dwilt_fb_init)(g, gl, M, FFTW_ESTIMATE, &p));
 
-    LTFAT_REAL* pcoef  = cout;
-    LTFAT_COMPLEX* pcoef2 = coef2;
+    CHECKSTATUS(
+        LTFAT_NAME(dwilt_fb_execute)(p, f, L, W, cout));
 
-    POSTPROC_REAL
-
-    ltfat_free(coef2);
+error:
+    if (p) LTFAT_NAME(dwilt_fb_done)(&p);
+    return status;
 }
 
 #undef CH
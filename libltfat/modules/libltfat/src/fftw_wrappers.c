@@ -3,6 +3,186 @@
 #include "ltfat/macros.h"
 #include "ltfat/thirdparty/fftw3.h"
 
+/****** Plan registry ******/
+/* FFTW plans are shared among all wrapper plans of the same kind, length,
+ * number of transforms, in-placeness, array alignment and planner flags.
+ * This is safe because the wrappers always execute the FFTW plan using the
+ * new-array execute functions with the arrays passed to the init function.
+ * Sharing avoids repeated (expensive) planning with e.g. FFTW_MEASURE
+ * and it also keeps the arrays of the subsequent plans intact.
+ *
+ * The registry and the FFTW planner are protected by a critical section
+ * when compiled with OpenMP.
+ */
+typedef enum
+{
+    LTFAT_NAME(fftwkind_fft),
+    LTFAT_NAME(fftwkind_ifft),
+    LTFAT_NAME(fftwkind_fftreal),
+    LTFAT_NAME(fftwkind_ifftreal)
+} LTFAT_NAME(fftwkind);
+
+typedef struct LTFAT_NAME(fftwentry) LTFAT_NAME(fftwentry);
+
+struct LTFAT_NAME(fftwentry)
+{
+    LTFAT_NAME(fftwkind) kind;
+    ltfat_int L;
+    ltfat_int W;
+    int inplace;
+    int inalign;
+    int outalign;
+    unsigned flags;
+    ltfat_int refcount;
+    LTFAT_FFTW(plan) p;
+    LTFAT_NAME(fftwentry)* next;
+};
+
+static LTFAT_NAME(fftwentry)* LTFAT_NAME(fftwregistry) = NULL;
+
+static LTFAT_FFTW(plan)
+LTFAT_NAME(fftwregistry_plan)(LTFAT_NAME(fftwkind) kind, ltfat_int L, ltfat_int W,
+                              void* in, void* out, unsigned flags)
+{
+    LTFAT_FFTW(iodim64) dims;
+    LTFAT_FFTW(iodim64) howmany_dims;
+    ltfat_int M2 = L / 2 + 1;
+
+    dims.n = L; dims.is = 1; dims.os = 1;
+    howmany_dims.n = W; howmany_dims.is = L; howmany_dims.os = L;
+
+    switch (kind)
+    {
+    case LTFAT_NAME(fftwkind_fft):
+    case LTFAT_NAME(fftwkind_ifft):
+        return LTFAT_FFTW(plan_guru64_dft)(1, &dims, 1, &howmany_dims,
+                                           (LTFAT_FFTW(complex)*) in,
+                                           (LTFAT_FFTW(complex)*) out,
+                                           kind == LTFAT_NAME(fftwkind_fft) ?
+                                           FFTW_FORWARD : FFTW_BACKWARD, flags);
+    case LTFAT_NAME(fftwkind_fftreal):
+        howmany_dims.os = M2;
+        howmany_dims.is = in != out ? L : 2 * M2;
+        return LTFAT_FFTW(plan_guru64_dft_r2c)(1, &dims, 1, &howmany_dims,
+                                               (LTFAT_REAL*) in,
+                                               (LTFAT_FFTW(complex)*) out, flags);
+    case LTFAT_NAME(fftwkind_ifftreal):
+        howmany_dims.is = M2;
+        howmany_dims.os = in != out ? L : 2 * M2;
+        return LTFAT_FFTW(plan_guru64_dft_c2r)(1, &dims, 1, &howmany_dims,
+                                               (LTFAT_FFTW(complex)*) in,
+                                               (LTFAT_REAL*) out, flags);
+    }
+    return NULL;
+}
+
+/* Returns a shared FFTW plan or NULL if the plan creation failed */
+static LTFAT_FFTW(plan)
+LTFAT_NAME(fftwregistry_acquire)(LTFAT_NAME(fftwkind) kind, ltfat_int L,
+                                 ltfat_int W, void* in, void* out, unsigned flags)
+{
+    LTFAT_FFTW(plan) p = NULL;
+    int inplace = in == out;
+    int inalign = LTFAT_FFTW(alignment_of)((LTFAT_REAL*) in);
+    int outalign = LTFAT_FFTW(alignment_of)((LTFAT_REAL*) out);
+
+    LTFAT_OMP(critical(ltfat_fftwregistry))
+    {
+        LTFAT_NAME(fftwentry)* e = LTFAT_NAME(fftwregistry);
+
+        for (; e; e = e->next)
+            if (e->kind == kind && e->L == L && e->W == W &&
+                e->inplace == inplace && e->inalign == inalign &&
+                e->outalign == outalign && e->flags == flags)
+                break;
+
+        if (e)
+        {
+            e->refcount++;
+            p = e->p;
+        }
+        else if ( (e = LTFAT_NEW(LTFAT_NAME(fftwentry))) )
+        {
+            e->p = LTFAT_NAME(fftwregistry_plan)(kind, L, W, in, out, flags);
+
+            if (e->p)
+            {
+                e->kind = kind; e->L = L; e->W = W; e->inplace = inplace;
+                e->inalign = inalign; e->outalign = outalign; e->flags = flags;
+                e->refcount = 1;
+                e->next = LTFAT_NAME(fftwregistry);
+                LTFAT_NAME(fftwregistry) = e;
+                p = e->p;
+            }
+            else
+                ltfat_free(e);
+        }
+    }
+
+    return p;
+}
+
+static void
+LTFAT_NAME(fftwregistry_release)(LTFAT_FFTW(plan) p)
+{
+    LTFAT_OMP(critical(ltfat_fftwregistry))
+    {
+        LTFAT_NAME(fftwentry)** eptr = &LTFAT_NAME(fftwregistry);
+
+        while (*eptr && (*eptr)->p != p)
+            eptr = &(*eptr)->next;
+
+        if (*eptr && --(*eptr)->refcount == 0)
+        {
+            LTFAT_NAME(fftwentry)* e = *eptr;
+            *eptr = e->next;
+            LTFAT_FFTW(destroy_plan)(e->p);
+            ltfat_free(e);
+        }
+    }
+}
+
+/****** Wisdom ******/
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_import)(const char* filename)
+{
+    int imported = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    LTFAT_OMP(critical(ltfat_fftwregistry))
+    imported = LTFAT_FFTW(import_wisdom_from_filename)(filename);
+
+    CHECK(LTFATERR_FAILED, imported, "Importing FFTW wisdom from %s failed.",
+          filename);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_export)(const char* filename)
+{
+    int exported = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    LTFAT_OMP(critical(ltfat_fftwregistry))
+    exported = LTFAT_FFTW(export_wisdom_to_filename)(filename);
+
+    CHECK(LTFATERR_FAILED, exported, "Exporting FFTW wisdom to %s failed.",
+          filename);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_forget)(void)
+{
+    LTFAT_OMP(critical(ltfat_fftwregistry))
+    LTFAT_FFTW(forget_wisdom)();
+    return LTFATERR_SUCCESS;
+}
+
 /****** FFT ******/
 struct LTFAT_NAME(fft_plan)
 {
@@ -32,8 +212,6 @@ LTFAT_NAME(fft_init)(ltfat_int L, ltfat_int W,
                      LTFAT_COMPLEX in[], LTFAT_COMPLEX out[],
                      unsigned flags, LTFAT_NAME(fft_plan)** p)
 {
-    LTFAT_FFTW(iodim64) dims;
-    LTFAT_FFTW(iodim64) howmany_dims;
     LTFAT_NAME(fft_plan)* fftwp = NULL;
 
     int status = LTFATERR_SUCCESS;
@@ -45,13 +223,8 @@ LTFAT_NAME(fft_init)(ltfat_int L, ltfat_int W,
 
     fftwp->L = L; fftwp->W = W; fftwp->in = in; fftwp->out = out;
 
-    dims.n = L; dims.is = 1; dims.os = 1;
-    howmany_dims.n = W; howmany_dims.is = L; howmany_dims.os = L;
-
-    fftwp->p = LTFAT_FFTW(plan_guru64_dft)(1, &dims, 1, &howmany_dims,
-                                           (LTFAT_FFTW(complex)*)  in,
-                                           (LTFAT_FFTW(complex)*) out,
-                                           FFTW_FORWARD, flags);
+    fftwp->p = LTFAT_NAME(fftwregistry_acquire)(
+                   LTFAT_NAME(fftwkind_fft), L, W, in, out, flags);
 
     CHECKINIT(fftwp->p, "FFTW plan creation failed.");
     *p = fftwp;
@@ -59,7 +232,7 @@ LTFAT_NAME(fft_init)(ltfat_int L, ltfat_int W,
 error:
     if (fftwp)
     {
-        if (fftwp->p) LTFAT_FFTW(destroy_plan)(fftwp->p);
+        if (fftwp->p) LTFAT_NAME(fftwregistry_release)(fftwp->p);
         ltfat_free(fftwp);
     }
     *p = NULL;
@@ -71,7 +244,9 @@ LTFAT_NAME(fft_execute)(LTFAT_NAME(fft_plan)* p)
 {
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(p->in); CHECKNULL(p->out);
-    LTFAT_FFTW(execute)(p->p);
+    LTFAT_FFTW(execute_dft)(p->p,
+                            (LTFAT_FFTW(complex)*)p->in,
+                            (LTFAT_FFTW(complex)*)p->out);
 error:
     return status;
 }
@@ -96,7 +271,7 @@ LTFAT_NAME(fft_done)(LTFAT_NAME(fft_plan)** p)
     LTFAT_NAME(fft_plan)* pp = NULL;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    LTFAT_FFTW(destroy_plan)(pp->p);
+    LTFAT_NAME(fftwregistry_release)(pp->p);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -132,8 +307,6 @@ LTFAT_NAME(ifft_init)(ltfat_int L, ltfat_int W,
                       LTFAT_COMPLEX in[], LTFAT_COMPLEX out[],
                       unsigned flags, LTFAT_NAME(ifft_plan)** p)
 {
-    LTFAT_FFTW(iodim64) dims;
-    LTFAT_FFTW(iodim64) howmany_dims;
     LTFAT_NAME(ifft_plan)* fftwp = NULL;
 
     int status = LTFATERR_SUCCESS;
@@ -145,13 +318,8 @@ LTFAT_NAME(ifft_init)(ltfat_int L, ltfat_int W,
 
     fftwp->L = L; fftwp->W = W; fftwp->in = in; fftwp->out = out;
 
-    dims.n = L; dims.is = 1; dims.os = 1;
-    howmany_dims.n = W; howmany_dims.is = L; howmany_dims.os = L;
-
-    fftwp->p = LTFAT_FFTW(plan_guru64_dft)(1, &dims, 1, &howmany_dims,
-                                           (LTFAT_FFTW(complex)*)  in,
-                                           (LTFAT_FFTW(complex)*) out,
-                                           FFTW_BACKWARD, flags);
+    fftwp->p = LTFAT_NAME(fftwregistry_acquire)(
+                   LTFAT_NAME(fftwkind_ifft), L, W, in, out, flags);
 
     CHECKINIT(fftwp->p, "FFTW plan creation failed.");
     *p = fftwp;
@@ -159,7 +327,7 @@ LTFAT_NAME(ifft_init)(ltfat_int L, ltfat_int W,
 error:
     if (fftwp)
     {
-        if (fftwp->p) LTFAT_FFTW(destroy_plan)(fftwp->p);
+        if (fftwp->p) LTFAT_NAME(fftwregistry_release)(fftwp->p);
         ltfat_free(fftwp);
     }
     *p = NULL;
@@ -171,7 +339,9 @@ LTFAT_NAME(ifft_execute)(LTFAT_NAME(ifft_plan)* p)
 {
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(p->in); CHECKNULL(p->out);
-    LTFAT_FFTW(execute)(p->p);
+    LTFAT_FFTW(execute_dft)(p->p,
+                            (LTFAT_FFTW(complex)*)p->in,
+                            (LTFAT_FFTW(complex)*)p->out);
 error:
     return status;
 }
@@ -196,7 +366,7 @@ LTFAT_NAME(ifft_done)(LTFAT_NAME(ifft_plan)** p)
     LTFAT_NAME(ifft_plan)* pp = NULL;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    LTFAT_FFTW(destroy_plan)(pp->p);
+    LTFAT_NAME(fftwregistry_release)(pp->p);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -232,9 +402,6 @@ LTFAT_NAME(fftreal_init)(ltfat_int L, ltfat_int W,
                          LTFAT_REAL in[], LTFAT_COMPLEX out[],
                          unsigned flags, LTFAT_NAME(fftreal_plan)** p)
 {
-    LTFAT_FFTW(iodim64) dims;
-    LTFAT_FFTW(iodim64) howmany_dims;
-    ltfat_int M2;
     LTFAT_NAME(fftreal_plan)* fftwp = NULL;
 
     int status = LTFATERR_SUCCESS;
@@ -246,19 +413,8 @@ LTFAT_NAME(fftreal_init)(ltfat_int L, ltfat_int W,
 
     fftwp->L = L; fftwp->W = W; fftwp->in = in; fftwp->out = out;
 
-    M2 = L / 2 + 1;
-    dims.n = L; dims.is = 1; dims.os = 1;
-    howmany_dims.n = W;  howmany_dims.os = M2;
-
-    if (in != (LTFAT_REAL*) out )
-        howmany_dims.is = L;
-    else
-        howmany_dims.is = 2 * M2;
-
-    fftwp->p =
-        LTFAT_FFTW(plan_guru64_dft_r2c)(1, &dims, 1, &howmany_dims,
-                                        in, (LTFAT_FFTW(complex)*) out,
-                                        flags);
+    fftwp->p = LTFAT_NAME(fftwregistry_acquire)(
+                   LTFAT_NAME(fftwkind_fftreal), L, W, in, out, flags);
 
     CHECKINIT(fftwp->p, "FFTW plan creation failed.");
     *p = fftwp;
@@ -266,7 +422,7 @@ LTFAT_NAME(fftreal_init)(ltfat_int L, ltfat_int W,
 error:
     if (fftwp)
     {
-        if (fftwp->p) LTFAT_FFTW(destroy_plan)(fftwp->p);
+        if (fftwp->p) LTFAT_NAME(fftwregistry_release)(fftwp->p);
         ltfat_free(fftwp);
     }
     *p = NULL;
@@ -278,7 +434,7 @@ LTFAT_NAME(fftreal_execute)(LTFAT_NAME(fftreal_plan)* p)
 {
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(p->in); CHECKNULL(p->out);
-    LTFAT_FFTW(execute)(p->p);
+    LTFAT_FFTW(execute_dft_r2c)(p->p, p->in, (LTFAT_FFTW(complex)*) p->out);
 error:
     return status;
 }
@@ -301,7 +457,7 @@ LTFAT_NAME(fftreal_done)(LTFAT_NAME(fftreal_plan)** p)
     LTFAT_NAME(fftreal_plan)* pp = NULL;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    LTFAT_FFTW(destroy_plan)(pp->p);
+    LTFAT_NAME(fftwregistry_release)(pp->p);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -337,9 +493,6 @@ LTFAT_NAME(ifftreal_init)(ltfat_int L, ltfat_int W,
                           LTFAT_COMPLEX in[], LTFAT_REAL out[],
                           unsigned flags, LTFAT_NAME(ifftreal_plan)** p)
 {
-    LTFAT_FFTW(iodim64) dims;
-    LTFAT_FFTW(iodim64) howmany_dims;
-    ltfat_int M2;
     LTFAT_NAME(ifftreal_plan)* fftwp = NULL;
 
     int status = LTFATERR_SUCCESS;
@@ -349,22 +502,10 @@ LTFAT_NAME(ifftreal_init)(ltfat_int L, ltfat_int W,
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
     CHECKMEM( fftwp = LTFAT_NEW(LTFAT_NAME(ifftreal_plan)) );
 
-    M2 = L / 2 + 1;
-
     fftwp->L = L; fftwp->W = W; fftwp->in = in; fftwp->out = out;
 
-    dims.n = L; dims.is = 1; dims.os = 1;
-    howmany_dims.n = W; howmany_dims.is = L / 2 + 1;
-
-    if (in != (LTFAT_COMPLEX*) out )
-        howmany_dims.os = L;
-    else
-        howmany_dims.os = 2 * M2;
-
-    fftwp->p =
-        LTFAT_FFTW(plan_guru64_dft_c2r)(1, &dims, 1, &howmany_dims,
-                                        (LTFAT_FFTW(complex)*)  in,
-                                        out, flags);
+    fftwp->p = LTFAT_NAME(fftwregistry_acquire)(
+                   LTFAT_NAME(fftwkind_ifftreal), L, W, in, out, flags);
 
     CHECKINIT(fftwp->p, "FFTW plan creation failed.");
     *p = fftwp;
@@ -372,7 +513,7 @@ LTFAT_NAME(ifftreal_init)(ltfat_int L, ltfat_int W,
 error:
     if (fftwp)
     {
-        if (fftwp->p) LTFAT_FFTW(destroy_plan)(fftwp->p);
+        if (fftwp->p) LTFAT_NAME(fftwregistry_release)(fftwp->p);
         ltfat_free(fftwp);
     }
     *p = NULL;
@@ -384,7 +525,7 @@ LTFAT_NAME(ifftreal_execute)(LTFAT_NAME(ifftreal_plan)* p)
 {
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(p->in); CHECKNULL(p->out);
-    LTFAT_FFTW(execute)(p->p);
+    LTFAT_FFTW(execute_dft_c2r)(p->p, (LTFAT_FFTW(complex)*) p->in, p->out);
 error:
     return status;
 }
@@ -407,7 +548,7 @@ LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p)
     LTFAT_NAME(ifftreal_plan)* pp = NULL;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    LTFAT_FFTW(destroy_plan)(pp->p);
+    LTFAT_NAME(fftwregistry_release)(pp->p);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -1,14 +1,14 @@
-files = dgt.c dgtreal_fb.c dgt_multi.c dgt_ola.c dgt_shear.c	\
+files = dgt.c dgtreal_fb.c dgt_multi.c dgt_ola.c dgt_shear.c nsdgtreal.c \
 		dgtreal_long.c dwilt.c idwilt.c wmdct.c iwmdct.c \
 		filterbank.c ifilterbank.c heapint.c heap.c wfacreal.c \
 		idgtreal_long.c idgtreal_fb.c iwfacreal.c pfilt.c reassign_ti.c \
 		windows.c  \
 		dgt_shearola.c utils.c rtdgtreal.c circularbuf.c slicingbuf.c \
-		dgtrealwrapper.c dgtrealmp.c dgtrealmp_parbuf.c dgtrealmp_kernel.c dgtrealmp_guts.c maxtree.c \
-		slidgtrealmp.c
+		dgtrealwrapper.c dgtrealmp.c dgtrealmp_parbuf.c dgtrealmp_kernel.c dgtrealmp_guts.c dgtrealmp_atoms.c maxtree.c \
+		slidgtrealmp.c wilson_fb.c rtwmdct.c coeffile.c
 
 files_complextransp =\
-ci_utils.c ci_windows.c spread.c wavelets.c goertzel.c \
+ci_utils.c ci_windows.c spread.c wavelets.c wfbt.c goertzel.c \
 reassign.c gabdual_painless.c wfac.c iwfac.c \
 dgt_long.c idgt_long.c dgt_fb.c idgt_fb.c ci_memalloc.c \
 dgtwrapper.c
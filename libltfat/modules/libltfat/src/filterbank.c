@@ -6,6 +6,9 @@
 
 /**
 * FFT filterbank routines
+*
+* The filters are processed in parallel when compiled with OpenMP.
+* The plans in p[] must therefore be distinct.
 */
 
 struct LTFAT_NAME(convsub_fft_plan_struct)
@@ -34,6 +37,7 @@ LTFAT_NAME(filterbank_fft)(const LTFAT_COMPLEX* F, const LTFAT_COMPLEX* G[],
                            ltfat_int L, ltfat_int W, ltfat_int a[], ltfat_int M,
                            LTFAT_COMPLEX* cout[])
 {
+    LTFAT_OMP(parallel for schedule(dynamic))
     for (ltfat_int m = 0; m < M; m++)
     {
         LTFAT_NAME(convsub_fft)(F, G[m], L, W, a[m], cout[m]);
@@ -47,6 +51,7 @@ LTFAT_NAME(filterbank_fft_execute)(LTFAT_NAME(convsub_fft_plan) p[],
                                    ltfat_int M, LTFAT_COMPLEX* cout[])
 {
 
+    LTFAT_OMP(parallel for schedule(dynamic))
     for (ltfat_int m = 0; m < M; m++)
     {
         LTFAT_NAME(convsub_fft_execute)(p[m], F, G[m], cout[m]);
@@ -145,6 +150,7 @@ LTFAT_NAME(filterbank_fftbl)(const LTFAT_COMPLEX* F, const LTFAT_COMPLEX* G[],
                              ltfat_int foff[], const int realonly[],
                              LTFAT_COMPLEX* cout[])
 {
+    LTFAT_OMP(parallel for schedule(dynamic))
     for (ltfat_int m = 0; m < M; m++)
     {
         LTFAT_NAME(convsub_fftbl)(F, G[m], L, Gl[m], W, a[m],
@@ -159,6 +165,7 @@ LTFAT_NAME(filterbank_fftbl_execute)(LTFAT_NAME(convsub_fftbl_plan) p[],
                                      ltfat_int M, ltfat_int foff[],
                                      const int realonly[], LTFAT_COMPLEX* cout[])
 {
+    LTFAT_OMP(parallel for schedule(dynamic))
     for (ltfat_int m = 0; m < M; m++)
     {
         LTFAT_NAME(convsub_fftbl_execute)(p[m], F, G[m], foff[m], realonly[m], cout[m]);
@@ -1,6 +1,14 @@
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+/* The bucket index is the exponent and the LTFAT_HEAP_BUCKETBITS leading
+ * mantissa bits of the value in single precision, i.e. a quantized log2. */
+#define HEAP_NBUCKETS (256 << LTFAT_HEAP_BUCKETBITS)
+#define HEAP_LN2 0.69314718055994530942
 
 struct LTFAT_NAME(heap)
 {
@@ -8,32 +16,85 @@ struct LTFAT_NAME(heap)
     ltfat_int heapsize;
     ltfat_int totalheapsize;
     const LTFAT_REAL* s;
+    ltfat_heaptype type;
+    int do_log;
+    /* Bucket queue. Nodes are stored in h (keys) and next (links), each
+     * bucket is a singly linked list of nodes starting at head. */
+    ltfat_int* next;
+    ltfat_int* head;
+    ltfat_int freenode;
+    ltfat_int nodesused;
+    ltfat_int top;
+    ltfat_int bottom;
 };
 
 LTFAT_API LTFAT_NAME(heap)*
 LTFAT_NAME(heap_init)(ltfat_int initmaxsize, const LTFAT_REAL* s)
 {
-    LTFAT_NAME(heap)* h = (LTFAT_NAME(heap)*) ltfat_malloc(sizeof * h);
+    return LTFAT_NAME(heap_init_gen)(initmaxsize, s, LTFAT_HEAP_BINARY, 0);
+}
 
-    h->totalheapsize  = initmaxsize;
+LTFAT_API LTFAT_NAME(heap)*
+LTFAT_NAME(heap_init_gen)(ltfat_int initmaxsize, const LTFAT_REAL* s,
+                          ltfat_heaptype type, int do_log)
+{
+    LTFAT_NAME(heap)* h = (LTFAT_NAME(heap)*) ltfat_calloc(1, sizeof * h);
+
+    h->totalheapsize  = ltfat_imax(1, initmaxsize);
     h->h              = (ltfat_int*) ltfat_malloc(h->totalheapsize * sizeof * h->h);
     h->s              = s;
     h->heapsize       = 0;
+    h->type           = type;
+    h->do_log         = do_log;
+
+    if (type == LTFAT_HEAP_BUCKET)
+    {
+        h->next = (ltfat_int*) ltfat_malloc(h->totalheapsize * sizeof * h->next);
+        h->head = (ltfat_int*) ltfat_malloc(HEAP_NBUCKETS * sizeof * h->head);
+        for (ltfat_int b = 0; b < HEAP_NBUCKETS; b++)
+            h->head[b] = -1;
+        h->freenode  = -1;
+        h->nodesused = 0;
+        h->top       = -1;
+        h->bottom    = HEAP_NBUCKETS;
+    }
+
     return h;
 }
 
 LTFAT_API void
 LTFAT_NAME(heap_done)(LTFAT_NAME(heap)* h)
 {
+    ltfat_safefree(h->next);
+    ltfat_safefree(h->head);
     ltfat_free(h->h);
     ltfat_free(h);
 }
 
 LTFAT_API void
 LTFAT_NAME(heap_reset)(LTFAT_NAME(heap)* h, const LTFAT_REAL* news)
+{
+    LTFAT_NAME(heap_reset_gen)(h, news, h->do_log);
+}
+
+LTFAT_API void
+LTFAT_NAME(heap_reset_gen)(LTFAT_NAME(heap)* h, const LTFAT_REAL* news,
+                           int do_log)
 {
     h->s = news;
     h->heapsize = 0;
+    h->do_log = do_log;
+
+    if (h->type == LTFAT_HEAP_BUCKET)
+    {
+        /* Only buckets in [bottom,top] can be non-empty */
+        for (ltfat_int b = h->bottom; b <= h->top; b++)
+            h->head[b] = -1;
+        h->freenode  = -1;
+        h->nodesused = 0;
+        h->top       = -1;
+        h->bottom    = HEAP_NBUCKETS;
+    }
 }
 
 LTFAT_API void
@@ -43,6 +104,72 @@ LTFAT_NAME(heap_grow)(LTFAT_NAME(heap)* h, int factor)
     h->h = (ltfat_int*)ltfat_realloc((void*)h->h,
                                     h->totalheapsize * sizeof * h->h / factor,
                                     h->totalheapsize * sizeof * h->h);
+    if (h->next)
+        h->next = (ltfat_int*)ltfat_realloc((void*)h->next,
+                                           h->totalheapsize * sizeof * h->next / factor,
+                                           h->totalheapsize * sizeof * h->next);
+}
+
+static inline ltfat_int
+LTFAT_NAME(heap_bucketof)(const LTFAT_NAME(heap)* h, ltfat_int key)
+{
+    ltfat_int b;
+
+    if (h->do_log)
+    {
+        /* Same scale as below, log(1) maps to the bucket of 1.0f */
+        double v = h->s[key] * ((double)(1 << LTFAT_HEAP_BUCKETBITS) / HEAP_LN2);
+        v = floor(v) + (double)(127 << LTFAT_HEAP_BUCKETBITS);
+        b = v > 0.0 ? (v < HEAP_NBUCKETS ? (ltfat_int) v : HEAP_NBUCKETS - 1) : 0;
+    }
+    else
+    {
+        float v = (float) h->s[key];
+        uint32_t bits;
+        if (!(v > 0.0f)) return 0;
+        memcpy(&bits, &v, sizeof bits);
+        b = (ltfat_int)(bits >> (23 - LTFAT_HEAP_BUCKETBITS));
+        if (b >= HEAP_NBUCKETS) b = HEAP_NBUCKETS - 1; // inf and nan
+    }
+
+    return b;
+}
+
+static void
+LTFAT_NAME(heap_insert_bucket)(LTFAT_NAME(heap) *h, ltfat_int key)
+{
+    ltfat_int node, b;
+
+    if (h->freenode >= 0)
+    {
+        node = h->freenode;
+        h->freenode = h->next[node];
+    }
+    else
+    {
+        if (h->totalheapsize == h->nodesused)
+            LTFAT_NAME(heap_grow)( h, 2);
+        node = h->nodesused++;
+    }
+
+    b = LTFAT_NAME(heap_bucketof)(h, key);
+    h->h[node] = key;
+    h->next[node] = h->head[b];
+    h->head[b] = node;
+    h->heapsize++;
+
+    if (b > h->top) h->top = b;
+    if (b < h->bottom) h->bottom = b;
+}
+
+static inline ltfat_int
+LTFAT_NAME(heap_topnode)(LTFAT_NAME(heap) *h)
+{
+    /* Buckets above top are always empty. */
+    while (h->head[h->top] < 0)
+        h->top--;
+
+    return h->head[h->top];
 }
 
 LTFAT_API void
@@ -50,6 +177,12 @@ LTFAT_NAME(heap_insert)(LTFAT_NAME(heap) *h, ltfat_int key)
 {
     ltfat_int pos, pos2;
 
+    if (h->type == LTFAT_HEAP_BUCKET)
+    {
+        LTFAT_NAME(heap_insert_bucket)(h, key);
+        return;
+    }
+
     /* Grow heap if necessary */
     if (h->totalheapsize == h->heapsize)
         LTFAT_NAME(heap_grow)( h, 2);
@@ -79,6 +212,10 @@ LTFAT_API ltfat_int
 LTFAT_NAME(heap_get)(LTFAT_NAME(heap) *h)
 {
     if (h->heapsize == 0) return LTFATERR_UNDERFLOW;
+
+    if (h->type == LTFAT_HEAP_BUCKET)
+        return h->h[LTFAT_NAME(heap_topnode)(h)];
+
     return h->h[0];
 }
 
@@ -90,6 +227,17 @@ LTFAT_NAME(heap_delete)(LTFAT_NAME(heap) *h)
     LTFAT_REAL maxchildkey, val;
 
     if (h->heapsize == 0) return LTFATERR_UNDERFLOW;
+
+    if (h->type == LTFAT_HEAP_BUCKET)
+    {
+        ltfat_int node = LTFAT_NAME(heap_topnode)(h);
+        h->head[h->top] = h->next[node];
+        h->next[node] = h->freenode;
+        h->freenode = node;
+        h->heapsize--;
+        return h->h[node];
+    }
+
     /* Extract first element */
     retkey = h->h[0];
     key = h->h[h->heapsize - 1];
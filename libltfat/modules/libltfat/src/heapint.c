@@ -24,13 +24,23 @@ LTFAT_API LTFAT_NAME(heapinttask)*
 LTFAT_NAME(heapinttask_init)(ltfat_int height, ltfat_int N,
                              ltfat_int initheapsize,
                              const LTFAT_REAL* s, int do_real)
+{
+    return LTFAT_NAME(heapinttask_init_gen)(height, N, initheapsize, s, do_real,
+                                            LTFAT_HEAP_BINARY);
+}
+
+LTFAT_API LTFAT_NAME(heapinttask)*
+LTFAT_NAME(heapinttask_init_gen)(ltfat_int height, ltfat_int N,
+                                 ltfat_int initheapsize,
+                                 const LTFAT_REAL* s, int do_real,
+                                 ltfat_heaptype queuetype)
 {
     LTFAT_NAME(heapinttask)* hit = (LTFAT_NAME(heapinttask)*) ltfat_malloc(
                                        sizeof * hit);
     hit->height = height;
     hit->N = N;
     hit->donemask = (int*) ltfat_malloc(height * N * sizeof * hit->donemask);
-    hit->heap = LTFAT_NAME(heap_init)(initheapsize, s);
+    hit->heap = LTFAT_NAME(heap_init_gen)(initheapsize, s, queuetype, 0);
     hit->do_real = do_real;
 
     if (do_real)
@@ -67,7 +77,7 @@ LTFAT_NAME(heapinttask_resetmax)(LTFAT_NAME(heapinttask)* hit,
     ltfat_int Imax;
     LTFAT_REAL maxs;
 
-    LTFAT_NAME(heap_reset)(hit->heap, news);
+    LTFAT_NAME(heap_reset_gen)(hit->heap, news, 0);
 
     // Find the biggest coefficient
     LTFAT_NAME_REAL(findmaxinarray)(news,  hit->height * hit->N , &maxs, &Imax);
@@ -96,7 +106,7 @@ LTFAT_NAME(heapinttask_resetmask)(LTFAT_NAME(heapinttask)* hit,
     ltfat_int dummyImax;
     LTFAT_REAL maxs;
 
-    LTFAT_NAME(heap_reset)(hit->heap, news);
+    LTFAT_NAME(heap_reset_gen)(hit->heap, news, do_log);
 
     /* Copy known phase */
     for (ltfat_int w = 0; w < hit->height * hit->N; w++)
@@ -250,8 +260,8 @@ void LTFAT_NAME(heapint)(const LTFAT_REAL* s,
     memset(phase, 0, M * N * W * sizeof * phase);
 
     // Init plan
-    hit = LTFAT_NAME(heapinttask_init)( M, N, (ltfat_int)( M * log((double)M)) , s,
-                                        0);
+    hit = LTFAT_NAME(heapinttask_init_gen)( M, N, (ltfat_int)( M * log((double)M)) , s,
+                                            0, LTFAT_HEAPINT_QUEUE);
 
     for (ltfat_int w = 0; w < W; ++w)
     {
@@ -284,8 +294,8 @@ void LTFAT_NAME(maskedheapint)(const LTFAT_REAL* s,
     ltfat_int N = L / a;
 
     /* Main body */
-    hit = LTFAT_NAME(heapinttask_init)( M, N, (ltfat_int)( M * log((double)M) ), s,
-                                        0);
+    hit = LTFAT_NAME(heapinttask_init_gen)( M, N, (ltfat_int)( M * log((double)M) ), s,
+                                            0, LTFAT_HEAPINT_QUEUE);
 
     // Set all phases outside of the mask to zeros, do not modify the rest
     for (ltfat_int ii = 0; ii < M * N * W; ii++)
@@ -484,9 +494,8 @@ void LTFAT_NAME(heapintreal)(const LTFAT_REAL* s,
     memset(phase, 0, M2 * N * W * sizeof * phase);
 
     // Init plan
-    hit = LTFAT_NAME(heapinttask_init)( M2, N, (ltfat_int)( M2 * log((double)M2)),
-                                        s,
-                                        1);
+    hit = LTFAT_NAME(heapinttask_init_gen)( M2, N, (ltfat_int)( M2 * log((double)M2)),
+                                            s, 1, LTFAT_HEAPINT_QUEUE);
 
     for (ltfat_int w = 0; w < W; ++w)
     {
@@ -520,8 +529,8 @@ void LTFAT_NAME(maskedheapintreal)(const LTFAT_REAL* s,
     ltfat_int N = L / a;
 
     // Initialize plan
-    hit = LTFAT_NAME(heapinttask_init)( M2, N, (ltfat_int)( M2 * log((double) M2)),
-                                        s, 1);
+    hit = LTFAT_NAME(heapinttask_init_gen)( M2, N, (ltfat_int)( M2 * log((double) M2)),
+                                            s, 1, LTFAT_HEAPINT_QUEUE);
 
     // Set all phases outside of the mask to zeros, do not modify the rest
     for (ltfat_int ii = 0; ii < M2 * N * W; ii++)
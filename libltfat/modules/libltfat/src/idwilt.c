@@ -2,6 +2,8 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+#include "ltfat/thirdparty/fftw3.h"
+
 #define CH(name) LTFAT_COMPLEXH(name)
 
 #define PREPROC_REAL \
@@ -101,7 +103,7 @@ LTFAT_NAME_REAL(idwilt_long)(const LTFAT_REAL* c, const LTFAT_REAL* g,
 
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_COMPLEX(idwilt_fb)(const LTFAT_COMPLEX* c, const LTFAT_COMPLEX* g,
                               ltfat_int L, ltfat_int gl,
                               ltfat_int W, ltfat_int M,
@@ -121,33 +123,31 @@ LTFAT_NAME_COMPLEX(idwilt_fb)(const LTFAT_COMPLEX* c, const LTFAT_COMPLEX* g,
 
     PREPROC_COMPLEX
 
-    LTFAT_NAME_COMPLEX(idgt_fb)(coef2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, f);
+    int status =
+        LTFAT_NAME_COMPLEX(idgt_fb)(coef2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, f);
 
     ltfat_free(coef2);
-
+    return status;
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_REAL(idwilt_fb)(const LTFAT_REAL* c, const LTFAT_REAL* g,
                            ltfat_int L, ltfat_int gl,
                            ltfat_int W, ltfat_int M,
                            LTFAT_REAL* f)
 {
-    ltfat_int N = L / M;
-    ltfat_int coef2_ld = M + 1;
-    ltfat_int nyquestadd = (M % 2) * coef2_ld;
-    const LTFAT_REAL scalconst = (LTFAT_REAL) ( 1.0 / sqrt(2.0) );
+    LTFAT_NAME(idwilt_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_COMPLEX* coef2 = LTFAT_NAME_COMPLEX(calloc)((M + 1) * N * W);
+    CHECKSTATUS(
+        LTFAT_NAME(idwilt_fb_init)(g, gl, M, FFTW_ESTIMATE, &p));
 
-    const LTFAT_REAL* pcoef  = c;
-    LTFAT_COMPLEX* pcoef2 = coef2;
+    CHECKSTATUS(
+        LTFAT_NAME(idwilt_fb_execute)(p, c, L, W, f));
 
-    PREPROC_REAL
-
-    LTFAT_NAME(idgtreal_fb)(coef2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, f);
-
-    ltfat_free(coef2);
+error:
+    if (p) LTFAT_NAME(idwilt_fb_done)(&p);
+    return status;
 }
 
 #undef CH
@@ -25,23 +25,60 @@ struct LTFAT_NAME(upconv_fftbl_plan_struct)
     LTFAT_NAME_REAL(fft_plan)* p_c;
     LTFAT_COMPLEX* buf;
     ltfat_int bufLen;
+    LTFAT_COMPLEX* Gconj;
 };
 
+/* F is split to chunks of this many samples, each of which is owned by
+ * a single thread during the accumulation. */
+#define IFILTERBANK_CHUNK 1024
+
 LTFAT_API void
 LTFAT_NAME(ifilterbank_fft)(const LTFAT_COMPLEX* cin[],
                             const LTFAT_COMPLEX* G[],
                             ltfat_int L, ltfat_int W, ltfat_int a[],
                             ltfat_int M, LTFAT_COMPLEX* F)
 {
-    // This is necessary since F us used as an accumulator
-    memset(F, 0, L * W * sizeof * F);
+    LTFAT_NAME(upconv_fft_plan)* p = LTFAT_NEWARRAY(LTFAT_NAME(upconv_fft_plan), M);
+    int do_batch = p != NULL;
 
-    for (ltfat_int m = 0; m < M; m++)
+    for (ltfat_int m = 0; m < M && do_batch; m++)
+        do_batch = (p[m] = LTFAT_NAME(upconv_fft_init)(L, W, a[m])) != NULL;
+
+    if (do_batch)
     {
-        LTFAT_NAME(upconv_fft)(cin[m], G[m], L, W, a[m], F);
+        LTFAT_NAME(ifilterbank_fft_execute)(p, cin, G, M, F);
+    }
+    else
+    {
+        /* Not enough memory for the plans of all filters at once,
+         * fall back to processing the filters one by one. */
+        for (ltfat_int l = 0; l < L * W; l++) F[l] = 0.0;
+        for (ltfat_int m = 0; m < M; m++)
+            LTFAT_NAME(upconv_fft)(cin[m], G[m], L, W, a[m], F);
+    }
+
+    if (p)
+    {
+        for (ltfat_int m = 0; m < M; m++)
+            if (p[m]) LTFAT_NAME(upconv_fft_done)(p[m]);
+        ltfat_free(p);
     }
 }
 
+static void
+LTFAT_NAME(upconv_fft_transform)(LTFAT_NAME(upconv_fft_plan) p,
+                                 const LTFAT_COMPLEX* cin);
+
+static void
+LTFAT_NAME(upconv_fft_accumulate)(LTFAT_NAME(upconv_fft_plan) p,
+                                  const LTFAT_COMPLEX* G,
+                                  ltfat_int l0, ltfat_int l1, LTFAT_COMPLEX* F);
+
+/* The filters are processed in two phases. First, the coefficients of all
+ * the subbands are transformed in parallel. Then, each thread accumulates
+ * contributions of all filters to its own range of F. The contributions are
+ * added in the order of filters, so the result is bit-identical for any
+ * number of threads and there is no false sharing on F. */
 LTFAT_API void
 LTFAT_NAME(ifilterbank_fft_execute)(LTFAT_NAME(upconv_fft_plan) p[],
                                     const LTFAT_COMPLEX* cin[],
@@ -51,12 +88,25 @@ LTFAT_NAME(ifilterbank_fft_execute)(LTFAT_NAME(upconv_fft_plan) p[],
 {
     ltfat_int L = p[0]->L;
     ltfat_int W = p[0]->W;
+    ltfat_int nchunks = ltfat_idivceil(L, IFILTERBANK_CHUNK);
     // This is necessary since F us used as an accumulator
     memset(F, 0, W * L * sizeof * F);
 
-    for (ltfat_int m = 0; m < M; m++)
+    LTFAT_OMP(parallel)
     {
-        LTFAT_NAME(upconv_fft_execute)(p[m], cin[m], G[m], F);
+        LTFAT_OMP(for schedule(dynamic))
+        for (ltfat_int m = 0; m < M; m++)
+            LTFAT_NAME(upconv_fft_transform)(p[m], cin[m]);
+
+        LTFAT_OMP(for schedule(static))
+        for (ltfat_int c = 0; c < nchunks; c++)
+        {
+            ltfat_int l0 = c * IFILTERBANK_CHUNK;
+            ltfat_int l1 = ltfat_imin(L, l0 + IFILTERBANK_CHUNK);
+
+            for (ltfat_int m = 0; m < M; m++)
+                LTFAT_NAME(upconv_fft_accumulate)(p[m], G[m], l0, l1, F);
+        }
     }
 }
 
@@ -69,6 +119,7 @@ LTFAT_NAME(upconv_fft)(const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
 {
     LTFAT_NAME(upconv_fft_plan) p =
         LTFAT_NAME(upconv_fft_init)(L, W, a);
+    if (!p) return;
 
     LTFAT_NAME(upconv_fft_execute)(p, cin, G, F);
 
@@ -80,8 +131,12 @@ LTFAT_NAME(upconv_fft_init)(ltfat_int L, ltfat_int W,
                             ltfat_int a)
 {
     ltfat_int N = L / a;
+    LTFAT_NAME(upconv_fft_plan) p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_COMPLEX* buf = LTFAT_NAME_COMPLEX(malloc)(W * N);
+    CHECKMEM( p = LTFAT_NEW(struct LTFAT_NAME(upconv_fft_plan_struct)) );
+    p->L = L; p->a = a; p->W = W; p->bufLen = W * N;
+    CHECKMEM( p->buf = LTFAT_NAME_COMPLEX(malloc)(W * N) );
 
     /* LTFAT_FFTW(iodim64) dims; */
     /* dims.n = N; dims.is = 1; dims.os = 1; */
@@ -94,60 +149,69 @@ LTFAT_NAME(upconv_fft_init)(ltfat_int L, ltfat_int W,
     /*                                 (LTFAT_FFTW(complex)*) buf, */
     /*                                 FFTW_FORWARD, FFTW_ESTIMATE); */
 
-    LTFAT_NAME_REAL(fft_plan)* p_many;
-    LTFAT_NAME_REAL(fft_init)(N, W, buf, buf, FFTW_ESTIMATE, &p_many);
-
-    /* struct LTFAT_NAME(upconv_fft_plan_struct) p_struct = */
-    /* { .L = L, .a = a, .W = W, .p_c = p_many, .buf = buf, .bufLen = W * N }; */
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fft_init)(N, W, p->buf, p->buf, FFTW_ESTIMATE, &p->p_c));
 
-    LTFAT_NAME(upconv_fft_plan) p =
-        (LTFAT_NAME(upconv_fft_plan))ltfat_malloc( sizeof * p);
-    p->L = L; p->a = a; p->W = W; p->p_c = p_many; p->buf = buf; p->bufLen = W * N;
-    /* memcpy(p, &p_struct, sizeof * p); */
     return p;
+error:
+    if (p)
+    {
+        ltfat_safefree(p->buf);
+        ltfat_free(p);
+    }
+    return NULL;
 }
 
 
-LTFAT_API void
-LTFAT_NAME(upconv_fft_execute)(LTFAT_NAME(upconv_fft_plan) p,
-                               const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
-                               LTFAT_COMPLEX* F)
+static void
+LTFAT_NAME(upconv_fft_transform)(LTFAT_NAME(upconv_fft_plan) p,
+                                 const LTFAT_COMPLEX* cin)
 {
-    ltfat_int L = p->L;
-    ltfat_int a = p->a;
-    ltfat_int W = p->W;
-    LTFAT_COMPLEX* buf = p->buf;
-    ltfat_int N = L / a;
-    memcpy(buf, cin, W * N * sizeof * cin);
-
+    ltfat_int N = p->L / p->a;
+    memcpy(p->buf, cin, p->W * N * sizeof * cin);
 
     // New array execution, inplace
-    /* LTFAT_FFTW(execute_dft)(p->p_c, */
-    /*                         (LTFAT_FFTW(complex)*) buf, */
-    /*                         (LTFAT_FFTW(complex)*) buf); */
-    LTFAT_NAME_REAL(fft_execute_newarray)(p->p_c, buf, buf);
+    LTFAT_NAME_REAL(fft_execute_newarray)(p->p_c, p->buf, p->buf);
+}
 
-    for (ltfat_int w = 0; w < W; w++)
+/* Adds contribution of the transformed coefficients to F[l0:l1-1] */
+static void
+LTFAT_NAME(upconv_fft_accumulate)(LTFAT_NAME(upconv_fft_plan) p,
+                                  const LTFAT_COMPLEX* G,
+                                  ltfat_int l0, ltfat_int l1, LTFAT_COMPLEX* F)
+{
+    ltfat_int L = p->L;
+    ltfat_int N = L / p->a;
+
+    for (ltfat_int w = 0; w < p->W; w++)
     {
         LTFAT_COMPLEX* FPtr = F + w * L;
-        LTFAT_COMPLEX* GPtr = (LTFAT_COMPLEX*) G;
-        for (ltfat_int jj = 0; jj < a; jj++)
+        const LTFAT_COMPLEX* bufPtr = p->buf + N * w;
+
+        for (ltfat_int l = l0, ii = l0 % N; l < l1; l++)
         {
-            for (ltfat_int ii = 0; ii < N; ii++)
-            {
-                // Really readable ;)
-                *FPtr++ += conj(*GPtr++) * buf[ii + N * w];
-            }
+            FPtr[l] += conj(G[l]) * bufPtr[ii];
+            if (++ii == N) ii = 0;
         }
     }
 }
 
+LTFAT_API void
+LTFAT_NAME(upconv_fft_execute)(LTFAT_NAME(upconv_fft_plan) p,
+                               const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
+                               LTFAT_COMPLEX* F)
+{
+    LTFAT_NAME(upconv_fft_transform)(p, cin);
+    LTFAT_NAME(upconv_fft_accumulate)(p, G, 0, p->L, F);
+}
+
 LTFAT_API void
 LTFAT_NAME(upconv_fft_done)(LTFAT_NAME(upconv_fft_plan) p)
 {
     /* LTFAT_FFTW(destroy_plan)(p->p_c); */
     LTFAT_NAME_REAL(fft_done)(&p->p_c);
     ltfat_free(p->buf);
+    ltfat_free(p);
 }
 
 
@@ -159,16 +223,47 @@ LTFAT_NAME(ifilterbank_fftbl)(const LTFAT_COMPLEX* cin[],
                               const ltfat_int foff[], const int realonly[],
                               LTFAT_COMPLEX* F)
 {
-    // This is necessary since F us used as an accumulator
-    memset(F, 0, W * L * sizeof * F);
+    LTFAT_NAME(upconv_fftbl_plan)* p =
+        LTFAT_NEWARRAY(LTFAT_NAME(upconv_fftbl_plan), M);
+    int do_batch = p != NULL;
+
+    for (ltfat_int m = 0; m < M && do_batch; m++)
+        do_batch = (p[m] = LTFAT_NAME(upconv_fftbl_init)(L, Gl[m], W, a[m])) != NULL;
+
+    if (do_batch)
+    {
+        LTFAT_NAME(ifilterbank_fftbl_execute)(p, cin, G, M, (ltfat_int*) foff,
+                                              realonly, F);
+    }
+    else
+    {
+        /* See ifilterbank_fft */
+        for (ltfat_int l = 0; l < L * W; l++) F[l] = 0.0;
+        for (ltfat_int m = 0; m < M; m++)
+            LTFAT_NAME(upconv_fftbl)(cin[m], G[m], L, Gl[m], W, a[m], foff[m],
+                                     realonly[m], F);
+    }
 
-    for (ltfat_int m = 0; m < M; m++)
+    if (p)
     {
-        LTFAT_NAME(upconv_fftbl)(cin[m], G[m], L, Gl[m], W, a[m], foff[m],
-                                 realonly[m], F);
+        for (ltfat_int m = 0; m < M; m++)
+            if (p[m]) LTFAT_NAME(upconv_fftbl_done)(p[m]);
+        ltfat_free(p);
     }
 }
 
+static void
+LTFAT_NAME(upconv_fftbl_transform)(const LTFAT_NAME(upconv_fftbl_plan) p,
+                                   const LTFAT_COMPLEX* cin,
+                                   const LTFAT_COMPLEX* G, const int realonly);
+
+static void
+LTFAT_NAME(upconv_fftbl_accumulate)(const LTFAT_NAME(upconv_fftbl_plan) p,
+                                    const LTFAT_COMPLEX* G, ltfat_int foff,
+                                    const int realonly,
+                                    ltfat_int l0, ltfat_int l1, LTFAT_COMPLEX* F);
+
+/* See ifilterbank_fft_execute */
 LTFAT_API void
 LTFAT_NAME(ifilterbank_fftbl_execute)(LTFAT_NAME(upconv_fftbl_plan) p[],
                                       const LTFAT_COMPLEX* cin[],
@@ -179,16 +274,31 @@ LTFAT_NAME(ifilterbank_fftbl_execute)(LTFAT_NAME(upconv_fftbl_plan) p[],
 {
     ltfat_int L = p[0]->L;
     ltfat_int W = p[0]->W;
+    ltfat_int nchunks = ltfat_idivceil(L, IFILTERBANK_CHUNK);
     // This is necessary since F us used as an accumulator
     memset(F, 0, W * L * sizeof * F);
 
-    for (ltfat_int m = 0; m < M; m++)
+    LTFAT_OMP(parallel)
     {
-        LTFAT_NAME(upconv_fftbl_execute)(p[m], cin[m], G[m], foff[m], realonly[m], F);
-    }
+        LTFAT_OMP(for schedule(dynamic))
+        for (ltfat_int m = 0; m < M; m++)
+            LTFAT_NAME(upconv_fftbl_transform)(p[m], cin[m], G[m], realonly[m]);
+
+        LTFAT_OMP(for schedule(static))
+        for (ltfat_int c = 0; c < nchunks; c++)
+        {
+            ltfat_int l0 = c * IFILTERBANK_CHUNK;
+            ltfat_int l1 = ltfat_imin(L, l0 + IFILTERBANK_CHUNK);
 
+            for (ltfat_int m = 0; m < M; m++)
+                LTFAT_NAME(upconv_fftbl_accumulate)(p[m], G[m], foff[m],
+                                                    realonly[m], l0, l1, F);
+        }
+    }
 }
 
+#undef IFILTERBANK_CHUNK
+
 
 LTFAT_API void
 LTFAT_NAME(upconv_fftbl)(const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
@@ -199,6 +309,7 @@ LTFAT_NAME(upconv_fftbl)(const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
 {
     LTFAT_NAME(upconv_fftbl_plan) p =
         LTFAT_NAME(upconv_fftbl_init)( L, Gl, W, a);
+    if (!p) return;
 
     LTFAT_NAME(upconv_fftbl_execute)(p, cin, G, foff, realonly, F);
 
@@ -210,9 +321,14 @@ LTFAT_NAME(upconv_fftbl_init)( ltfat_int L, ltfat_int Gl,
                                ltfat_int W, const double a)
 {
     ltfat_int N = (ltfat_int) floor(L / a + 0.5);
-    ltfat_int bufLen =  N > Gl ? N : Gl ;
+    ltfat_int bufLen = N;
+    LTFAT_NAME(upconv_fftbl_plan) p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_COMPLEX* buf = LTFAT_NAME_COMPLEX(malloc)(bufLen * W);
+    CHECKMEM( p = LTFAT_NEW(struct LTFAT_NAME(upconv_fftbl_plan_struct)) );
+    p->L = L; p->Gl = Gl; p->a = a; p->W = W; p->bufLen = bufLen;
+    CHECKMEM( p->buf = LTFAT_NAME_COMPLEX(malloc)(bufLen * W) );
+    if (Gl) CHECKMEM( p->Gconj = LTFAT_NAME_COMPLEX(malloc)(Gl) );
 
     /* LTFAT_FFTW(iodim64) dims; */
     /* dims.n = N; dims.is = 1; dims.os = 1; */
@@ -225,112 +341,112 @@ LTFAT_NAME(upconv_fftbl_init)( ltfat_int L, ltfat_int Gl,
     /*                                 (LTFAT_FFTW(complex)*)buf, */
     /*                                 FFTW_FORWARD, FFTW_ESTIMATE); */
 
-    LTFAT_NAME_REAL(fft_plan)* p_many;
-    LTFAT_NAME_REAL(fft_init)(N, W, buf, buf, FFTW_ESTIMATE, &p_many);
-
-    /* struct LTFAT_NAME(upconv_fftbl_plan_struct) p_struct = */
-    /* { */
-    /*     .L = L, .Gl = Gl, .a = a, .W = W, */
-    /*     .p_c = p_many, .buf = buf, .bufLen = bufLen */
-    /* }; */
-
-    LTFAT_NAME(upconv_fftbl_plan) p =
-        (LTFAT_NAME(upconv_fftbl_plan)) ltfat_malloc(sizeof * p);
-    p->L = L; p->Gl = Gl; p->a = a; p->W = W;
-    p->p_c = p_many; p->buf = buf; p->bufLen = bufLen;
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fft_init)(N, W, p->buf, p->buf, FFTW_ESTIMATE, &p->p_c));
 
-    /* memcpy(p, &p_struct, sizeof * p); */
     return p;
+error:
+    if (p)
+    {
+        ltfat_safefree(p->buf);
+        ltfat_safefree(p->Gconj);
+        ltfat_free(p);
+    }
+    return NULL;
 }
 
 
-LTFAT_API void
-LTFAT_NAME(upconv_fftbl_execute)(const LTFAT_NAME(upconv_fftbl_plan) p,
-                                 const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
-                                 ltfat_int foff,
-                                 const int realonly, LTFAT_COMPLEX* F)
+static void
+LTFAT_NAME(upconv_fftbl_transform)(const LTFAT_NAME(upconv_fftbl_plan) p,
+                                   const LTFAT_COMPLEX* cin,
+                                   const LTFAT_COMPLEX* G, const int realonly)
 {
-    ltfat_int Gl = p->Gl;
-    if (!Gl) return; // Bail out if filter has zero bandwidth
-    ltfat_int bufLen = p->bufLen;
-    ltfat_int L = p->L;
-    ltfat_int W = p->W;
-    const double a = p->a;
-    LTFAT_COMPLEX* cbuf = p->buf;
+    ltfat_int N = (ltfat_int) floor(p->L / p->a + 0.5);
+    if (!p->Gl) return; // Bail out if filter has zero bandwidth
 
-    ltfat_int N = (ltfat_int) floor(L / a + 0.5);
-
-    for (ltfat_int w = 0; w < W; w++)
-        memcpy(cbuf + w * bufLen, cin + w * N, N * sizeof * cin);
+    // The FFT plan expects the channels to be stored contiguously
+    memcpy(p->buf, cin, p->W * N * sizeof * cin);
 
-    /* LTFAT_FFTW(execute_dft)(p->p_c, (LTFAT_FFTW(complex)*)cbuf, */
-    /*                         (LTFAT_FFTW(complex)*)cbuf); */
-    LTFAT_NAME_REAL(fft_execute_newarray)(p->p_c, cbuf, cbuf);
+    LTFAT_NAME_REAL(fft_execute_newarray)(p->p_c, p->buf, p->buf);
 
-    for (ltfat_int w = 0; w < W; w++)
+    if (realonly)
     {
+        // Involuted filter
+        LTFAT_NAME_COMPLEX(reverse_array)(G, p->Gl, p->Gconj);
+        LTFAT_NAME_COMPLEX(conjugate_array)(p->Gconj, p->Gl, p->Gconj);
+    }
+}
 
-        LTFAT_NAME_COMPLEX(circshift)(cbuf + w * bufLen, N, -foff, cbuf + w * bufLen);
-        // This does nothing if bufLen == N
-        LTFAT_NAME_COMPLEX(periodize_array)(cbuf + w * bufLen, N, bufLen,
-                                            cbuf + w * bufLen);
+/* Adds contribution of a band of Gl samples starting at foff (modulo L)
+ * to F[l0:l1-1]. The band wraps around, therefore it is processed in
+ * (at most) two segments. */
+static void
+LTFAT_NAME(upconv_fftbl_accumulate_band)(const LTFAT_NAME(upconv_fftbl_plan) p,
+        const LTFAT_COMPLEX* G, ltfat_int foff,
+        ltfat_int l0, ltfat_int l1, LTFAT_COMPLEX* F)
+{
+    ltfat_int L = p->L;
+    ltfat_int Gl = p->Gl;
+    ltfat_int N = (ltfat_int) floor(L / p->a + 0.5);
+    ltfat_int start = ltfat_positiverem(foff, L);
+    // Segments as [first sample, last sample + 1, index in G of the first sample]
+    ltfat_int seg[2][3] =
+    {
+        { start, ltfat_imin(start + Gl, L), 0 },
+        { 0, start + Gl - L, L - start }
+    };
 
-        const LTFAT_COMPLEX* GPtrTmp = G;
-        LTFAT_COMPLEX* FPtrTmp = F + w * L;
-        LTFAT_COMPLEX* CPtrTmp = cbuf + w * bufLen;
-        ltfat_int Gltmp = Gl;
+    for (ltfat_int s = 0; s < 2; s++)
+    {
+        ltfat_int lo = ltfat_imax(seg[s][0], l0);
+        ltfat_int hi = ltfat_imin(seg[s][1], l1);
+        if (lo >= hi) continue;
 
-        // Determine range of G
-        ltfat_int foffTmp = foff;
+        ltfat_int ii0 = seg[s][2] + lo - seg[s][0];
 
-        ltfat_int over = 0;
-        if (foffTmp + Gltmp > (ltfat_int)L)
+        for (ltfat_int w = 0; w < p->W; w++)
         {
-            over = foffTmp + Gltmp - (ltfat_int)L;
-        }
+            LTFAT_COMPLEX* FPtr = F + w * L;
+            const LTFAT_COMPLEX* CPtr = p->buf + w * N;
+            ltfat_int cidx = ltfat_positiverem(ii0 + foff, N);
 
-
-        if (foffTmp < 0)
-        {
-            ltfat_int toCopy = (-foffTmp) < Gltmp ? -foffTmp : Gltmp;
-            FPtrTmp = F + (w + 1) * L + foffTmp;
-            for (ltfat_int ii = 0; ii < toCopy; ii++)
+            for (ltfat_int l = lo, ii = ii0; l < hi; l++, ii++)
             {
-                LTFAT_COMPLEX tmp = *CPtrTmp++ * conj(*GPtrTmp++);
-                FPtrTmp[ii] += tmp;
+                FPtr[l] += CPtr[cidx] * conj(G[ii]);
+                if (++cidx == N) cidx = 0;
             }
-
-            Gltmp -= toCopy;
-            foffTmp = 0;
-        }
-
-        FPtrTmp = F + w * L + foffTmp;
-        for (ltfat_int ii = 0; ii < Gltmp - over; ii++)
-        {
-            LTFAT_COMPLEX tmp = *CPtrTmp++ * conj(*GPtrTmp++);
-            FPtrTmp[ii] += tmp;
-        }
-
-        FPtrTmp = F + w * L;
-        for (ltfat_int ii = 0; ii < over; ii++)
-        {
-            LTFAT_COMPLEX tmp = (*CPtrTmp++ * conj(*GPtrTmp++));
-            FPtrTmp[ii] += tmp;
         }
     }
+}
 
+/* Adds contribution of the transformed coefficients to F[l0:l1-1] */
+static void
+LTFAT_NAME(upconv_fftbl_accumulate)(const LTFAT_NAME(upconv_fftbl_plan) p,
+                                    const LTFAT_COMPLEX* G, ltfat_int foff,
+                                    const int realonly,
+                                    ltfat_int l0, ltfat_int l1, LTFAT_COMPLEX* F)
+{
+    ltfat_int L = p->L;
+    ltfat_int Gl = p->Gl;
+    if (!Gl) return; // Bail out if filter has zero bandwidth
+
+    LTFAT_NAME(upconv_fftbl_accumulate_band)(p, G, foff, l0, l1, F);
 
     if (realonly)
     {
         ltfat_int foffconj = -L + ltfat_positiverem(L - foff - Gl, L) + 1;
-        LTFAT_COMPLEX* Gconj = LTFAT_NAME_COMPLEX(malloc)(Gl);
-        LTFAT_NAME_COMPLEX(reverse_array)(G, Gl, Gconj);
-        LTFAT_NAME_COMPLEX(conjugate_array)(Gconj, Gl, Gconj);
-
-        LTFAT_NAME(upconv_fftbl_execute)(p, cin, Gconj, foffconj, 0, F);
-        ltfat_free(Gconj);
+        LTFAT_NAME(upconv_fftbl_accumulate_band)(p, p->Gconj, foffconj, l0, l1, F);
     }
+}
 
+LTFAT_API void
+LTFAT_NAME(upconv_fftbl_execute)(const LTFAT_NAME(upconv_fftbl_plan) p,
+                                 const LTFAT_COMPLEX* cin, const LTFAT_COMPLEX* G,
+                                 ltfat_int foff,
+                                 const int realonly, LTFAT_COMPLEX* F)
+{
+    LTFAT_NAME(upconv_fftbl_transform)(p, cin, G, realonly);
+    LTFAT_NAME(upconv_fftbl_accumulate)(p, G, foff, realonly, 0, p->L, F);
 }
 
 
@@ -340,4 +456,6 @@ LTFAT_NAME(upconv_fftbl_done)(LTFAT_NAME(upconv_fftbl_plan) p)
     /* LTFAT_FFTW(destroy_plan)(p->p_c); */
     LTFAT_NAME_REAL(fft_done)(&p->p_c);
     if (p->buf) ltfat_free(p->buf);
+    if (p->Gconj) ltfat_free(p->Gconj);
+    ltfat_free(p);
 }
@@ -135,6 +135,28 @@ ltfat_dgtlengthmulti(ltfat_int Ls, ltfat_int P, ltfat_int a[], ltfat_int M[])
     return nminL * minL;
 }
 
+LTFAT_API ltfat_int
+ltfat_nsdgtlength(const ltfat_int a[], ltfat_int N)
+{
+    ltfat_int L = 0;
+
+    for (ltfat_int n = 0; n < N; n++)
+        L += a[n];
+
+    return L;
+}
+
+LTFAT_API ltfat_int
+ltfat_nsdgtreal_coefsize(const ltfat_int M[], ltfat_int N)
+{
+    ltfat_int Ctot = 0;
+
+    for (ltfat_int n = 0; n < N; n++)
+        Ctot += M[n] / 2 + 1;
+
+    return Ctot;
+}
+
 
 LTFAT_API void
 gabimagepars(ltfat_int Ls, ltfat_int x, ltfat_int y,
@@ -2,6 +2,8 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+#include "ltfat/thirdparty/fftw3.h"
+
 
 #define CH(name) LTFAT_COMPLEXH(name)
 
@@ -99,7 +101,7 @@ LTFAT_NAME_REAL(idwiltiii_long)(const LTFAT_REAL* c, const LTFAT_REAL* g,
 
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_COMPLEX(idwiltiii_fb)(const LTFAT_COMPLEX* c, const LTFAT_COMPLEX* g,
                                  ltfat_int L, ltfat_int gl,
                                  ltfat_int W, ltfat_int M,
@@ -121,43 +123,35 @@ LTFAT_NAME_COMPLEX(idwiltiii_fb)(const LTFAT_COMPLEX* c, const LTFAT_COMPLEX* g,
 
     PREPROC_COMPLEX
 
-    LTFAT_NAME_COMPLEX(idgt_fb)(coef2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, f2);
+    int status =
+        LTFAT_NAME_COMPLEX(idgt_fb)(coef2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, f2);
 
-    POSTPROC_COMPLEX
+    if (status == LTFATERR_SUCCESS)
+    {
+        POSTPROC_COMPLEX
+    }
 
     LTFAT_SAFEFREEALL(coef2, f2);
-
+    return status;
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_REAL(idwiltiii_fb)(const LTFAT_REAL* c, const LTFAT_REAL* g,
                               ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int M,
                               LTFAT_REAL* f)
 {
-    ltfat_int N = L / M;
-    ltfat_int M2 = 2 * M;
-    ltfat_int M4 = 4 * M;
-    const LTFAT_REAL scalconst = (LTFAT_REAL)( 1.0 / sqrt(2.0) );
-    const LTFAT_COMPLEX eipi4 =  exp( I * (LTFAT_REAL)(M_PI / 4.0));
-    const LTFAT_COMPLEX emipi4 = exp(-I * (LTFAT_REAL)(M_PI / 4.0));
+    LTFAT_NAME(iwmdct_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_COMPLEX* coef2 = LTFAT_NAME_COMPLEX(calloc)(2 * M * N * W);
-    LTFAT_COMPLEX* f2 = LTFAT_NAME_COMPLEX(malloc)(L * W);
-    LTFAT_COMPLEX* g2 = LTFAT_NAME_COMPLEX(malloc)(gl);
-    for (ltfat_int ii = 0; ii < gl; ii++)
-        g2[ii] = g[ii];
-
-
-    const LTFAT_REAL* pcoef  = c;
-    LTFAT_COMPLEX* pcoef2 = coef2;
+    CHECKSTATUS(
+        LTFAT_NAME(iwmdct_fb_init)(g, gl, M, FFTW_ESTIMATE, &p));
 
-    PREPROC_COMPLEX
-
-    LTFAT_NAME_COMPLEX(idgt_fb)(coef2, g2, L, gl, W, M, 2 * M, LTFAT_FREQINV, f2);
+    CHECKSTATUS(
+        LTFAT_NAME(iwmdct_fb_execute)(p, c, L, W, f));
 
-    POSTPROC_REAL
-
-    LTFAT_SAFEFREEALL(coef2, f2, g2);
+error:
+    if (p) LTFAT_NAME(iwmdct_fb_done)(&p);
+    return status;
 }
 
 #undef CH
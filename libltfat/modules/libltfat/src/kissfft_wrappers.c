@@ -452,3 +452,31 @@ LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p)
 {
     return LTFAT_NAME(fftreal_done)((LTFAT_NAME(fftreal_plan)**) p);
 }
+
+/****** Wisdom ******/
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_import)(const char* UNUSED(filename))
+{
+    int status = LTFATERR_SUCCESS;
+    CHECK(LTFATERR_NOTSUPPORTED, 0, "Wisdom is not supported by the KISS FFT backend.");
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_export)(const char* UNUSED(filename))
+{
+    int status = LTFATERR_SUCCESS;
+    CHECK(LTFATERR_NOTSUPPORTED, 0, "Wisdom is not supported by the KISS FFT backend.");
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_wisdom_forget)(void)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECK(LTFATERR_NOTSUPPORTED, 0, "Wisdom is not supported by the KISS FFT backend.");
+error:
+    return status;
+}
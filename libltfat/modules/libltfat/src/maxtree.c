@@ -2,11 +2,15 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+/* The tree is B-ary, B=LTFAT_MAXTREE_BRANCHING. Level depth are the leaves
+ * i.e. the input array, level 0 is the top level which is searched linearly.
+ * Each node holds maximum of its (at most) B children and the position of the
+ * corresponding leaf. Children of one node are stored contiguously and every
+ * level starts at an aligned address. */
 struct LTFAT_NAME(maxtree)
 {
     ltfat_int dirtystart;
     ltfat_int dirtyend;
-    LTFAT_REAL*  pointedarray;
     LTFAT_REAL*  treeVals;
     LTFAT_REAL** treePtrs;
     ltfat_int*   treePos;
@@ -14,9 +18,7 @@ struct LTFAT_NAME(maxtree)
     ltfat_int    depth;
     ltfat_int    L;
     ltfat_int    Lstep;
-    ltfat_int    nextL;
     ltfat_int*   levelL;
-    ltfat_int    W;
     int is_complexinput;
     LTFAT_NAME(maxtree_complexinput_callback)* callback;
     void* userdata;
@@ -42,7 +44,7 @@ LTFAT_NAME(maxtree_init)(
     LTFAT_NAME(maxtree)** pout)
 {
     LTFAT_NAME(maxtree)* p = NULL;
-    ltfat_int nextL, granL, cumL;
+    ltfat_int levels, Llevel, cumL;
     int status = LTFATERR_SUCCESS;
 
     CHECK(LTFATERR_NOTPOSARG, L > 0,
@@ -50,29 +52,34 @@ LTFAT_NAME(maxtree_init)(
     CHECK(LTFATERR_BADARG, depth >= 0,
           "depth must be zero or greater (passed %td)", depth);
 
-    granL = 1 << (depth);
-
-    while ( granL > 2 * L )
-        granL = 1 << (--depth);
-
-    nextL = granL * ((L + granL - 1 ) / granL);
+    /* depth is the maximum number of levels. There is no point in having
+     * more levels once the top level fits into a single node. */
+    levels = 0; Llevel = L;
+    while ( levels < depth && Llevel > 1 )
+    {
+        Llevel = ltfat_idivceil(Llevel, LTFAT_MAXTREE_BRANCHING);
+        levels++;
+        if ( Llevel <= LTFAT_MAXTREE_BRANCHING ) break;
+    }
+    depth = levels;
 
     CHECKMEM( p = LTFAT_NEW( LTFAT_NAME(maxtree)) );
     CHECKMEM( p->levelL = LTFAT_NEWARRAY(ltfat_int, depth + 1) );
     CHECKMEM( p->treePtrs = LTFAT_NEWARRAY(LTFAT_REAL*, depth + 1) );
 
     p->levelL[depth] = L;
-    for (ltfat_int d = 1; d < depth + 1; d++)
-    {
-        ltfat_int Llevel = ltfat_idivceil(L, 1 << (d));
-        p->levelL[depth - d] = Llevel + Llevel%2;
-    }
+    for (ltfat_int d = depth - 1; d >= 0; d--)
+        p->levelL[d] = ltfat_idivceil(p->levelL[d + 1], LTFAT_MAXTREE_BRANCHING);
 
     if (depth > 0)
     {
+        cumL = 0;
+        for (ltfat_int d = 0; d < depth; d++)
+            cumL += LTFAT_MAXTREE_BRANCHING *
+                    ltfat_idivceil(p->levelL[d], LTFAT_MAXTREE_BRANCHING);
 
-        CHECKMEM( p->treeVals = LTFAT_NAME_REAL(calloc)( nextL ));
-        CHECKMEM( p->treePos = LTFAT_NEWARRAY(ltfat_int, nextL ) );
+        CHECKMEM( p->treeVals = LTFAT_NAME_REAL(calloc)( cumL ));
+        CHECKMEM( p->treePos = LTFAT_NEWARRAY(ltfat_int, cumL ) );
         CHECKMEM( p->treePosPtrs = LTFAT_NEWARRAY(ltfat_int*, depth ) );
 
         cumL = 0;
@@ -80,11 +87,12 @@ LTFAT_NAME(maxtree_init)(
         {
             p->treePosPtrs[d] = p->treePos + cumL;
             p->treePtrs[d] = p->treeVals + cumL;
-            cumL += p->levelL[d];
+            cumL += LTFAT_MAXTREE_BRANCHING *
+                    ltfat_idivceil(p->levelL[d], LTFAT_MAXTREE_BRANCHING);
         }
     }
 
-    p->depth = depth; p->L = L; p->nextL = nextL; p->Lstep = Lstep;
+    p->depth = depth; p->L = L; p->Lstep = Lstep;
 
     p->dirtystart = p->Lstep;
     p->dirtyend   = 0;
@@ -186,123 +194,111 @@ LTFAT_NAME(maxtree_updatedirty)(LTFAT_NAME(maxtree)* p)
     return ret;
 }
 
-int
-LTFAT_NAME(maxtree_updaterange)(LTFAT_NAME(maxtree)* p, ltfat_int start,
-                                ltfat_int end)
+/* Maximum and its (first) position in an array of length len.
+ * Both loops are simple enough to be vectorized. */
+static inline void
+LTFAT_NAME(maxtree_blockmax)(const LTFAT_REAL* LTFAT_RESTRICT in,
+                             ltfat_int len, LTFAT_REAL* max, ltfat_int* maxPos)
 {
-    if (p->depth == 0) return 0;
+    LTFAT_REAL m = in[0];
 
-    if (end > p->Lstep)
-    {
-        ltfat_int over = end - p->Lstep;
-        LTFAT_NAME(maxtree_updaterange)( p, 0, over);
-    }
+    LTFAT_OMP(simd reduction(max:m))
+    for (ltfat_int l = 1; l < len; l++)
+        m = in[l] > m ? in[l] : m;
 
-    if (end > p->L) end = p->L;
-    if (start >= end) return 0;
+    ltfat_int l = 0;
+    while ( l < len - 1 && in[l] != m ) l++;
 
-    ltfat_int parity = 0;
-    parity =  end == p->L ? end % 2 : 0;
-    start = start - start % 2;
-    end   = end   + end % 2;
-    start = start >> 1; end = end >> 1;
+    *max = m; *maxPos = l;
+}
 
-    LTFAT_REAL* treeVal = p->treePtrs[p->depth];
-    LTFAT_REAL* treeValnext = p->treePtrs[p->depth - 1];
-    ltfat_int* treePosnext = p->treePosPtrs[p->depth - 1];
+/* Values of leaves start,...,start+len-1, len<=LTFAT_MAXTREE_BRANCHING */
+static inline void
+LTFAT_NAME(maxtree_leafvals)(LTFAT_NAME(maxtree)* p, ltfat_int start,
+                             ltfat_int len, LTFAT_REAL* LTFAT_RESTRICT out)
+{
+    const LTFAT_REAL* LTFAT_RESTRICT leafs = p->treePtrs[p->depth];
+
+    if (!p->is_complexinput)
+        memcpy(out, leafs + start, len * sizeof * out);
+    else if (p->callback)
+        for (ltfat_int l = 0; l < len; l++)
+            out[l] = p->callback(p->userdata,
+                                 *((LTFAT_COMPLEX*)&leafs[2 * (start + l)]), start + l);
+    else
+    {
+        leafs += 2 * start;
+        LTFAT_OMP(simd)
+        for (ltfat_int l = 0; l < len; l++)
+            out[l] = leafs[2 * l] * leafs[2 * l] + leafs[2 * l + 1] * leafs[2 * l + 1];
+    }
+}
 
-    ltfat_int endmpar = end - parity - start;
-    ltfat_int newl = start - 1;
+/* Updates max with the maximum of nodes start,...,end-1 of level d.
+ * maxPos<0 means no maximum was found yet. */
+static void
+LTFAT_NAME(maxtree_scanlevel)(LTFAT_NAME(maxtree)* p, ltfat_int d,
+                              ltfat_int start, ltfat_int end,
+                              LTFAT_REAL* max, ltfat_int* maxPos)
+{
+    LTFAT_REAL valTmp; ltfat_int posTmp;
 
-    for (ltfat_int l = 0; l < endmpar; l++)
+    if ( d == p->depth )
     {
-        newl++;
-        ltfat_int twol = newl << 1;
-        ltfat_int twolp1 = twol + 1;
-        LTFAT_REAL tv1, tv2;
-        if (p->is_complexinput)
+        LTFAT_REAL buf[LTFAT_MAXTREE_BRANCHING];
+        for (ltfat_int l = start; l < end; l += LTFAT_MAXTREE_BRANCHING)
         {
-            if(p->callback)
-            {
-                tv1 = p->callback(p->userdata, *((LTFAT_COMPLEX*)&treeVal[2 * twol]), twol);
-                tv2 = p->callback(p->userdata, *((LTFAT_COMPLEX*)&treeVal[2 * twolp1]), twolp1);
-            }
-            else
+            ltfat_int len = ltfat_imin(LTFAT_MAXTREE_BRANCHING, end - l);
+            LTFAT_NAME(maxtree_leafvals)(p, l, len, buf);
+            LTFAT_NAME(maxtree_blockmax)(buf, len, &valTmp, &posTmp);
+            if ( *maxPos < 0 || valTmp > *max )
             {
-                tv1 = treeVal[2 * twol] * treeVal[2 * twol] +
-                      treeVal[2 * twol + 1] * treeVal[2 * twol + 1];
-                tv2 = treeVal[2 * twolp1] * treeVal[2 * twolp1] +
-                      treeVal[2 * twolp1 + 1] * treeVal[2 * twolp1 + 1];
+                *max = valTmp; *maxPos = l + posTmp;
             }
         }
-        else
-        {
-            tv1 = treeVal[twol];
-            tv2 = treeVal[twolp1];
-        }
-
-        if ( tv1 > tv2)
-        {
-            treeValnext[newl] = tv1;
-            treePosnext[newl] = twol;
-        }
-        else
-        {
-            treeValnext[newl] = tv2;
-            treePosnext[newl] = twolp1;
-        }
     }
-
-    if ( parity )
+    else if ( end > start )
     {
-        ltfat_int lastl = 2 * (end - 1);
-        if (p->is_complexinput)
+        LTFAT_NAME(maxtree_blockmax)(p->treePtrs[d] + start, end - start,
+                                     &valTmp, &posTmp);
+        if ( *maxPos < 0 || valTmp > *max )
         {
-            if(p->callback)
-                treeValnext[end - 1] =
-                    p->callback(p->userdata, *((LTFAT_COMPLEX*)&treeVal[2 * lastl]), lastl);
-            else
-                treeValnext[end - 1] =
-                    treeVal[2 * lastl] * treeVal[2 * lastl] +
-                    treeVal[2 * lastl + 1] * treeVal[2 * lastl + 1];
+            *max = valTmp; *maxPos = p->treePosPtrs[d][start + posTmp];
         }
-        else
-            treeValnext[end - 1] = treeVal[lastl];
-
-        treePosnext[end - 1] = 2 * (end - 1);
     }
+}
 
-    for (ltfat_int d = p->depth - 1; d > 0; d--)
+int
+LTFAT_NAME(maxtree_updaterange)(LTFAT_NAME(maxtree)* p, ltfat_int start,
+                                ltfat_int end)
+{
+    if (p->depth == 0) return 0;
+
+    if (end > p->Lstep)
     {
-        start = start - start % 2;
-        end   = end   + end % 2;
-        start = start >> 1; end = end >> 1;
+        ltfat_int over = end - p->Lstep;
+        LTFAT_NAME(maxtree_updaterange)( p, 0, over);
+    }
 
-        LTFAT_REAL* treeVal     = p->treePtrs[d];
-        LTFAT_REAL* treeValnext = p->treePtrs[d - 1];
-        ltfat_int* treePos      = p->treePosPtrs[d];
-        ltfat_int* treePosnext  = p->treePosPtrs[d - 1];
+    if (end > p->L) end = p->L;
+    if (start >= end) return 0;
 
-        ltfat_int endmpar = end - start;
-        ltfat_int newl = start - 1;
+    for (ltfat_int d = p->depth - 1; d >= 0; d--)
+    {
+        ltfat_int Lchild = p->levelL[d + 1];
+        start = start / LTFAT_MAXTREE_BRANCHING;
+        end   = ltfat_idivceil(end, LTFAT_MAXTREE_BRANCHING);
 
-        for (ltfat_int l = 0; l < endmpar; l++)
+        LTFAT_REAL* treeVal = p->treePtrs[d];
+        ltfat_int*  treePos = p->treePosPtrs[d];
+
+        for (ltfat_int l = start; l < end; l++)
         {
-            newl++;
-            ltfat_int twol = newl << 1;
-            ltfat_int twolp1 = twol + 1;
-            LTFAT_REAL tv1 = treeVal[twol];
-            LTFAT_REAL tv2 = treeVal[twolp1];
-            if ( tv1 > tv2)
-            {
-                treeValnext[newl] = tv1;
-                treePosnext[newl] = treePos[twol];
-            }
-            else
-            {
-                treeValnext[newl] = tv2;
-                treePosnext[newl] = treePos[twolp1];
-            }
+            ltfat_int cstart = l * LTFAT_MAXTREE_BRANCHING;
+            ltfat_int cend = ltfat_imin(cstart + LTFAT_MAXTREE_BRANCHING, Lchild);
+            treePos[l] = -1;
+            LTFAT_NAME(maxtree_scanlevel)(p, d + 1, cstart, cend,
+                                          &treeVal[l], &treePos[l]);
         }
     }
 
@@ -315,10 +311,43 @@ LTFAT_NAME(maxtree_findmax)(LTFAT_NAME(maxtree)* p, LTFAT_REAL* max,
 {
     LTFAT_NAME(maxtree_updatedirty)(p);
 
-    LTFAT_NAME_REAL(findmaxinarray)(p->treePtrs[0], p->levelL[0],
-                                    max, maxPos);
-
-    if (p->depth > 0)
-        *maxPos = p->treePos[*maxPos];
+    *maxPos = -1;
+    LTFAT_NAME(maxtree_scanlevel)(p, 0, 0, p->levelL[0], max, maxPos);
     return 0;
 }
+
+LTFAT_API int
+LTFAT_NAME(maxtree_findmaxinrange)(LTFAT_NAME(maxtree)* p, ltfat_int start,
+                                   ltfat_int end, LTFAT_REAL* max,
+                                   ltfat_int* maxPos)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int d;
+    CHECKNULL(p); CHECKNULL(max); CHECKNULL(maxPos);
+    CHECK(LTFATERR_BADARG, start >= 0 && start < end && end <= p->L,
+          "Invalid range [%td,%td)", start, end);
+
+    LTFAT_NAME(maxtree_updatedirty)(p);
+
+    *maxPos = -1;
+
+    // Scan the incomplete blocks at both ends of the range and move
+    // one level up with the rest.
+    for (d = p->depth; d > 0; d--)
+    {
+        ltfat_int startUp = ltfat_idivceil(start, LTFAT_MAXTREE_BRANCHING);
+        ltfat_int endUp = end / LTFAT_MAXTREE_BRANCHING;
+        if ( startUp >= endUp ) break;
+
+        LTFAT_NAME(maxtree_scanlevel)(p, d, start,
+                                      startUp * LTFAT_MAXTREE_BRANCHING, max, maxPos);
+        LTFAT_NAME(maxtree_scanlevel)(p, d, endUp * LTFAT_MAXTREE_BRANCHING,
+                                      end, max, maxPos);
+        start = startUp; end = endUp;
+    }
+
+    LTFAT_NAME(maxtree_scanlevel)(p, d, start, end, max, maxPos);
+
+error:
+    return status;
+}
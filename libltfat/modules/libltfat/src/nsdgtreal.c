@@ -0,0 +1,493 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+
+struct LTFAT_NAME(nsdgtreal_plan)
+{
+    ltfat_int N;
+    ltfat_int L;
+    ltfat_int* timepos;
+    ltfat_int* gl;
+    ltfat_int* M;
+    ltfat_int* coff;
+    LTFAT_REAL** gw;
+    // FFT plans are shared among windows with equal M
+    ltfat_int P;
+    ltfat_int* pidx;
+    LTFAT_NAME_REAL(fftreal_plan)** p;
+    LTFAT_REAL*    sbuf;
+    LTFAT_COMPLEX* cbuf;
+};
+
+struct LTFAT_NAME(insdgtreal_plan)
+{
+    ltfat_int N;
+    ltfat_int L;
+    ltfat_int* timepos;
+    ltfat_int* gl;
+    ltfat_int* M;
+    ltfat_int* coff;
+    LTFAT_REAL** gw;
+    ltfat_int P;
+    ltfat_int* pidx;
+    LTFAT_NAME_REAL(ifftreal_plan)** p;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL*    crbuf;
+};
+
+/* Checks parameters of the non-stationary system and returns its length */
+static int
+LTFAT_NAME(nsdgtreal_checkpars)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                                const ltfat_int a[], const ltfat_int M[],
+                                ltfat_int N, ltfat_int* Lout)
+{
+    ltfat_int L;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(M);
+    CHECK(LTFATERR_NOTPOSARG, N > 0, "N (passed %td) must be positive.", N);
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECK(LTFATERR_NULLPOINTER, g[n] != NULL, "g[%td] is a null-pointer.", n);
+        CHECK(LTFATERR_BADARG, a[n] >= 0, "a[%td] (passed %td) must be nonnegative.",
+              n, a[n]);
+        CHECK(LTFATERR_NOTPOSARG, M[n] > 0, "M[%td] (passed %td) must be positive.",
+              n, M[n]);
+    }
+
+    L = ltfat_nsdgtlength(a, N);
+    CHECK(LTFATERR_BADARG, L > 0, "Sum of a must be positive.");
+
+    for (ltfat_int n = 0; n < N; n++)
+        CHECK(LTFATERR_BADSIZE, gl[n] > 0 && gl[n] <= L,
+              "gl[%td] (passed %td) must be positive and not longer than L=%td.",
+              n, gl[n], L);
+
+    *Lout = L;
+error:
+    return status;
+}
+
+/* Fills in the time positions, coefficient offsets and assigns the windows
+ * to the unique FFT lengths. Muniq must have length N. Returns the number of
+ * the unique FFT lengths. */
+static ltfat_int
+LTFAT_NAME(nsdgtreal_layout)(const ltfat_int a[], const ltfat_int M[],
+                             ltfat_int N, ltfat_int timepos[], ltfat_int coff[],
+                             ltfat_int pidx[], ltfat_int Muniq[])
+{
+    ltfat_int P = 0;
+
+    timepos[0] = 0;
+    coff[0] = 0;
+    for (ltfat_int n = 1; n < N; n++)
+    {
+        timepos[n] = timepos[n - 1] + a[n];
+        coff[n] = coff[n - 1] + M[n - 1] / 2 + 1;
+    }
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        ltfat_int pId = 0;
+        while (pId < P && Muniq[pId] != M[n]) pId++;
+
+        if (pId == P) Muniq[P++] = M[n];
+
+        pidx[n] = pId;
+    }
+
+    return P;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal)(const LTFAT_REAL f[], const LTFAT_REAL* g[],
+                      const ltfat_int gl[], const ltfat_int a[],
+                      const ltfat_int M[], ltfat_int N,
+                      ltfat_int L, ltfat_int W, LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(nsdgtreal_plan)* plan = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(nsdgtreal_init)(g, gl, a, M, N, FFTW_ESTIMATE, &plan));
+
+    CHECKSTATUS(
+        LTFAT_NAME(nsdgtreal_execute)(plan, f, L, W, c));
+
+error:
+    if (plan) LTFAT_NAME(nsdgtreal_done)(&plan);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                           unsigned flags, LTFAT_NAME(nsdgtreal_plan)** pout)
+{
+    LTFAT_NAME(nsdgtreal_plan)* plan = NULL;
+    ltfat_int* Muniq = NULL;
+    ltfat_int L, Mmax;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_checkpars)(g, gl, a, M, N, &L));
+
+    CHECKMEM( plan = LTFAT_NEW(LTFAT_NAME(nsdgtreal_plan)) );
+    plan->N = N;
+    plan->L = L;
+
+    CHECKMEM( plan->timepos = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->gl      = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->M       = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->coff    = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->pidx    = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->gw      = LTFAT_NEWARRAY(LTFAT_REAL*, N));
+    CHECKMEM( Muniq         = LTFAT_NEWARRAY(ltfat_int, N));
+
+    memcpy(plan->gl, gl, N * sizeof * gl);
+    memcpy(plan->M, M, N * sizeof * M);
+
+    plan->P = LTFAT_NAME(nsdgtreal_layout)(a, M, N, plan->timepos, plan->coff,
+                                           plan->pidx, Muniq);
+
+    Mmax = Muniq[0];
+    for (ltfat_int pId = 1; pId < plan->P; pId++)
+        Mmax = ltfat_imax(Mmax, Muniq[pId]);
+
+    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)(Mmax));
+    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(Mmax / 2 + 1));
+    CHECKMEM( plan->p = LTFAT_NEWARRAY(LTFAT_NAME_REAL(fftreal_plan)*, plan->P));
+
+    for (ltfat_int pId = 0; pId < plan->P; pId++)
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fftreal_init)(Muniq[pId], 1, plan->sbuf, plan->cbuf,
+                                          flags, &plan->p[pId]));
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECKMEM( plan->gw[n] = LTFAT_NAME_REAL(malloc)(gl[n]));
+        LTFAT_NAME_REAL(fftshift)(g[n], gl[n], plan->gw[n]);
+    }
+
+    ltfat_free(Muniq);
+    *pout = plan;
+    return status;
+error:
+    ltfat_safefree(Muniq);
+    if (plan) LTFAT_NAME(nsdgtreal_done)(&plan);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_done)(LTFAT_NAME(nsdgtreal_plan)** plan)
+{
+    LTFAT_NAME(nsdgtreal_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    pp = *plan;
+
+    if (pp->p)
+    {
+        for (ltfat_int pId = 0; pId < pp->P; pId++)
+            if (pp->p[pId]) LTFAT_NAME_REAL(fftreal_done)(&pp->p[pId]);
+    }
+
+    if (pp->gw)
+    {
+        for (ltfat_int n = 0; n < pp->N; n++)
+            ltfat_safefree(pp->gw[n]);
+    }
+
+    LTFAT_SAFEFREEALL(pp->timepos, pp->gl, pp->M, pp->coff, pp->pidx, pp->gw,
+                      pp->p, pp->sbuf, pp->cbuf);
+    ltfat_free(pp);
+    *plan = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_execute)(LTFAT_NAME(nsdgtreal_plan)* plan,
+                              const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                              LTFAT_COMPLEX c[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADTRALEN, L == plan->L,
+          "L (passed %td) must be equal to the sum of a (%td).", L, plan->L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    for (ltfat_int n = 0; n < plan->N; n++)
+    {
+        ltfat_int M = plan->M[n];
+        ltfat_int M2 = M / 2 + 1;
+        ltfat_int gl = plan->gl[n];
+        /* This is a floor operation. */
+        ltfat_int glh = gl / 2;
+        LTFAT_COMPLEX* cwin = c + W * plan->coff[n];
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            /* The window is centered at timepos and the phase is
+             * relative to the window center */
+            LTFAT_NAME(windowfold_array)(f + w * L, L, plan->timepos[n] - glh,
+                                         plan->gw[n], gl, -glh, M, plan->sbuf);
+
+            LTFAT_NAME_REAL(fftreal_execute)(plan->p[plan->pidx[n]]);
+            memcpy(cwin + w * M2, plan->cbuf, M2 * sizeof * c);
+        }
+    }
+
+error:
+    return status;
+}
+
+/* ------------------- INSDGTREAL ---------------------- */
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal)(const LTFAT_COMPLEX c[], const LTFAT_REAL* g[],
+                       const ltfat_int gl[], const ltfat_int a[],
+                       const ltfat_int M[], ltfat_int N,
+                       ltfat_int L, ltfat_int W, LTFAT_REAL f[])
+{
+    LTFAT_NAME(insdgtreal_plan)* plan = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(insdgtreal_init)(g, gl, a, M, N, FFTW_ESTIMATE, &plan));
+
+    CHECKSTATUS(
+        LTFAT_NAME(insdgtreal_execute)(plan, c, L, W, f));
+
+error:
+    if (plan) LTFAT_NAME(insdgtreal_done)(&plan);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                            const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                            unsigned flags, LTFAT_NAME(insdgtreal_plan)** pout)
+{
+    LTFAT_NAME(insdgtreal_plan)* plan = NULL;
+    ltfat_int* Muniq = NULL;
+    ltfat_int L, Mmax;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_checkpars)(g, gl, a, M, N, &L));
+
+    CHECKMEM( plan = LTFAT_NEW(LTFAT_NAME(insdgtreal_plan)) );
+    plan->N = N;
+    plan->L = L;
+
+    CHECKMEM( plan->timepos = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->gl      = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->M       = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->coff    = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->pidx    = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( plan->gw      = LTFAT_NEWARRAY(LTFAT_REAL*, N));
+    CHECKMEM( Muniq         = LTFAT_NEWARRAY(ltfat_int, N));
+
+    memcpy(plan->gl, gl, N * sizeof * gl);
+    memcpy(plan->M, M, N * sizeof * M);
+
+    plan->P = LTFAT_NAME(nsdgtreal_layout)(a, M, N, plan->timepos, plan->coff,
+                                           plan->pidx, Muniq);
+
+    Mmax = Muniq[0];
+    for (ltfat_int pId = 1; pId < plan->P; pId++)
+        Mmax = ltfat_imax(Mmax, Muniq[pId]);
+
+    CHECKMEM( plan->cbuf  = LTFAT_NAME_COMPLEX(malloc)(Mmax / 2 + 1));
+    CHECKMEM( plan->crbuf = LTFAT_NAME_REAL(malloc)(Mmax));
+    CHECKMEM( plan->p = LTFAT_NEWARRAY(LTFAT_NAME_REAL(ifftreal_plan)*, plan->P));
+
+    for (ltfat_int pId = 0; pId < plan->P; pId++)
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(ifftreal_init)(Muniq[pId], 1, plan->cbuf, plan->crbuf,
+                                           flags, &plan->p[pId]));
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECKMEM( plan->gw[n] = LTFAT_NAME_REAL(malloc)(gl[n]));
+        LTFAT_NAME_REAL(fftshift)(g[n], gl[n], plan->gw[n]);
+    }
+
+    ltfat_free(Muniq);
+    *pout = plan;
+    return status;
+error:
+    ltfat_safefree(Muniq);
+    if (plan) LTFAT_NAME(insdgtreal_done)(&plan);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_done)(LTFAT_NAME(insdgtreal_plan)** plan)
+{
+    LTFAT_NAME(insdgtreal_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    pp = *plan;
+
+    if (pp->p)
+    {
+        for (ltfat_int pId = 0; pId < pp->P; pId++)
+            if (pp->p[pId]) LTFAT_NAME_REAL(ifftreal_done)(&pp->p[pId]);
+    }
+
+    if (pp->gw)
+    {
+        for (ltfat_int n = 0; n < pp->N; n++)
+            ltfat_safefree(pp->gw[n]);
+    }
+
+    LTFAT_SAFEFREEALL(pp->timepos, pp->gl, pp->M, pp->coff, pp->pidx, pp->gw,
+                      pp->p, pp->cbuf, pp->crbuf);
+    ltfat_free(pp);
+    *plan = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_execute)(LTFAT_NAME(insdgtreal_plan)* plan,
+                               const LTFAT_COMPLEX c[], ltfat_int L, ltfat_int W,
+                               LTFAT_REAL f[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_BADTRALEN, L == plan->L,
+          "L (passed %td) must be equal to the sum of a (%td).", L, plan->L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    memset(f, 0, L * W * sizeof * f);
+
+    for (ltfat_int n = 0; n < plan->N; n++)
+    {
+        ltfat_int M = plan->M[n];
+        ltfat_int M2 = M / 2 + 1;
+        ltfat_int gl = plan->gl[n];
+        /* This is a floor operation. */
+        ltfat_int glh = gl / 2;
+        const LTFAT_REAL* gw = plan->gw[n];
+        const LTFAT_REAL* crbuf = plan->crbuf;
+        const LTFAT_COMPLEX* cwin = c + W * plan->coff[n];
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            LTFAT_REAL* fw = f + w * L;
+            ltfat_int fIdx = ltfat_positiverem(plan->timepos[n] - glh, L);
+            ltfat_int cIdx = ltfat_positiverem(-glh, M);
+
+            memcpy(plan->cbuf, cwin + w * M2, M2 * sizeof * c);
+            LTFAT_NAME_REAL(ifftreal_execute)(plan->p[plan->pidx[n]]);
+
+            /* Periodize the M samples to the window length, window them
+             * and add them to f at the window position. The runs neither
+             * wrap around the end of f nor around the end of crbuf. */
+            for (ltfat_int l = 0; l < gl;)
+            {
+                ltfat_int run = gl - l;
+                if (L - fIdx < run) run = L - fIdx;
+                if (M - cIdx < run) run = M - cIdx;
+
+                for (ltfat_int ii = 0; ii < run; ii++)
+                    fw[fIdx + ii] += crbuf[cIdx + ii] * gw[l + ii];
+
+                l += run;
+                fIdx += run;
+                cIdx += run;
+                if (fIdx == L) fIdx = 0;
+                if (cIdx == M) cIdx = 0;
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+/* ------------------- NSGABDUAL ---------------------- */
+
+LTFAT_API int
+LTFAT_NAME(nsgabframediag)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                           ltfat_int L, LTFAT_REAL d[])
+{
+    ltfat_int Lsys, timepos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(d);
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_checkpars)(g, gl, a, M, N, &Lsys));
+    CHECK(LTFATERR_BADTRALEN, L == Lsys,
+          "L (passed %td) must be equal to the sum of a (%td).", L, Lsys);
+
+    memset(d, 0, L * sizeof * d);
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        /* This is a ceil operation. */
+        ltfat_int glh2 = (gl[n] + 1) / 2;
+
+        if (n > 0) timepos += a[n];
+
+        /* Window is zero-centered, the second half belongs to
+         * negative time indices */
+        for (ltfat_int ii = 0; ii < gl[n]; ii++)
+        {
+            ltfat_int k = ii < glh2 ? ii : ii - gl[n];
+            ltfat_int dIdx = ltfat_positiverem(timepos + k, L);
+            d[dIdx] += M[n] * g[n][ii] * g[n][ii];
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsgabdual_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+                               LTFAT_REAL* gd[])
+{
+    LTFAT_REAL* d = NULL;
+    ltfat_int L, timepos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(gd);
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_checkpars)(g, gl, a, M, N, &L));
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECK(LTFATERR_NULLPOINTER, gd[n] != NULL, "gd[%td] is a null-pointer.", n);
+        CHECK(LTFATERR_NOTPAINLESS, gl[n] <= M[n],
+              "Not painless. Check if gl[%td] <= M[%td] (passed %td, %td).",
+              n, n, gl[n], M[n]);
+    }
+
+    CHECKMEM( d = LTFAT_NAME_REAL(malloc)(L));
+    CHECKSTATUS( LTFAT_NAME(nsgabframediag)(g, gl, a, M, N, L, d));
+
+    for (ltfat_int l = 0; l < L; l++)
+        CHECK(LTFATERR_NOTAFRAME, d[l] > 0,
+              "Not a frame. The frame diagonal is zero at %td.", l);
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        /* This is a ceil operation. */
+        ltfat_int glh2 = (gl[n] + 1) / 2;
+
+        if (n > 0) timepos += a[n];
+
+        for (ltfat_int ii = 0; ii < gl[n]; ii++)
+        {
+            ltfat_int k = ii < glh2 ? ii : ii - gl[n];
+            ltfat_int dIdx = ltfat_positiverem(timepos + k, L);
+            gd[n][ii] = g[n][ii] / d[dIdx];
+        }
+    }
+
+error:
+    ltfat_safefree(d);
+    return status;
+}
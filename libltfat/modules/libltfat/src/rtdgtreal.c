@@ -17,9 +17,10 @@ struct LTFAT_NAME(rtdgtreal_plan)
     ltfat_int gl; //!< Window length
     ltfat_int M; //!< Number of FFT channels
     rtdgt_phasetype ptype; //!< Phase convention
-    LTFAT_REAL* fftBuf; //!< Internal buffer
-    LTFAT_COMPLEX* fftBuf_cpx; //!< Internal buffer
-    ltfat_int fftBufLen; //!< Internal buffer length
+    ltfat_int Wmax; //!< Number of channels in one FFT batch
+    rtdgt_layout layout; //!< Coefficient layout
+    LTFAT_REAL* fftBuf; //!< Internal buffer, M x Wmax
+    LTFAT_COMPLEX* fftBuf_cpx; //!< Internal buffer, M2 x Wmax
     LTFAT_NAME_REAL(fftreal_plan)*  pfft;
     LTFAT_NAME_REAL(ifftreal_plan)* pifft;
 };
@@ -28,6 +29,7 @@ int
 LTFAT_NAME(rtdgtreal_commoninit)(const LTFAT_REAL* g, ltfat_int gl,
                                  ltfat_int M, const rtdgt_phasetype ptype,
                                  const ltfat_transformdirection tradir,
+                                 ltfat_int Wmax, const rtdgt_layout layout,
                                  LTFAT_NAME(rtdgtreal_plan)** pout)
 {
     ltfat_int M2;
@@ -36,30 +38,35 @@ LTFAT_NAME(rtdgtreal_commoninit)(const LTFAT_REAL* g, ltfat_int gl,
     int status = LTFATERR_FAILED;
     CHECK(LTFATERR_NOTPOSARG, gl > 0, "gl must be positive");
     CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_NOTPOSARG, Wmax > 0, "Wmax must be positive");
+    CHECK(LTFATERR_CANNOTHAPPEN, layout == LTFAT_RTDGTLAYOUT_CHANMAJOR ||
+          layout == LTFAT_RTDGTLAYOUT_FREQMAJOR, "Unknown layout.");
 
     CHECKMEM( p = LTFAT_NEW( LTFAT_NAME(rtdgtreal_plan) ));
 
     M2 = M / 2 + 1;
-    p->fftBufLen = gl > 2 * M2 ? gl : 2 * M2;
 
     CHECKMEM( p->g = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( p->fftBuf =     LTFAT_NAME_REAL(malloc)(p->fftBufLen));
-    CHECKMEM( p->fftBuf_cpx = LTFAT_NAME_COMPLEX(malloc)(M2));
+    CHECKMEM( p->fftBuf =     LTFAT_NAME_REAL(malloc)(Wmax * M));
+    CHECKMEM( p->fftBuf_cpx = LTFAT_NAME_COMPLEX(malloc)(Wmax * M2));
     p->gl = gl;
     p->M = M;
     p->ptype = ptype;
+    p->Wmax = Wmax;
+    p->layout = layout;
 
     LTFAT_NAME_REAL(fftshift)(g, gl, p->g);
 
+    // One batched FFT covers all Wmax channels
     if (LTFAT_FORWARD == tradir)
     {
-        LTFAT_NAME_REAL(fftreal_init)(M, 1, p->fftBuf, p->fftBuf_cpx,
+        LTFAT_NAME_REAL(fftreal_init)(M, Wmax, p->fftBuf, p->fftBuf_cpx,
                                       FFTW_MEASURE, &p->pfft);
         CHECKINIT(p->pfft, "FFTW plan creation failed.");
     }
     else if (LTFAT_INVERSE == tradir)
     {
-        LTFAT_NAME_REAL(ifftreal_init)(M, 1, p->fftBuf_cpx, p->fftBuf,
+        LTFAT_NAME_REAL(ifftreal_init)(M, Wmax, p->fftBuf_cpx, p->fftBuf,
                                        FFTW_MEASURE, &p->pifft);
         CHECKINIT(p->pifft, "FFTW plan creation failed.");
     }
@@ -79,7 +86,18 @@ LTFAT_NAME(rtdgtreal_init)(const LTFAT_REAL* g, ltfat_int gl,
                            ltfat_int M, const rtdgt_phasetype ptype,
                            LTFAT_NAME(rtdgtreal_plan)** p)
 {
-    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_FORWARD, p);
+    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_FORWARD,
+                                            1, LTFAT_RTDGTLAYOUT_CHANMAJOR, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_init_batch)(const LTFAT_REAL* g, ltfat_int gl,
+                                 ltfat_int M, const rtdgt_phasetype ptype,
+                                 ltfat_int Wmax, const rtdgt_layout layout,
+                                 LTFAT_NAME(rtdgtreal_plan)** p)
+{
+    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_FORWARD,
+                                            Wmax, layout, p);
 }
 
 LTFAT_API int
@@ -87,7 +105,18 @@ LTFAT_NAME(rtidgtreal_init)(const LTFAT_REAL* g, ltfat_int gl,
                             ltfat_int M, const rtdgt_phasetype ptype,
                             LTFAT_NAME(rtdgtreal_plan)** p)
 {
-    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_INVERSE, p);
+    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_INVERSE,
+                                            1, LTFAT_RTDGTLAYOUT_CHANMAJOR, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtidgtreal_init_batch)(const LTFAT_REAL* g, ltfat_int gl,
+                                  ltfat_int M, const rtdgt_phasetype ptype,
+                                  ltfat_int Wmax, const rtdgt_layout layout,
+                                  LTFAT_NAME(rtdgtreal_plan)** p)
+{
+    return LTFAT_NAME(rtdgtreal_commoninit)(g, gl, M, ptype, LTFAT_INVERSE,
+                                            Wmax, layout, p);
 }
 
 LTFAT_API int
@@ -95,7 +124,7 @@ LTFAT_NAME(rtdgtreal_execute)(const LTFAT_NAME(rtdgtreal_plan)* p,
                               const LTFAT_REAL* f, ltfat_int W,
                               LTFAT_COMPLEX* c)
 {
-    ltfat_int M, M2, gl;
+    ltfat_int M, M2, gl, shift;
     LTFAT_REAL* fftBuf;
     LTFAT_COMPLEX* fftBuf_cpx;
     int status = LTFATERR_FAILED;
@@ -107,28 +136,35 @@ LTFAT_NAME(rtdgtreal_execute)(const LTFAT_NAME(rtdgtreal_plan)* p,
     gl = p->gl;
     fftBuf = p->fftBuf;
     fftBuf_cpx = p->fftBuf_cpx;
+    shift = p->ptype == LTFAT_RTDGTPHASE_ZERO ? -(gl / 2) : 0;
 
-    for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wmax)
     {
-        const LTFAT_REAL* fchan = f + w * gl;
-        LTFAT_COMPLEX* cchan = c + w * M2;
-
-        if (p->g)
-            for (ltfat_int ii = 0; ii < gl; ii++)
-                fftBuf[ii] = fchan[ii] * p->g[ii];
+        ltfat_int Wb = W - w0 < p->Wmax ? W - w0 : p->Wmax;
 
-        if (M > gl)
-            memset(fftBuf + gl, 0, (M - gl) * sizeof * fftBuf);
+        // Window, fold to M and apply the phase convention in one pass
+        for (ltfat_int w = 0; w < Wb; w++)
+            LTFAT_NAME_REAL(windowfold_array)(f + (w0 + w) * gl, gl, 0,
+                                              p->g, gl, shift, M, fftBuf + w * M);
 
-        if (gl > M)
-            LTFAT_NAME_REAL(fold_array)(fftBuf, gl, M, 0, fftBuf);
-
-        if (p->ptype == LTFAT_RTDGTPHASE_ZERO)
-            LTFAT_NAME_REAL(circshift)(fftBuf, M, -(gl / 2), fftBuf );
+        if (Wb < p->Wmax)
+            memset(fftBuf + Wb * M, 0, (p->Wmax - Wb) * M * sizeof * fftBuf);
 
         LTFAT_NAME_REAL(fftreal_execute)(p->pfft);
 
-        memcpy(cchan, fftBuf_cpx, M2 * sizeof * c);
+        if (p->layout == LTFAT_RTDGTLAYOUT_CHANMAJOR)
+        {
+            memcpy(c + w0 * M2, fftBuf_cpx, Wb * M2 * sizeof * c);
+        }
+        else
+        {
+            for (ltfat_int m = 0; m < M2; m++)
+            {
+                LTFAT_COMPLEX* cfreq = c + w0 + m * W;
+                for (ltfat_int w = 0; w < Wb; w++)
+                    cfreq[w] = fftBuf_cpx[m + w * M2];
+            }
+        }
     }
 
     return LTFATERR_SUCCESS;
@@ -149,7 +185,7 @@ LTFAT_NAME(rtidgtreal_execute)(const LTFAT_NAME(rtidgtreal_plan)* p,
                                const LTFAT_COMPLEX* c, ltfat_int W,
                                LTFAT_REAL* f)
 {
-    ltfat_int M, M2, gl;
+    ltfat_int M, M2, gl, shift;
     LTFAT_REAL* fftBuf;
     LTFAT_COMPLEX* fftBuf_cpx;
     int status = LTFATERR_FAILED;
@@ -161,27 +197,50 @@ LTFAT_NAME(rtidgtreal_execute)(const LTFAT_NAME(rtidgtreal_plan)* p,
     gl = p->gl;
     fftBuf = p->fftBuf;
     fftBuf_cpx = p->fftBuf_cpx;
+    shift = p->ptype == LTFAT_RTDGTPHASE_ZERO ? gl / 2 : 0;
 
-    for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wmax)
     {
-        const LTFAT_COMPLEX* cchan = c + w * M2;
-        LTFAT_REAL* fchan = f + w * gl;
-
-        memcpy(fftBuf_cpx, cchan, M2 * sizeof * cchan);
+        ltfat_int Wb = W - w0 < p->Wmax ? W - w0 : p->Wmax;
+
+        if (p->layout == LTFAT_RTDGTLAYOUT_CHANMAJOR)
+        {
+            memcpy(fftBuf_cpx, c + w0 * M2, Wb * M2 * sizeof * c);
+        }
+        else
+        {
+            for (ltfat_int m = 0; m < M2; m++)
+            {
+                const LTFAT_COMPLEX* cfreq = c + w0 + m * W;
+                for (ltfat_int w = 0; w < Wb; w++)
+                    fftBuf_cpx[m + w * M2] = cfreq[w];
+            }
+        }
+
+        for (ltfat_int l = Wb * M2; l < p->Wmax * M2; l++)
+            fftBuf_cpx[l] = 0.0;
 
         LTFAT_NAME_REAL(ifftreal_execute)(p->pifft);
 
-        if (p->ptype == LTFAT_RTDGTPHASE_ZERO)
-            LTFAT_NAME_REAL(circshift)(fftBuf, M, gl / 2, fftBuf );
-
-        if (gl > M)
-            LTFAT_NAME_REAL(periodize_array)(fftBuf, M , gl, fftBuf);
-
-        if (p->g)
-            for (ltfat_int ii = 0; ii < gl; ii++)
-                fftBuf[ii] *= p->g[ii];
-
-        memcpy(fchan, fftBuf, gl * sizeof * fchan);
+        // Undo the phase convention, periodize to gl and apply the window
+        // in one pass: fchan[l] = fftBuf[(l - shift) mod M]*g[l]
+        for (ltfat_int w = 0; w < Wb; w++)
+        {
+            const LTFAT_REAL* bufchan = fftBuf + w * M;
+            LTFAT_REAL* fchan = f + (w0 + w) * gl;
+            ltfat_int idx = ltfat_positiverem(-shift, M);
+
+            for (ltfat_int l = 0; l < gl; )
+            {
+                ltfat_int run = M - idx < gl - l ? M - idx : gl - l;
+
+                for (ltfat_int ii = 0; ii < run; ii++)
+                    fchan[l + ii] = bufchan[idx + ii] * p->g[l + ii];
+
+                l += run;
+                idx = 0;
+            }
+        }
     }
 
     return LTFATERR_SUCCESS;
@@ -280,7 +339,7 @@ LTFAT_NAME(rtdgtreal_processor_init)(const LTFAT_REAL* ga, ltfat_int gal,
     CHECKMEM(
         p->fftbufOut = LTFAT_NAME_COMPLEX(malloc)( numChans * (M / 2 + 1)));
 
-    CHECKMEM( p->buf = LTFAT_NAME_REAL(malloc)( numChans * gal));
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(malloc)( numChans * (gal > gsl ? gal : gsl)));
     CHECKMEM( p->inTmp =  LTFAT_NEWARRAY(const LTFAT_REAL*, numChans));
     CHECKMEM( p->outTmp = LTFAT_NEWARRAY(LTFAT_REAL*, numChans));
 
@@ -291,11 +350,14 @@ LTFAT_NAME(rtdgtreal_processor_init)(const LTFAT_REAL* ga, ltfat_int gal,
     CHECKSTATUS(
         LTFAT_NAME(synthesis_fifo_init)(bufLenMax + gsl, gsl, a, numChans, &p->backfifo));
 
-    CHECKSTATUS( LTFAT_NAME(rtdgtreal_init)(ga, gal, M, LTFAT_RTDGTPHASE_ZERO,
-                                            &p->fwdplan));
+    // All channels of one hop are transformed by a single batched FFT
+    CHECKSTATUS( LTFAT_NAME(rtdgtreal_init_batch)(ga, gal, M,
+                 LTFAT_RTDGTPHASE_ZERO, numChans, LTFAT_RTDGTLAYOUT_CHANMAJOR,
+                 &p->fwdplan));
 
-    CHECKSTATUS( LTFAT_NAME(rtidgtreal_init)(gs, gsl, M,
-                 LTFAT_RTDGTPHASE_ZERO, &p->backplan));
+    CHECKSTATUS( LTFAT_NAME(rtidgtreal_init_batch)(gs, gsl, M,
+                 LTFAT_RTDGTPHASE_ZERO, numChans, LTFAT_RTDGTLAYOUT_CHANMAJOR,
+                 &p->backplan));
 
     p->fwdtra = &LTFAT_NAME(rtdgtreal_execute_wrapper);
     p->backtra = &LTFAT_NAME(rtidgtreal_execute_wrapper);
@@ -407,6 +469,23 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_processor_setlayout)(
+    LTFAT_NAME(rtdgtreal_processor_state)* p, rtdgt_layout layout)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+    CHECK(LTFATERR_CANNOTHAPPEN, layout == LTFAT_RTDGTLAYOUT_CHANMAJOR ||
+          layout == LTFAT_RTDGTLAYOUT_FREQMAJOR, "Unknown layout.");
+
+    p->fwdplan->layout = layout;
+    p->backplan->layout = layout;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(rtdgtreal_processor_execute_compact)(
     LTFAT_NAME(rtdgtreal_processor_state)* p, const LTFAT_REAL* in,
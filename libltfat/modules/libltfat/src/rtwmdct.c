@@ -0,0 +1,535 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "ltfat/thirdparty/fftw3.h"
+#include "circularbuf_private.h"
+#include "wilson_fb_private.h"
+
+struct LTFAT_NAME(rtwmdct_plan)
+{
+    LTFAT_REAL* g; //!< Window
+    ltfat_int gl; //!< Window length
+    ltfat_int M; //!< Number of channels
+    ltfat_int Wmax; //!< Number of channels in one FFT batch
+    LTFAT_REAL* fbuf; //!< Folded frame, 4M
+    LTFAT_REAL* zbuf; //!< DCT work buffer, M+1
+    LTFAT_COMPLEX* tw; //!< Twiddle factors, M/2+1
+    LTFAT_REAL* fftBuf; //!< Internal buffer, M x Wmax
+    LTFAT_COMPLEX* fftBuf_cpx; //!< Internal buffer, M/2+1 x Wmax
+    LTFAT_NAME_REAL(ifftreal_plan)* pfft; //!< DCT-III of the analysis
+    LTFAT_NAME_REAL(fftreal_plan)* pifft; //!< DCT-II of the synthesis
+};
+
+static int
+LTFAT_NAME(rtwmdct_commoninit)(const LTFAT_REAL* g, ltfat_int gl, ltfat_int M,
+                               const ltfat_transformdirection tradir,
+                               ltfat_int Wmax, LTFAT_NAME(rtwmdct_plan)** pout)
+{
+    ltfat_int M2;
+    LTFAT_NAME(rtwmdct_plan)* p = NULL;
+
+    int status = LTFATERR_FAILED;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, gl > 0, "gl must be positive");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_NOTPOSARG, Wmax > 0, "Wmax must be positive");
+
+    CHECKMEM( p = LTFAT_NEW( LTFAT_NAME(rtwmdct_plan) ));
+
+    M2 = M / 2 + 1;
+
+    CHECKMEM( p->g = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->fbuf = LTFAT_NAME_REAL(malloc)(4 * M));
+    CHECKMEM( p->zbuf = LTFAT_NAME_REAL(malloc)(M + 1));
+    CHECKMEM( p->tw = LTFAT_NAME_COMPLEX(malloc)(M2));
+    CHECKMEM( p->fftBuf =     LTFAT_NAME_REAL(malloc)(Wmax * M));
+    CHECKMEM( p->fftBuf_cpx = LTFAT_NAME_COMPLEX(malloc)(Wmax * M2));
+    p->gl = gl;
+    p->M = M;
+    p->Wmax = Wmax;
+
+    LTFAT_NAME_REAL(fftshift)(g, gl, p->g);
+    LTFAT_NAME(wmdct_fb_twiddles)(M, p->tw);
+
+    if (LTFAT_FORWARD == tradir)
+    {
+        LTFAT_NAME_REAL(ifftreal_init)(M, Wmax, p->fftBuf_cpx, p->fftBuf,
+                                       FFTW_MEASURE, &p->pfft);
+        CHECKINIT(p->pfft, "FFTW plan creation failed.");
+    }
+    else if (LTFAT_INVERSE == tradir)
+    {
+        LTFAT_NAME_REAL(fftreal_init)(M, Wmax, p->fftBuf, p->fftBuf_cpx,
+                                      FFTW_MEASURE, &p->pifft);
+        CHECKINIT(p->pifft, "FFTW plan creation failed.");
+    }
+    else
+        CHECKCANTHAPPEN("Unknown transform direction.");
+
+    *pout = p;
+    return LTFATERR_SUCCESS;
+error:
+    if (p) LTFAT_NAME(rtwmdct_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                         ltfat_int Wmax, LTFAT_NAME(rtwmdct_plan)** p)
+{
+    return LTFAT_NAME(rtwmdct_commoninit)(g, gl, M, LTFAT_FORWARD, Wmax, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          ltfat_int Wmax, LTFAT_NAME(rtiwmdct_plan)** p)
+{
+    return LTFAT_NAME(rtwmdct_commoninit)(g, gl, M, LTFAT_INVERSE, Wmax, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_execute)(const LTFAT_NAME(rtwmdct_plan)* p,
+                            const LTFAT_REAL f[], ltfat_int n, ltfat_int W,
+                            LTFAT_REAL c[])
+{
+    ltfat_int M, M2, gl;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+
+    M = p->M;
+    M2 = M / 2 + 1;
+    gl = p->gl;
+
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wmax)
+    {
+        ltfat_int Wb = W - w0 < p->Wmax ? W - w0 : p->Wmax;
+
+        for (ltfat_int w = 0; w < Wb; w++)
+        {
+            LTFAT_NAME_REAL(windowfold_array)(f + (w0 + w) * gl, gl, 0,
+                                              p->g, gl, n * M - gl / 2,
+                                              4 * M, p->fbuf);
+            LTFAT_NAME(wmdct_fb_foldtodct)(M, n, p->tw, p->fbuf, p->zbuf,
+                                           p->fftBuf_cpx + w * M2);
+        }
+
+        for (ltfat_int l = Wb * M2; l < p->Wmax * M2; l++)
+            p->fftBuf_cpx[l] = 0.0;
+
+        LTFAT_NAME_REAL(ifftreal_execute)(p->pfft);
+
+        for (ltfat_int w = 0; w < Wb; w++)
+            LTFAT_NAME(wmdct_fb_postframe)(M, p->fftBuf + w * M,
+                                           c + (w0 + w) * M);
+    }
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_execute)(const LTFAT_NAME(rtiwmdct_plan)* p,
+                             const LTFAT_REAL c[], ltfat_int n, ltfat_int W,
+                             LTFAT_REAL f[])
+{
+    ltfat_int M, M2, gl;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+
+    M = p->M;
+    M2 = M / 2 + 1;
+    gl = p->gl;
+
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wmax)
+    {
+        ltfat_int Wb = W - w0 < p->Wmax ? W - w0 : p->Wmax;
+
+        for (ltfat_int w = 0; w < Wb; w++)
+            LTFAT_NAME(iwmdct_fb_preframe)(M, c + (w0 + w) * M,
+                                           p->fftBuf + w * M);
+
+        if (Wb < p->Wmax)
+            memset(p->fftBuf + Wb * M, 0,
+                   (p->Wmax - Wb) * M * sizeof * p->fftBuf);
+
+        LTFAT_NAME_REAL(fftreal_execute)(p->pifft);
+
+        // Unfold and apply the window:
+        // fchan[l] = fbuf[(n*M - gl/2 + l) mod 4M]*g[l]
+        for (ltfat_int w = 0; w < Wb; w++)
+        {
+            LTFAT_REAL* fchan = f + (w0 + w) * gl;
+            ltfat_int idx = ltfat_positiverem(n * M - gl / 2, 4 * M);
+
+            LTFAT_NAME(iwmdct_fb_dcttofold)(M, n, p->tw, p->fftBuf_cpx + w * M2,
+                                            p->zbuf, p->fbuf);
+
+            for (ltfat_int l = 0; l < gl; )
+            {
+                ltfat_int run = 4 * M - idx < gl - l ? 4 * M - idx : gl - l;
+
+                for (ltfat_int ii = 0; ii < run; ii++)
+                    fchan[l + ii] = p->fbuf[idx + ii] * p->g[l + ii];
+
+                l += run;
+                idx = 0;
+            }
+        }
+    }
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_done)(LTFAT_NAME(rtwmdct_plan)** p)
+{
+    LTFAT_NAME(rtwmdct_plan)* pp;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(*p);
+
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->g, pp->fbuf, pp->zbuf, pp->tw, pp->fftBuf,
+                      pp->fftBuf_cpx);
+    if (pp->pfft) LTFAT_NAME_REAL(ifftreal_done)(&pp->pfft);
+    if (pp->pifft) LTFAT_NAME_REAL(fftreal_done)(&pp->pifft);
+    ltfat_free(pp);
+    *p = NULL;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtiwmdct_done)(LTFAT_NAME(rtiwmdct_plan)** p)
+{
+    return LTFAT_NAME(rtwmdct_done)(p);
+}
+
+
+/* WMDCT processor */
+struct LTFAT_NAME(rtwmdct_processor_state)
+{
+    LTFAT_NAME(rtwmdct_processor_callback)*
+    processorCallback; //!< Custom processor callback
+    void* userdata; //!< Callback data
+    LTFAT_NAME(analysis_fifo_state)* fwdfifo;
+    LTFAT_NAME(synthesis_fifo_state)* backfifo;
+    LTFAT_NAME(rtwmdct_plan)* fwdplan;
+    LTFAT_NAME(rtiwmdct_plan)* backplan;
+    LTFAT_REAL* buf;
+    LTFAT_REAL* cbufIn;
+    LTFAT_REAL* cbufOut;
+    ltfat_int bufLenMax;
+    ltfat_int n; //!< Index of the next frame modulo 4
+    void** garbageBin;
+    int garbageBinSize;
+    const LTFAT_REAL** inTmp;
+    LTFAT_REAL** outTmp;
+};
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_init)(const LTFAT_REAL* ga, ltfat_int gal,
+                                   const LTFAT_REAL* gs, ltfat_int gsl,
+                                   ltfat_int M, ltfat_int Wmax,
+                                   ltfat_int bufLenMax, ltfat_int procDelay,
+                                   LTFAT_NAME(rtwmdct_processor_state)** pout)
+{
+    LTFAT_NAME(rtwmdct_processor_state)* p = NULL;
+    ltfat_int glmax;
+
+    int status = LTFATERR_FAILED;
+    CHECKNULL(ga); CHECKNULL(gs); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gal > 0, "gal must be positive");
+    CHECK(LTFATERR_BADSIZE, gsl > 0, "gsl must be positive");
+
+    glmax = gal > gsl ? gal - 1 : gsl - 1;
+
+    CHECK(LTFATERR_BADSIZE, procDelay >= glmax && procDelay <= glmax + bufLenMax,
+          "procdelay must be at least the window length at most the bufLenMax");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_NOTPOSARG, Wmax > 0, "Wmax must be positive");
+    CHECK(LTFATERR_NOTPOSARG, bufLenMax > 0, "bufLenMax must be positive");
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(rtwmdct_processor_state)) );
+
+    CHECKMEM( p->cbufIn = LTFAT_NAME_REAL(malloc)( Wmax * M));
+    CHECKMEM( p->cbufOut = LTFAT_NAME_REAL(malloc)( Wmax * M));
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(malloc)( Wmax * (gal > gsl ? gal : gsl)));
+    CHECKMEM( p->inTmp =  LTFAT_NEWARRAY(const LTFAT_REAL*, Wmax));
+    CHECKMEM( p->outTmp = LTFAT_NEWARRAY(LTFAT_REAL*, Wmax));
+
+    CHECKSTATUS(
+        LTFAT_NAME(analysis_fifo_init)(bufLenMax + gal, procDelay,
+                                        gal, M, Wmax, &p->fwdfifo));
+
+    CHECKSTATUS(
+        LTFAT_NAME(synthesis_fifo_init)(bufLenMax + gsl, gsl, M, Wmax,
+                                         &p->backfifo));
+
+    CHECKSTATUS( LTFAT_NAME(rtwmdct_init)(ga, gal, M, Wmax, &p->fwdplan));
+    CHECKSTATUS( LTFAT_NAME(rtiwmdct_init)(gs, gsl, M, Wmax, &p->backplan));
+
+    p->bufLenMax = bufLenMax;
+
+    *pout = p;
+    return LTFATERR_SUCCESS;
+error:
+    if (p) LTFAT_NAME(rtwmdct_processor_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_init_win)(LTFAT_FIRWIN win, ltfat_int gl,
+                                       ltfat_int M, ltfat_int Wmax,
+                                       ltfat_int bufLenMax, ltfat_int procDelay,
+                                       LTFAT_NAME(rtwmdct_processor_state)** pout)
+{
+    LTFAT_NAME(rtwmdct_processor_state)* p;
+    LTFAT_REAL* g = NULL;
+    LTFAT_REAL* gd = NULL;
+    void** garbageBin = NULL;
+
+    int status = LTFATERR_FAILED;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 0,  "M must be positive");
+    CHECK(LTFATERR_BADSIZE, gl > 0 && gl <= 2 * M,
+          "gl must be positive and at most 2M");
+    CHECK(LTFATERR_NOTPOSARG, Wmax > 0, "Wmax must be positive");
+
+    CHECKMEM(g = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM(gd = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM(garbageBin = (void**) ltfat_malloc(2 * sizeof(void*)));
+
+    // The canonical dual Wilson window is twice the dual Gabor window
+    // with hop M and 2M channels.
+    CHECKSTATUS(LTFAT_NAME_REAL(firwin)(win, gl, g));
+    CHECKSTATUS(LTFAT_NAME_REAL(gabdual_painless)(g, gl, M, 2 * M, gd));
+    for (ltfat_int l = 0; l < gl; l++)
+        gd[l] *= 2.0;
+
+    CHECKSTATUS(LTFAT_NAME(rtwmdct_processor_init)(g, gl, gd, gl, M, Wmax,
+                bufLenMax, procDelay, pout));
+
+    p = *pout;
+    p->garbageBinSize = 2;
+    p->garbageBin = garbageBin;
+    p->garbageBin[0] = g;
+    p->garbageBin[1] = gd;
+
+    return LTFATERR_SUCCESS;
+error:
+    LTFAT_SAFEFREEALL(g, gd, garbageBin);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_reset)(LTFAT_NAME(rtwmdct_processor_state)* p)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+
+    LTFAT_NAME(analysis_fifo_reset)(p->fwdfifo);
+    LTFAT_NAME(synthesis_fifo_reset)(p->backfifo);
+    p->n = 0;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_setcallback)(
+    LTFAT_NAME(rtwmdct_processor_state)* p,
+    LTFAT_NAME(rtwmdct_processor_callback)* callback,
+    void* userdata)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+    p->processorCallback = callback;
+    p->userdata = userdata;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_compact)(
+    LTFAT_NAME(rtwmdct_processor_state)* p, const LTFAT_REAL* in,
+    ltfat_int len, ltfat_int chanNo, LTFAT_REAL* out)
+{
+    return LTFAT_NAME(rtwmdct_processor_execute_gen_compact)(
+               p, in, len, chanNo, len, out);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_gen_compact)(
+    LTFAT_NAME(rtwmdct_processor_state)* p, const LTFAT_REAL* in,
+    ltfat_int inLen, ltfat_int chanNo, ltfat_int outLen, LTFAT_REAL* out)
+{
+    ltfat_int chanLoc;
+    int status2 = LTFATERR_SUCCESS;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKNULL(p);
+    chanLoc = chanNo > p->fwdfifo->numChans ? p->fwdfifo->numChans : chanNo;
+
+    for (ltfat_int w = 0; w < chanLoc; w++)
+    {
+        p->inTmp[w] = &in[w * inLen];
+        p->outTmp[w] = &out[w * outLen];
+    }
+
+    // Clear superfluous channels
+    if (chanNo > chanLoc)
+    {
+        DEBUG("Channel overflow (passed %td, max %td)", chanNo, chanLoc);
+        status = LTFATERR_OVERFLOW;
+
+        memset(out + chanLoc * outLen, 0, (chanNo - chanLoc)*outLen * sizeof * out);
+    }
+
+    status2 = LTFAT_NAME(rtwmdct_processor_execute_gen)( p, p->inTmp, inLen,
+              chanLoc, outLen, p->outTmp);
+
+    if (status2 != LTFATERR_SUCCESS) return status2;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute)(
+    LTFAT_NAME(rtwmdct_processor_state)* p,
+    const LTFAT_REAL** in, ltfat_int len, ltfat_int chanNo,
+    LTFAT_REAL** out)
+{
+    return LTFAT_NAME(rtwmdct_processor_execute_gen)( p, in, len, chanNo, len,
+            out);
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_execute_gen)(
+    LTFAT_NAME(rtwmdct_processor_state)* p,
+    const LTFAT_REAL** in, ltfat_int inLen, ltfat_int chanNo, ltfat_int outLen,
+    LTFAT_REAL** out)
+{
+    int status = LTFATERR_FAILED;
+    ltfat_int samplesWritten = 0, samplesRead = 0;
+    LTFAT_NAME(rtwmdct_processor_callback)* processorCallback;
+
+    // Failing these checks prohibits execution altogether
+    CHECKNULL(p); CHECKNULL(in); CHECKNULL(out);
+    CHECK(LTFATERR_BADSIZE, inLen >= 0 && outLen >= 0,
+          "len must be positive or zero (passed %td and %td)", inLen, outLen);
+    CHECK(LTFATERR_BADSIZE, chanNo >= 0,
+          "chanNo must be positive or zero (passed %td)", chanNo);
+
+    // Just dont do anything
+    if (chanNo == 0 || (inLen == 0 && outLen == 0)) return LTFATERR_SUCCESS;
+
+    if ( chanNo > p->fwdfifo->numChans )
+    {
+        DEBUG("Channel overflow (passed %td, max %td)", chanNo, p->fwdfifo->numChans);
+        status = LTFATERR_OVERFLOW;
+
+        for (ltfat_int w = p->fwdfifo->numChans; w < chanNo; w++)
+            memset(out[w], 0, outLen * sizeof * out[w]);
+
+        chanNo = p->fwdfifo->numChans;
+    }
+
+    if ( inLen > p->bufLenMax )
+    {
+        DEBUG("Buffer overflow (passed %td, max %td)", inLen, p->bufLenMax);
+        status = LTFATERR_OVERFLOW;
+        inLen = p->bufLenMax;
+    }
+
+    if ( outLen > p->bufLenMax )
+    {
+        DEBUG("Buffer overflow (passed %td, max %td)", outLen, p->bufLenMax);
+        status = LTFATERR_OVERFLOW;
+
+        for (ltfat_int w = 0; w < chanNo; w++)
+            memset(out[w] + p->bufLenMax, 0, (outLen - p->bufLenMax)*sizeof * out[w]);
+
+        outLen = p->bufLenMax;
+    }
+
+    // Get default processor if none was set
+    processorCallback = p->processorCallback;
+    if (!processorCallback)
+        processorCallback = &LTFAT_NAME(default_rtwmdct_processor_callback);
+
+    samplesWritten =
+        LTFAT_NAME(analysis_fifo_write)(p->fwdfifo, in, inLen, chanNo);
+
+    while ( LTFAT_NAME(analysis_fifo_read)(p->fwdfifo, p->buf) > 0 )
+    {
+        LTFAT_NAME(rtwmdct_execute)(p->fwdplan, p->buf, p->n,
+                                    p->fwdfifo->numChans, p->cbufIn);
+
+        processorCallback(p->userdata, p->cbufIn, p->fwdplan->M,
+                          p->fwdfifo->numChans, p->cbufOut);
+
+        LTFAT_NAME(rtiwmdct_execute)(p->backplan, p->cbufOut, p->n,
+                                     p->backfifo->numChans, p->buf);
+
+        LTFAT_NAME(synthesis_fifo_write)(p->backfifo, p->buf);
+
+        // The frames only differ by their index modulo 4
+        p->n = (p->n + 1) % 4;
+    }
+
+    samplesRead =
+        LTFAT_NAME(synthesis_fifo_read)(p->backfifo, outLen, chanNo, out);
+
+    status = LTFATERR_SUCCESS;
+error:
+    if (status != LTFATERR_SUCCESS) return status;
+    // These should never occur, it would mean internal error
+    if ( samplesWritten != inLen ) return LTFATERR_OVERFLOW;
+    else if ( samplesRead != outLen ) return LTFATERR_UNDERFLOW;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(rtwmdct_processor_done)(LTFAT_NAME(rtwmdct_processor_state)** p)
+{
+    LTFAT_NAME(rtwmdct_processor_state)* pp;
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p); CHECKNULL(*p);
+
+    pp = *p;
+    if (pp->fwdfifo) LTFAT_NAME(analysis_fifo_done)(&pp->fwdfifo);
+    if (pp->backfifo) LTFAT_NAME(synthesis_fifo_done)(&pp->backfifo);
+    if (pp->fwdplan) LTFAT_NAME(rtwmdct_done)(&pp->fwdplan);
+    if (pp->backplan) LTFAT_NAME(rtiwmdct_done)(&pp->backplan);
+    LTFAT_SAFEFREEALL(pp->buf, pp->cbufIn, pp->cbufOut, pp->inTmp, pp->outTmp);
+
+    if (pp->garbageBinSize)
+    {
+        for (int ii = 0; ii < pp->garbageBinSize; ii++)
+            ltfat_safefree(pp->garbageBin[ii]);
+
+        ltfat_safefree(pp->garbageBin);
+    }
+
+    ltfat_free(pp);
+    *p = NULL;
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API void
+LTFAT_NAME(default_rtwmdct_processor_callback)(void* UNUSED(userdata),
+        const LTFAT_REAL* in, int M, int W, LTFAT_REAL* out)
+{
+    memcpy(out, in, W * M * sizeof * in);
+}
@@ -1,9 +1,49 @@
+// clock_gettime is POSIX, it is hidden with -std=c99
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 #include "dgtrealmp_private.h"
+#include "circularbuf_private.h"
 #include "slicingbuf_private.h"
 #include "slidgtrealmp_private.h"
+#include "ltfat/thirdparty/fftw3.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Monotonic wall clock time in seconds. clock() would measure the CPU time
+ * of the whole process instead. */
+static double
+LTFAT_NAME(slidgtrealmp_now)()
+{
+#ifdef _WIN32
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double) count.QuadPart / freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+/* Size of the buffers of the MP state which depend on L */
+static size_t
+LTFAT_NAME(slidgtrealmp_mpmemusage)(LTFAT_NAME(dgtrealmp_state)* mpstate)
+{
+    size_t bytes = 0;
+    for (ltfat_int k = 0; k < mpstate->P; k++)
+        bytes += mpstate->M2[k] * mpstate->N[k] *
+                 ( sizeof(LTFAT_COMPLEX) + sizeof(unsigned int) ) +
+                 mpstate->N[k] * ( sizeof(LTFAT_REAL) + sizeof(ltfat_int) );
+    return bytes;
+}
 
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_init)(
@@ -74,6 +114,11 @@ LTFAT_NAME(slidgtrealmp_init_fromstates)(
 
     p->mpstate = mpstate;
     p->slistate = slistate;
+    p->memusage = LTFAT_NAME(slidgtrealmp_mpmemusage)(mpstate) +
+                  2 * slistate->winLen * slistate->block_processor->fwdfifo->numChans *
+                  sizeof(LTFAT_REAL);
+    for (ltfat_int pidx = 0; pidx < p->P; pidx++)
+        p->memusage += mpstate->M2[pidx] * mpstate->N[pidx] * sizeof(LTFAT_COMPLEX);
     *pout = p;
     return LTFATERR_SUCCESS;
 error:
@@ -86,6 +131,8 @@ LTFAT_NAME(slidgtrealmp_getprocdelay)( LTFAT_NAME(slidgtrealmp_state)* p)
 {
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
+    if (p->blockstate)
+        return ltfat_imax(p->hop - 1, 1) + p->Llive;
     return LTFAT_NAME(slicing_processor_getprocdelay)(p->slistate);
 error:
     return status;
@@ -99,6 +146,9 @@ LTFAT_NAME(slidgtrealmp_execute)(
 {
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
+    if (p->blockstate)
+        return LTFAT_NAME(block_processor_execute)( p->blockstate, in, inLen,
+                chanNo, inLen, out);
     return LTFAT_NAME(slicing_processor_execute)( p->slistate, in, inLen, chanNo,
             out);
 error:
@@ -113,6 +163,9 @@ LTFAT_NAME(slidgtrealmp_execute_compact)(
 {
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
+    if (p->blockstate)
+        return LTFAT_NAME(block_processor_execute_compact)( p->blockstate, in,
+                inLen, chanNo, inLen, out);
     return LTFAT_NAME(slicing_processor_execute_compact)( p->slistate, in, inLen,
             chanNo, out);
 error:
@@ -140,6 +193,43 @@ LTFAT_NAME(slidgtrealmp_done)(LTFAT_NAME(slidgtrealmp_state)** p)
     if (pp->owning_slistate && pp->slistate)
         LTFAT_NAME(slicing_processor_done)(&pp->slistate);
 
+    if (pp->blockstate)
+        LTFAT_NAME(block_processor_done)(&pp->blockstate);
+
+    if (pp->chans)
+    {
+        for (ltfat_int w = 0; w < pp->numChans; w++)
+        {
+            LTFAT_NAME(slidgtrealmp_chanstate)* ch = &pp->chans[w];
+            if (ch->mpstate) LTFAT_NAME(dgtrealmp_done)(&ch->mpstate);
+            if (ch->cout)
+            {
+                for (ltfat_int k = 0; k < pp->P; k++)
+                    ltfat_safefree(ch->cout[k]);
+                ltfat_free(ch->cout);
+            }
+            ltfat_safefree(ch->f);
+        }
+        ltfat_free(pp->chans);
+    }
+
+    if (pp->anaplans)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            if (pp->anaplans[k]) LTFAT_NAME(dgtreal_fb_done)(&pp->anaplans[k]);
+        ltfat_free(pp->anaplans);
+    }
+
+    if (pp->synplans)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            if (pp->synplans[k]) LTFAT_NAME(idgtreal_fb_done)(&pp->synplans[k]);
+        ltfat_free(pp->synplans);
+    }
+
+    LTFAT_SAFEFREEALL(pp->gl, pp->segalign, pp->fseg, pp->cseg, pp->yseg,
+                      pp->dseg, pp->ftmp);
+
     ltfat_free(pp);
     pp = NULL;
     return LTFATERR_SUCCESS;
@@ -147,9 +237,566 @@ error:
     return status;
 }
 
+/* Streaming mode
+ *
+ * The analyzed signal f of each channel is stored in a circular buffer of
+ * length L. Its live part of length Llive starts at pos and the rest is
+ * zero padding. Every step
+ *
+ *   1) copies hop new samples right after the live part (the tail),
+ *   2) runs MP on the whole buffer,
+ *   3) outputs the approximation of the first hop samples of the live
+ *      part (the head) and sets the residual there to zero,
+ *   4) retires the atoms deep in the padding and clears the padding there.
+ *
+ * Only the coefficients of the columns around the modified hop samples are
+ * updated using short filter bank DGTs. The coefficients of the rest of the
+ * buffer, including the overlap with the previous steps, are carried over.
+ *
+ * The residual r = f - synthesis(cout) is kept consistent with the residual
+ * coefficients: f is changed only where r is known, or together with cout.
+ */
+
+/* Segment [s0, s0 + Le) covering [start, start + len) with a half window
+ * length margin on both sides. The windows of the columns touching [start,
+ * start + len) then do not wrap around the segment. The segment is aligned
+ * to multiples of a (lcm(a,M) for the frequency invariant phase) such that
+ * its coefficients are equal to the coefficients of the full buffer. */
+static void
+LTFAT_NAME(slidgtrealmp_segment)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                  ltfat_int k, ltfat_int start, ltfat_int len,
+                                  ltfat_int* s0, ltfat_int* Le)
+{
+    ltfat_int align = p->segalign[k];
+    ltfat_int s = start - (p->gl[k] + 1) / 2;
+    ltfat_int e = start + len + (p->gl[k] + 1) / 2;
+    s -= ltfat_positiverem(s, align);
+    e += ltfat_positiverem(-e, align);
+    *s0 = s; *Le = e - s;
+}
+
+/* Refresh the max trees after columns nfirst,...,nfirst+nNo-1 (modulo N)
+ * were changed */
+static void
+LTFAT_NAME(slidgtrealmp_refreshcols)( LTFAT_NAME(dgtrealmp_state)* mp,
+                                      ltfat_int k, ltfat_int nfirst, ltfat_int nNo)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = mp->iterstate;
+    ltfat_int N = mp->N[k];
+    nNo = ltfat_imin(nNo, N);
+    nfirst = ltfat_positiverem(nfirst, N);
+
+    for (ltfat_int nidx = 0; nidx < nNo; nidx++)
+    {
+        ltfat_int n = ltfat_positiverem(nfirst + nidx, N);
+        LTFAT_NAME(maxtree_setdirty)(s->fmaxtree[k][n], 0, mp->M2[k]);
+        LTFAT_NAME(maxtree_findmax)(s->fmaxtree[k][n], &s->maxcols[k][n],
+                                    &s->maxcolspos[k][n]);
+    }
+
+    ltfat_int nend = ltfat_imin(nfirst + nNo, N);
+    LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[k], nfirst, nend);
+    if (nfirst + nNo > N)
+        LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[k], 0, nfirst + nNo - N);
+}
+
+/* Add the coefficients of d, supported on [start, start + len), to the
+ * residual coefficients */
+static int
+LTFAT_NAME(slidgtrealmp_segana)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                 LTFAT_NAME(dgtrealmp_state)* mp, ltfat_int k,
+                                 const LTFAT_REAL d[], ltfat_int start, ltfat_int len)
+{
+    ltfat_int s0, Le;
+    ltfat_int a = mp->a[k], M2 = mp->M2[k], N = mp->N[k];
+    LTFAT_COMPLEX* c = mp->iterstate->c[k];
+
+    LTFAT_NAME(slidgtrealmp_segment)(p, k, start, len, &s0, &Le);
+
+    memset(p->fseg, 0, Le * sizeof * p->fseg);
+    memcpy(p->fseg + start - s0, d, len * sizeof * d);
+
+    int status = LTFAT_NAME(dgtreal_fb_execute)(p->anaplans[k], p->fseg, Le, 1,
+                 p->cseg);
+    if (status != LTFATERR_SUCCESS) return status;
+
+    for (ltfat_int ne = 0; ne < Le / a; ne++)
+    {
+        LTFAT_COMPLEX* cCol = c + ltfat_positiverem(s0 / a + ne, N) * M2;
+        const LTFAT_COMPLEX* csegCol = p->cseg + ne * M2;
+        for (ltfat_int m = 0; m < M2; m++)
+            cCol[m] += csegCol[m];
+    }
+
+    LTFAT_NAME(slidgtrealmp_refreshcols)(mp, k, s0 / a, Le / a);
+    return LTFATERR_SUCCESS;
+}
+
+static int
+LTFAT_NAME(slidgtrealmp_iszerocol)(const LTFAT_COMPLEX c[], ltfat_int M2)
+{
+    for (ltfat_int m = 0; m < M2; m++)
+        if (ltfat_norm(c[m]) > 0) return 0;
+    return 1;
+}
+
+/* Add the synthesis of the atoms with time positions in [cstart, cend) to
+ * y on [start, start + len). Only the columns between the first and the last
+ * nonzero one are transformed. */
+static int
+LTFAT_NAME(slidgtrealmp_segsyn)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                 LTFAT_NAME(dgtrealmp_state)* mp, ltfat_int k,
+                                 const LTFAT_COMPLEX cout[], ltfat_int start,
+                                 ltfat_int len, ltfat_int cstart, ltfat_int cend,
+                                 LTFAT_REAL y[])
+{
+    ltfat_int s0, Le, tfirst = 0, tlast = 0;
+    ltfat_int a = mp->a[k], M2 = mp->M2[k], N = mp->N[k];
+    int found = 0;
+
+    // Only the atoms overlapping [start, start + len) are needed
+    cstart = ltfat_imax(cstart, start - p->gl[k] / 2);
+    cend = ltfat_imin(cend, start + len + (p->gl[k] + 1) / 2);
+
+    for (ltfat_int n = ltfat_idivceil(cstart, a); n * a < cend; n++)
+    {
+        if ( !LTFAT_NAME(slidgtrealmp_iszerocol)(
+                 cout + ltfat_positiverem(n, N) * M2, M2) )
+        {
+            if (!found) tfirst = n * a;
+            tlast = n * a; found = 1;
+        }
+    }
+
+    if (!found) return LTFATERR_SUCCESS;
+
+    LTFAT_NAME(slidgtrealmp_segment)(p, k, tfirst, tlast - tfirst + 1, &s0, &Le);
+
+    for (ltfat_int ne = 0; ne < Le / a; ne++)
+    {
+        ltfat_int t = s0 + ne * a;
+        if (t >= tfirst && t <= tlast)
+            memcpy(p->cseg + ne * M2,
+                   cout + ltfat_positiverem(s0 / a + ne, N) * M2,
+                   M2 * sizeof * cout);
+        else
+            for (ltfat_int m = 0; m < M2; m++)
+                p->cseg[ne * M2 + m] = 0.0;
+    }
+
+    int status = LTFAT_NAME(idgtreal_fb_execute)(p->synplans[k], p->cseg, Le, 1,
+                 p->fseg);
+    if (status != LTFATERR_SUCCESS) return status;
+
+    for (ltfat_int l = ltfat_imax(0, s0 - start);
+         l < ltfat_imin(len, s0 + Le - start); l++)
+        y[l] += p->fseg[start - s0 + l];
+
+    return LTFATERR_SUCCESS;
+}
+
+/* Synthesis of all atoms on [start, start + len) */
+static int
+LTFAT_NAME(slidgtrealmp_segsynall)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                    LTFAT_NAME(slidgtrealmp_chanstate)* ch,
+                                    ltfat_int start, ltfat_int len, LTFAT_REAL y[])
+{
+    int status = LTFATERR_SUCCESS;
+    memset(y, 0, len * sizeof * y);
+    for (ltfat_int k = 0; k < p->P && !status; k++)
+        if (ch->mpstate->chanmask[k])
+            status = LTFAT_NAME(slidgtrealmp_segsyn)(
+                         p, ch->mpstate, k, ch->cout[k], start, len,
+                         start - p->L, start + p->L, y);
+    return status;
+}
+
+/* Remove the atoms with time positions in [start, start + hop) from cout and
+ * their contribution from f. The residual does not change. */
+static int
+LTFAT_NAME(slidgtrealmp_retire)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                 LTFAT_NAME(slidgtrealmp_chanstate)* ch,
+                                 ltfat_int start)
+{
+    LTFAT_NAME(dgtrealmp_state)* mp = ch->mpstate;
+    ltfat_int glmax = 0, ylen, ystart;
+    int found = 0, status = LTFATERR_SUCCESS;
+
+    for (ltfat_int k = 0; k < p->P && !found; k++)
+    {
+        ltfat_int a = mp->a[k], M2 = mp->M2[k];
+        for (ltfat_int n = ltfat_idivceil(start, a);
+             n * a < start + p->hop && !found; n++)
+            found = !LTFAT_NAME(slidgtrealmp_iszerocol)(
+                        ch->cout[k] + ltfat_positiverem(n, mp->N[k]) * M2, M2);
+    }
+
+    if (!found) return status;
+
+    for (ltfat_int k = 0; k < p->P; k++)
+        glmax = ltfat_imax(glmax, p->gl[k]);
+
+    ystart = start - (glmax + 1) / 2; ylen = p->hop + glmax + 1;
+    memset(p->yseg, 0, ylen * sizeof * p->yseg);
+
+    for (ltfat_int k = 0; k < p->P && !status; k++)
+        status = LTFAT_NAME(slidgtrealmp_segsyn)(
+                     p, mp, k, ch->cout[k], ystart, ylen, start, start + p->hop,
+                     p->yseg);
+
+    if (status) return status;
+
+    for (ltfat_int l = 0, idx = ltfat_positiverem(ystart, p->L); l < ylen; l++)
+    {
+        ch->f[idx] -= p->yseg[l];
+        if (++idx == p->L) idx = 0;
+    }
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        ltfat_int a = mp->a[k], M2 = mp->M2[k];
+        for (ltfat_int n = ltfat_idivceil(start, a); n * a < start + p->hop; n++)
+        {
+            ltfat_int nidx = ltfat_positiverem(n, mp->N[k]);
+            for (ltfat_int m = 0; m < M2; m++)
+                ch->cout[k][nidx * M2 + m] = 0.0;
+            memset(mp->iterstate->suppind[k] + nidx * M2, 0,
+                   M2 * sizeof * mp->iterstate->suppind[k]);
+        }
+    }
+
+    return status;
+}
+
+/* Clear f and the residual coefficients of the columns with time positions in
+ * [start, start + hop). There must be no atoms overlapping the segment. */
+static void
+LTFAT_NAME(slidgtrealmp_clear)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                LTFAT_NAME(slidgtrealmp_chanstate)* ch,
+                                ltfat_int start)
+{
+    LTFAT_NAME(dgtrealmp_state)* mp = ch->mpstate;
+    LTFAT_NAME(dgtrealmpiter_state)* s = mp->iterstate;
+
+    for (ltfat_int l = 0, idx = ltfat_positiverem(start, p->L); l < p->hop; l++)
+    {
+        s->err -= ch->f[idx] * ch->f[idx];
+        ch->f[idx] = 0;
+        if (++idx == p->L) idx = 0;
+    }
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        ltfat_int a = mp->a[k], M2 = mp->M2[k];
+        ltfat_int nfirst = ltfat_idivceil(start, a), n = nfirst;
+        for (; n * a < start + p->hop; n++)
+        {
+            LTFAT_COMPLEX* ccol = s->c[k] + ltfat_positiverem(n, mp->N[k]) * M2;
+            for (ltfat_int m = 0; m < M2; m++)
+                ccol[m] = 0.0;
+        }
+        LTFAT_NAME(slidgtrealmp_refreshcols)(mp, k, nfirst, n - nfirst);
+    }
+}
+
+static void
+LTFAT_NAME(slidgtrealmp_resetchan)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                    ltfat_int w)
+{
+    LTFAT_NAME(slidgtrealmp_chanstate)* ch = &p->chans[w];
+    LTFAT_NAME(dgtrealmp_state)* mp = ch->mpstate;
+    LTFAT_NAME(dgtrealmpiter_state)* s = mp->iterstate;
+
+    memset(ch->f, 0, p->L * sizeof * ch->f);
+    ch->fnorm2 = 0.0;
+    s->err = 0.0; s->fnorm2 = 0.0; s->currit = 0; s->curratoms = 0;
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        for (ltfat_int l = 0; l < mp->M2[k] * mp->N[k]; l++)
+        {
+            ch->cout[k][l] = 0.0;
+            s->c[k][l] = 0.0;
+        }
+        memset(s->suppind[k], 0, mp->M2[k] * mp->N[k] * sizeof * s->suppind[k]);
+
+        for (ltfat_int n = 0; n < mp->N[k]; n++)
+        {
+            LTFAT_NAME(maxtree_reset_complex)(s->fmaxtree[k][n],
+                                              s->c[k] + n * mp->M2[k]);
+            LTFAT_NAME(maxtree_findmax)(s->fmaxtree[k][n], &s->maxcols[k][n],
+                                        &s->maxcolspos[k][n]);
+        }
+        LTFAT_NAME(maxtree_reset)(s->tmaxtree[k], s->maxcols[k]);
+    }
+}
+
+static int
+LTFAT_NAME(slidgtrealmp_reseterr)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                   ltfat_int w)
+{
+    LTFAT_NAME(slidgtrealmp_chanstate)* ch = &p->chans[w];
+    LTFAT_NAME(dgtrealmpiter_state)* s = ch->mpstate->iterstate;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_execute_synthesize)(
+            ch->mpstate, (const LTFAT_COMPLEX**) ch->cout,
+            ch->mpstate->chanmask, p->ftmp));
+
+    s->err = 0.0;
+    for (ltfat_int l = 0; l < p->L; l++)
+    {
+        LTFAT_REAL r = ch->f[l] - p->ftmp[l];
+        s->err += r * r;
+    }
+error:
+    return status;
+}
+
+/* One step of a single channel */
+static int
+LTFAT_NAME(slidgtrealmp_stream_step)( LTFAT_NAME(slidgtrealmp_state)* p,
+                                      ltfat_int w, const LTFAT_REAL in[],
+                                      LTFAT_REAL out[])
+{
+    LTFAT_NAME(slidgtrealmp_chanstate)* ch = &p->chans[w];
+    LTFAT_NAME(dgtrealmp_state)* mp = ch->mpstate;
+    LTFAT_NAME(dgtrealmpiter_state)* s = mp->iterstate;
+    ltfat_int L = p->L, hop = p->hop;
+    ltfat_int tail = p->pos + p->Llive, head = p->pos;
+    ltfat_int idx;
+    int status = LTFATERR_SUCCESS, status2;
+
+    // 1) The new samples replace the (cleared) padding after the live part
+    CHECKSTATUS( LTFAT_NAME(slidgtrealmp_segsynall)(p, ch, tail, hop, p->yseg));
+
+    idx = ltfat_positiverem(tail, L);
+    for (ltfat_int l = 0; l < hop; l++)
+    {
+        LTFAT_REAL rold = ch->f[idx] - p->yseg[l];
+        LTFAT_REAL rnew = in[l] - p->yseg[l];
+        s->err += rnew * rnew - rold * rold;
+        ch->fnorm2 += in[l] * in[l];
+        p->dseg[l] = in[l] - ch->f[idx];
+        ch->f[idx] = in[l];
+        if (++idx == L) idx = 0;
+    }
+
+    for (ltfat_int k = 0; k < p->P; k++)
+        CHECKSTATUS( LTFAT_NAME(slidgtrealmp_segana)(p, mp, k, p->dseg, tail, hop));
+
+    // 2) MP with the tolerance relative to the energy of the live part
+    if (ch->fnorm2 < 0.0) ch->fnorm2 = 0.0;
+    if (s->err < 0.0) s->err = 0.0;
+
+    s->fnorm2 = ch->fnorm2;
+    s->currit = 0; s->curratoms = 0;
+    mp->params->errtoladj = powl((long double)10.0,
+                                 mp->params->errtoldb / 10.0) * ch->fnorm2;
+
+    if (s->fnorm2 > 0.0 && s->err > mp->params->errtoladj)
+    {
+        while ( LTFAT_DGTREALMP_STATUS_CANCONTINUE ==
+                ( status2 = LTFAT_NAME(dgtrealmp_execute_niters)(
+                                mp, mp->params->iterstep, ch->cout)))
+            ;
+
+        CHECKSTATUS(status2);
+    }
+
+    // 3) The head leaves the live part, the residual there is discarded
+    CHECKSTATUS( LTFAT_NAME(slidgtrealmp_segsynall)(p, ch, head, hop, out));
+
+    idx = ltfat_positiverem(head, L);
+    for (ltfat_int l = 0; l < hop; l++)
+    {
+        LTFAT_REAL r = ch->f[idx] - out[l];
+        s->err -= r * r;
+        ch->fnorm2 -= ch->f[idx] * ch->f[idx];
+        p->dseg[l] = -r;
+        ch->f[idx] = out[l];
+        if (++idx == L) idx = 0;
+    }
+
+    for (ltfat_int k = 0; k < p->P; k++)
+        CHECKSTATUS( LTFAT_NAME(slidgtrealmp_segana)(p, mp, k, p->dseg, head, hop));
+
+    // 4) Retire atoms far behind the head and clear the padding behind them
+    tail += 2 * hop + 2 * p->reach;
+    CHECKSTATUS( LTFAT_NAME(slidgtrealmp_retire)(p, ch, tail + 2 * p->reach));
+    LTFAT_NAME(slidgtrealmp_clear)(p, ch, tail);
+
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(slidgtrealmp_stream_callback)(void* userdata,
+        const LTFAT_REAL in[], int winLen, int W, LTFAT_REAL out[])
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(slidgtrealmp_state)* p =
+        (LTFAT_NAME(slidgtrealmp_state)*) userdata;
+    double tstart = LTFAT_NAME(slidgtrealmp_now)();
+
+    for (ltfat_int w = 0; w < W && !status; w++)
+        status = LTFAT_NAME(slidgtrealmp_stream_step)(
+                     p, w, in + w * winLen, out + w * winLen);
+
+    p->pos = ltfat_positiverem(p->pos + p->hop, p->L);
+
+    // The error is tracked incrementally. Recompute it once per cycle of
+    // the buffer such that the rounding and kernel truncation errors do
+    // not accumulate over time.
+    if (p->pos < p->hop)
+        for (ltfat_int w = 0; w < W && !status; w++)
+            status = LTFAT_NAME(slidgtrealmp_reseterr)(p, w);
+
+    p->lastslicetime = LTFAT_NAME(slidgtrealmp_now)() - tstart;
+    if (p->lastslicetime > p->maxslicetime)
+        p->maxslicetime = p->lastslicetime;
+
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_init_streaming)(
+    LTFAT_NAME(dgtrealmp_parbuf)* pb, ltfat_int L, ltfat_int hop,
+    ltfat_int numChans, ltfat_int bufLenMax,
+    LTFAT_NAME(slidgtrealmp_state)** pout)
+{
+    int status = LTFATERR_FAILED;
+    LTFAT_NAME(slidgtrealmp_state)* p = NULL;
+    ltfat_int zpadLen, segLenMax, csegLenMax = 0, glmax = 0, alignmax = 0;
+
+    CHECKNULL(pb); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, hop > 0, "hop must be positive (passed %td)", hop);
+    CHECK(LTFATERR_NOTPOSARG, numChans > 0,
+          "numChans must be positive (passed %td)", numChans);
+    CHECK(LTFATERR_BADARG, pb->P > 0 , "No Gabor system set in the plan");
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(slidgtrealmp_state)));
+    p->P = pb->P; p->L = L; p->hop = hop; p->numChans = numChans;
+
+    CHECKMEM( p->gl = LTFAT_NEWARRAY(ltfat_int, p->P));
+    CHECKMEM( p->segalign = LTFAT_NEWARRAY(ltfat_int, p->P));
+    CHECKMEM( p->anaplans = LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_fb_plan)*, p->P));
+    CHECKMEM( p->synplans = LTFAT_NEWARRAY(LTFAT_NAME(idgtreal_fb_plan)*, p->P));
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        p->gl[k] = pb->gl[k];
+        p->segalign[k] = pb->params->ptype == LTFAT_FREQINV ?
+                         ltfat_lcm(pb->a[k], pb->M[k]) : pb->a[k];
+        p->reach = ltfat_imax(p->reach, pb->gl[k] / 2 + pb->a[k]);
+        glmax = ltfat_imax(glmax, pb->gl[k]);
+        alignmax = ltfat_imax(alignmax, p->segalign[k]);
+    }
+
+    // Length of the longest segment, see slidgtrealmp_retire
+    segLenMax = hop + 2 * glmax + 2 + 2 * alignmax;
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        csegLenMax = ltfat_imax(csegLenMax,
+                                (pb->M[k] / 2 + 1) * (segLenMax / pb->a[k]));
+
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_fb_init)(pb->g[k], pb->gl[k], pb->a[k], pb->M[k],
+                                        pb->params->ptype, FFTW_ESTIMATE,
+                                        &p->anaplans[k]));
+        CHECKSTATUS(
+            LTFAT_NAME(idgtreal_fb_init)(pb->g[k], pb->gl[k], pb->a[k], pb->M[k],
+                                         pb->params->ptype, FFTW_ESTIMATE,
+                                         &p->synplans[k]));
+        LTFAT_NAME(idgtreal_fb_set_overwriteoutarray)(p->synplans[k], 1);
+    }
+
+    // The padding separates the tail, the cleared region and the atoms
+    // behind the head. See slidgtrealmp_stream_step.
+    zpadLen = 3 * hop + 6 * p->reach;
+    p->Llive = ((L - zpadLen) / hop) * hop;
+
+    CHECK(LTFATERR_BADARG, p->Llive >= hop && segLenMax <= L,
+          "L is too short. It must be at least %td for hop=%td.",
+          ltfat_imax(zpadLen + hop, segLenMax), hop);
+
+    CHECKMEM( p->fseg = LTFAT_NAME_REAL(malloc)(segLenMax));
+    CHECKMEM( p->yseg = LTFAT_NAME_REAL(malloc)(segLenMax));
+    CHECKMEM( p->dseg = LTFAT_NAME_REAL(malloc)(hop));
+    CHECKMEM( p->ftmp = LTFAT_NAME_REAL(malloc)(L));
+    CHECKMEM( p->cseg = LTFAT_NAME_COMPLEX(malloc)(csegLenMax));
+    p->memusage = (2 * segLenMax + hop + L) * sizeof(LTFAT_REAL) +
+                  csegLenMax * sizeof(LTFAT_COMPLEX);
+
+    CHECKMEM( p->chans =
+                  LTFAT_NEWARRAY(LTFAT_NAME(slidgtrealmp_chanstate), numChans));
+
+    for (ltfat_int w = 0; w < numChans; w++)
+    {
+        LTFAT_NAME(slidgtrealmp_chanstate)* ch = &p->chans[w];
+        CHECKSTATUS( LTFAT_NAME(dgtrealmp_init)(pb, L, &ch->mpstate));
+        CHECKMEM( ch->f = LTFAT_NAME_REAL(malloc)(L));
+        CHECKMEM( ch->cout = LTFAT_NEWARRAY(LTFAT_COMPLEX*, p->P));
+
+        for (ltfat_int k = 0; k < p->P; k++)
+            CHECKMEM( ch->cout[k] = LTFAT_NAME_COMPLEX(malloc)(
+                                        ch->mpstate->M2[k] * ch->mpstate->N[k]));
+
+        p->memusage += L * sizeof(LTFAT_REAL) +
+                       LTFAT_NAME(slidgtrealmp_mpmemusage)(ch->mpstate);
+        for (ltfat_int k = 0; k < p->P; k++)
+            p->memusage += ch->mpstate->M2[k] * ch->mpstate->N[k] *
+                           sizeof(LTFAT_COMPLEX);
+
+        LTFAT_NAME(slidgtrealmp_resetchan)(p, w);
+    }
+
+    CHECKSTATUS(
+        LTFAT_NAME(block_processor_init)(hop, hop, numChans, bufLenMax,
+                                         ltfat_imax(hop - 1, 1), &p->blockstate));
+    CHECKSTATUS(
+        LTFAT_NAME(block_processor_setcallback)(
+            p->blockstate, &LTFAT_NAME(slidgtrealmp_stream_callback), p));
+
+    p->memusage += 2 * (bufLenMax + hop) * numChans * sizeof(LTFAT_REAL);
+
+    *pout = p;
+    return LTFATERR_SUCCESS;
+error:
+    if (p) LTFAT_NAME(slidgtrealmp_done)(&p);
+    *pout = NULL;
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_reset)(
-    LTFAT_NAME(slidgtrealmp_state)* p);
+    LTFAT_NAME(slidgtrealmp_state)* p)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+
+    if (p->blockstate)
+    {
+        LTFAT_NAME(block_processor_reset)(p->blockstate);
+
+        for (ltfat_int w = 0; w < p->numChans; w++)
+            LTFAT_NAME(slidgtrealmp_resetchan)(p, w);
+
+        p->pos = 0;
+    }
+    else
+    {
+        LTFAT_NAME(slicing_processor_reset)(p->slistate);
+    }
+
+    p->lastslicetime = 0.0;
+    p->maxslicetime = 0.0;
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
 
 int
 LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
@@ -159,6 +806,7 @@ LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
 
     LTFAT_NAME(slidgtrealmp_state)* p =
         (LTFAT_NAME(slidgtrealmp_state)*) userdata;
+    double tstart = LTFAT_NAME(slidgtrealmp_now)();
 
     for (ltfat_int w = 0; w < W; w++)
     {
@@ -178,6 +826,10 @@ LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
         }
 
     }
+
+    p->lastslicetime = LTFAT_NAME(slidgtrealmp_now)() - tstart;
+    if (p->lastslicetime > p->maxslicetime)
+        p->maxslicetime = p->lastslicetime;
     return  0;
 }
 
@@ -209,3 +861,36 @@ error:
 /* error: */
 /*     return status; */
 /* } */
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_lastslicetime)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, double* seconds)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(seconds);
+    *seconds = p->lastslicetime;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_maxslicetime)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, double* seconds)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(seconds);
+    *seconds = p->maxslicetime;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_get_memusage)(
+    const LTFAT_NAME(slidgtrealmp_state)* p, size_t* bytes)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(bytes);
+    *bytes = p->memusage;
+error:
+    return status;
+}
@@ -4,6 +4,15 @@
 
 #endif
 
+/* Per-channel state of the streaming mode */
+typedef struct
+{
+    LTFAT_NAME(dgtrealmp_state)* mpstate;
+    LTFAT_COMPLEX** cout;
+    LTFAT_REAL* f;       // Analyzed signal, circular buffer of length L
+    long double fnorm2;  // Energy of the live part of f
+} LTFAT_NAME(slidgtrealmp_chanstate);
+
 struct LTFAT_NAME(slidgtrealmp_state)
 {
     LTFAT_NAME(dgtrealmp_state)* mpstate;
@@ -14,6 +23,26 @@ struct LTFAT_NAME(slidgtrealmp_state)
     ltfat_int P;
     void* userdata;
     LTFAT_NAME(slidgtrealmp_processor_callback)* callback;
+    // Streaming mode
+    LTFAT_NAME(block_processor_state)* blockstate;
+    LTFAT_NAME(slidgtrealmp_chanstate)* chans;
+    LTFAT_NAME(dgtreal_fb_plan)** anaplans;
+    LTFAT_NAME(idgtreal_fb_plan)** synplans;
+    ltfat_int* gl;
+    ltfat_int* segalign;
+    LTFAT_REAL* fseg;
+    LTFAT_COMPLEX* cseg;
+    LTFAT_REAL* yseg;
+    LTFAT_REAL* dseg;
+    LTFAT_REAL* ftmp;
+    ltfat_int numChans;
+    ltfat_int L;
+    ltfat_int Llive;
+    ltfat_int hop;
+    ltfat_int reach;
+    ltfat_int pos;
+    // Statistics
+    double lastslicetime;
+    double maxslicetime;
+    size_t memusage;
 };
-
-
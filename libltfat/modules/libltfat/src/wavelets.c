@@ -329,127 +329,146 @@ LTFAT_NAME(atrousupconv_td)(const LTFAT_TYPE *c, const LTFAT_TYPE *g,
 }
 
 
-LTFAT_API void
-LTFAT_NAME(convsub_td)(const LTFAT_TYPE *f, const LTFAT_TYPE *g, ltfat_int L,
-                       ltfat_int gl, ltfat_int a, ltfat_int skip,
-                       LTFAT_TYPE *c, ltfatExtType ext)
+/*
+ * Helpers for convsub_td and upconv_td
+ *
+ * Both routines compute only the samples which are retained after the
+ * subsampling (or which are hit by the upsampled coefficients). Outputs whose
+ * filter support lies completely inside the input are computed directly from
+ * the input array as contiguous dot products. Only the few outputs touching
+ * the boundaries read the extended signal, which is represented by short
+ * left and right extension buffers instead of a copy of the whole input.
+ */
+static inline LTFAT_TYPE
+LTFAT_NAME(td_dot)(const LTFAT_TYPE *LTFAT_RESTRICT x,
+                   const LTFAT_TYPE *LTFAT_RESTRICT h, ltfat_int len)
 {
-    ltfat_int N = filterbank_td_size(L,a,gl,skip,ext);
-    // Since c is used as an accu
-    memset(c,0,N*sizeof*c);
-    // Reverse and conjugate the filter
-    LTFAT_TYPE *filtRev = LTFAT_NAME(malloc)(gl);
-    LTFAT_NAME(reverse_array)(g, gl, filtRev);
-
-    LTFAT_TYPE *righExtbuff = 0;
-    // number of output samples that can be calculated "painlessly"
-    ltfat_int Nsafe = ltfat_imax((L + skip + a -1)/a,0);
-
-    // prepare cyclic buf of length of power of two (for effective modulo operations)
-    ltfat_int bufgl = ltfat_nextpow2(ltfat_imax(gl,a+1));
-    // buf index
-    ltfat_int buffPtr = 0;
-
-    // allocating and initializing the cyclic buf
-    LTFAT_TYPE *buf = LTFAT_NAME(calloc)(bufgl);
-
-    // pointer for moving in the input data
-    const LTFAT_TYPE * tmpIn = f;
-    LTFAT_TYPE * tmpOut = c;
-    LTFAT_TYPE *tmpg = filtRev;
-    LTFAT_TYPE *tmpBuffPtr = buf;
-
-    // fill buf with the initial values from the input signal according to the boundary treatment
-    // last glUps buf samples are filled to keep buffPtr=0
-    LTFAT_NAME(extend_left)(f,L,buf,bufgl,gl,ext,a);
-
-    if(Nsafe<N)
+#ifdef LTFAT_COMPLEXTYPE
+    // Work on the interleaved real and imaginary parts so that the compiler
+    // can vectorize the reduction.
+    const LTFAT_REAL *LTFAT_RESTRICT xr = (const LTFAT_REAL *) x;
+    const LTFAT_REAL *LTFAT_RESTRICT hr = (const LTFAT_REAL *) h;
+    LTFAT_REAL re = 0.0, im = 0.0;
+
+    LTFAT_OMP(simd reduction(+:re,im))
+    for (ltfat_int k = 0; k < len; k++)
     {
-        // right extension is necessary, additional buf from where to copy
-        righExtbuff = LTFAT_NAME(calloc)(bufgl);
-        // store extension in the buf (must be done now to avoid errors when inplace calculation is done)
-        LTFAT_NAME(extend_right)(f,L,righExtbuff,gl,ext,a);
+        re += xr[2 * k] * hr[2 * k] - xr[2 * k + 1] * hr[2 * k + 1];
+        im += xr[2 * k] * hr[2 * k + 1] + xr[2 * k + 1] * hr[2 * k];
     }
 
-#define ONEOUTSAMPLE                                                    \
-          tmpg = filtRev;                                           \
-          ltfat_int revBufPtr = ltfat_modpow2(buffPtr-gl,bufgl);                \
-          ltfat_int loop1it = gl+1;                                         \
-	      while(--loop1it)                                              \
-	      {                                                             \
-		     tmpBuffPtr = buf + ltfat_modpow2(revBufPtr++,bufgl);        \
-             *tmpOut += *(tmpBuffPtr) * *(tmpg++);                  \
-          }                                                             \
-          tmpOut++;
+    LTFAT_TYPE acc;
+    LTFAT_REAL *accr = (LTFAT_REAL *) &acc;
+    accr[0] = re; accr[1] = im;
+    return acc;
+#else
+    LTFAT_REAL acc = 0.0;
 
+    LTFAT_OMP(simd reduction(+:acc))
+    for (ltfat_int k = 0; k < len; k++)
+        acc += x[k] * h[k];
 
+    return acc;
+#endif
+}
 
-#define READNEXTDATA(samples,wherePtr)                                              \
-	   buffOver = ltfat_imax(buffPtr+(samples)-bufgl, 0);                               \
-   	memcpy(buf + buffPtr, wherePtr, ((samples)-buffOver)*sizeof*buf); \
-	   memcpy(buf,wherePtr+(samples)-buffOver,buffOver*sizeof*buf);      \
-	   buffPtr = ltfat_modpow2(buffPtr += (samples),bufgl);
-
-
-    ltfat_int buffOver = 0;
-    /*** initial buf fill ***/
-    ltfat_int sampToRead = ltfat_imin((-skip+1),L);
-    READNEXTDATA(sampToRead,tmpIn);
-    tmpIn += sampToRead;
+// Extended signal as seen by the filters. Periodic extensions are evaluated
+// by the modulo, the other ones are read from the extension buffers
+// filled by extend_left and extend_right.
+typedef struct
+{
+    const LTFAT_TYPE *in;
+    ltfat_int L;
+    int periodic;
+    const LTFAT_TYPE *left;  // left[leftLen - j] is sample -j
+    ltfat_int leftLen;
+    const LTFAT_TYPE *right; // right[j] is sample L + j
+    ltfat_int rightLen;
+} LTFAT_NAME(td_extsig);
+
+static void
+LTFAT_NAME(td_extsig_read)(const LTFAT_NAME(td_extsig) *s, ltfat_int start,
+                           ltfat_int len, LTFAT_TYPE *out)
+{
+    for (ltfat_int k = 0; k < len; k++)
+    {
+        ltfat_int ii = start + k;
+
+        if (ii >= 0 && ii < s->L)
+            out[k] = s->in[ii];
+        else if (s->periodic)
+            out[k] = s->in[ltfat_positiverem(ii, s->L)];
+        else if (ii < 0 && -ii <= s->leftLen && s->left)
+            out[k] = s->left[s->leftLen + ii];
+        else if (ii >= s->L && ii - s->L < s->rightLen && s->right)
+            out[k] = s->right[ii - s->L];
+        else
+            out[k] = (LTFAT_TYPE) 0.0;
+    }
+}
 
-    /*********** STEP 1: FREE LUNCH ( but also a hot-spot) *******************************/
-    // Take the smaller value from "painless" output length and the user defined output length
-    ltfat_int iiLoops = ltfat_imin(Nsafe-1,N-1);
+LTFAT_API void
+LTFAT_NAME(convsub_td)(const LTFAT_TYPE *f, const LTFAT_TYPE *g, ltfat_int L,
+                       ltfat_int gl, ltfat_int a, ltfat_int skip,
+                       LTFAT_TYPE *c, ltfatExtType ext)
+{
+    ltfat_int N = filterbank_td_size(L,a,gl,skip,ext);
 
-    // loop trough all output samples, omit the very last one.
-    for (ltfat_int ii = 0; ii < iiLoops; ii++)
+    // The outputs overwrite input samples which are still to be read
+    // if the computation is done inplace
+    LTFAT_TYPE *fbuf = NULL;
+    if (f == c)
     {
-        ONEOUTSAMPLE
-        READNEXTDATA(a,tmpIn)
-        tmpIn += a;
+        fbuf = LTFAT_NAME(malloc)(L);
+        memcpy(fbuf, f, L * sizeof * f);
+        f = fbuf;
     }
 
-    /*********** STEP 2: FINALIZE FREE LUNCH ************************************/
-    if(Nsafe>0)
+    // c[n] = sum_k filtRev[k]*x[n*a - skip - (gl-1) + k]
+    // where x is f extended according to ext.
+    LTFAT_TYPE *filtRev = LTFAT_NAME(malloc)(gl);
+    LTFAT_NAME(reverse_array)(g, gl, filtRev);
+    LTFAT_TYPE *win = LTFAT_NAME(malloc)(gl);
+
+    LTFAT_NAME(td_extsig) x;
+    memset(&x, 0, sizeof x);
+    x.in = f; x.L = L;
+    x.periodic = ext == PER || ext == PPD;
+
+    // Short extension buffers. The left one has some slack because PERDEC
+    // can write a - L%a samples in front of the legal extension.
+    ltfat_int extLen = gl + a;
+    LTFAT_TYPE *leftbuf = NULL, *rightbuf = NULL;
+    if (!x.periodic)
     {
-        ONEOUTSAMPLE
+        leftbuf = LTFAT_NAME(calloc)(extLen);
+        rightbuf = LTFAT_NAME(calloc)(extLen);
+        LTFAT_NAME(extend_left)(f, L, leftbuf, extLen, gl, ext, a);
+        LTFAT_NAME(extend_right)(f, L, rightbuf, gl, ext, a);
+        x.left = leftbuf; x.leftLen = extLen;
+        x.right = rightbuf; x.rightLen = extLen;
     }
-    /*********** STEP 3: NOW FOR THE TRICKY PART ************************************/
-    if(Nsafe<N)
+
+    // Outputs nFirst,...,nLast-1 only read samples from f
+    ltfat_int nFirst = gl - 1 + skip > 0 ? (gl - 1 + skip + a - 1) / a : 0;
+    ltfat_int nLast = ltfat_imin(N, ltfat_imax((L + skip + a - 1) / a, 0));
+
+    for (ltfat_int n = 0; n < N; n++)
     {
-        /************ STEP 3a: DEALING WITH THE REMAINING SAMPLES ******************/
-        // CAREFULL NOW! possibly stepping outside of input signal
-        // last index in the input signal for which reading next a samples reaches outside of the input signal
-        ltfat_int rightExtBuffIdx = 0;
-        if(Nsafe>0)
+        ltfat_int start = n * a - skip - (gl - 1);
+
+        if (n >= nFirst && n < nLast)
         {
-            ltfat_int lastInIdx = (a*(Nsafe-1)+1-skip);
-            rightExtBuffIdx = lastInIdx + a - L;
-            ltfat_int diff = ltfat_imax(0,L - lastInIdx);
-            READNEXTDATA(diff,(f + lastInIdx))
+            c[n] = LTFAT_NAME(td_dot)(f + start, filtRev, gl);
         }
         else
         {
-            rightExtBuffIdx = 1-skip - L;
-        }
-
-        // now copying samples that are outside
-        READNEXTDATA(rightExtBuffIdx,righExtbuff)
-
-        /************ STEP 3b: ALL OK, proceed reading input values from righExtbuff ******************/
-        // loop for the remaining output samples
-        for(ltfat_int ii=0; ii<N-Nsafe; ii++)
-        {
-            ONEOUTSAMPLE
-            READNEXTDATA(a,(righExtbuff+rightExtBuffIdx))
-            rightExtBuffIdx = ltfat_modpow2(rightExtBuffIdx += a,bufgl);
+            LTFAT_NAME(td_extsig_read)(&x, start, gl, win);
+            c[n] = LTFAT_NAME(td_dot)(win, filtRev, gl);
         }
     }
 
-
-#undef READNEXTDATA
-#undef ONEOUTSAMPLE
-    LTFAT_SAFEFREEALL(buf,filtRev,righExtbuff);
+    LTFAT_SAFEFREEALL(filtRev, win, leftbuf, rightbuf, fbuf);
 }
 
 
@@ -460,132 +479,60 @@ LTFAT_NAME(upconv_td)(const LTFAT_TYPE *c, const LTFAT_TYPE *g, ltfat_int L,
 {
     ltfat_int N = filterbank_td_size(L,a,gl,skip,ext);
 
-    // Copy, reverse and conjugate the imp resp.
-    LTFAT_TYPE *gInv = LTFAT_NAME(malloc)(gl);
-    memcpy(gInv,g,gl*sizeof*gInv);
-    LTFAT_NAME(reverse_array)(gInv,gl,gInv);
-    LTFAT_NAME(conjugate_array)(gInv,gl,gInv);
-    ltfat_int skipRev = -(1 - gl - skip);
-
-    // Running output pointer
-    LTFAT_TYPE* tmpOut = f;
-    // Running input pointer
-    const LTFAT_TYPE* tmpIn =  c;
-
-    /** prepare cyclic buf */
-    ltfat_int bufgl = ltfat_nextpow2(gl);
-    LTFAT_TYPE* buf = LTFAT_NAME(calloc)(bufgl);
-    ltfat_int buffPtr = 0;
-
-    ltfat_int inSkip = (skipRev + a - 1)/a;
-    ltfat_int skipModUp = skipRev%a;
-    ltfat_int skipToNextUp = 0;
-    if(skipModUp!=0)  skipToNextUp = a-skipModUp;
-    ltfat_int outAlign = 0;
-
-    ltfat_int iiLoops = 0;
-    ltfat_int uuLoops = 0;
-    ltfat_int remainsOutSamp = L;
-    ltfat_int rightBuffPreLoad = 0;
-
-    if(inSkip >= N)
+    // f[l] += sum_q cx[q]*conj(g[q*a - skip - l]),
+    // where cx is c extended periodically for PER and by zeros otherwise.
+    //
+    // The outputs l = r + k*a of the polyphase component r all use the taps
+    // g[j0 + t*a] with j0 = (-skip - r) mod a, so the upsampled convolution
+    // reduces to a correlation of c with a short polyphase filter.
+    ltfat_int Tmax = (gl + a - 1) / a;
+    LTFAT_TYPE *hpoly = LTFAT_NAME(malloc)(Tmax);
+    LTFAT_TYPE *win = LTFAT_NAME(malloc)(Tmax);
+
+    LTFAT_NAME(td_extsig) cx;
+    memset(&cx, 0, sizeof cx);
+    cx.in = c; cx.L = N;
+    cx.periodic = ext == PER;
+
+    for (ltfat_int r = 0; r < ltfat_imin(a, L); r++)
     {
-        inSkip = N;
-        outAlign = skipModUp;
-        rightBuffPreLoad = (skipRev + 1 + a - 1)/a - N;
-    }
-    else
-    {
-        uuLoops = skipToNextUp;
-        iiLoops = ltfat_imin(N - inSkip,(L-skipToNextUp + a -1)/a); // just in case L/a < N - inSkip
-        remainsOutSamp = L - (uuLoops + (iiLoops-1)*a);
-    }
-
-    LTFAT_TYPE *rightbuf = LTFAT_NAME(calloc)(bufgl);
-    LTFAT_TYPE *rightbufTmp = rightbuf;
-
-    if(ext==PER) // if periodic extension
-    {
-        LTFAT_NAME(extend_left)(c,N,buf,bufgl,gl,PER,0); // extension as a last (tmpgl-1) samples of the buf -> pointer dont have to be moved
-        LTFAT_NAME(extend_right)(c,N,rightbuf,gl,PER,0);
-    }
-
-    ltfat_int iniStoCopy = ltfat_imin(inSkip,bufgl);
-    ltfat_int tmpInSkip = ltfat_imax(0,inSkip-bufgl);
-    memcpy(buf,tmpIn+tmpInSkip,iniStoCopy*sizeof*buf);
-    tmpIn += (iniStoCopy+tmpInSkip);
-    buffPtr = ltfat_modpow2(buffPtr += iniStoCopy,bufgl);
-
-
-
-#define ONEOUTSAMPLE(filtTmp,jjLoops)                                   \
-	    for(ltfat_int jj=0;jj<(jjLoops);jj++)                                  \
-		    {                                                            \
-				ltfat_int idx = ltfat_modpow2((-jj+buffPtr-1), bufgl);             \
-				*tmpOut += *(buf+idx) * *((filtTmp) +(jj*a));        \
-		    }                                                            \
-	    tmpOut++;
+        ltfat_int j0 = ltfat_positiverem(-skip - r, a);
+        ltfat_int q0 = (r + skip + j0) / a;
+        ltfat_int T = (gl - j0 + a - 1) / a;
 
-#define READNEXTSAMPLE(wherePtr)                               \
-   	   *(buf + buffPtr) = *(wherePtr);                      \
-	   buffPtr = ltfat_modpow2(++buffPtr,bufgl);
+        if (T <= 0 || N <= 0) continue;
 
+        for (ltfat_int t = 0; t < T; t++)
+            hpoly[t] = g[j0 + t * a];
+        LTFAT_NAME(conjugate_array)(hpoly, T, hpoly);
 
-    /** STEP 1: Deal with the shift - upsampling misaligment */
-    for(ltfat_int uu=0; uu<uuLoops; uu++)
-    {
-        ONEOUTSAMPLE((gInv + skipModUp+uu),((gl-(skipModUp+uu)+a-1)/a))
-    }
+        ltfat_int K = (L - r + a - 1) / a;
+        // Outputs k = kFirst,...,kLast-1 only read coefficients from c
+        ltfat_int kFirst = ltfat_imax(-q0, 0);
+        ltfat_int kLast = ltfat_imax(ltfat_imin(N - T - q0 + 1, K), kFirst);
 
-    /** STEP 2: MAIN LOOP */
-    if(iiLoops>0)
-    {
-        for(ltfat_int ii=0; ii<iiLoops-1; ii++)
+        for (ltfat_int k = 0; k < K; k++)
         {
-            READNEXTSAMPLE(tmpIn)
-            tmpIn++;
-            for(ltfat_int uu=0; uu<a; uu++)
+            ltfat_int q = q0 + k;
+
+            if (k >= kFirst && k < kLast)
             {
-                ONEOUTSAMPLE((gInv+uu),((gl-uu+a-1)/a))
+                f[r + k * a] += LTFAT_NAME(td_dot)(c + q, hpoly, T);
+            }
+            else
+            {
+                LTFAT_NAME(td_extsig_read)(&cx, q, T, win);
+                f[r + k * a] += LTFAT_NAME(td_dot)(win, hpoly, T);
             }
         }
-        READNEXTSAMPLE(tmpIn)
-        tmpIn++;
-    }
-
-
-    /** STEP 3b: load samples from right buf */
-    while(rightBuffPreLoad--)
-    {
-        READNEXTSAMPLE((rightbufTmp))
-        rightbufTmp++;
-    }
-
-
-    /*
-    STEP 3b: calculate remaining output samples,
-    Again, there can be shift/a misaligment thne shift>L
-    */
-
-    for(ltfat_int ii=outAlign; ii<remainsOutSamp+outAlign; ii++)
-    {
-        if(ii!=outAlign&&ii%a==0)
-        {
-            READNEXTSAMPLE((rightbufTmp))
-            rightbufTmp++;
-        }
-        ONEOUTSAMPLE((gInv+ii%a),((gl-ii%a+a-1)/a))
     }
 
-#undef ONEOUTSAMPLE
-#undef READNEXTSAMPLE
-    LTFAT_SAFEFREEALL(buf,rightbuf,gInv);
+    LTFAT_SAFEFREEALL(hpoly, win);
 }
 
 
 
 
-
 // fills last buf samples
 LTFAT_API
 void LTFAT_NAME(extend_left)(const LTFAT_TYPE *in, ltfat_int L, LTFAT_TYPE *buf,ltfat_int bufgl, ltfat_int gl, ltfatExtType ext, ltfat_int a)
@@ -0,0 +1,557 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+typedef struct
+{
+    ltfat_int M;
+    LTFAT_TYPE** g;
+    ltfat_int* gl;
+    ltfat_int* a;
+    ltfat_int* offset;
+    // Index of the child node connected to each output or -1
+    ltfat_int* child;
+    ltfat_int parent;
+    ltfat_int parentout;
+    ltfat_int depth;
+} LTFAT_NAME(wfbt_node);
+
+struct LTFAT_NAME(wfbt_tree)
+{
+    ltfat_int nodesNo;
+    LTFAT_NAME(wfbt_node)* nodes;
+};
+
+typedef enum
+{
+    wfbt_kind_analysis,
+    wfbt_kind_packets,
+    wfbt_kind_synthesis
+} LTFAT_NAME(wfbt_kind);
+
+/* All per-output arrays are indexed by the "flat" output index
+ * nodeoff[node] + m */
+struct LTFAT_NAME(wfbt_plan)
+{
+    LTFAT_NAME(wfbt_tree)* tree;
+    LTFAT_NAME(wfbt_kind) kind;
+    ltfat_int L;
+    ltfat_int W;
+    ltfatExtType ext;
+    ltfat_int* nodeoff;
+    ltfat_int* Lin;
+    ltfat_int* Lo;
+    ltfat_int* offset;
+    // Index of the coefficient array or -1 for outputs stored in the arena
+    ltfat_int* cidx;
+    ltfat_int* bufoff;
+    ltfat_int outNo;
+    ltfat_int* outLens;
+    LTFAT_TYPE* arena;
+    // Nodes sorted by depth
+    ltfat_int depthNo;
+    ltfat_int* depthoff;
+    ltfat_int* nodesbydepth;
+};
+
+LTFAT_API int
+LTFAT_NAME(wfbt_tree_init)(LTFAT_NAME(wfbt_tree)** tree)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(tree);
+
+    CHECKMEM( *tree = LTFAT_NEW(LTFAT_NAME(wfbt_tree)) );
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_tree_done)(LTFAT_NAME(wfbt_tree)** tree)
+{
+    LTFAT_NAME(wfbt_tree)* t;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(tree); CHECKNULL(*tree);
+    t = *tree;
+
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+    {
+        LTFAT_NAME(wfbt_node)* node = &t->nodes[n];
+        if (node->g)
+            for (ltfat_int m = 0; m < node->M; m++)
+                ltfat_safefree(node->g[m]);
+
+        LTFAT_SAFEFREEALL(node->g, node->gl, node->a, node->offset, node->child);
+    }
+
+    ltfat_safefree(t->nodes);
+    ltfat_free(t);
+    *tree = NULL;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_tree_addnode)(LTFAT_NAME(wfbt_tree)* t,
+                              ltfat_int parent, ltfat_int parentout,
+                              const LTFAT_TYPE* g[], const ltfat_int gl[],
+                              const ltfat_int a[], const ltfat_int offset[],
+                              ltfat_int M)
+{
+    LTFAT_NAME(wfbt_node)* node = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(t); CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(offset);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        CHECK(LTFATERR_NULLPOINTER, g[m] != NULL, "g[%td] is a null-pointer.", m);
+        CHECK(LTFATERR_NOTPOSARG, gl[m] > 0, "gl[%td] (passed %td) must be positive.",
+              m, gl[m]);
+        CHECK(LTFATERR_NOTPOSARG, a[m] > 0, "a[%td] (passed %td) must be positive.",
+              m, a[m]);
+    }
+
+    if (parent < 0)
+    {
+        CHECK(LTFATERR_BADARG, t->nodesNo == 0, "The tree already has a root.");
+    }
+    else
+    {
+        CHECK(LTFATERR_BADARG, parent < t->nodesNo,
+              "parent (passed %td) is not a valid node index.", parent);
+        CHECK(LTFATERR_NOTINRANGE,
+              parentout >= 0 && parentout < t->nodes[parent].M,
+              "parentout (passed %td) is not a valid output index.", parentout);
+        CHECK(LTFATERR_BADARG, t->nodes[parent].child[parentout] < 0,
+              "Output %td of node %td is already connected.", parentout, parent);
+    }
+
+    CHECKMEM( t->nodes = LTFAT_POSTPADARRAY(LTFAT_NAME(wfbt_node), t->nodes,
+                         t->nodesNo, t->nodesNo + 1));
+    node = &t->nodes[t->nodesNo++];
+
+    node->M = M;
+    node->parent = parent < 0 ? -1 : parent;
+    node->parentout = parent < 0 ? -1 : parentout;
+    node->depth = parent < 0 ? 0 : t->nodes[parent].depth + 1;
+    CHECKMEM( node->g      = LTFAT_NEWARRAY(LTFAT_TYPE*, M));
+    CHECKMEM( node->gl     = LTFAT_NEWARRAY(ltfat_int, M));
+    CHECKMEM( node->a      = LTFAT_NEWARRAY(ltfat_int, M));
+    CHECKMEM( node->offset = LTFAT_NEWARRAY(ltfat_int, M));
+    CHECKMEM( node->child  = LTFAT_NEWARRAY(ltfat_int, M));
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        CHECKMEM( node->g[m] = LTFAT_NAME(malloc)(gl[m]));
+        memcpy(node->g[m], g[m], gl[m] * sizeof * g[m]);
+        node->child[m] = -1;
+    }
+    memcpy(node->gl, gl, M * sizeof * gl);
+    memcpy(node->a, a, M * sizeof * a);
+    memcpy(node->offset, offset, M * sizeof * offset);
+
+    if (parent >= 0)
+        t->nodes[parent].child[parentout] = t->nodesNo - 1;
+
+    return t->nodesNo - 1;
+error:
+    if (node)
+    {
+        if (node->g)
+            for (ltfat_int m = 0; m < M; m++)
+                ltfat_safefree(node->g[m]);
+
+        LTFAT_SAFEFREEALL(node->g, node->gl, node->a, node->offset, node->child);
+        t->nodesNo--;
+    }
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_tree_init)(const LTFAT_TYPE* g[], const ltfat_int gl[],
+                          const ltfat_int a[], const ltfat_int offset[],
+                          ltfat_int M, ltfat_int J, LTFAT_NAME(wfbt_tree)** tree)
+{
+    LTFAT_NAME(wfbt_tree)* t = NULL;
+    ltfat_int parent = -1;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(tree);
+    CHECK(LTFATERR_NOTPOSARG, J > 0, "J (passed %td) must be positive.", J);
+
+    CHECKSTATUS( LTFAT_NAME(wfbt_tree_init)(&t));
+
+    for (ltfat_int j = 0; j < J; j++)
+    {
+        ltfat_int nodeId =
+            LTFAT_NAME(wfbt_tree_addnode)(t, parent, 0, g, gl, a, offset, M);
+        CHECKSTATUS( nodeId );
+        parent = nodeId;
+    }
+
+    *tree = t;
+    return status;
+error:
+    if (t) LTFAT_NAME(wfbt_tree_done)(&t);
+    return status;
+}
+
+static int
+LTFAT_NAME(wfbt_tree_copy)(const LTFAT_NAME(wfbt_tree)* t,
+                           LTFAT_NAME(wfbt_tree)** tout)
+{
+    LTFAT_NAME(wfbt_tree)* tc = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(wfbt_tree_init)(&tc));
+
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+    {
+        const LTFAT_NAME(wfbt_node)* node = &t->nodes[n];
+
+        CHECKSTATUS(
+            LTFAT_NAME(wfbt_tree_addnode)(tc, node->parent, node->parentout,
+                                          (const LTFAT_TYPE**) node->g, node->gl,
+                                          node->a, node->offset, node->M));
+    }
+
+    *tout = tc;
+    return status;
+error:
+    if (tc) LTFAT_NAME(wfbt_tree_done)(&tc);
+    return status;
+}
+
+/* Assigns coefficient array indices to the terminal outputs in the
+ * depth-first order */
+static void
+LTFAT_NAME(wfbt_dfsorder)(const LTFAT_NAME(wfbt_tree)* t, ltfat_int n,
+                          const ltfat_int nodeoff[], ltfat_int cidx[],
+                          ltfat_int* k)
+{
+    const LTFAT_NAME(wfbt_node)* node = &t->nodes[n];
+
+    for (ltfat_int m = 0; m < node->M; m++)
+    {
+        if (node->child[m] < 0)
+            cidx[nodeoff[n] + m] = (*k)++;
+        else
+            LTFAT_NAME(wfbt_dfsorder)(t, node->child[m], nodeoff, cidx, k);
+    }
+}
+
+static int
+LTFAT_NAME(wfbt_init_common)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L,
+                             ltfat_int W, ltfatExtType ext,
+                             LTFAT_NAME(wfbt_kind) kind,
+                             LTFAT_NAME(wfbt_plan)** pout)
+{
+    LTFAT_NAME(wfbt_plan)* p = NULL;
+    LTFAT_NAME(wfbt_tree)* t;
+    ltfat_int outTotal, arenaLen = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(tree); CHECKNULL(pout);
+    CHECK(LTFATERR_EMPTY, tree->nodesNo > 0, "The tree has no nodes.");
+    CHECK(LTFATERR_NOTPOSARG, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_BADARG, ext >= PER && ext < BAD_TYPE,
+          "Invalid ltfatExtType enum value.");
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(wfbt_plan)) );
+    p->kind = kind; p->L = L; p->W = W; p->ext = ext;
+
+    CHECKSTATUS( LTFAT_NAME(wfbt_tree_copy)(tree, &p->tree));
+    t = p->tree;
+
+    CHECKMEM( p->nodeoff = LTFAT_NEWARRAY(ltfat_int, t->nodesNo + 1));
+    CHECKMEM( p->Lin     = LTFAT_NEWARRAY(ltfat_int, t->nodesNo));
+
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+        p->nodeoff[n + 1] = p->nodeoff[n] + t->nodes[n].M;
+
+    outTotal = p->nodeoff[t->nodesNo];
+    CHECKMEM( p->Lo     = LTFAT_NEWARRAY(ltfat_int, outTotal));
+    CHECKMEM( p->offset = LTFAT_NEWARRAY(ltfat_int, outTotal));
+    CHECKMEM( p->cidx   = LTFAT_NEWARRAY(ltfat_int, outTotal));
+    CHECKMEM( p->bufoff = LTFAT_NEWARRAY(ltfat_int, outTotal));
+
+    // Nodes are added after their parents so Lin of the parent is known
+    p->Lin[0] = L;
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+    {
+        LTFAT_NAME(wfbt_node)* node = &t->nodes[n];
+
+        for (ltfat_int m = 0; m < node->M; m++)
+        {
+            ltfat_int fi = p->nodeoff[n] + m;
+
+            if (ext == PER)
+                p->offset[fi] = node->offset[m];
+            else if (ext == VALID)
+                p->offset[fi] = -(node->gl[m] - 1);
+            else
+                p->offset[fi] = -(node->a[m] - 1);
+
+            CHECK(LTFATERR_NOTINRANGE,
+                  -p->offset[fi] >= 0 && -p->offset[fi] < node->gl[m],
+                  "Filter %td of node %td: The zero index position (offset %td) is outside of the filter support.",
+                  m, n, p->offset[fi]);
+
+            p->Lo[fi] = filterbank_td_size(p->Lin[n], node->a[m], node->gl[m],
+                                           p->offset[fi], ext);
+            CHECK(LTFATERR_BADTRALEN, p->Lo[fi] > 0,
+                  "Output %td of node %td would be empty. The tree is too deep for L=%td.",
+                  m, n, L);
+
+            if (node->child[m] >= 0)
+                p->Lin[node->child[m]] = p->Lo[fi];
+        }
+    }
+
+    // Terminal outputs go directly to the user arrays, all the other
+    // ones are stored in the arena
+    if (kind == wfbt_kind_packets)
+    {
+        for (ltfat_int fi = 0; fi < outTotal; fi++)
+        {
+            p->cidx[fi] = fi;
+            p->bufoff[fi] = -1;
+        }
+        p->outNo = outTotal;
+    }
+    else
+    {
+        p->outNo = 0;
+        LTFAT_NAME(wfbt_dfsorder)(t, 0, p->nodeoff, p->cidx, &p->outNo);
+
+        for (ltfat_int n = 0; n < t->nodesNo; n++)
+        {
+            for (ltfat_int m = 0; m < t->nodes[n].M; m++)
+            {
+                ltfat_int fi = p->nodeoff[n] + m;
+                p->bufoff[fi] = -1;
+                if (t->nodes[n].child[m] >= 0)
+                {
+                    p->cidx[fi] = -1;
+                    p->bufoff[fi] = arenaLen;
+                    arenaLen += p->Lo[fi] * W;
+                }
+            }
+        }
+    }
+
+    CHECKMEM( p->outLens = LTFAT_NEWARRAY(ltfat_int, p->outNo));
+    for (ltfat_int fi = 0; fi < outTotal; fi++)
+        if (p->cidx[fi] >= 0)
+            p->outLens[p->cidx[fi]] = p->Lo[fi];
+
+    if (arenaLen > 0)
+        CHECKMEM( p->arena = LTFAT_NAME(malloc)(arenaLen));
+
+    // Group the nodes by depth
+    p->depthNo = 0;
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+        p->depthNo = ltfat_imax(p->depthNo, t->nodes[n].depth + 1);
+
+    CHECKMEM( p->depthoff     = LTFAT_NEWARRAY(ltfat_int, p->depthNo + 1));
+    CHECKMEM( p->nodesbydepth = LTFAT_NEWARRAY(ltfat_int, t->nodesNo));
+
+    for (ltfat_int n = 0; n < t->nodesNo; n++)
+        p->depthoff[t->nodes[n].depth + 1]++;
+
+    for (ltfat_int d = 0; d < p->depthNo; d++)
+        p->depthoff[d + 1] += p->depthoff[d];
+
+    for (ltfat_int d = 0, k = 0; d < p->depthNo; d++)
+        for (ltfat_int n = 0; n < t->nodesNo; n++)
+            if (t->nodes[n].depth == d)
+                p->nodesbydepth[k++] = n;
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(wfbt_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                      ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan)
+{
+    return LTFAT_NAME(wfbt_init_common)(tree, L, W, ext,
+                                        wfbt_kind_analysis, plan);
+}
+
+LTFAT_API int
+LTFAT_NAME(wpfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                       ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan)
+{
+    return LTFAT_NAME(wfbt_init_common)(tree, L, W, ext,
+                                        wfbt_kind_packets, plan);
+}
+
+LTFAT_API int
+LTFAT_NAME(iwfbt_init)(const LTFAT_NAME(wfbt_tree)* tree, ltfat_int L, ltfat_int W,
+                       ltfatExtType ext, LTFAT_NAME(wfbt_plan)** plan)
+{
+    return LTFAT_NAME(wfbt_init_common)(tree, L, W, ext,
+                                        wfbt_kind_synthesis, plan);
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_done)(LTFAT_NAME(wfbt_plan)** plan)
+{
+    LTFAT_NAME(wfbt_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    pp = *plan;
+    if (pp->tree) LTFAT_NAME(wfbt_tree_done)(&pp->tree);
+    LTFAT_SAFEFREEALL(pp->nodeoff, pp->Lin, pp->Lo, pp->offset, pp->cidx,
+                      pp->bufoff, pp->outLens, pp->arena, pp->depthoff,
+                      pp->nodesbydepth);
+    ltfat_free(pp);
+    *plan = NULL;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_get_outno)(const LTFAT_NAME(wfbt_plan)* plan)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    return plan->outNo;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_get_outlens)(const LTFAT_NAME(wfbt_plan)* plan, ltfat_int Lc[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(Lc);
+    memcpy(Lc, plan->outLens, plan->outNo * sizeof * Lc);
+error:
+    return status;
+}
+
+/* Buffer holding output fi (all channels) */
+static inline LTFAT_TYPE*
+LTFAT_NAME(wfbt_outbuf)(const LTFAT_NAME(wfbt_plan)* p, ltfat_int fi,
+                        LTFAT_TYPE* c[])
+{
+    return p->cidx[fi] >= 0 ? c[p->cidx[fi]] : p->arena + p->bufoff[fi];
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_execute)(LTFAT_NAME(wfbt_plan)* p, const LTFAT_TYPE f[],
+                         LTFAT_TYPE* c[])
+{
+    LTFAT_NAME(wfbt_tree)* t;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADARG, p->kind != wfbt_kind_synthesis,
+          "The plan was created by iwfbt_init.");
+    for (ltfat_int k = 0; k < p->outNo; k++)
+        CHECK(LTFATERR_NULLPOINTER, c[k] != NULL, "c[%td] is a null-pointer.", k);
+
+    t = p->tree;
+
+    // Nodes at the same depth only depend on the previous depth. Each
+    // (output, channel) pair of a depth level is an independent task.
+    for (ltfat_int d = 0; d < p->depthNo; d++)
+    {
+        ltfat_int nStart = p->depthoff[d];
+        ltfat_int taskNo = 0;
+
+        for (ltfat_int k = nStart; k < p->depthoff[d + 1]; k++)
+            taskNo += t->nodes[p->nodesbydepth[k]].M;
+
+        LTFAT_OMP(parallel for schedule(dynamic))
+        for (ltfat_int task = 0; task < taskNo * p->W; task++)
+        {
+            ltfat_int w = task % p->W;
+            ltfat_int k = nStart, mIdx = task / p->W;
+            ltfat_int n, m, fi;
+            const LTFAT_NAME(wfbt_node)* node;
+            const LTFAT_TYPE* in;
+
+            while (mIdx >= t->nodes[p->nodesbydepth[k]].M)
+                mIdx -= t->nodes[p->nodesbydepth[k++]].M;
+
+            n = p->nodesbydepth[k];
+            node = &t->nodes[n];
+            m = mIdx;
+            fi = p->nodeoff[n] + m;
+
+            if (node->parent < 0)
+                in = f;
+            else
+                in = LTFAT_NAME(wfbt_outbuf)(p, p->nodeoff[node->parent] +
+                                             node->parentout, c);
+
+            LTFAT_NAME(convsub_td)(in + w * p->Lin[n], node->g[m], p->Lin[n],
+                                   node->gl[m], node->a[m], p->offset[fi],
+                                   LTFAT_NAME(wfbt_outbuf)(p, fi, c) + w * p->Lo[fi],
+                                   p->ext);
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(iwfbt_execute)(LTFAT_NAME(wfbt_plan)* p, const LTFAT_TYPE* c[],
+                          LTFAT_TYPE f[])
+{
+    LTFAT_NAME(wfbt_tree)* t;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_BADARG, p->kind == wfbt_kind_synthesis,
+          "The plan was not created by iwfbt_init.");
+    for (ltfat_int k = 0; k < p->outNo; k++)
+        CHECK(LTFATERR_NULLPOINTER, c[k] != NULL, "c[%td] is a null-pointer.", k);
+
+    t = p->tree;
+
+    // From the leaves to the root. The filters of a node accumulate to the
+    // same buffer, (node, channel) pairs of a depth level are independent.
+    for (ltfat_int d = p->depthNo - 1; d >= 0; d--)
+    {
+        ltfat_int nStart = p->depthoff[d];
+        ltfat_int nNo = p->depthoff[d + 1] - nStart;
+
+        LTFAT_OMP(parallel for schedule(dynamic))
+        for (ltfat_int task = 0; task < nNo * p->W; task++)
+        {
+            ltfat_int w = task % p->W;
+            ltfat_int n = p->nodesbydepth[nStart + task / p->W];
+            const LTFAT_NAME(wfbt_node)* node = &t->nodes[n];
+            LTFAT_TYPE* out;
+
+            if (node->parent < 0)
+                out = f;
+            else
+                out = p->arena + p->bufoff[p->nodeoff[node->parent] +
+                                           node->parentout];
+            out += w * p->Lin[n];
+
+            for (ltfat_int l = 0; l < p->Lin[n]; l++)
+                out[l] = 0.0;
+
+            for (ltfat_int m = 0; m < node->M; m++)
+            {
+                ltfat_int fi = p->nodeoff[n] + m;
+                const LTFAT_TYPE* in = p->cidx[fi] >= 0 ?
+                                       c[p->cidx[fi]] : p->arena + p->bufoff[fi];
+
+                LTFAT_NAME(upconv_td)(in + w * p->Lo[fi], node->g[m], p->Lin[n],
+                                      node->gl[m], node->a[m], p->offset[fi],
+                                      out, p->ext);
+            }
+        }
+    }
+
+error:
+    return status;
+}
@@ -0,0 +1,737 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+#include "wilson_fb_private.h"
+
+/* All plans process the frames in blocks of blocksize frames transformed
+ * by a single batched FFT, see dgtreal_fb_execute. */
+
+struct LTFAT_NAME(dwilt_fb_plan)
+{
+    ltfat_int M;
+    ltfat_int gl;
+    ltfat_int blocksize;
+    LTFAT_NAME_REAL(fftreal_plan)* p_small;
+    LTFAT_NAME_REAL(fftreal_plan)* p_block;
+    LTFAT_REAL*    sbuf; // Folded frames, 2M x blocksize
+    LTFAT_COMPLEX* cbuf; // Their spectra, M+1 x blocksize
+    LTFAT_REAL* gw;
+};
+
+struct LTFAT_NAME(idwilt_fb_plan)
+{
+    ltfat_int M;
+    ltfat_int gl;
+    ltfat_int blocksize;
+    LTFAT_NAME_REAL(ifftreal_plan)* p_small;
+    LTFAT_NAME_REAL(ifftreal_plan)* p_block;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL*    sbuf;
+    LTFAT_REAL* gw;
+};
+
+struct LTFAT_NAME(wmdct_fb_plan)
+{
+    ltfat_int M;
+    ltfat_int gl;
+    ltfat_int blocksize;
+    LTFAT_NAME_REAL(ifftreal_plan)* p_small;
+    LTFAT_NAME_REAL(ifftreal_plan)* p_block;
+    LTFAT_COMPLEX* cbuf; // DCT inputs, M/2+1 x blocksize
+    LTFAT_REAL*    sbuf; // DCT outputs, M x blocksize
+    LTFAT_REAL*    fbuf; // Folded frame, 4M
+    LTFAT_REAL*    zbuf; // Folded frame, M+1
+    LTFAT_COMPLEX* tw;   // exp(i*pi*k/(2M)), k=0,...,M/2
+    LTFAT_REAL* gw;
+};
+
+struct LTFAT_NAME(iwmdct_fb_plan)
+{
+    ltfat_int M;
+    ltfat_int gl;
+    ltfat_int blocksize;
+    LTFAT_NAME_REAL(fftreal_plan)* p_small;
+    LTFAT_NAME_REAL(fftreal_plan)* p_block;
+    LTFAT_REAL*    sbuf;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL*    fbuf;
+    LTFAT_REAL*    zbuf;
+    LTFAT_COMPLEX* tw;
+    LTFAT_REAL* gw;
+};
+
+/* Windows the frame starting at f[start] and sums it modulo Lfold to out.
+ * Unlike windowfold_array, the sample f[l] always goes to out[l % Lfold],
+ * also when the frame wraps around the end of f. This matches the
+ * modulation of the whole signal done by dwiltiii_long. */
+static void
+LTFAT_NAME(wilson_fb_fold)(const LTFAT_REAL* f, ltfat_int L, ltfat_int start,
+                           const LTFAT_REAL* gw, ltfat_int gl,
+                           ltfat_int Lfold, LTFAT_REAL* out)
+{
+    ltfat_int inIdx = ltfat_positiverem(start, L);
+    ltfat_int outIdx = inIdx % Lfold;
+
+    memset(out, 0, Lfold * sizeof * out);
+
+    for (ltfat_int l = 0; l < gl;)
+    {
+        ltfat_int run = gl - l;
+        if (L - inIdx < run) run = L - inIdx;
+        if (Lfold - outIdx < run) run = Lfold - outIdx;
+
+        for (ltfat_int ii = 0; ii < run; ii++)
+            out[outIdx + ii] += f[inIdx + ii] * gw[l + ii];
+
+        l += run;
+        inIdx += run;
+        outIdx += run;
+        if (inIdx == L) inIdx = outIdx = 0;
+        if (outIdx == Lfold) outIdx = 0;
+    }
+}
+
+/* Adjoint of wilson_fb_fold, the windowed frame is added to f */
+static void
+LTFAT_NAME(wilson_fb_unfold)(const LTFAT_REAL* in, ltfat_int Lfold,
+                             const LTFAT_REAL* gw, ltfat_int gl,
+                             ltfat_int start, ltfat_int L, LTFAT_REAL* f)
+{
+    ltfat_int inIdx = ltfat_positiverem(start, L);
+    ltfat_int outIdx = inIdx % Lfold;
+
+    for (ltfat_int l = 0; l < gl;)
+    {
+        ltfat_int run = gl - l;
+        if (L - inIdx < run) run = L - inIdx;
+        if (Lfold - outIdx < run) run = Lfold - outIdx;
+
+        for (ltfat_int ii = 0; ii < run; ii++)
+            f[inIdx + ii] += in[outIdx + ii] * gw[l + ii];
+
+        l += run;
+        inIdx += run;
+        outIdx += run;
+        if (inIdx == L) inIdx = outIdx = 0;
+        if (outIdx == Lfold) outIdx = 0;
+    }
+}
+
+/* -------------------------- DWILT ------------------------------ */
+
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          unsigned flags, LTFAT_NAME(dwilt_fb_plan)** pout)
+{
+    LTFAT_NAME(dwilt_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive.", gl);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dwilt_fb_plan)) );
+    p->M = M; p->gl = gl;
+    p->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / ((M + 1) * sizeof(LTFAT_COMPLEX)));
+
+    CHECKMEM( p->gw   = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->sbuf = LTFAT_NAME_REAL(malloc)(p->blocksize * 2 * M));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->blocksize * (M + 1)));
+
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(2 * M, 1, p->sbuf, p->cbuf, flags,
+                                      &p->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(2 * M, p->blocksize, p->sbuf, p->cbuf,
+                                      flags, &p->p_block));
+
+    LTFAT_NAME_REAL(fftshift)(g, gl, p->gw);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(dwilt_fb_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_done)(LTFAT_NAME(dwilt_fb_plan)** p)
+{
+    LTFAT_NAME(dwilt_fb_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->gw);
+    if (pp->p_small) LTFAT_NAME_REAL(fftreal_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(fftreal_done)(&pp->p_block);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+/* Picks the coefficients of the n-th frame from the 2M-channel DGT frame X.
+ * For even M, the Nyquist coefficient of an even frame is the first
+ * coefficient of the following frame. */
+static void
+LTFAT_NAME(dwilt_fb_postframe)(ltfat_int M, ltfat_int n, const LTFAT_COMPLEX* X,
+                               LTFAT_REAL* c)
+{
+    const LTFAT_REAL scalconst = (LTFAT_REAL) sqrt(2.0);
+
+    if (n % 2 == 0)
+    {
+        c[0] = ltfat_real(X[0]);
+
+        for (ltfat_int m = 1; m < M; m += 2)
+            c[m] = -scalconst * ltfat_imag(X[m]);
+
+        for (ltfat_int m = 2; m < M; m += 2)
+            c[m] = scalconst * ltfat_real(X[m]);
+
+        if (M % 2 == 0) c[M] = ltfat_real(X[M]);
+    }
+    else
+    {
+        for (ltfat_int m = 1; m < M; m += 2)
+            c[m] = scalconst * ltfat_real(X[m]);
+
+        for (ltfat_int m = 2; m < M; m += 2)
+            c[m] = -scalconst * ltfat_imag(X[m]);
+
+        if (M % 2) c[0] = ltfat_real(X[M]);
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dwilt_fb_execute)(LTFAT_NAME(dwilt_fb_plan)* p,
+                             const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                             LTFAT_REAL c[])
+{
+    ltfat_int M, N, K, glh;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % (2 * p->M)),
+          "L (passed %td) must be greater or equal to gl and divisible by 2M (passed %td).",
+          L, 2 * p->M);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    M = p->M;
+    N = L / M;
+    K = p->blocksize;
+    glh = p->gl / 2;
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* fchan = f + w * L;
+        LTFAT_REAL* cchan = c + w * M * N;
+
+        for (ltfat_int n = 0; n < N; n += K)
+        {
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(wilson_fb_fold)(fchan, L, (n + k) * M - glh,
+                                               p->gw, p->gl, 2 * M,
+                                               p->sbuf + k * 2 * M);
+
+                LTFAT_NAME_REAL(fftreal_execute)(p->p_block);
+
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(dwilt_fb_postframe)(M, n + k, p->cbuf + k * (M + 1),
+                                                   cchan + (n + k) * M);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(wilson_fb_fold)(fchan, L, k * M - glh, p->gw,
+                                               p->gl, 2 * M, p->sbuf);
+                    LTFAT_NAME_REAL(fftreal_execute)(p->p_small);
+                    LTFAT_NAME(dwilt_fb_postframe)(M, k, p->cbuf, cchan + k * M);
+                }
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+/* -------------------------- IDWILT ----------------------------- */
+
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                           unsigned flags, LTFAT_NAME(idwilt_fb_plan)** pout)
+{
+    LTFAT_NAME(idwilt_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive.", gl);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(idwilt_fb_plan)) );
+    p->M = M; p->gl = gl;
+    p->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / ((M + 1) * sizeof(LTFAT_COMPLEX)));
+
+    CHECKMEM( p->gw   = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->blocksize * (M + 1)));
+    CHECKMEM( p->sbuf = LTFAT_NAME_REAL(malloc)(p->blocksize * 2 * M));
+
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(ifftreal_init)(2 * M, 1, p->cbuf, p->sbuf, flags,
+                                       &p->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(ifftreal_init)(2 * M, p->blocksize, p->cbuf, p->sbuf,
+                                       flags, &p->p_block));
+
+    LTFAT_NAME_REAL(fftshift)(g, gl, p->gw);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(idwilt_fb_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_done)(LTFAT_NAME(idwilt_fb_plan)** p)
+{
+    LTFAT_NAME(idwilt_fb_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->gw);
+    if (pp->p_small) LTFAT_NAME_REAL(ifftreal_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(ifftreal_done)(&pp->p_block);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+/* Adjoint of dwilt_fb_postframe */
+static void
+LTFAT_NAME(idwilt_fb_preframe)(ltfat_int M, ltfat_int n, const LTFAT_REAL* c,
+                               LTFAT_COMPLEX* X)
+{
+    const LTFAT_REAL scalconst = (LTFAT_REAL) ( 1.0 / sqrt(2.0) );
+
+    if (n % 2 == 0)
+    {
+        X[0] = c[0];
+
+        for (ltfat_int m = 1; m < M; m += 2)
+            X[m] = -I * scalconst * c[m];
+
+        for (ltfat_int m = 2; m < M; m += 2)
+            X[m] = scalconst * c[m];
+
+        X[M] = M % 2 ? (LTFAT_REAL) 0.0 : c[M];
+    }
+    else
+    {
+        X[0] = (LTFAT_REAL) 0.0;
+
+        for (ltfat_int m = 1; m < M; m += 2)
+            X[m] = scalconst * c[m];
+
+        for (ltfat_int m = 2; m < M; m += 2)
+            X[m] = -I * scalconst * c[m];
+
+        X[M] = M % 2 ? c[0] : (LTFAT_REAL) 0.0;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(idwilt_fb_execute)(LTFAT_NAME(idwilt_fb_plan)* p,
+                              const LTFAT_REAL c[], ltfat_int L, ltfat_int W,
+                              LTFAT_REAL f[])
+{
+    ltfat_int M, N, K, glh;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % (2 * p->M)),
+          "L (passed %td) must be greater or equal to gl and divisible by 2M (passed %td).",
+          L, 2 * p->M);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    M = p->M;
+    N = L / M;
+    K = p->blocksize;
+    glh = p->gl / 2;
+
+    memset(f, 0, L * W * sizeof * f);
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* cchan = c + w * M * N;
+        LTFAT_REAL* fchan = f + w * L;
+
+        for (ltfat_int n = 0; n < N; n += K)
+        {
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(idwilt_fb_preframe)(M, n + k, cchan + (n + k) * M,
+                                                   p->cbuf + k * (M + 1));
+
+                LTFAT_NAME_REAL(ifftreal_execute)(p->p_block);
+
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(wilson_fb_unfold)(p->sbuf + k * 2 * M, 2 * M,
+                                                 p->gw, p->gl, (n + k) * M - glh,
+                                                 L, fchan);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(idwilt_fb_preframe)(M, k, cchan + k * M, p->cbuf);
+                    LTFAT_NAME_REAL(ifftreal_execute)(p->p_small);
+                    LTFAT_NAME(wilson_fb_unfold)(p->sbuf, 2 * M, p->gw, p->gl,
+                                                 k * M - glh, L, fchan);
+                }
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+/* -------------------------- WMDCT ------------------------------ */
+
+/* With the frame h_n[l] = f[l]g[l-nM] folded modulo 4M to b, the
+ * coefficients of dwiltiii are
+ *
+ *   c[m,n] = sum_{j=0}^{M-1} z[j] cos(pi(2m+1)j/(2M)),
+ *
+ * where, denoting y[r] = b[r] - b[r+2M] and s = (-1)^n,
+ *
+ *   z[0] = y[0] - s y[M],
+ *   z[j] = y[j] - s y[M+j] - y[2M-j] - s y[M-j],  j = 1,...,M-1.
+ *
+ * The sum is a DCT-III, which is computed using a real IFFT of length M
+ * (J. Makhoul, A fast cosine transform in one and two dimensions, 1980). */
+
+void
+LTFAT_NAME(wmdct_fb_twiddles)(ltfat_int M, LTFAT_COMPLEX* tw)
+{
+    for (ltfat_int k = 0; k < M / 2 + 1; k++)
+        tw[k] = exp(I * (LTFAT_REAL)( M_PI * k / (2.0 * M)));
+}
+
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                          unsigned flags, LTFAT_NAME(wmdct_fb_plan)** pout)
+{
+    LTFAT_NAME(wmdct_fb_plan)* p = NULL;
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive.", gl);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(wmdct_fb_plan)) );
+    p->M = M; p->gl = gl;
+    M2 = M / 2 + 1;
+    p->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / (M2 * sizeof(LTFAT_COMPLEX)));
+
+    CHECKMEM( p->gw   = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->blocksize * M2));
+    CHECKMEM( p->sbuf = LTFAT_NAME_REAL(malloc)(p->blocksize * M));
+    CHECKMEM( p->fbuf = LTFAT_NAME_REAL(malloc)(4 * M));
+    CHECKMEM( p->zbuf = LTFAT_NAME_REAL(malloc)(M + 1));
+    CHECKMEM( p->tw   = LTFAT_NAME_COMPLEX(malloc)(M2));
+
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(ifftreal_init)(M, 1, p->cbuf, p->sbuf, flags,
+                                       &p->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(ifftreal_init)(M, p->blocksize, p->cbuf, p->sbuf,
+                                       flags, &p->p_block));
+
+    LTFAT_NAME_REAL(fftshift)(g, gl, p->gw);
+    LTFAT_NAME(wmdct_fb_twiddles)(M, p->tw);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(wmdct_fb_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_done)(LTFAT_NAME(wmdct_fb_plan)** p)
+{
+    LTFAT_NAME(wmdct_fb_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->fbuf, pp->zbuf, pp->tw, pp->gw);
+    if (pp->p_small) LTFAT_NAME_REAL(ifftreal_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(ifftreal_done)(&pp->p_block);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+/* Folds the n-th frame and prepares the input of the IFFT */
+static void
+LTFAT_NAME(wmdct_fb_preframe)(LTFAT_NAME(wmdct_fb_plan)* p, const LTFAT_REAL* f,
+                              ltfat_int L, ltfat_int n, LTFAT_COMPLEX* V)
+{
+    LTFAT_NAME(wilson_fb_fold)(f, L, n * p->M - p->gl / 2, p->gw, p->gl,
+                               4 * p->M, p->fbuf);
+    LTFAT_NAME(wmdct_fb_foldtodct)(p->M, n, p->tw, p->fbuf, p->zbuf, V);
+}
+
+void
+LTFAT_NAME(wmdct_fb_foldtodct)(ltfat_int M, ltfat_int n, const LTFAT_COMPLEX* tw,
+                               LTFAT_REAL* y, LTFAT_REAL* z, LTFAT_COMPLEX* V)
+{
+    LTFAT_REAL s = n % 2 ? -1.0 : 1.0;
+
+    for (ltfat_int r = 0; r < 2 * M; r++)
+        y[r] -= y[r + 2 * M];
+
+    z[0] = y[0] - s * y[M];
+    for (ltfat_int j = 1; j < M; j++)
+        z[j] = y[j] - s * y[M + j] - y[2 * M - j] - s * y[M - j];
+    z[M] = 0.0;
+
+    V[0] = z[0];
+    for (ltfat_int k = 1; k < M / 2 + 1; k++)
+        V[k] = (LTFAT_REAL) 0.5 * (z[k] - I * z[M - k]) * tw[k];
+}
+
+void
+LTFAT_NAME(wmdct_fb_postframe)(ltfat_int M, const LTFAT_REAL* v, LTFAT_REAL* c)
+{
+    for (ltfat_int q = 0; q < (M + 1) / 2; q++)
+        c[2 * q] = v[q];
+
+    for (ltfat_int q = 0; q < M / 2; q++)
+        c[2 * q + 1] = v[M - 1 - q];
+}
+
+LTFAT_API int
+LTFAT_NAME(wmdct_fb_execute)(LTFAT_NAME(wmdct_fb_plan)* p,
+                             const LTFAT_REAL f[], ltfat_int L, ltfat_int W,
+                             LTFAT_REAL c[])
+{
+    ltfat_int M, M2, N, K;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % (2 * p->M)),
+          "L (passed %td) must be greater or equal to gl and divisible by 2M (passed %td).",
+          L, 2 * p->M);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    M = p->M;
+    M2 = M / 2 + 1;
+    N = L / M;
+    K = p->blocksize;
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* fchan = f + w * L;
+        LTFAT_REAL* cchan = c + w * M * N;
+
+        for (ltfat_int n = 0; n < N; n += K)
+        {
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(wmdct_fb_preframe)(p, fchan, L, n + k,
+                                                  p->cbuf + k * M2);
+
+                LTFAT_NAME_REAL(ifftreal_execute)(p->p_block);
+
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(wmdct_fb_postframe)(M, p->sbuf + k * M,
+                                                   cchan + (n + k) * M);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(wmdct_fb_preframe)(p, fchan, L, k, p->cbuf);
+                    LTFAT_NAME_REAL(ifftreal_execute)(p->p_small);
+                    LTFAT_NAME(wmdct_fb_postframe)(M, p->sbuf, cchan + k * M);
+                }
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+/* -------------------------- IWMDCT ----------------------------- */
+
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int M,
+                           unsigned flags, LTFAT_NAME(iwmdct_fb_plan)** pout)
+{
+    LTFAT_NAME(iwmdct_fb_plan)* p = NULL;
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive.", gl);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(iwmdct_fb_plan)) );
+    p->M = M; p->gl = gl;
+    M2 = M / 2 + 1;
+    p->blocksize = ltfat_imax(1, LTFAT_FFTBATCHBYTES / (M2 * sizeof(LTFAT_COMPLEX)));
+
+    CHECKMEM( p->gw   = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM( p->sbuf = LTFAT_NAME_REAL(malloc)(p->blocksize * M));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->blocksize * M2));
+    CHECKMEM( p->fbuf = LTFAT_NAME_REAL(malloc)(4 * M));
+    CHECKMEM( p->zbuf = LTFAT_NAME_REAL(malloc)(M));
+    CHECKMEM( p->tw   = LTFAT_NAME_COMPLEX(malloc)(M2));
+
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(M, 1, p->sbuf, p->cbuf, flags,
+                                      &p->p_small));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(M, p->blocksize, p->sbuf, p->cbuf,
+                                      flags, &p->p_block));
+
+    LTFAT_NAME_REAL(fftshift)(g, gl, p->gw);
+    LTFAT_NAME(wmdct_fb_twiddles)(M, p->tw);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(iwmdct_fb_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_done)(LTFAT_NAME(iwmdct_fb_plan)** p)
+{
+    LTFAT_NAME(iwmdct_fb_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->fbuf, pp->zbuf, pp->tw, pp->gw);
+    if (pp->p_small) LTFAT_NAME_REAL(fftreal_done)(&pp->p_small);
+    if (pp->p_block) LTFAT_NAME_REAL(fftreal_done)(&pp->p_block);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+void
+LTFAT_NAME(iwmdct_fb_preframe)(ltfat_int M, const LTFAT_REAL* c, LTFAT_REAL* v)
+{
+    for (ltfat_int q = 0; q < (M + 1) / 2; q++)
+        v[q] = c[2 * q];
+
+    for (ltfat_int q = 0; q < M / 2; q++)
+        v[M - 1 - q] = c[2 * q + 1];
+}
+
+void
+LTFAT_NAME(iwmdct_fb_dcttofold)(ltfat_int M, ltfat_int n, const LTFAT_COMPLEX* tw,
+                                const LTFAT_COMPLEX* V, LTFAT_REAL* z, LTFAT_REAL* y)
+{
+    LTFAT_REAL s = n % 2 ? -1.0 : 1.0;
+
+    for (ltfat_int k = 0; k < M / 2 + 1; k++)
+    {
+        LTFAT_COMPLEX zk = V[k] * conj(tw[k]);
+        z[k] = ltfat_real(zk);
+        if (k > 0 && 2 * k != M)
+            z[M - k] = -ltfat_imag(zk);
+    }
+
+    memset(y, 0, 2 * M * sizeof * y);
+
+    y[0] += z[0];
+    y[M] -= s * z[0];
+    for (ltfat_int j = 1; j < M; j++)
+    {
+        y[j]         += z[j];
+        y[M + j]     -= s * z[j];
+        y[2 * M - j] -= z[j];
+        y[M - j]     -= s * z[j];
+    }
+
+    for (ltfat_int r = 0; r < 2 * M; r++)
+        y[r + 2 * M] = -y[r];
+}
+
+/* Adjoint of wmdct_fb_preframe. The FFT output is turned into a DCT-II
+ * which is unfolded and added to the n-th frame of f. */
+static void
+LTFAT_NAME(iwmdct_fb_postframe)(LTFAT_NAME(iwmdct_fb_plan)* p,
+                                const LTFAT_COMPLEX* V, ltfat_int n,
+                                ltfat_int L, LTFAT_REAL* f)
+{
+    LTFAT_NAME(iwmdct_fb_dcttofold)(p->M, n, p->tw, V, p->zbuf, p->fbuf);
+    LTFAT_NAME(wilson_fb_unfold)(p->fbuf, 4 * p->M, p->gw, p->gl,
+                                 n * p->M - p->gl / 2, L, f);
+}
+
+LTFAT_API int
+LTFAT_NAME(iwmdct_fb_execute)(LTFAT_NAME(iwmdct_fb_plan)* p,
+                              const LTFAT_REAL c[], ltfat_int L, ltfat_int W,
+                              LTFAT_REAL f[])
+{
+    ltfat_int M, M2, N, K;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % (2 * p->M)),
+          "L (passed %td) must be greater or equal to gl and divisible by 2M (passed %td).",
+          L, 2 * p->M);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    M = p->M;
+    M2 = M / 2 + 1;
+    N = L / M;
+    K = p->blocksize;
+
+    memset(f, 0, L * W * sizeof * f);
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* cchan = c + w * M * N;
+        LTFAT_REAL* fchan = f + w * L;
+
+        for (ltfat_int n = 0; n < N; n += K)
+        {
+            if (N - n >= K)
+            {
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(iwmdct_fb_preframe)(M, cchan + (n + k) * M,
+                                                   p->sbuf + k * M);
+
+                LTFAT_NAME_REAL(fftreal_execute)(p->p_block);
+
+                for (ltfat_int k = 0; k < K; k++)
+                    LTFAT_NAME(iwmdct_fb_postframe)(p, p->cbuf + k * M2, n + k,
+                                                    L, fchan);
+            }
+            else
+            {
+                for (ltfat_int k = n; k < N; k++)
+                {
+                    LTFAT_NAME(iwmdct_fb_preframe)(M, cchan + k * M, p->sbuf);
+                    LTFAT_NAME_REAL(fftreal_execute)(p->p_small);
+                    LTFAT_NAME(iwmdct_fb_postframe)(p, p->cbuf, k, L, fchan);
+                }
+            }
+        }
+    }
+
+error:
+    return status;
+}
@@ -0,0 +1,40 @@
+#ifndef _LTFAT_WILSON_FB_PRIVATE_H
+#define _LTFAT_WILSON_FB_PRIVATE_H
+
+
+#endif
+
+/* Building blocks of the WMDCT plans shared with rtwmdct.c.
+ *
+ * The n-th frame is windowed and folded modulo 4M to y such that the signal
+ * sample at time n*M - gl/2 + l goes to y[(n*M - gl/2 + l) mod 4M].
+ * The coefficients are then obtained as
+ *
+ *   wmdct_fb_foldtodct -> ifftreal of length M -> wmdct_fb_postframe
+ *
+ * and the synthesis uses the adjoint steps
+ *
+ *   iwmdct_fb_preframe -> fftreal of length M -> iwmdct_fb_dcttofold
+ */
+
+/* tw must have M/2+1 elements */
+void
+LTFAT_NAME(wmdct_fb_twiddles)(ltfat_int M, LTFAT_COMPLEX* tw);
+
+/* y (4M) is overwritten, z (M+1) is a work buffer, V has M/2+1 elements */
+void
+LTFAT_NAME(wmdct_fb_foldtodct)(ltfat_int M, ltfat_int n, const LTFAT_COMPLEX* tw,
+                               LTFAT_REAL* y, LTFAT_REAL* z, LTFAT_COMPLEX* V);
+
+/* Unshuffles the IFFT output v to the coefficients c */
+void
+LTFAT_NAME(wmdct_fb_postframe)(ltfat_int M, const LTFAT_REAL* v, LTFAT_REAL* c);
+
+/* Adjoint of wmdct_fb_postframe */
+void
+LTFAT_NAME(iwmdct_fb_preframe)(ltfat_int M, const LTFAT_REAL* c, LTFAT_REAL* v);
+
+/* Adjoint of wmdct_fb_foldtodct. z (M) is a work buffer, y (4M) is overwritten */
+void
+LTFAT_NAME(iwmdct_fb_dcttofold)(ltfat_int M, ltfat_int n, const LTFAT_COMPLEX* tw,
+                                const LTFAT_COMPLEX* V, LTFAT_REAL* z, LTFAT_REAL* y);
@@ -2,6 +2,8 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+#include "ltfat/thirdparty/fftw3.h"
+
 
 #define CH(name) LTFAT_COMPLEXH(name)
 
@@ -110,7 +112,7 @@ LTFAT_NAME_REAL(dwiltiii_long)(const LTFAT_REAL* f, const LTFAT_REAL* g,
 
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_COMPLEX(dwiltiii_fb)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
                                 ltfat_int L, ltfat_int gl,
                                 ltfat_int W, ltfat_int M,
@@ -130,46 +132,40 @@ LTFAT_NAME_COMPLEX(dwiltiii_fb)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
     PREPROC
 
     /* coef2=comp_dgt(f,g,a,2*M,L); */
-    LTFAT_NAME_COMPLEX(dgt_fb)(f2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
+    int status =
+        LTFAT_NAME_COMPLEX(dgt_fb)(f2, g, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
 
 
     LTFAT_COMPLEX* pcoef  = cout;
     LTFAT_COMPLEX* pcoef2 = coef2;
 
-    POSTPROC_COMPLEX
+    if (status == LTFATERR_SUCCESS)
+    {
+        POSTPROC_COMPLEX
+    }
 
     LTFAT_SAFEFREEALL(coef2, f2);
-
+    return status;
 }
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME_REAL(dwiltiii_fb)(const LTFAT_REAL* f, const LTFAT_REAL* g,
                              ltfat_int L, ltfat_int gl,
                              ltfat_int W, ltfat_int M,
                              LTFAT_REAL* cout)
 {
-    ltfat_int N = L / M;
-    ltfat_int M2 = 2 * M;
-    ltfat_int M4 = 4 * M;
-
-    LTFAT_COMPLEX* coef2 = LTFAT_NAME_COMPLEX(malloc)(2 * M * N * W);
-    LTFAT_COMPLEX* f2 = LTFAT_NAME_COMPLEX(malloc)(L * W);
-    LTFAT_COMPLEX* g2 = LTFAT_NAME_COMPLEX(malloc)(gl);
-
-    //Real to complex
-    for (ltfat_int ii = 0; ii < gl; ii++)
-        g2[ii] = g[ii];
-
-    PREPROC
+    LTFAT_NAME(wmdct_fb_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_NAME_COMPLEX(dgt_fb)(f2, g2, L, gl, W, M, 2 * M, LTFAT_FREQINV, coef2);
+    CHECKSTATUS(
+        LTFAT_NAME(wmdct_fb_init)(g, gl, M, FFTW_ESTIMATE, &p));
 
-    LTFAT_REAL* pcoef  = cout;
-    LTFAT_COMPLEX* pcoef2 = coef2;
+    CHECKSTATUS(
+        LTFAT_NAME(wmdct_fb_execute)(p, f, L, W, cout));
 
-    POSTPROC_REAL
-
-    LTFAT_SAFEFREEALL(coef2, f2, g2);
+error:
+    if (p) LTFAT_NAME(wmdct_fb_done)(&p);
+    return status;
 }
 
 #undef CH
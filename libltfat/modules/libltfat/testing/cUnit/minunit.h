@@ -84,6 +84,11 @@ void fillRand_s(float *in, int L);
 void fillRand_dc(double _Complex *in, int L);
 void fillRand_sc(float _Complex *in, int L);
 
+double absDiff_d(double x, double y);
+float absDiff_s(float x, float y);
+double absDiff_dc(double _Complex x, double _Complex y);
+float absDiff_sc(float _Complex x, float _Complex y);
+
 
 /*
 Fills array with pseudorandom values in range [0-1]
@@ -136,6 +141,29 @@ void fillRand_sc(float _Complex* f, int L)
 
 
 
+/*
+Absolute value of the difference of two samples of the same type
+*/
+double absDiff_d(double x, double y)
+{
+    return fabs(x - y);
+}
+
+float absDiff_s(float x, float y)
+{
+    return fabsf(x - y);
+}
+
+double absDiff_dc(double _Complex x, double _Complex y)
+{
+    return cabs(x - y);
+}
+
+float absDiff_sc(float _Complex x, float _Complex y)
+{
+    return cabsf(x - y);
+}
+
 
 
 #endif
@@ -21,11 +21,30 @@ void all_tests()
     mu_run_test_singledoublecomplex(test_idgt_fb);
     mu_run_test_singledoublecomplex(test_dgt_long);
     mu_run_test_singledoublecomplex(test_idgt_long);
+    mu_run_test_singledoublecomplex(test_wfbt);
+    mu_run_test_singledoublecomplex(test_convsub_td);
     mu_run_test_singledouble(test_dgtreal_fb);
     mu_run_test_singledouble(test_idgtreal_fb);
     mu_run_test_singledouble(test_dgtreal_long);
     mu_run_test_singledouble(test_idgtreal_long);
+    mu_run_test_singledouble(test_dgt_long_nthreads);
+    mu_run_test_singledouble(test_nsdgtreal);
     mu_run_test_singledouble(test_pgauss);
+    mu_run_test_singledouble(test_circularbuf);
+    mu_run_test_singledouble(test_block_processor);
+    mu_run_test_singledouble(test_slidgtrealmp);
+    mu_run_test_singledouble(test_dgtrealmp_atoms);
+    mu_run_test_singledouble(test_dgtrealmp_parmp);
+    mu_run_test_singledouble(test_heap);
+    mu_run_test_singledouble(test_wilson_fb);
+    mu_run_test_singledouble(test_rtdgtreal);
+    mu_run_test_singledouble(test_rtwmdct);
+    mu_run_test_singledouble(test_dgtreal_ola);
+    mu_run_test_singledouble(test_dgtreal_fb_stream);
+    mu_run_test_singledouble(test_dgtreal_blockfunc);
+    mu_run_test_singledouble(test_coeffile);
+    mu_run_test_singledouble(test_filterbank_fft);
+    mu_run_test_singledouble(test_fftplans);
     mu_run_test_singledouble(test_fftcircshift);
     mu_run_test_singledouble(test_fftfftshift);
     mu_run_test_singledouble(test_fftifftshift);
@@ -0,0 +1,174 @@
+#include <pthread.h>
+
+/* The callback doubles the samples and counts the blocks. The count is
+ * protected by a mutex, the samples are passed by the fifos only. */
+typedef struct
+{
+    LTFAT_NAME(block_processor_state)* p;
+    pthread_mutex_t lock;
+    ltfat_int blocks;
+    int stop;
+} TEST_NAME(blockproc_args);
+
+int TEST_NAME(blockproc_double)(void* userdata, const LTFAT_REAL in[],
+                                int winLen, int W, LTFAT_REAL out[])
+{
+    TEST_NAME(blockproc_args)* a = (TEST_NAME(blockproc_args)*) userdata;
+
+    for (ltfat_int l = 0; l < winLen * W; l++)
+        out[l] = 2 * in[l];
+
+    pthread_mutex_lock(&a->lock);
+    a->blocks++;
+    pthread_mutex_unlock(&a->lock);
+    return 0;
+}
+
+static void*
+TEST_NAME(blockproc_worker)(void* arg)
+{
+    TEST_NAME(blockproc_args)* a = (TEST_NAME(blockproc_args)*) arg;
+    int stop = 0;
+
+    while (!stop)
+    {
+        LTFAT_NAME(block_processor_process)(a->p);
+        pthread_mutex_lock(&a->lock);
+        stop = a->stop;
+        pthread_mutex_unlock(&a->lock);
+    }
+    return NULL;
+}
+
+static ltfat_int
+TEST_NAME(blockproc_getblocks)(TEST_NAME(blockproc_args)* a)
+{
+    ltfat_int blocks;
+    pthread_mutex_lock(&a->lock);
+    blocks = a->blocks;
+    pthread_mutex_unlock(&a->lock);
+    return blocks;
+}
+
+int TEST_NAME(test_block_processor)()
+{
+    ltfat_int winLen[] = { 16, 64 };
+    ltfat_int bufLenMax = 37, N = 20000;
+    LTFAT_REAL in[2][37], out[2][37];
+    const LTFAT_REAL* inPtr[2] = { in[0], in[1] };
+    LTFAT_REAL* outPtr[2] = { out[0], out[1] };
+
+    for (unsigned int id = 0; id < ARRAYLEN(winLen); id++)
+    {
+        // The output is the doubled input delayed by procDelay
+        ltfat_int procDelay = winLen[id] - 1;
+
+        for (int threaded = 0; threaded < 2; threaded++)
+        {
+            TEST_NAME(blockproc_args) args;
+            pthread_t worker;
+            ltfat_int badsamples = 0, badcalls = 0, n = 0, chunkLen = 1;
+
+            args.blocks = 0; args.stop = 0;
+            pthread_mutex_init(&args.lock, NULL);
+            mu_assert( LTFAT_NAME(block_processor_init)(winLen[id], winLen[id], 2,
+                       bufLenMax, procDelay, &args.p) == LTFATERR_SUCCESS,
+                       "block_processor_init returns success");
+            LTFAT_NAME(block_processor_setcallback)(args.p,
+                    &TEST_NAME(blockproc_double), &args);
+
+            if (threaded)
+                mu_assert( pthread_create(&worker, NULL,
+                                          TEST_NAME(blockproc_worker), &args) == 0,
+                           "pthread_create");
+
+            while (n < N)
+            {
+                ltfat_int len = ltfat_imin(chunkLen, N - n);
+                ltfat_int filled = n + len + procDelay;
+                ltfat_int blocks = filled < winLen[id] ? 0 :
+                                   (filled - winLen[id]) / winLen[id] + 1;
+
+                for (ltfat_int l = 0; l < len; l++)
+                {
+                    in[0][l] = (LTFAT_REAL) (n + l + 1);
+                    in[1][l] = -in[0][l];
+                }
+
+                if (LTFAT_NAME(block_processor_push)(args.p, inPtr, len, 2)
+                    != LTFATERR_SUCCESS) badcalls++;
+
+                // The audio thread waits for the worker, there are no xruns
+                if (threaded)
+                    while (TEST_NAME(blockproc_getblocks)(&args) < blocks);
+                else
+                    LTFAT_NAME(block_processor_process)(args.p);
+
+                if (LTFAT_NAME(block_processor_pull)(args.p, len, 2, outPtr)
+                    != LTFATERR_SUCCESS) badcalls++;
+
+                for (ltfat_int l = 0; l < len; l++)
+                {
+                    ltfat_int pos = n + l - procDelay;
+                    LTFAT_REAL expected = pos < 0 ? 0 : (LTFAT_REAL) (2 * (pos + 1));
+                    if (out[0][l] != expected || out[1][l] != -expected)
+                        badsamples++;
+                }
+
+                n += len;
+                chunkLen = chunkLen % bufLenMax + 1;
+            }
+
+            if (threaded)
+            {
+                pthread_mutex_lock(&args.lock);
+                args.stop = 1;
+                pthread_mutex_unlock(&args.lock);
+                pthread_join(worker, NULL);
+            }
+
+            mu_assert( badsamples == 0 && badcalls == 0,
+                       "block_processor push, process and pull, winLen=%td, "
+                       "threaded=%d, %td bad samples, %td failed calls",
+                       winLen[id], threaded, badsamples, badcalls);
+            mu_assert( LTFAT_NAME(block_processor_get_overruns)(args.p) == 0 &&
+                       LTFAT_NAME(block_processor_get_underruns)(args.p) == 0,
+                       "There are no xruns if the worker keeps up");
+
+            LTFAT_NAME(block_processor_done)(&args.p);
+            pthread_mutex_destroy(&args.lock);
+        }
+
+        // The input fifo holds bufLenMax + winLen samples including the
+        // procDelay zeros, the second push does not fit
+        {
+            LTFAT_NAME(block_processor_state)* p = NULL;
+            int status = LTFATERR_SUCCESS;
+            LTFAT_NAME(block_processor_init)(winLen[id], winLen[id], 2, bufLenMax,
+                                             procDelay, &p);
+            for (ltfat_int l = 0; l < bufLenMax; l++)
+                in[0][l] = in[1][l] = 1.0;
+
+            mu_assert( LTFAT_NAME(block_processor_push)(p, inPtr, bufLenMax, 2)
+                       == LTFATERR_SUCCESS, "block_processor_push returns success");
+            mu_assert( LTFAT_NAME(block_processor_push)(p, inPtr, bufLenMax, 2)
+                       == LTFATERR_OVERFLOW &&
+                       LTFAT_NAME(block_processor_get_overruns)(p) == 1,
+                       "block_processor_push reports the overrun, winLen=%td",
+                       winLen[id]);
+
+            // Nothing was processed, the output fifo runs dry
+            for (ltfat_int k = 0; k < 3; k++)
+                status = LTFAT_NAME(block_processor_pull)(p, bufLenMax, 2, outPtr);
+            mu_assert( status == LTFATERR_UNDERFLOW &&
+                       LTFAT_NAME(block_processor_get_underruns)(p) > 0 &&
+                       out[0][bufLenMax - 1] == 0 && out[1][bufLenMax - 1] == 0,
+                       "block_processor_pull reports the underrun and outputs "
+                       "silence, winLen=%td", winLen[id]);
+
+            LTFAT_NAME(block_processor_done)(&p);
+        }
+    }
+
+    return 0;
+}
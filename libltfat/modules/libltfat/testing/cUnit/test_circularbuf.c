@@ -0,0 +1,151 @@
+#include <pthread.h>
+
+/* The producers write a ramp to both channels, negated in the second one,
+ * and the consumers check it. The chunk sizes vary so that the read and
+ * write positions wrap around at different places. */
+typedef struct
+{
+    LTFAT_NAME(analysis_fifo_state)* afifo;
+    LTFAT_NAME(synthesis_fifo_state)* sfifo;
+    ltfat_int hop;
+    ltfat_int winLen;
+    ltfat_int N;
+} TEST_NAME(fifo_args);
+
+static void*
+TEST_NAME(analysis_fifo_producer)(void* arg)
+{
+    TEST_NAME(fifo_args)* a = (TEST_NAME(fifo_args)*) arg;
+    LTFAT_REAL chunk[2][37];
+    const LTFAT_REAL* chunkPtr[2] = { chunk[0], chunk[1] };
+    ltfat_int n = 0, chunkLen = 1;
+
+    while (n < a->N)
+    {
+        ltfat_int written, len = ltfat_imin(chunkLen, a->N - n);
+        for (ltfat_int l = 0; l < len; l++)
+        {
+            chunk[0][l] = (LTFAT_REAL) (n + l + 1);
+            chunk[1][l] = -chunk[0][l];
+        }
+
+        written = LTFAT_NAME(analysis_fifo_write)(a->afifo, chunkPtr, len, 2);
+        if (written < 0) break;
+        n += written;
+        chunkLen = chunkLen % 37 + 1;
+    }
+    return NULL;
+}
+
+static void*
+TEST_NAME(synthesis_fifo_producer)(void* arg)
+{
+    TEST_NAME(fifo_args)* a = (TEST_NAME(fifo_args)*) arg;
+    LTFAT_REAL* block = LTFAT_NAME_REAL(calloc)(2 * a->winLen);
+
+    // Only the first hop samples of a block are non-zero, the overlap-add
+    // must not change them
+    for (ltfat_int n = 0; n < a->N; )
+    {
+        for (ltfat_int l = 0; l < a->hop; l++)
+        {
+            block[l] = (LTFAT_REAL) (n + l + 1);
+            block[l + a->winLen] = -block[l];
+        }
+
+        ltfat_int written = LTFAT_NAME(synthesis_fifo_write)(a->sfifo, block);
+        if (written < 0) break;
+        if (written > 0) n += a->hop;
+    }
+
+    ltfat_free(block);
+    return NULL;
+}
+
+int TEST_NAME(test_circularbuf)()
+{
+    ltfat_int winLen[] = { 16, 16, 64 };
+    ltfat_int hop[] =    { 16,  4, 48 };
+    ltfat_int N = 20000;
+
+    for (unsigned int id = 0; id < ARRAYLEN(winLen); id++)
+    {
+        TEST_NAME(fifo_args) args;
+        pthread_t producer;
+        ltfat_int procDelay = winLen[id] - 1, badsamples = 0;
+
+        args.N = N; args.hop = hop[id]; args.winLen = winLen[id];
+
+        // Analysis fifo, the consumer reads overlapping blocks. The fifo
+        // starts with procDelay zeros.
+        mu_assert(
+            LTFAT_NAME(analysis_fifo_init)(3 * winLen[id], procDelay, winLen[id],
+                                           hop[id], 2, &args.afifo)
+            == LTFATERR_SUCCESS, "analysis_fifo_init");
+        mu_assert(
+            pthread_create(&producer, NULL,
+                           TEST_NAME(analysis_fifo_producer), &args) == 0,
+            "pthread_create");
+        {
+            LTFAT_REAL* block = LTFAT_NAME_REAL(malloc)(2 * winLen[id]);
+            for (ltfat_int k = 0; k * hop[id] + winLen[id] <= N + procDelay; )
+            {
+                ltfat_int read = LTFAT_NAME(analysis_fifo_read)(args.afifo, block);
+                if (read < 0) { badsamples++; break; }
+                if (read == 0) continue;
+
+                for (ltfat_int l = 0; l < winLen[id]; l++)
+                {
+                    ltfat_int pos = k * hop[id] + l - procDelay;
+                    LTFAT_REAL expected = pos < 0 ? 0 : (LTFAT_REAL) (pos + 1);
+                    if (block[l] != expected || block[l + winLen[id]] != -expected)
+                        badsamples++;
+                }
+                k++;
+            }
+            ltfat_free(block);
+        }
+        pthread_join(producer, NULL);
+        mu_assert(badsamples == 0,
+                  "analysis fifo, winLen=%td, hop=%td, %td bad samples",
+                  winLen[id], hop[id], badsamples);
+        LTFAT_NAME(analysis_fifo_done)(&args.afifo);
+
+        // Synthesis fifo, the consumer reads chunks of varying length
+        mu_assert(
+            LTFAT_NAME(synthesis_fifo_init)(3 * winLen[id], winLen[id], hop[id],
+                                            2, &args.sfifo)
+            == LTFATERR_SUCCESS, "synthesis_fifo_init");
+        mu_assert(
+            pthread_create(&producer, NULL,
+                           TEST_NAME(synthesis_fifo_producer), &args) == 0,
+            "pthread_create");
+        {
+            LTFAT_REAL chunk[2][37];
+            LTFAT_REAL* chunkPtr[2] = { chunk[0], chunk[1] };
+            ltfat_int n = 0, chunkLen = 1;
+            while (n < N)
+            {
+                ltfat_int len = ltfat_imin(chunkLen, N - n);
+                ltfat_int read =
+                    LTFAT_NAME(synthesis_fifo_read)(args.sfifo, len, 2, chunkPtr);
+                if (read < 0) { badsamples++; break; }
+
+                for (ltfat_int l = 0; l < read; l++)
+                    if (chunk[0][l] != (LTFAT_REAL) (n + l + 1) ||
+                        chunk[1][l] != -(LTFAT_REAL) (n + l + 1))
+                        badsamples++;
+
+                n += read;
+                chunkLen = chunkLen % 37 + 1;
+            }
+        }
+        pthread_join(producer, NULL);
+        mu_assert(badsamples == 0,
+                  "synthesis fifo, winLen=%td, hop=%td, %td bad samples",
+                  winLen[id], hop[id], badsamples);
+        LTFAT_NAME(synthesis_fifo_done)(&args.sfifo);
+    }
+
+    return 0;
+}
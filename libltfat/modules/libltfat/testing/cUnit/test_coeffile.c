@@ -0,0 +1,100 @@
+int TEST_NAME(test_coeffile)()
+{
+    const char* filename = "test_coeffile.ltfatcf";
+    ltfat_int L = 3001, gl = 64, a = 16, M = 32, W = 2;
+    ltfat_int M2 = M / 2 + 1, N = (L + a - 1) / a, Nw = 0, n;
+    ltfat_int chunkLen[] = { 0, 7, 499, 100, 1 };
+    ltfat_int Lr, ar, Mr, Wr;
+    ltfat_phaseconvention ptyper;
+    int status, equal = 1;
+    LTFAT_NAME(dgtreal_fb_stream_state)* s = NULL;
+    LTFAT_NAME(dgtreal_coefsink)* sink = NULL;
+    LTFAT_NAME(dgtreal_coefreader)* reader = NULL;
+    LTFAT_REAL* g = LTFAT_NAME(malloc)(gl);
+    LTFAT_REAL* f = LTFAT_NAME(malloc)(L * W);
+    LTFAT_REAL* fchunk = LTFAT_NAME(malloc)(L * W);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W);
+    LTFAT_COMPLEX* cchunk = LTFAT_NAME_COMPLEX(malloc)(M2 * (N + 1) * W);
+    TEST_NAME(fillRand)(g, gl);
+    TEST_NAME(fillRand)(f, L * W);
+
+    status = LTFAT_NAME(dgtreal_coefsink_init)(filename, L, a, M, W,
+             LTFAT_FREQINV, &sink);
+    // Memory-mapped files are not available everywhere
+    if (status == LTFATERR_NOTSUPPORTED) goto done;
+    mu_assert( status == LTFATERR_SUCCESS, "dgtreal_coefsink_init returns success");
+
+    // The streamed columns are written as they come
+    LTFAT_NAME(dgtreal_fb_stream_init)(g, gl, a, M, LTFAT_FREQINV, W, ZPD, 0, &s);
+    for (ltfat_int k = 0, pos = 0; ; k++)
+    {
+        ltfat_int len = chunkLen[k % ARRAYLEN(chunkLen)];
+        if (pos + len > L) len = L - pos;
+
+        for (ltfat_int w = 0; w < W; w++)
+            memcpy(fchunk + w * len, f + w * L + pos, len * sizeof * f);
+
+        // The last write passes the flushed columns
+        if (pos < L)
+            n = LTFAT_NAME(dgtreal_fb_stream_execute)(s, fchunk, len, cchunk);
+        else
+            n = LTFAT_NAME(dgtreal_fb_stream_flush)(s, cchunk);
+
+        mu_assert( LTFAT_NAME(dgtreal_coefsink_write)(sink, cchunk, n)
+                   == LTFATERR_SUCCESS, "dgtreal_coefsink_write returns success");
+
+        for (ltfat_int w = 0; w < W; w++)
+            memcpy(c + M2 * (w * N + Nw), cchunk + M2 * w * n, M2 * n * sizeof * c);
+        Nw += n;
+        if (pos == L) break;
+        pos += len;
+    }
+    LTFAT_NAME(dgtreal_fb_stream_done)(&s);
+
+    mu_assert( Nw == N && LTFAT_NAME(dgtreal_coefsink_get_ncols)(sink) == N,
+               "The sink holds all N columns");
+    mu_assert( LTFAT_NAME(dgtreal_coefsink_write)(sink, cchunk, 1) == LTFATERR_OVERFLOW,
+               "dgtreal_coefsink_write rejects more than N columns");
+    mu_assert( LTFAT_NAME(dgtreal_coefsink_done)(&sink) == LTFATERR_SUCCESS,
+               "dgtreal_coefsink_done returns success");
+
+    mu_assert( LTFAT_NAME(dgtreal_coefreader_init)(filename, &reader)
+               == LTFATERR_SUCCESS, "dgtreal_coefreader_init returns success");
+    LTFAT_NAME(dgtreal_coefreader_get_params)(reader, &Lr, &ar, &Mr, &Wr, &ptyper);
+    mu_assert( Lr == L && ar == a && Mr == M && Wr == W && ptyper == LTFAT_FREQINV &&
+               LTFAT_NAME(dgtreal_coefreader_get_ncols)(reader) == N,
+               "The reader returns the parameters of the sink");
+
+    mu_assert( !memcmp(LTFAT_NAME(dgtreal_coefreader_get_array)(reader), c,
+                       M2 * N * W * sizeof * c),
+               "The mapped array equals the written columns");
+
+    mu_assert( LTFAT_NAME(dgtreal_coefreader_read)(reader, 37, 10, cchunk)
+               == LTFATERR_SUCCESS, "dgtreal_coefreader_read returns success");
+    for (ltfat_int w = 0; w < W; w++)
+        equal &= !memcmp(cchunk + M2 * w * 10, c + M2 * (w * N + 37),
+                         M2 * 10 * sizeof * c);
+    mu_assert( equal, "dgtreal_coefreader_read equals the written columns");
+    mu_assert( LTFAT_NAME(dgtreal_coefreader_read)(reader, N - 5, 6, cchunk)
+               == LTFATERR_NOTINRANGE, "dgtreal_coefreader_read rejects columns past N");
+
+    LTFAT_NAME(dgtreal_coefreader_done)(&reader);
+
+    // A file which is not a coefficient file
+    {
+        FILE* fp = fopen(filename, "w");
+        fprintf(fp, "garbage");
+        fclose(fp);
+    }
+    mu_assert( LTFAT_NAME(dgtreal_coefreader_init)(filename, &reader) == LTFATERR_FAILED,
+               "dgtreal_coefreader_init rejects an invalid file");
+
+    remove(filename);
+done:
+    ltfat_free(g);
+    ltfat_free(f);
+    ltfat_free(fchunk);
+    ltfat_free(c);
+    ltfat_free(cchunk);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/* Sample ii of f extended according to ext. The extension buffers are
+ * filled by extend_left and extend_right, see convsub_td. */
+LTFAT_TYPE TEST_NAME(td_extsample)(const LTFAT_TYPE* f, ltfat_int L,
+                                   const LTFAT_TYPE* left, const LTFAT_TYPE* right,
+                                   ltfat_int extLen, ltfatExtType ext, ltfat_int ii)
+{
+    if (ii >= 0 && ii < L) return f[ii];
+    if (ext == PER || ext == PPD) return f[ltfat_positiverem(ii, L)];
+    if (ii < 0 && -ii <= extLen) return left[extLen + ii];
+    if (ii >= L && ii - L < extLen) return right[ii - L];
+    return (LTFAT_TYPE) 0.0;
+}
+
+int TEST_NAME(test_convsub_td)()
+{
+    ltfatExtType ext[] = { PER, PERDEC, PPD, SYM, EVEN, SYMW, ASYM, ODD, ASYMW,
+                           SP0, ZPD, ZERO, VALID
+                         };
+    ltfat_int L[]  = { 64, 67, 100 };
+    ltfat_int gl[] = { 10, 16, 23 };
+    ltfat_int a[]  = {  2,  3,  4 };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(L); id++)
+    {
+        ltfat_int skip[] = { 0, 5, -2, -(gl[id] - 1) };
+        ltfat_int extLen = gl[id] + a[id];
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_TYPE* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_TYPE* gconj = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_TYPE* left = LTFAT_NAME(malloc)(extLen);
+        LTFAT_TYPE* right = LTFAT_NAME(malloc)(extLen);
+        LTFAT_TYPE* fup = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_TYPE* fupref = LTFAT_NAME(malloc)(L[id]);
+        TEST_NAME(fillRand)(f, L[id]);
+        TEST_NAME(fillRand)(g, gl[id]);
+        LTFAT_NAME(conjugate_array)(g, gl[id], gconj);
+
+        for (unsigned int eId = 0; eId < ARRAYLEN(ext); eId++)
+        {
+            for (unsigned int sId = 0; sId < ARRAYLEN(skip); sId++)
+            {
+                ltfat_int N = filterbank_td_size(L[id], a[id], gl[id], skip[sId],
+                                                 ext[eId]);
+                ltfat_int Nbuf = ltfat_imax(N, L[id]);
+                LTFAT_TYPE* c = LTFAT_NAME(malloc)(Nbuf);
+                LTFAT_TYPE* cref = LTFAT_NAME(malloc)(Nbuf);
+                LTFAT_TYPE* cinpl = LTFAT_NAME(malloc)(Nbuf);
+                LTFAT_REAL err = 0, errinpl = 0, errup = 0;
+
+                for (ltfat_int l = 0; l < extLen; l++)
+                    left[l] = right[l] = 0.0;
+                LTFAT_NAME(extend_left)(f, L[id], left, extLen, gl[id], ext[eId], a[id]);
+                LTFAT_NAME(extend_right)(f, L[id], right, gl[id], ext[eId], a[id]);
+
+                // c[n] = sum_k g[k]*x[n*a - skip - k]
+                for (ltfat_int n = 0; n < N; n++)
+                {
+                    cref[n] = 0.0;
+                    for (ltfat_int k = 0; k < gl[id]; k++)
+                        cref[n] += g[k] * TEST_NAME(td_extsample)(
+                                       f, L[id], left, right, extLen, ext[eId],
+                                       n * a[id] - skip[sId] - k);
+                }
+
+                LTFAT_NAME(convsub_td)(f, g, L[id], gl[id], a[id], skip[sId], c,
+                                       ext[eId]);
+                memcpy(cinpl, f, L[id] * sizeof * f);
+                LTFAT_NAME(convsub_td)(cinpl, g, L[id], gl[id], a[id], skip[sId],
+                                       cinpl, ext[eId]);
+
+                for (ltfat_int n = 0; n < N; n++)
+                {
+                    LTFAT_REAL d = TEST_NAME(absDiff)(c[n], cref[n]);
+                    if (d > err) err = d;
+                    d = TEST_NAME(absDiff)(cinpl[n], cref[n]);
+                    if (d > errinpl) errinpl = d;
+                }
+
+                // f[l] += sum_q cx[q]*conj(g[q*a - skip - l]) where cx is c
+                // extended periodically for PER and by zeros otherwise
+                for (ltfat_int l = 0; l < L[id]; l++)
+                {
+                    fup[l] = fupref[l] = f[l];
+                    for (ltfat_int k = 0; k < gl[id]; k++)
+                    {
+                        ltfat_int q = l + skip[sId] + k;
+                        if (q % a[id]) continue;
+                        q /= a[id];
+                        if (ext[eId] == PER)
+                            q = ltfat_positiverem(q, N);
+                        else if (q < 0 || q >= N)
+                            continue;
+                        fupref[l] += cref[q] * gconj[k];
+                    }
+                }
+
+                LTFAT_NAME(upconv_td)(cref, g, L[id], gl[id], a[id], skip[sId], fup,
+                                      ext[eId]);
+
+                for (ltfat_int l = 0; l < L[id]; l++)
+                {
+                    LTFAT_REAL d = TEST_NAME(absDiff)(fup[l], fupref[l]);
+                    if (d > errup) errup = d;
+                }
+
+                mu_assert( err < tol && errinpl < tol && errup < tol,
+                           "convsub_td, inplace convsub_td and upconv_td equal the "
+                           "direct sums, L=%td, gl=%td, a=%td, skip=%td, ext=%d, "
+                           "err=%g, %g, %g", L[id], gl[id], a[id], skip[sId],
+                           ext[eId], (double) err, (double) errinpl, (double) errup);
+
+                ltfat_free(c);
+                ltfat_free(cref);
+                ltfat_free(cinpl);
+            }
+        }
+
+        ltfat_free(f);
+        ltfat_free(g);
+        ltfat_free(gconj);
+        ltfat_free(left);
+        ltfat_free(right);
+        ltfat_free(fup);
+        ltfat_free(fupref);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+int TEST_NAME(test_dgt_long_nthreads)()
+{
+    // gcd(a,M) is 2, 1, 16 and 3
+    ltfat_int L[] = { 120, 90, 160, 144 };
+    ltfat_int a[] = {   2, 10,  16,   9 };
+    ltfat_int M[] = {  10,  9, 160,  12 };
+    ltfat_int W[] = {   1,  3,   5,   4 };
+    ltfat_int nthreads[] = { 2, 3, 4 };
+    ltfat_phaseconvention ptype[] = { LTFAT_FREQINV, LTFAT_TIMEINV };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(L); id++)
+    {
+        ltfat_int N = L[id] / a[id], M2 = M[id] / 2 + 1;
+        ltfat_int clen = M[id] * N * W[id];
+        LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(L[id]);
+        LTFAT_COMPLEX* fc = LTFAT_NAME_COMPLEX(malloc)(L[id] * W[id]);
+        LTFAT_COMPLEX* gc = LTFAT_NAME_COMPLEX(malloc)(L[id]);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(clen);
+        LTFAT_COMPLEX* crefc = LTFAT_NAME_COMPLEX(malloc)(clen);
+        LTFAT_COMPLEX* crefr = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(clen);
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+        TEST_NAME(fillRand)(g, L[id]);
+        TEST_NAME_COMPLEX(fillRand)(fc, L[id] * W[id]);
+        TEST_NAME_COMPLEX(fillRand)(gc, L[id]);
+
+        for (unsigned int pId = 0; pId < ARRAYLEN(ptype); pId++)
+        {
+            LTFAT_NAME(dgt_long_plan)* p = NULL;
+            LTFAT_NAME_COMPLEX(dgt_long_plan)* pc = NULL;
+            LTFAT_NAME(dgtreal_long_plan)* pr = NULL;
+
+            // Flags 0 means FFTW_MEASURE, the planners may overwrite c
+            mu_assert( LTFAT_NAME(dgt_long_init)(g, L[id], W[id], a[id], M[id], f, c,
+                       ptype[pId], 0, &p) == LTFATERR_SUCCESS,
+                       "dgt_long_init returns success");
+            mu_assert( LTFAT_NAME_COMPLEX(dgt_long_init)(gc, L[id], W[id], a[id], M[id],
+                       fc, c, ptype[pId], 0, &pc) == LTFATERR_SUCCESS,
+                       "dgt_long_init returns success for complex signals");
+            mu_assert( LTFAT_NAME(dgtreal_long_init)(g, L[id], W[id], a[id], M[id], f,
+                       c, ptype[pId], 0, &pr) == LTFATERR_SUCCESS,
+                       "dgtreal_long_init returns success");
+
+            // The plans use a single thread by default
+            LTFAT_NAME(dgt_long_execute_newarray)(p, f, cref);
+            LTFAT_NAME_COMPLEX(dgt_long_execute_newarray)(pc, fc, crefc);
+            LTFAT_NAME(dgtreal_long_execute_newarray)(pr, f, crefr);
+
+            for (unsigned int tId = 0; tId < ARRAYLEN(nthreads); tId++)
+            {
+                LTFAT_REAL err = 0, errc = 0, errr = 0;
+
+                mu_assert( LTFAT_NAME(dgt_long_setnthreads)(p, nthreads[tId])
+                           == LTFATERR_SUCCESS &&
+                           LTFAT_NAME_COMPLEX(dgt_long_setnthreads)(pc, nthreads[tId])
+                           == LTFATERR_SUCCESS &&
+                           LTFAT_NAME(dgtreal_long_setnthreads)(pr, nthreads[tId])
+                           == LTFATERR_SUCCESS, "setnthreads returns success");
+
+                LTFAT_NAME(dgt_long_execute_newarray)(p, f, c);
+                for (ltfat_int l = 0; l < clen; l++)
+                    if (LTFAT_COMPLEXH(cabs)(c[l] - cref[l]) > err)
+                        err = LTFAT_COMPLEXH(cabs)(c[l] - cref[l]);
+
+                LTFAT_NAME_COMPLEX(dgt_long_execute_newarray)(pc, fc, c);
+                for (ltfat_int l = 0; l < clen; l++)
+                    if (LTFAT_COMPLEXH(cabs)(c[l] - crefc[l]) > errc)
+                        errc = LTFAT_COMPLEXH(cabs)(c[l] - crefc[l]);
+
+                LTFAT_NAME(dgtreal_long_execute_newarray)(pr, f, c);
+                for (ltfat_int l = 0; l < M2 * N * W[id]; l++)
+                    if (LTFAT_COMPLEXH(cabs)(c[l] - crefr[l]) > errr)
+                        errr = LTFAT_COMPLEXH(cabs)(c[l] - crefr[l]);
+
+                mu_assert( err < tol && errc < tol && errr < tol,
+                           "dgt_long and dgtreal_long with nthreads=%td equal nthreads=1, "
+                           "L=%td, a=%td, M=%td, W=%td, ptype=%d", nthreads[tId], L[id],
+                           a[id], M[id], W[id], ptype[pId]);
+            }
+
+            LTFAT_NAME(dgt_long_done)(&p);
+            LTFAT_NAME_COMPLEX(dgt_long_done)(&pc);
+            LTFAT_NAME(dgtreal_long_done)(&pr);
+        }
+
+        ltfat_free(f);
+        ltfat_free(g);
+        ltfat_free(fc);
+        ltfat_free(gc);
+        ltfat_free(cref);
+        ltfat_free(crefc);
+        ltfat_free(crefr);
+        ltfat_free(c);
+    }
+
+    return 0;
+}
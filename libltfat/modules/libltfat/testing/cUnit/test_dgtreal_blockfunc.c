@@ -0,0 +1,142 @@
+/* Records which coefficients the block function was called on. Every
+ * coefficient is scaled by its linear index + 1 so that a wrong offset
+ * shows up in the output too. */
+typedef struct
+{
+    LTFAT_COMPLEX* c;       // Start of the output array
+    int* seen;              // Number of times each coefficient was passed
+    ltfat_int M2;
+    ltfat_int M2N;
+    ltfat_int K;            // Frames per block, 0 for one block per channel
+    ltfat_int blockcalls;   // Calls with a full block of K frames
+    ltfat_int badcalls;
+} TEST_NAME(blockfunc_args);
+
+void TEST_NAME(blockfunc_scale)(void* userdata, const LTFAT_COMPLEX in[],
+                                ltfat_int offset, ltfat_int len,
+                                LTFAT_COMPLEX out[])
+{
+    TEST_NAME(blockfunc_args)* a = (TEST_NAME(blockfunc_args)*) userdata;
+
+    if (a->K == 0)
+    {
+        if (len != a->M2N || offset % a->M2N) a->badcalls++;
+    }
+    else
+    {
+        if (len == a->K * a->M2) a->blockcalls++;
+        else if (len != a->M2) a->badcalls++;
+        if (offset % a->M2 || offset / a->M2N != (offset + len - 1) / a->M2N)
+            a->badcalls++;
+    }
+
+    if (out != a->c + offset) a->badcalls++;
+
+    for (ltfat_int l = 0; l < len; l++)
+    {
+        a->seen[offset + l]++;
+        out[l] = in[l] * (LTFAT_REAL)(offset + l + 1);
+    }
+}
+
+int TEST_NAME(test_dgtreal_blockfunc)()
+{
+    ltfat_int M[]  = { 1024, 64 };
+    ltfat_int a[]  = {  256, 16 };
+    ltfat_int gl[] = { 1024, 64 };
+    ltfat_int N = 40, W = 3;
+    ltfat_dgt_hint hint[] = { ltfat_dgt_fb, ltfat_dgt_long };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(M); id++)
+    {
+        ltfat_int L = N * a[id], M2 = M[id] / 2 + 1, M2N = M2 * N;
+        // Frames per batched FFT, see dgtreal_fb_init
+        ltfat_int K = ltfat_imax(1, LTFAT_FFTBATCHBYTES / (M2 * sizeof(LTFAT_COMPLEX)));
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(L * W);
+        LTFAT_REAL* fbuf = LTFAT_NAME(malloc)(L * W);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2N * W);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(M2N * W);
+        int* seen = ltfat_malloc(M2N * W * sizeof * seen);
+        TEST_NAME(fillRand)(g, gl[id]);
+        TEST_NAME(fillRand)(f, L * W);
+
+        for (unsigned int hId = 0; hId < ARRAYLEN(hint); hId++)
+        {
+            LTFAT_NAME(dgtreal_plan)* p = NULL;
+            ltfat_dgt_params* params = ltfat_dgt_params_allocdef();
+            TEST_NAME(blockfunc_args) args;
+
+            ltfat_dgt_setpar_hint(params, hint[hId]);
+            mu_assert( LTFAT_NAME(dgtreal_init)(g, gl[id], L, W, a[id], M[id], NULL,
+                       NULL, params, &p) == LTFATERR_SUCCESS,
+                       "dgtreal_init returns success");
+            ltfat_dgt_params_free(params);
+
+            // The analysis and the projection pass through the same blocks
+            for (int proj = 0; proj < 2; proj++)
+            {
+                LTFAT_REAL err = 0;
+                ltfat_int badseen = 0;
+
+                args.c = c; args.seen = seen; args.M2 = M2; args.M2N = M2N;
+                args.K = hint[hId] == ltfat_dgt_fb ? K : 0;
+                args.blockcalls = 0; args.badcalls = 0;
+                memset(seen, 0, M2N * W * sizeof * seen);
+
+                if (proj)
+                {
+                    LTFAT_NAME(dgtreal_execute_proj)(p, cref, fbuf, c);
+                    memcpy(cref, c, M2N * W * sizeof * c);
+                    LTFAT_NAME(dgtreal_execute_ana_newarray)(p, f, c);
+                    mu_assert( LTFAT_NAME(dgtreal_execute_proj_blockfunc)(p, c, fbuf,
+                               &TEST_NAME(blockfunc_scale), &args, c)
+                               == LTFATERR_SUCCESS,
+                               "dgtreal_execute_proj_blockfunc returns success");
+                }
+                else
+                {
+                    LTFAT_NAME(dgtreal_execute_ana_newarray)(p, f, cref);
+                    mu_assert( LTFAT_NAME(dgtreal_execute_ana_blockfunc)(p, f,
+                               &TEST_NAME(blockfunc_scale), &args, c)
+                               == LTFATERR_SUCCESS,
+                               "dgtreal_execute_ana_blockfunc returns success");
+                }
+
+                for (ltfat_int l = 0; l < M2N * W; l++)
+                {
+                    LTFAT_REAL d = LTFAT_COMPLEXH(cabs)(c[l] - cref[l] * (LTFAT_REAL)(l + 1));
+                    if (d > err) err = d;
+                    if (seen[l] != 1) badseen++;
+                }
+
+                mu_assert( badseen == 0 && args.badcalls == 0,
+                           "The block function sees each coefficient once with the right "
+                           "offset and length, M=%td, hint=%d, proj=%d",
+                           M[id], hint[hId], proj);
+                mu_assert( args.K == 0 || args.blockcalls == W * (N / K),
+                           "The block function gets full blocks of K=%td frames, "
+                           "M=%td, proj=%d", K, M[id], proj);
+                mu_assert( err < tol * M2N * W,
+                           "The block function output is the scaled transform, "
+                           "M=%td, hint=%d, proj=%d", M[id], hint[hId], proj);
+
+                // The projection reference needs the plain coefficients
+                if (!proj)
+                    LTFAT_NAME(dgtreal_execute_ana_newarray)(p, f, cref);
+            }
+
+            LTFAT_NAME(dgtreal_done)(&p);
+        }
+
+        ltfat_free(g);
+        ltfat_free(f);
+        ltfat_free(fbuf);
+        ltfat_free(c);
+        ltfat_free(cref);
+        ltfat_free(seen);
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+int TEST_NAME(test_dgtreal_fb_stream)()
+{
+    ltfat_int Ls[] = { 1000, 777, 555, 50, 20 };
+    ltfat_int gl[] = {   64,  30,  16, 33, 100 };
+    ltfat_int a[]  = {   16,  10,  40, 11, 25 };
+    ltfat_int M[]  = {   32,  40,  20, 16, 64 };
+    ltfat_int W[]  = {    2,   1,   3,  2,  1 };
+    ltfatExtType ext[] = { VALID, ZPD };
+    ltfat_phaseconvention ptype[] = { LTFAT_FREQINV, LTFAT_TIMEINV };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(Ls); id++)
+    {
+        ltfat_int M2 = M[id] / 2 + 1, glh = gl[id] / 2;
+        // Columns of the stream, VALID has no more than ZPD
+        ltfat_int Nmax = (Ls[id] + a[id] - 1) / a[id];
+        ltfat_int chunkLen[] = { 0, 1, a[id] - 1, gl[id], 3 * gl[id] + 1 };
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(Ls[id] * W[id]);
+        LTFAT_REAL* fchunk = LTFAT_NAME(malloc)(Ls[id] * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * Nmax * W[id]);
+        LTFAT_COMPLEX* cchunk = LTFAT_NAME_COMPLEX(malloc)(M2 * (Nmax + 1) * W[id]);
+        TEST_NAME(fillRand)(g, gl[id]);
+        TEST_NAME(fillRand)(f, Ls[id] * W[id]);
+
+        for (unsigned int eId = 0; eId < ARRAYLEN(ext); eId++)
+        {
+            // The reference is dgtreal_fb of the signal placed at offset P in
+            // zeros long enough to avoid the periodic wrap. Column n of the
+            // stream is column n0 + n of the reference.
+            ltfat_int n0 = ext[eId] == ZPD ? (gl[id] + a[id] - 1) / a[id] :
+                           (gl[id] + glh + a[id] - 1) / a[id];
+            ltfat_int P = ext[eId] == ZPD ? n0 * a[id] : n0 * a[id] - glh;
+            ltfat_int Lp = ((P + Ls[id] + 2 * gl[id]) / a[id] + 1) * a[id];
+            ltfat_int Np = Lp / a[id];
+            ltfat_int Nexp = ext[eId] == ZPD ? Nmax :
+                             Ls[id] >= gl[id] ? (Ls[id] - gl[id]) / a[id] + 1 : 0;
+            LTFAT_REAL* fp = LTFAT_NAME(calloc)(Lp * W[id]);
+            LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(M2 * Np * W[id]);
+            for (ltfat_int w = 0; w < W[id]; w++)
+                memcpy(fp + w * Lp + P, f + w * Ls[id], Ls[id] * sizeof * f);
+
+            for (unsigned int pId = 0; pId < ARRAYLEN(ptype); pId++)
+            {
+                LTFAT_NAME(dgtreal_fb_stream_state)* p = NULL;
+                ltfat_int pos = 0, N = 0, Nchunk;
+                LTFAT_REAL err = 0;
+
+                LTFAT_NAME(dgtreal_fb)(fp, g, Lp, gl[id], W[id], a[id], M[id],
+                                       ptype[pId], cref);
+
+                mu_assert(
+                    LTFAT_NAME(dgtreal_fb_stream_init)(g, gl[id], a[id], M[id],
+                            ptype[pId], W[id], ext[eId], 0, &p) == LTFATERR_SUCCESS,
+                    "dgtreal_fb_stream_init returns success");
+
+                for (ltfat_int k = 0; pos < Ls[id]; k++)
+                {
+                    ltfat_int len = chunkLen[k % ARRAYLEN(chunkLen)];
+                    if (pos + len > Ls[id]) len = Ls[id] - pos;
+
+                    for (ltfat_int w = 0; w < W[id]; w++)
+                        memcpy(fchunk + w * len, f + w * Ls[id] + pos,
+                               len * sizeof * f);
+
+                    Nchunk = LTFAT_NAME(dgtreal_fb_stream_nextncols)(p, len);
+                    mu_assert( Nchunk >= 0 && N + Nchunk <= Nexp &&
+                               LTFAT_NAME(dgtreal_fb_stream_execute)(p, fchunk, len,
+                                       cchunk) == Nchunk,
+                               "dgtreal_fb_stream_execute emits nextncols columns");
+
+                    for (ltfat_int w = 0; w < W[id]; w++)
+                        memcpy(c + M2 * (w * Nmax + N), cchunk + M2 * w * Nchunk,
+                               M2 * Nchunk * sizeof * c);
+                    N += Nchunk;
+                    pos += len;
+                }
+
+                Nchunk = LTFAT_NAME(dgtreal_fb_stream_flushncols)(p);
+                mu_assert( N + Nchunk == Nexp &&
+                           LTFAT_NAME(dgtreal_fb_stream_flush)(p, cchunk) == Nchunk,
+                           "dgtreal_fb_stream emits all columns, Ls=%td, ext=%d",
+                           Ls[id], ext[eId]);
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    memcpy(c + M2 * (w * Nmax + N), cchunk + M2 * w * Nchunk,
+                           M2 * Nchunk * sizeof * c);
+
+                // FREQINV phase of the reference is relative to the padding
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    for (ltfat_int n = 0; n < Nexp; n++)
+                        for (ltfat_int m = 0; m < M2; m++)
+                        {
+                            LTFAT_COMPLEX ref = cref[M2 * (w * Np + n0 + n) + m];
+                            LTFAT_REAL errm;
+                            if (ptype[pId] == LTFAT_FREQINV)
+                                ref *= LTFAT_COMPLEXH(cexp)( I * (LTFAT_REAL)
+                                        (2.0 * M_PI * ((m * P) % M[id]) / M[id]));
+                            errm = LTFAT_COMPLEXH(cabs)(c[M2 * (w * Nmax + n) + m] - ref);
+                            if (errm > err) err = errm;
+                        }
+
+                mu_assert( err < tol,
+                           "dgtreal_fb_stream equals padded dgtreal_fb, Ls=%td, gl=%td, "
+                           "a=%td, ext=%d, ptype=%d", Ls[id], gl[id], a[id], ext[eId],
+                           ptype[pId]);
+
+                LTFAT_NAME(dgtreal_fb_stream_done)(&p);
+            }
+
+            ltfat_free(fp);
+            ltfat_free(cref);
+        }
+
+        ltfat_free(g);
+        ltfat_free(f);
+        ltfat_free(fchunk);
+        ltfat_free(c);
+        ltfat_free(cchunk);
+    }
+
+    return 0;
+}
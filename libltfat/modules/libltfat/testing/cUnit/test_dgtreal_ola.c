@@ -0,0 +1,195 @@
+/* Returns the max. abs. difference of x and y */
+LTFAT_REAL TEST_NAME(ola_maxdiff)(const LTFAT_COMPLEX* x, const LTFAT_COMPLEX* y,
+                                  ltfat_int n)
+{
+    LTFAT_REAL err = 0;
+    for (ltfat_int l = 0; l < n; l++)
+        if (LTFAT_COMPLEXH(cabs)(x[l] - y[l]) > err)
+            err = LTFAT_COMPLEXH(cabs)(x[l] - y[l]);
+    return err;
+}
+
+int TEST_NAME(test_dgtreal_ola)()
+{
+    ltfat_int a[]  = {  4,  8,  4,  6,  5,  4 };
+    ltfat_int M[]  = {  8, 16, 16, 12, 10,  8 };
+    ltfat_int gl[] = { 16, 32, 16, 36, 10, 32 };
+    ltfat_int bl[] = { 64, 64, 32, 36, 50, 32 };
+    ltfat_int W[]  = {  1,  2,  1,  3,  1,  2 };
+    ltfat_int Nb[] = {  5,  4,  7,  3,  2,  6 };
+    ltfat_int nthreads[] = { 1, 3 };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(a); id++)
+    {
+        // The signal is followed by zeros flushing the overlap of the stream
+        ltfat_int L = bl[id] * (Nb[id] + (gl[id] + bl[id] - 1) / bl[id] + 1);
+        ltfat_int M2 = M[id] / 2 + 1, N = L / a[id], b2 = gl[id] / a[id] / 2;
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_REAL* glong = LTFAT_NAME(malloc)(L);
+        LTFAT_REAL* f = LTFAT_NAME(calloc)(L * W[id]);
+        LTFAT_REAL* fchunk = LTFAT_NAME(malloc)(L * W[id]);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        LTFAT_COMPLEX* cchunk = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        for (ltfat_int w = 0; w < W[id]; w++)
+            TEST_NAME(fillRand)(f + w * L, bl[id] * Nb[id]);
+        LTFAT_NAME(firwin)(LTFAT_HANN, gl[id], g);
+        LTFAT_NAME(fir2long)(g, gl[id], L, glong);
+
+        for (unsigned int tId = 0; tId < ARRAYLEN(nthreads); tId++)
+        {
+            for (int pt = 0; pt < 2; pt++)
+            {
+                ltfat_phaseconvention ptype = pt ? LTFAT_TIMEINV : LTFAT_FREQINV;
+                LTFAT_NAME(dgtreal_ola_plan) p;
+                LTFAT_REAL err;
+
+                // The frequency-invariant phase needs whole periods in a block
+                if (ptype == LTFAT_FREQINV && bl[id] % M[id]) continue;
+
+                LTFAT_NAME(dgtreal_long)(f, glong, L, W[id], a[id], M[id], ptype,
+                                         cref);
+
+                // Flags 0 means FFTW_MEASURE, the planners may overwrite buffers
+                p = LTFAT_NAME(dgtreal_ola_init)(g, gl[id], W[id], a[id], M[id],
+                                                 bl[id], ptype, 0);
+                mu_assert( LTFAT_NAME(dgtreal_ola_setnthreads)(&p, nthreads[tId])
+                           == LTFATERR_SUCCESS, "dgtreal_ola_setnthreads returns success");
+
+                for (ltfat_int l = 0; l < M2 * N * W[id]; l++) c[l] = NAN;
+                LTFAT_NAME(dgtreal_ola_execute)(p, f, L, c);
+                err = TEST_NAME(ola_maxdiff)(c, cref, M2 * N * W[id]);
+                mu_assert( err < tol,
+                           "dgtreal_ola equals dgtreal_long, case %d, ptype=%d, nthreads=%td",
+                           id, ptype, nthreads[tId]);
+
+                LTFAT_NAME(dgtreal_ola_done)(p);
+            }
+
+            // Streaming in chunks of 1, 2 and 3 blocks matches the DGT of the
+            // signal, delayed by b2 frames
+            {
+                LTFAT_NAME(dgtreal_ola_plan) p;
+                LTFAT_REAL err = 0;
+                ltfat_int Lchunk = bl[id];
+
+                LTFAT_NAME(dgtreal_long)(f, glong, L, W[id], a[id], M[id],
+                                         LTFAT_TIMEINV, cref);
+
+                p = LTFAT_NAME(dgtreal_ola_init)(g, gl[id], W[id], a[id], M[id],
+                                                 bl[id], LTFAT_TIMEINV, 0);
+                LTFAT_NAME(dgtreal_ola_setnthreads)(&p, nthreads[tId]);
+
+                for (int rep = 0; rep < 2; rep++)
+                {
+                    // The reset discards the overlap of an unrelated block
+                    if (rep > 0)
+                    {
+                        TEST_NAME(fillRand)(fchunk, bl[id] * W[id]);
+                        LTFAT_NAME(dgtreal_ola_execute_stream)(&p, fchunk, bl[id],
+                                                               cchunk);
+                        mu_assert( LTFAT_NAME(dgtreal_ola_reset)(&p) == LTFATERR_SUCCESS,
+                                   "dgtreal_ola_reset returns success");
+                    }
+
+                    for (ltfat_int pos = 0; pos < L; pos += Lchunk)
+                    {
+                        ltfat_int Nchunk;
+                        Lchunk = pos == 0 ? bl[id] : Lchunk % (3 * bl[id]) + bl[id];
+                        if (pos + Lchunk > L) Lchunk = L - pos;
+                        Nchunk = Lchunk / a[id];
+
+                        for (ltfat_int w = 0; w < W[id]; w++)
+                            memcpy(fchunk + w * Lchunk, f + w * L + pos,
+                                   Lchunk * sizeof * f);
+
+                        mu_assert(
+                            LTFAT_NAME(dgtreal_ola_execute_stream)(&p, fchunk, Lchunk,
+                                    cchunk) == LTFATERR_SUCCESS,
+                            "dgtreal_ola_execute_stream returns success");
+
+                        for (ltfat_int w = 0; w < W[id]; w++)
+                            for (ltfat_int n = 0; n < Nchunk; n++)
+                                memcpy(c + M2 * (w * N + pos / a[id] + n),
+                                       cchunk + M2 * (w * Nchunk + n),
+                                       M2 * sizeof * c);
+                    }
+
+                    for (ltfat_int w = 0; w < W[id]; w++)
+                        for (ltfat_int n = 0; n < N; n++)
+                        {
+                            ltfat_int nref = ltfat_positiverem(n - b2, N);
+                            LTFAT_REAL errn =
+                                TEST_NAME(ola_maxdiff)(c + M2 * (w * N + n),
+                                                       cref + M2 * (w * N + nref), M2);
+                            if (errn > err) err = errn;
+                        }
+
+                    mu_assert( err < tol,
+                               "dgtreal_ola_execute_stream equals delayed dgtreal_long, "
+                               "case %d, nthreads=%td, rep=%d",
+                               id, nthreads[tId], rep);
+                }
+
+                LTFAT_NAME(dgtreal_ola_done)(p);
+            }
+
+            // Streaming the signal without the trailing zeros, the flush
+            // emits the b2 frames still held back
+            {
+                LTFAT_NAME(dgtreal_ola_plan) p;
+                LTFAT_REAL err = 0;
+                ltfat_int Ls = bl[id] * Nb[id], Ns = Ls / a[id];
+
+                p = LTFAT_NAME(dgtreal_ola_init)(g, gl[id], W[id], a[id], M[id],
+                                                 bl[id], LTFAT_TIMEINV, 0);
+                LTFAT_NAME(dgtreal_ola_setnthreads)(&p, nthreads[tId]);
+
+                for (int rep = 0; rep < 2; rep++)
+                {
+                    for (ltfat_int w = 0; w < W[id]; w++)
+                        memcpy(fchunk + w * Ls, f + w * L, Ls * sizeof * f);
+
+                    mu_assert(
+                        LTFAT_NAME(dgtreal_ola_execute_stream)(&p, fchunk, Ls, cchunk)
+                        == LTFATERR_SUCCESS, "dgtreal_ola_execute_stream returns success");
+                    mu_assert(
+                        LTFAT_NAME(dgtreal_ola_stream_flush)(&p, c) == b2,
+                        "dgtreal_ola_stream_flush returns b2");
+
+                    // The flushed frames follow the frames of the stream
+                    for (ltfat_int w = 0; w < W[id]; w++)
+                        for (ltfat_int n = 0; n < Ns + b2; n++)
+                        {
+                            const LTFAT_COMPLEX* cn = n < Ns ?
+                                                      cchunk + M2 * (w * Ns + n) :
+                                                      c + M2 * (w * b2 + n - Ns);
+                            ltfat_int nref = ltfat_positiverem(n - b2, N);
+                            LTFAT_REAL errn =
+                                TEST_NAME(ola_maxdiff)(cn, cref + M2 * (w * N + nref), M2);
+                            if (errn > err) err = errn;
+                        }
+
+                    // The flush resets the plan, the second run is identical
+                    mu_assert( err < tol,
+                               "dgtreal_ola_execute_stream followed by "
+                               "dgtreal_ola_stream_flush equals dgtreal_long, "
+                               "case %d, nthreads=%td, rep=%d", id, nthreads[tId], rep);
+                }
+
+                LTFAT_NAME(dgtreal_ola_done)(p);
+            }
+        }
+
+        ltfat_free(g);
+        ltfat_free(glong);
+        ltfat_free(f);
+        ltfat_free(fchunk);
+        ltfat_free(cref);
+        ltfat_free(c);
+        ltfat_free(cchunk);
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+int TEST_NAME(test_dgtrealmp_atoms)()
+{
+    ltfat_int Ls = 8192, atomsLen = 3000;
+    ltfat_int gl[] = { 512, 128 }, a[] = { 128, 32 }, M[] = { 512, 128 };
+    LTFAT_FIRWIN win[] = { LTFAT_BLACKMAN, LTFAT_HANN };
+    ltfat_dgtmp_alg alg[] = { ltfat_dgtmp_alg_MP, ltfat_dgtmp_alg_LocCyclicMP };
+    ltfat_phaseconvention ptype[] = { LTFAT_TIMEINV, LTFAT_FREQINV };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_NAME(dgtrealmp_atom)* atoms =
+        LTFAT_NEWARRAY(LTFAT_NAME(dgtrealmp_atom), atomsLen);
+    LTFAT_NAME(dgtrealmp_atom)* atoms2 =
+        LTFAT_NEWARRAY(LTFAT_NAME(dgtrealmp_atom), atomsLen);
+
+    for (unsigned int algid = 0; algid < ARRAYLEN(alg); algid++)
+    {
+        for (unsigned int pid = 0; pid < ARRAYLEN(ptype); pid++)
+        {
+            LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+            LTFAT_NAME(dgtrealmp_state)* p = NULL;
+            LTFAT_COMPLEX* c[2];
+            ltfat_int M2[2], N[2], nnz = 0;
+            size_t atomsNo = 0, atomsNo2 = 0;
+            unsigned char* buf;
+            ptrdiff_t bufLen;
+            LTFAT_REAL cerr = 0, ferr = 0, fnorm = 0;
+
+            mu_assert( LTFAT_NAME(dgtrealmp_parbuf_init)(&pb) == LTFATERR_SUCCESS,
+                       "parbuf_init");
+            for (int k = 0; k < 2; k++)
+                mu_assert( LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(
+                               pb, win[k], gl[k], a[k], M[k])
+                           == LTFATERR_SUCCESS, "add_firwin");
+            LTFAT_NAME(dgtrealmp_setparbuf_phaseconv)(pb, ptype[pid]);
+            LTFAT_NAME(dgtrealmp_setparbuf_alg)(pb, alg[algid]);
+            LTFAT_NAME(dgtrealmp_setparbuf_snrdb)(pb, 30);
+            LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, 2000);
+
+            ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, Ls);
+            mu_assert( LTFAT_NAME(dgtrealmp_init)(pb, L, &p) == LTFATERR_SUCCESS,
+                       "dgtrealmp_init");
+
+            LTFAT_REAL* f = LTFAT_NAME_REAL(calloc)(L);
+            LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L);
+            LTFAT_REAL* fatoms = LTFAT_NAME_REAL(malloc)(L);
+            TEST_NAME(fillRand)(f, Ls);
+            for (ltfat_int l = 0; l < Ls; l++)
+                f[l] *= 1e-2;
+            for (ltfat_int k = 0; k < 20; k++)
+            {
+                ltfat_int start = (k * 3571) % (Ls - 2000), len = 300 + (k * 131) % 1500;
+                double freq = 0.01 + 0.45 * ((k * 37) % 100) / 100.0;
+                for (ltfat_int l = 0; l < len; l++)
+                    f[start + l] += sin(2.0 * M_PI * freq * l) * sin(M_PI * l / len);
+            }
+
+            for (int k = 0; k < 2; k++)
+            {
+                M2[k] = M[k] / 2 + 1; N[k] = L / a[k];
+                c[k] = LTFAT_NAME_COMPLEX(calloc)(M2[k] * N[k]);
+            }
+
+            // Dense reference
+            mu_assert( LTFAT_NAME(dgtrealmp_execute)(p, f, c, fout) >= 0,
+                       "dgtrealmp_execute");
+
+            mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+                           p, f, atomsLen, atoms, &atomsNo) >= 0,
+                       "decompose_atoms");
+
+            // The atoms are exactly the non-zero dense coefficients
+            for (int k = 0; k < 2; k++)
+                for (ltfat_int l = 0; l < M2[k] * N[k]; l++)
+                    if (LTFAT_COMPLEXH(cabs)(c[k][l]) > 0) nnz++;
+
+            for (size_t i = 0; i < atomsNo; i++)
+            {
+                LTFAT_COMPLEX cref =
+                    c[atoms[i].w][atoms[i].m + M2[atoms[i].w] * atoms[i].n];
+                LTFAT_REAL d = LTFAT_COMPLEXH(cabs)(cref - atoms[i].c) /
+                               (1 + LTFAT_COMPLEXH(cabs)(cref));
+                if (d > cerr) cerr = d;
+            }
+            mu_assert( atomsNo > 0 && (ltfat_int) atomsNo == nnz,
+                       "Atom count %zu, dense non-zeros %td, alg=%d, ptype=%d",
+                       atomsNo, nnz, alg[algid], ptype[pid]);
+            mu_assert( cerr < tol, "Atom coefficients, alg=%d, ptype=%d, err %g",
+                       alg[algid], ptype[pid], cerr);
+
+            // Synthesis from the atoms equals the dense synthesis
+            mu_assert( LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+                           p, atoms, atomsNo, NULL, fatoms) == LTFATERR_SUCCESS,
+                       "synthesize_atoms");
+            for (ltfat_int l = 0; l < L; l++)
+            {
+                ferr += (fatoms[l] - fout[l]) * (fatoms[l] - fout[l]);
+                fnorm += fout[l] * fout[l];
+            }
+            mu_assert( sqrt(ferr / fnorm) < tol,
+                       "Atom synthesis, alg=%d, ptype=%d, rel. err %g",
+                       alg[algid], ptype[pid], sqrt(ferr / fnorm));
+
+            // Serialization round trip
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_sort)(atoms, atomsNo)
+                       == LTFATERR_SUCCESS, "atoms_sort");
+            bufLen = LTFAT_NAME(dgtrealmp_atoms_serialize)(atoms, atomsNo, 0, NULL);
+            mu_assert( bufLen > 0 &&
+                       (size_t) bufLen < atomsNo * sizeof(LTFAT_NAME(dgtrealmp_atom)),
+                       "Serialized length %td", bufLen);
+            buf = LTFAT_NEWARRAY(unsigned char, bufLen);
+
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_serialize)(
+                           atoms, atomsNo, bufLen - 1, buf) == LTFATERR_BADREQSIZE,
+                       "Serialization buffer too short");
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_serialize)(
+                           atoms, atomsNo, bufLen, buf) == bufLen, "atoms_serialize");
+
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+                           buf, bufLen, 0, NULL, &atomsNo2) >= 0 && atomsNo2 == atomsNo,
+                       "Atom count from the header");
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+                           buf, bufLen, atomsNo - 1, atoms2, &atomsNo2)
+                       == LTFATERR_BADREQSIZE, "Atom array too short");
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+                           buf, bufLen, atomsLen, atoms2, &atomsNo2) == bufLen,
+                       "atoms_deserialize");
+            {
+                size_t mismatches = 0;
+                for (size_t i = 0; i < atomsNo2; i++)
+                    if (atoms[i].w != atoms2[i].w || atoms[i].m != atoms2[i].m ||
+                        atoms[i].n != atoms2[i].n || atoms[i].c != atoms2[i].c)
+                        mismatches++;
+                mu_assert( atomsNo2 == atomsNo && mismatches == 0,
+                           "Deserialized atoms, alg=%d, ptype=%d, %zu mismatches",
+                           alg[algid], ptype[pid], mismatches);
+            }
+
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+                           buf, bufLen - 3, atomsLen, atoms2, &atomsNo2) < 0,
+                       "Truncated stream");
+            buf[0] = sizeof(LTFAT_REAL) == sizeof(double) ? sizeof(float) : sizeof(double);
+            mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+                           buf, bufLen, atomsLen, atoms2, &atomsNo2)
+                       == LTFATERR_BADARG, "Stream of other precision");
+
+            // Too many atoms for the output array
+            mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+                           p, f, atomsNo / 2, atoms2, &atomsNo2)
+                       == LTFATERR_BADREQSIZE, "Atom array too short for decompose");
+
+            ltfat_free(buf);
+            for (int k = 0; k < 2; k++)
+                ltfat_free(c[k]);
+            ltfat_free(f);
+            ltfat_free(fout);
+            ltfat_free(fatoms);
+            LTFAT_NAME(dgtrealmp_done)(&p);
+            LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+        }
+    }
+
+    // The atoms are deserialized with LTFAT_COMPLEX(re, im), which must not
+    // round to a lower precision
+    {
+        double re = 1.0 + 1e-12, im = -1.0 - 1e-12;
+        LTFAT_COMPLEX z = LTFAT_COMPLEX(re, im);
+        mu_assert( sizeof(LTFAT_COMPLEX(re, im)) == sizeof(LTFAT_COMPLEX) &&
+                   ltfat_real(z) == (LTFAT_REAL) re && ltfat_imag(z) == (LTFAT_REAL) im,
+                   "LTFAT_COMPLEX(re, im) keeps the precision of LTFAT_REAL");
+    }
+
+    ltfat_free(atoms);
+    ltfat_free(atoms2);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/* Runs the decomposition and returns its SNR in dB, fout is the approximation */
+int TEST_NAME(parmp_run)(ltfat_dgtmp_alg alg, ltfat_int nthreads,
+                         const LTFAT_REAL* f, ltfat_int Ls,
+                         LTFAT_COMPLEX** c, LTFAT_REAL* fout, double* snr,
+                         size_t* atoms)
+{
+    ltfat_int gl[] = { 512, 128 }, a[] = { 128, 32 }, M[] = { 512, 128 };
+    LTFAT_FIRWIN win[] = { LTFAT_BLACKMAN, LTFAT_HANN };
+    LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+    LTFAT_NAME(dgtrealmp_state)* p = NULL;
+    double ferr = 0, fnorm = 0;
+    int status;
+
+    LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+    for (int k = 0; k < 2; k++)
+        LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, win[k], gl[k], a[k], M[k]);
+    LTFAT_NAME(dgtrealmp_setparbuf_alg)(pb, alg);
+    LTFAT_NAME(dgtrealmp_setparbuf_snrdb)(pb, 30);
+    LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, 10000);
+    LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(pb, nthreads);
+
+    LTFAT_NAME(dgtrealmp_init)(pb, Ls, &p);
+    status = LTFAT_NAME(dgtrealmp_execute)(p, f, c, fout);
+    LTFAT_NAME(dgtrealmp_get_numatoms)(p, atoms);
+
+    for (ltfat_int l = 0; l < Ls; l++)
+    {
+        ferr += (f[l] - fout[l]) * (f[l] - fout[l]);
+        fnorm += f[l] * f[l];
+    }
+    *snr = 10.0 * log10(fnorm / ferr);
+
+    LTFAT_NAME(dgtrealmp_done)(&p);
+    LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+    return status;
+}
+
+int TEST_NAME(test_dgtrealmp_parmp)()
+{
+    ltfat_int Ls = 8192, M2[] = { 257, 65 }, N[] = { 64, 256 };
+    ltfat_int nthreads[] = { 1, 2, 4 };
+    LTFAT_REAL* f = LTFAT_NAME_REAL(calloc)(Ls);
+    LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(Ls);
+    LTFAT_REAL* foutpar = LTFAT_NAME_REAL(malloc)(Ls);
+    LTFAT_REAL* foutpar1 = LTFAT_NAME_REAL(malloc)(Ls);
+    LTFAT_COMPLEX* c[2], *cpar[2], *cpar1[2];
+    double snr, snrpar;
+    size_t atoms, atomspar;
+
+    TEST_NAME(fillRand)(f, Ls);
+    for (ltfat_int l = 0; l < Ls; l++)
+        f[l] *= 1e-2;
+    for (ltfat_int k = 0; k < 20; k++)
+    {
+        ltfat_int start = (k * 3571) % (Ls - 2000), len = 300 + (k * 131) % 1500;
+        double freq = 0.01 + 0.45 * ((k * 37) % 100) / 100.0;
+        for (ltfat_int l = 0; l < len; l++)
+            f[start + l] += sin(2.0 * M_PI * freq * l) * sin(M_PI * l / len);
+    }
+
+    for (int k = 0; k < 2; k++)
+    {
+        c[k] = LTFAT_NAME_COMPLEX(calloc)(M2[k] * N[k]);
+        cpar[k] = LTFAT_NAME_COMPLEX(calloc)(M2[k] * N[k]);
+        cpar1[k] = LTFAT_NAME_COMPLEX(calloc)(M2[k] * N[k]);
+    }
+
+    mu_assert( TEST_NAME(parmp_run)(ltfat_dgtmp_alg_MP, 1, f, Ls, c, fout,
+                                    &snr, &atoms)
+               == LTFAT_DGTREALMP_STATUS_TOLREACHED, "MP reaches the target SNR");
+
+    for (unsigned int tId = 0; tId < ARRAYLEN(nthreads); tId++)
+    {
+        int equal = 1;
+        LTFAT_COMPLEX** cout = tId == 0 ? cpar1 : cpar;
+        LTFAT_REAL* fo = tId == 0 ? foutpar1 : foutpar;
+
+        mu_assert( TEST_NAME(parmp_run)(ltfat_dgtmp_alg_ParallelMP, nthreads[tId],
+                                        f, Ls, cout, fo, &snrpar, &atomspar)
+                   == LTFAT_DGTREALMP_STATUS_TOLREACHED,
+                   "ParallelMP reaches the target SNR, nthreads=%td", nthreads[tId]);
+
+        // The atoms are selected in a different order, the approximation must
+        // be about as good and not much sparser than the one of MP
+        mu_assert( snrpar > 29.9 && fabs(snrpar - snr) < 0.5 &&
+                   atomspar < 1.2 * atoms,
+                   "ParallelMP SNR %g dB with %zu atoms is comparable to MP "
+                   "SNR %g dB with %zu atoms", snrpar, atomspar, snr, atoms);
+
+        if (tId == 0) continue;
+
+        // The result does not depend on the number of threads
+        equal &= !memcmp(fo, foutpar1, Ls * sizeof * fo);
+        for (int k = 0; k < 2; k++)
+            equal &= !memcmp(cout[k], cpar1[k], M2[k] * N[k] * sizeof * cout[k]);
+        mu_assert( equal, "ParallelMP with nthreads=%td equals nthreads=1",
+                   nthreads[tId]);
+    }
+
+    for (int k = 0; k < 2; k++)
+    {
+        ltfat_free(c[k]);
+        ltfat_free(cpar[k]);
+        ltfat_free(cpar1[k]);
+    }
+    ltfat_free(f);
+    ltfat_free(fout);
+    ltfat_free(foutpar);
+    ltfat_free(foutpar1);
+    return 0;
+}
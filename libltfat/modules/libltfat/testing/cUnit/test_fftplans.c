@@ -0,0 +1,94 @@
+int TEST_NAME(test_fftplans)()
+{
+    const char* filename = "test_fftplans.wisdom";
+    ltfat_int L = 240, W = 3, M2 = L / 2 + 1;
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+    LTFAT_REAL err = 0;
+    LTFAT_NAME(fft_plan)* p1 = NULL, *p2 = NULL;
+    LTFAT_NAME(fftreal_plan)* pr1 = NULL, *pr2 = NULL;
+    LTFAT_COMPLEX* in1 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* in2 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* in2copy = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* out1 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* out2 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* outref = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_REAL* inr1 = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* inr2 = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* inr2copy = LTFAT_NAME_REAL(malloc)(L * W);
+    int status;
+
+    // flags 0 is FFTW_MEASURE, which overwrites the arrays while planning.
+    // The second plan with identical parameters reuses the plan of the
+    // first one and leaves its arrays intact.
+    TEST_NAME_COMPLEX(fillRand)(in2, L * W);
+    memcpy(in2copy, in2, L * W * sizeof * in2);
+    memcpy(outref, in2, L * W * sizeof * in2);
+    LTFAT_NAME(fft)(outref, L, W, outref);
+
+    mu_assert( LTFAT_NAME(fft_init)(L, W, in1, out1, 0, &p1) == LTFATERR_SUCCESS,
+               "fft_init returns success");
+    mu_assert( LTFAT_NAME(fft_init)(L, W, in2, out2, 0, &p2) == LTFATERR_SUCCESS,
+               "fft_init with identical parameters returns success");
+    mu_assert( !memcmp(in2, in2copy, L * W * sizeof * in2),
+               "fft_init with identical parameters keeps the input");
+
+    // The shared plan outlives the plan it was created for
+    LTFAT_NAME(fft_done)(&p1);
+    LTFAT_NAME(fft_execute)(p2);
+    for (ltfat_int l = 0; l < L * W; l++)
+        if (LTFAT_COMPLEXH(cabs)(out2[l] - outref[l]) > err)
+            err = LTFAT_COMPLEXH(cabs)(out2[l] - outref[l]);
+    mu_assert( err < tol, "The shared fft plan works after the first one was destroyed");
+    LTFAT_NAME(fft_done)(&p2);
+
+    err = 0;
+    TEST_NAME(fillRand)(inr2, L * W);
+    memcpy(inr2copy, inr2, L * W * sizeof * inr2);
+    LTFAT_NAME(fftreal)(inr2copy, L, W, outref);
+
+    mu_assert( LTFAT_NAME(fftreal_init)(L, W, inr1, out1, 0, &pr1) == LTFATERR_SUCCESS,
+               "fftreal_init returns success");
+    mu_assert( LTFAT_NAME(fftreal_init)(L, W, inr2, out2, 0, &pr2) == LTFATERR_SUCCESS,
+               "fftreal_init with identical parameters returns success");
+    mu_assert( !memcmp(inr2, inr2copy, L * W * sizeof * inr2),
+               "fftreal_init with identical parameters keeps the input");
+
+    LTFAT_NAME(fftreal_done)(&pr1);
+    LTFAT_NAME(fftreal_execute)(pr2);
+    for (ltfat_int l = 0; l < M2 * W; l++)
+        if (LTFAT_COMPLEXH(cabs)(out2[l] - outref[l]) > err)
+            err = LTFAT_COMPLEXH(cabs)(out2[l] - outref[l]);
+    mu_assert( err < tol, "The shared fftreal plan works after the first one was destroyed");
+    LTFAT_NAME(fftreal_done)(&pr2);
+
+    // Wisdom is only available with FFTW
+    status = LTFAT_NAME(fft_wisdom_forget)();
+    if (status == LTFATERR_NOTSUPPORTED)
+    {
+        mu_assert( LTFAT_NAME(fft_wisdom_export)(filename) == LTFATERR_NOTSUPPORTED &&
+                   LTFAT_NAME(fft_wisdom_import)(filename) == LTFATERR_NOTSUPPORTED,
+                   "fft_wisdom_export and fft_wisdom_import are not supported");
+    }
+    else
+    {
+        mu_assert( status == LTFATERR_SUCCESS, "fft_wisdom_forget returns success");
+        mu_assert( LTFAT_NAME(fft_wisdom_export)(filename) == LTFATERR_SUCCESS,
+                   "fft_wisdom_export returns success");
+        mu_assert( LTFAT_NAME(fft_wisdom_import)(filename) == LTFATERR_SUCCESS,
+                   "fft_wisdom_import reads the exported wisdom");
+        remove(filename);
+        mu_assert( LTFAT_NAME(fft_wisdom_import)(filename) == LTFATERR_FAILED,
+                   "fft_wisdom_import fails for a missing file");
+    }
+
+    ltfat_free(in1);
+    ltfat_free(in2);
+    ltfat_free(in2copy);
+    ltfat_free(out1);
+    ltfat_free(out2);
+    ltfat_free(outref);
+    ltfat_free(inr1);
+    ltfat_free(inr2);
+    ltfat_free(inr2copy);
+    return 0;
+}
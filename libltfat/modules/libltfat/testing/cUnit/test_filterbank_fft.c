@@ -0,0 +1,105 @@
+int TEST_NAME(test_filterbank_fft)()
+{
+    // Painless filterbank: the filters cover the whole frequency axis and each
+    // of them is shorter than the number of subband coefficients. L spans
+    // several chunks of the accumulation.
+    ltfat_int L = 2880, W = 2, M = 4;
+    ltfat_int a[] = { 2, 3, 4, 6 };
+    double afrac[] = { 2.0, 3.0, 4.0, 6.0 };
+    ltfat_int foff[] = { 0, 1200, 2000, 2480 };
+    ltfat_int Gl[] = { 1440, 960, 720, 480 };
+    int realonly[] = { 0, 0, 0, 0 };
+    int nthreads[] = { 1, 4 };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+    LTFAT_COMPLEX* G[4], *Gd[4], *Gbl[4], *Gdbl[4], *c[4];
+    LTFAT_REAL* S = LTFAT_NAME_REAL(calloc)(L);
+    LTFAT_COMPLEX* F = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* Fr = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* Fr1 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* Frbl1 = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    TEST_NAME_COMPLEX(fillRand)(F, L * W);
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        G[m] = LTFAT_NAME_COMPLEX(calloc)(L);
+        Gd[m] = LTFAT_NAME_COMPLEX(calloc)(L);
+        Gbl[m] = LTFAT_NAME_COMPLEX(malloc)(Gl[m]);
+        Gdbl[m] = LTFAT_NAME_COMPLEX(malloc)(Gl[m]);
+        c[m] = LTFAT_NAME_COMPLEX(malloc)(L / a[m] * W);
+
+        TEST_NAME_COMPLEX(fillRand)(Gbl[m], Gl[m]);
+        for (ltfat_int l = 0; l < Gl[m]; l++)
+        {
+            ltfat_int lL = (foff[m] + l) % L;
+            Gbl[m][l] += 2.0;
+            G[m][lL] = Gbl[m][l];
+            S[lL] += (ltfat_real(Gbl[m][l]) * ltfat_real(Gbl[m][l]) +
+                      ltfat_imag(Gbl[m][l]) * ltfat_imag(Gbl[m][l])) / a[m];
+        }
+    }
+
+    // The canonical dual filters
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        for (ltfat_int l = 0; l < L; l++)
+            Gd[m][l] = G[m][l] / S[l];
+        for (ltfat_int l = 0; l < Gl[m]; l++)
+            Gdbl[m][l] = Gbl[m][l] / S[(foff[m] + l) % L];
+    }
+
+    for (unsigned int tId = 0; tId < ARRAYLEN(nthreads); tId++)
+    {
+        LTFAT_REAL err = 0;
+        LTFAT_COMPLEX* Fout = tId == 0 ? Fr1 : Fr;
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads[tId]);
+#endif
+
+        LTFAT_NAME(filterbank_fft)(F, (const LTFAT_COMPLEX**) G, L, W, a, M, c);
+        LTFAT_NAME(ifilterbank_fft)((const LTFAT_COMPLEX**) c,
+                                    (const LTFAT_COMPLEX**) Gd, L, W, a, M, Fout);
+
+        for (ltfat_int l = 0; l < L * W; l++)
+            if (LTFAT_COMPLEXH(cabs)(Fout[l] - F[l]) > err)
+                err = LTFAT_COMPLEXH(cabs)(Fout[l] - F[l]);
+        mu_assert( err < tol, "ifilterbank_fft reconstructs, nthreads=%d, err=%g",
+                   nthreads[tId], (double) err);
+        if (tId > 0)
+            mu_assert( !memcmp(Fout, Fr1, L * W * sizeof * Fout),
+                       "ifilterbank_fft with nthreads=%d equals nthreads=1",
+                       nthreads[tId]);
+
+        err = 0;
+        Fout = tId == 0 ? Frbl1 : Fr;
+        LTFAT_NAME(filterbank_fftbl)(F, (const LTFAT_COMPLEX**) Gbl, L, Gl, W,
+                                     afrac, M, foff, realonly, c);
+        LTFAT_NAME(ifilterbank_fftbl)((const LTFAT_COMPLEX**) c,
+                                      (const LTFAT_COMPLEX**) Gdbl, L, Gl, W,
+                                      afrac, M, foff, realonly, Fout);
+
+        for (ltfat_int l = 0; l < L * W; l++)
+            if (LTFAT_COMPLEXH(cabs)(Fout[l] - F[l]) > err)
+                err = LTFAT_COMPLEXH(cabs)(Fout[l] - F[l]);
+        mu_assert( err < tol, "ifilterbank_fftbl reconstructs, nthreads=%d, err=%g",
+                   nthreads[tId], (double) err);
+        if (tId > 0)
+            mu_assert( !memcmp(Fout, Frbl1, L * W * sizeof * Fout),
+                       "ifilterbank_fftbl with nthreads=%d equals nthreads=1",
+                       nthreads[tId]);
+    }
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        ltfat_free(G[m]);
+        ltfat_free(Gd[m]);
+        ltfat_free(Gbl[m]);
+        ltfat_free(Gdbl[m]);
+        ltfat_free(c[m]);
+    }
+    ltfat_free(S);
+    ltfat_free(F);
+    ltfat_free(Fr);
+    ltfat_free(Fr1);
+    ltfat_free(Frbl1);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/* Pops all elements from h and checks that each popped value is, up to the
+ * resolution of the queue, the maximum of the remaining ones. inheap marks
+ * the keys currently in h. Returns the number of violations. */
+ltfat_int TEST_NAME(heap_popall)(LTFAT_NAME(heap)* h, const LTFAT_REAL* s,
+                                 int* inheap, ltfat_int L, double resol,
+                                 int do_log)
+{
+    ltfat_int errors = 0, key;
+
+    while ((key = LTFAT_NAME(heap_get)(h)) >= 0)
+    {
+        LTFAT_REAL smax = -INFINITY;
+        if (LTFAT_NAME(heap_delete)(h) != key || !inheap[key]) errors++;
+        inheap[key] = 0;
+
+        for (ltfat_int l = 0; l < L; l++)
+            if (inheap[l] && s[l] > smax) smax = s[l];
+
+        if (do_log ? s[key] < smax - resol : s[key] < smax / resol)
+            errors++;
+    }
+
+    for (ltfat_int l = 0; l < L; l++)
+        if (inheap[l]) errors++;
+
+    return errors;
+}
+
+int TEST_NAME(test_heap)()
+{
+    ltfat_int L = 2000;
+    ltfat_heaptype type[] = { LTFAT_HEAP_BINARY, LTFAT_HEAP_BUCKET };
+    LTFAT_REAL* s = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* slog = LTFAT_NAME_REAL(malloc)(L);
+    int* inheap = LTFAT_NEWARRAY(int, L);
+
+    // Magnitudes spanning several octaves, some exactly zero
+    TEST_NAME(fillRand)(s, L);
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        s[l] = l % 50 == 0 ? 0 : exp(20.0 * s[l]);
+        slog[l] = log(s[l] + 1e-30);
+    }
+
+    for (unsigned int tid = 0; tid < ARRAYLEN(type); tid++)
+    {
+        for (int do_log = 0; do_log <= 1; do_log++)
+        {
+            const LTFAT_REAL* sval = do_log ? slog : s;
+            // The bucket queue does not distinguish values in one bucket.
+            // The magnitude buckets split each octave linearly, the widest
+            // one spans the ratio 1 + 2^-LTFAT_HEAP_BUCKETBITS.
+            double bucketwidth = 1.0 / (1 << LTFAT_HEAP_BUCKETBITS);
+            double resol = type[tid] == LTFAT_HEAP_BINARY ? (do_log ? 0 : 1) :
+                           (do_log ? log(2.0) * bucketwidth : 1 + bucketwidth) * (1 + 1e-6);
+
+            // Small initial size to force growing
+            LTFAT_NAME(heap)* h =
+                LTFAT_NAME(heap_init_gen)(16, sval, type[tid], do_log);
+            mu_assert( LTFAT_NAME(heap_get)(h) == LTFATERR_UNDERFLOW &&
+                       LTFAT_NAME(heap_delete)(h) == LTFATERR_UNDERFLOW,
+                       "Empty heap, type=%d", type[tid]);
+
+            for (ltfat_int l = 0; l < L; l++)
+            {
+                LTFAT_NAME(heap_insert)(h, l);
+                inheap[l] = 1;
+            }
+            mu_assert( TEST_NAME(heap_popall)(h, sval, inheap, L, resol, do_log) == 0,
+                       "Insert all, pop all, type=%d, do_log=%d", type[tid], do_log);
+
+            // Interleaved inserts and deletes reuse the freed nodes
+            {
+                ltfat_int errors = 0;
+                for (ltfat_int l = 0; l < L; l++)
+                {
+                    LTFAT_NAME(heap_insert)(h, l);
+                    inheap[l] = 1;
+                    if (l % 3 == 2)
+                    {
+                        ltfat_int key = LTFAT_NAME(heap_delete)(h);
+                        LTFAT_REAL smax = -INFINITY;
+                        for (ltfat_int k = 0; k <= l; k++)
+                            if (inheap[k] && sval[k] > smax) smax = sval[k];
+                        if (key < 0 || !inheap[key] ||
+                            (do_log ? sval[key] < smax - resol : sval[key] < smax / resol))
+                            errors++;
+                        else
+                            inheap[key] = 0;
+                    }
+                }
+                errors += TEST_NAME(heap_popall)(h, sval, inheap, L, resol, do_log);
+                mu_assert( errors == 0, "Interleaved, type=%d, do_log=%d, %td errors",
+                           type[tid], do_log, errors);
+            }
+
+            // Reset of a partially filled heap
+            for (ltfat_int l = 0; l < L / 2; l++)
+                LTFAT_NAME(heap_insert)(h, l);
+            LTFAT_NAME(heap_reset)(h, sval);
+            mu_assert( LTFAT_NAME(heap_get)(h) == LTFATERR_UNDERFLOW,
+                       "Empty after reset, type=%d", type[tid]);
+            for (ltfat_int l = L / 2; l < L; l++)
+            {
+                LTFAT_NAME(heap_insert)(h, l);
+                inheap[l] = 1;
+            }
+            mu_assert( TEST_NAME(heap_popall)(h, sval, inheap, L, resol, do_log) == 0,
+                       "After reset, type=%d, do_log=%d", type[tid], do_log);
+
+            LTFAT_NAME(heap_done)(h);
+        }
+    }
+
+    ltfat_free(s);
+    ltfat_free(slog);
+    ltfat_free(inheap);
+    return 0;
+}
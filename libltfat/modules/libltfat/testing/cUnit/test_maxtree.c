@@ -53,6 +53,25 @@ for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
             }
         }
 
+        TEST_NAME(fillRand)(fin, L[lId]);
+        LTFAT_NAME(maxtree_reset)(p, fin);
+
+        for (unsigned int idx = 0; idx < L[lId]; idx++)
+        {
+            for (unsigned int rIdx = 0; rIdx < ARRAYLEN(rLen); rIdx++)
+            {
+                ltfat_int end = ltfat_imin(idx + rLen[rIdx], L[lId]);
+
+                LTFAT_NAME(findmaxinarray)(fin + idx, end - idx, &max, &maxPos);
+                maxPos += idx;
+
+                LTFAT_NAME(maxtree_findmaxinrange)(p, idx, end, &max2, &maxPos2);
+
+                mu_assert( max == max2 && maxPos == maxPos2 ,
+                           "TREEMAXRANGE L=%td, d=%td, idx=%d, r=%td",
+                           L[lId], depth[dId], idx, rLen[rIdx] );
+            }
+        }
 
         LTFAT_NAME(maxtree_done)(&p);
     }
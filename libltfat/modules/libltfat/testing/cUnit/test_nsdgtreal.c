@@ -0,0 +1,90 @@
+int TEST_NAME(test_nsdgtreal)()
+{
+    ltfat_int a[]  =  {  5,   8,   8,  12,   6,   9,  10};
+    ltfat_int M[]  =  { 16,  16,  24,  32,  16,  20,  24};
+    ltfat_int gl[] =  { 12,  16,  24,  30,   9,  20,  18};
+    ltfat_int W = 3;
+    ltfat_int N = ARRAYLEN(a);
+    ltfat_int L = ltfat_nsdgtlength(a, N);
+    ltfat_int C = ltfat_nsdgtreal_coefsize(M, N);
+
+    LTFAT_REAL* g[ARRAYLEN(a)];
+    LTFAT_REAL* gd[ARRAYLEN(a)];
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        g[n] = LTFAT_NAME(malloc)(gl[n]);
+        gd[n] = LTFAT_NAME(malloc)(gl[n]);
+        TEST_NAME(fillRand)(g[n], gl[n]);
+    }
+
+    LTFAT_REAL* f = LTFAT_NAME(malloc)(L * W);
+    TEST_NAME(fillRand)(f, L * W);
+    LTFAT_REAL* frec = LTFAT_NAME(malloc)(L * W);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(C * W);
+
+    mu_assert(
+        LTFAT_NAME(nsgabdual_painless)((const LTFAT_REAL**)g, gl, a, M, N, gd)
+        == LTFATERR_SUCCESS, "nsgabdual_painless");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**)g, gl, a, M, N, L, W, c)
+        == LTFATERR_SUCCESS, "nsdgtreal");
+
+    mu_assert(
+        LTFAT_NAME(insdgtreal)(c, (const LTFAT_REAL**)gd, gl, a, M, N, L, W, frec)
+        == LTFATERR_SUCCESS, "insdgtreal");
+
+    LTFAT_REAL err = 0;
+    for (ltfat_int l = 0; l < L * W; l++)
+    {
+        LTFAT_REAL d = frec[l] - f[l];
+        if (d < 0) d = -d;
+        if (d > err) err = d;
+    }
+    mu_assert( err < (sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4),
+               "Perfect reconstruction, max error %g", (double) err);
+
+    // Inputs can be checked only once
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(NULL, (const LTFAT_REAL**)g, gl, a, M, N, L, W, c)
+        == LTFATERR_NULLPOINTER, "Signal is null");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, NULL, gl, a, M, N, L, W, c)
+        == LTFATERR_NULLPOINTER, "Windows are null");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**)g, gl, a, M, N, L, W, NULL)
+        == LTFATERR_NULLPOINTER, "Coefficients array is null");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**)g, gl, a, M, 0, L, W, c)
+        == LTFATERR_NOTPOSARG, "N is not positive");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**)g, gl, a, M, N, L, 0, c)
+        == LTFATERR_NOTPOSARG, "W is not positive");
+
+    mu_assert(
+        LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**)g, gl, a, M, N, L - 1, W, c)
+        == LTFATERR_BADTRALEN, "L is not sum of a");
+
+    mu_assert(
+        LTFAT_NAME(nsgabdual_painless)((const LTFAT_REAL**)g, gl, a, gl, N, gd)
+        == LTFATERR_SUCCESS, "nsgabdual_painless M == gl");
+
+    M[3] = gl[3] - 1;
+    mu_assert(
+        LTFAT_NAME(nsgabdual_painless)((const LTFAT_REAL**)g, gl, a, M, N, gd)
+        == LTFATERR_NOTPAINLESS, "Not painless");
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        ltfat_free(g[n]);
+        ltfat_free(gd[n]);
+    }
+    ltfat_free(f);
+    ltfat_free(frec);
+    ltfat_free(c);
+    return 0;
+}
@@ -0,0 +1,163 @@
+/* Gain depending on the frequency and the channel, the coefficients are
+ * in[m + w*M2] or in[w + m*W] depending on the layout passed in userdata */
+void TEST_NAME(rtdgtreal_gain)(void* userdata, const LTFAT_COMPLEX in[],
+                               int M2, int W, LTFAT_COMPLEX out[])
+{
+    rtdgt_layout layout = *(rtdgt_layout*) userdata;
+
+    for (int w = 0; w < W; w++)
+        for (int m = 0; m < M2; m++)
+        {
+            ltfat_int ii = layout == LTFAT_RTDGTLAYOUT_CHANMAJOR ? m + w * M2 : w + m * W;
+            out[ii] = in[ii] * (LTFAT_REAL)(1.0 + w + (double) m / M2);
+        }
+}
+
+int TEST_NAME(test_rtdgtreal)()
+{
+    ltfat_int M[] = { 32, 32, 31 };
+    ltfat_int gl[] = { 24, 48, 70 };
+    ltfat_int Wmax[] = { 1, 3, 4 };
+    ltfat_int W = 7;
+    rtdgt_layout layout[] = { LTFAT_RTDGTLAYOUT_CHANMAJOR, LTFAT_RTDGTLAYOUT_FREQMAJOR };
+    rtdgt_phasetype ptype[] = { LTFAT_RTDGTPHASE_ZERO, LTFAT_RTDGTPHASE_HALFSHIFT };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // The batched plans equal the single-channel plans for any W, in
+    // particular if W is not divisible by Wmax, and for gl > M
+    for (unsigned int mId = 0; mId < ARRAYLEN(M); mId++)
+    {
+        ltfat_int M2 = M[mId] / 2 + 1;
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl[mId]);
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(gl[mId] * W);
+        LTFAT_REAL* fr = LTFAT_NAME(malloc)(gl[mId] * W);
+        LTFAT_REAL* frbatch = LTFAT_NAME(malloc)(gl[mId] * W);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * W);
+        LTFAT_COMPLEX* cbatch = LTFAT_NAME_COMPLEX(malloc)(M2 * W);
+        TEST_NAME(fillRand)(g, gl[mId]);
+        TEST_NAME(fillRand)(f, gl[mId] * W);
+
+        for (unsigned int pId = 0; pId < ARRAYLEN(ptype); pId++)
+        {
+            LTFAT_NAME(rtdgtreal_plan)* p = NULL, *pi = NULL;
+
+            mu_assert( LTFAT_NAME(rtdgtreal_init)(g, gl[mId], M[mId], ptype[pId], &p)
+                       == LTFATERR_SUCCESS, "rtdgtreal_init returns success");
+            mu_assert( LTFAT_NAME(rtidgtreal_init)(g, gl[mId], M[mId], ptype[pId], &pi)
+                       == LTFATERR_SUCCESS, "rtidgtreal_init returns success");
+
+            // Reference, one channel at a time
+            for (ltfat_int w = 0; w < W; w++)
+            {
+                LTFAT_NAME(rtdgtreal_execute)(p, f + w * gl[mId], 1, c + w * M2);
+                LTFAT_NAME(rtidgtreal_execute)(pi, c + w * M2, 1, fr + w * gl[mId]);
+            }
+
+            for (unsigned int wId = 0; wId < ARRAYLEN(Wmax); wId++)
+            {
+                for (unsigned int lId = 0; lId < ARRAYLEN(layout); lId++)
+                {
+                    LTFAT_NAME(rtdgtreal_plan)* pb = NULL, *pib = NULL;
+                    LTFAT_REAL err = 0, errinv = 0;
+
+                    mu_assert( LTFAT_NAME(rtdgtreal_init_batch)(g, gl[mId], M[mId],
+                               ptype[pId], Wmax[wId], layout[lId], &pb)
+                               == LTFATERR_SUCCESS, "rtdgtreal_init_batch returns success");
+                    mu_assert( LTFAT_NAME(rtidgtreal_init_batch)(g, gl[mId], M[mId],
+                               ptype[pId], Wmax[wId], layout[lId], &pib)
+                               == LTFATERR_SUCCESS, "rtidgtreal_init_batch returns success");
+
+                    LTFAT_NAME(rtdgtreal_execute)(pb, f, W, cbatch);
+
+                    for (ltfat_int w = 0; w < W; w++)
+                        for (ltfat_int m = 0; m < M2; m++)
+                        {
+                            ltfat_int ii = layout[lId] == LTFAT_RTDGTLAYOUT_CHANMAJOR ?
+                                           m + w * M2 : w + m * W;
+                            LTFAT_REAL d = LTFAT_COMPLEXH(cabs)(cbatch[ii] - c[m + w * M2]);
+                            if (d > err) err = d;
+                        }
+
+                    LTFAT_NAME(rtidgtreal_execute)(pib, cbatch, W, frbatch);
+
+                    for (ltfat_int l = 0; l < gl[mId] * W; l++)
+                        if (fabs(frbatch[l] - fr[l]) > errinv)
+                            errinv = fabs(frbatch[l] - fr[l]);
+
+                    mu_assert( err < tol && errinv < tol,
+                               "Batched plans equal the single-channel plans, M=%td, "
+                               "gl=%td, W=%td, Wmax=%td, layout=%d, ptype=%d",
+                               M[mId], gl[mId], W, Wmax[wId], layout[lId], ptype[pId]);
+
+                    LTFAT_NAME(rtdgtreal_done)(&pb);
+                    LTFAT_NAME(rtidgtreal_done)(&pib);
+                }
+            }
+
+            LTFAT_NAME(rtdgtreal_done)(&p);
+            LTFAT_NAME(rtidgtreal_done)(&pi);
+        }
+
+        ltfat_free(g);
+        ltfat_free(f);
+        ltfat_free(fr);
+        ltfat_free(frbatch);
+        ltfat_free(c);
+        ltfat_free(cbatch);
+    }
+
+    // The processor passes the coefficients in the layout which was set
+    {
+        ltfat_int gpl = 64, a = 16, Mp = 64, Wp = 3, bufLen = 37, L = 1000;
+        LTFAT_REAL err = 0;
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(L * Wp);
+        LTFAT_REAL* fout[2];
+        TEST_NAME(fillRand)(f, L * Wp);
+
+        for (unsigned int lId = 0; lId < ARRAYLEN(layout); lId++)
+        {
+            LTFAT_NAME(rtdgtreal_processor_state)* p = NULL;
+            fout[lId] = LTFAT_NAME(malloc)(L * Wp);
+
+            mu_assert( LTFAT_NAME(rtdgtreal_processor_init_win)(LTFAT_HANN, gpl, a, Mp,
+                       Wp, bufLen, gpl - 1, &p) == LTFATERR_SUCCESS,
+                       "rtdgtreal_processor_init_win returns success");
+            LTFAT_NAME(rtdgtreal_processor_setcallback)(p,
+                    &TEST_NAME(rtdgtreal_gain), &layout[lId]);
+            mu_assert( LTFAT_NAME(rtdgtreal_processor_setlayout)(p, layout[lId])
+                       == LTFATERR_SUCCESS, "rtdgtreal_processor_setlayout returns success");
+
+            for (ltfat_int pos = 0; pos < L; pos += bufLen)
+            {
+                ltfat_int len = L - pos < bufLen ? L - pos : bufLen;
+                const LTFAT_REAL* inPtr[3];
+                LTFAT_REAL* outPtr[3];
+                for (ltfat_int w = 0; w < Wp; w++)
+                {
+                    inPtr[w] = f + w * L + pos;
+                    outPtr[w] = fout[lId] + w * L + pos;
+                }
+                LTFAT_NAME(rtdgtreal_processor_execute)(p, inPtr, len, Wp, outPtr);
+            }
+
+            LTFAT_NAME(rtdgtreal_processor_done)(&p);
+        }
+
+        for (ltfat_int l = 0; l < L * Wp; l++)
+            if (fabs(fout[1][l] - fout[0][l]) > err)
+                err = fabs(fout[1][l] - fout[0][l]);
+
+        mu_assert( err < tol, "Processor with LTFAT_RTDGTLAYOUT_FREQMAJOR equals "
+                   "LTFAT_RTDGTLAYOUT_CHANMAJOR");
+
+        mu_assert( LTFAT_NAME(rtdgtreal_processor_setlayout)(NULL,
+                   LTFAT_RTDGTLAYOUT_CHANMAJOR) == LTFATERR_NULLPOINTER,
+                   "rtdgtreal_processor_setlayout rejects NULL");
+
+        ltfat_free(f);
+        ltfat_free(fout[0]);
+        ltfat_free(fout[1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+int TEST_NAME(test_rtwmdct)()
+{
+    ltfat_int M[] = { 4, 5, 16, 63 };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // The processor reconstructs the delayed input
+    for (unsigned int mId = 0; mId < ARRAYLEN(M); mId++)
+    {
+        ltfat_int gl[] = { 2 * M[mId], 2 * M[mId] - 1, M[mId] + 2 };
+
+        for (unsigned int gId = 0; gId < ARRAYLEN(gl); gId++)
+        {
+            ltfat_int W = 3, bufLen = M[mId] + 7, delay = gl[gId] - 1;
+            ltfat_int L = 40 * M[mId] + 123;
+            LTFAT_REAL err = 0;
+            LTFAT_NAME(rtwmdct_processor_state)* p = NULL;
+            LTFAT_REAL* f = LTFAT_NAME(malloc)(W * L);
+            LTFAT_REAL* fout = LTFAT_NAME(malloc)(W * L);
+            const LTFAT_REAL* inPtr[3];
+            LTFAT_REAL* outPtr[3];
+            TEST_NAME(fillRand)(f, W * L);
+
+            mu_assert(
+                LTFAT_NAME(rtwmdct_processor_init_win)(LTFAT_HANN, gl[gId], M[mId],
+                        W, bufLen, delay, &p) == LTFATERR_SUCCESS,
+                "rtwmdct_processor_init_win returns success");
+
+            for (ltfat_int pos = 0; pos < L; pos += bufLen)
+            {
+                ltfat_int len = L - pos < bufLen ? L - pos : bufLen;
+                for (ltfat_int w = 0; w < W; w++)
+                {
+                    inPtr[w] = f + w * L + pos;
+                    outPtr[w] = fout + w * L + pos;
+                }
+                LTFAT_NAME(rtwmdct_processor_execute)(p, inPtr, len, W, outPtr);
+            }
+
+            for (ltfat_int w = 0; w < W; w++)
+                for (ltfat_int l = delay + 2 * gl[gId]; l < L; l++)
+                    if (fabs(fout[w * L + l] - f[w * L + l - delay]) > err)
+                        err = fabs(fout[w * L + l] - f[w * L + l - delay]);
+
+            mu_assert( err < tol,
+                       "Processor reconstructs the input, M=%td, gl=%td, err=%g",
+                       M[mId], gl[gId], (double) err);
+
+            LTFAT_NAME(rtwmdct_processor_done)(&p);
+            ltfat_free(f);
+            ltfat_free(fout);
+        }
+    }
+
+    // The frame plan equals dwiltiii_fb on a periodic signal. The channels are
+    // transformed in batches of Wmax with the last one incomplete.
+    {
+        ltfat_int Mf = 16, gl = 32, L = 8 * Mf, W = 3, Wmax = 2;
+        LTFAT_REAL err = 0;
+        LTFAT_NAME(rtwmdct_plan)* p = NULL;
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl);
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(W * L);
+        LTFAT_REAL* fr = LTFAT_NAME(malloc)(W * gl);
+        LTFAT_REAL* c = LTFAT_NAME(malloc)(W * L);
+        LTFAT_REAL* cr = LTFAT_NAME(malloc)(W * Mf);
+        TEST_NAME(fillRand)(f, W * L);
+        LTFAT_NAME(firwin)(LTFAT_HANN, gl, g);
+
+        LTFAT_NAME(dwiltiii_fb)(f, g, L, gl, W, Mf, c);
+        mu_assert( LTFAT_NAME(rtwmdct_init)(g, gl, Mf, Wmax, &p) == LTFATERR_SUCCESS,
+                   "rtwmdct_init returns success");
+
+        for (ltfat_int n = 0; n < L / Mf; n++)
+        {
+            for (ltfat_int w = 0; w < W; w++)
+                for (ltfat_int l = 0; l < gl; l++)
+                    fr[w * gl + l] =
+                        f[w * L + ltfat_positiverem(n * Mf - gl / 2 + l, L)];
+
+            LTFAT_NAME(rtwmdct_execute)(p, fr, n, W, cr);
+
+            for (ltfat_int w = 0; w < W; w++)
+                for (ltfat_int m = 0; m < Mf; m++)
+                    if (fabs(cr[w * Mf + m] - c[w * L + n * Mf + m]) > err)
+                        err = fabs(cr[w * Mf + m] - c[w * L + n * Mf + m]);
+        }
+
+        mu_assert( err < tol, "rtwmdct_execute equals dwiltiii_fb, err=%g",
+                   (double) err);
+
+        LTFAT_NAME(rtwmdct_done)(&p);
+        ltfat_free(g);
+        ltfat_free(f);
+        ltfat_free(fr);
+        ltfat_free(c);
+        ltfat_free(cr);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* Feeds f to the sliding MP in chunks of varying length and returns the
+ * output in fout */
+int TEST_NAME(slidgtrealmp_run)(LTFAT_NAME(slidgtrealmp_state)* p,
+                                const LTFAT_REAL* f, ltfat_int Ls, ltfat_int W,
+                                ltfat_int chunkLenMax, LTFAT_REAL* fout)
+{
+    ltfat_int chunkLen = 1;
+    for (ltfat_int pos = 0; pos < Ls; )
+    {
+        const LTFAT_REAL* in[2];
+        LTFAT_REAL* out[2];
+        ltfat_int len = ltfat_imin(chunkLen, Ls - pos);
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            in[w] = f + w * Ls + pos;
+            out[w] = fout + w * Ls + pos;
+        }
+
+        int status = LTFAT_NAME(slidgtrealmp_execute)(p, in, len, W, out);
+        if (status != LTFATERR_SUCCESS) return status;
+
+        pos += len;
+        chunkLen = (chunkLen * 7) % chunkLenMax + 1;
+    }
+    return LTFATERR_SUCCESS;
+}
+
+int TEST_NAME(test_slidgtrealmp)()
+{
+    ltfat_int Ls = 24576, W = 2, L = 4096, hop = 256, bufLenMax = 1000;
+    double snrdb = 30;
+    LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+    LTFAT_NAME(slidgtrealmp_state)* p = NULL;
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(Ls * W);
+    LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(Ls * W);
+    LTFAT_REAL* fout2 = LTFAT_NAME_REAL(malloc)(Ls * W);
+    size_t mem, mem2;
+    double lasttime, maxtime;
+
+    // Windowed sinusoids in low level noise
+    TEST_NAME(fillRand)(f, Ls * W);
+    for (ltfat_int l = 0; l < Ls * W; l++)
+        f[l] *= 1e-3;
+    for (ltfat_int k = 0; k < 60; k++)
+    {
+        ltfat_int start = (k * 7919) % (Ls * W - 2000), len = 300 + (k * 131) % 1500;
+        double freq = 0.01 + 0.45 * ((k * 37) % 100) / 100.0;
+        for (ltfat_int l = 0; l < len; l++)
+            f[start + l] += sin(2.0 * M_PI * freq * l) * sin(M_PI * l / len);
+    }
+
+    mu_assert( LTFAT_NAME(dgtrealmp_parbuf_init)(&pb) == LTFATERR_SUCCESS,
+               "parbuf_init");
+    mu_assert( LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN,
+               256, 64, 256) == LTFATERR_SUCCESS, "add_firwin");
+    mu_assert( LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN,
+               64, 16, 64) == LTFATERR_SUCCESS, "add_firwin");
+    mu_assert( LTFAT_NAME(dgtrealmp_setparbuf_snrdb)(pb, snrdb)
+               == LTFATERR_SUCCESS, "setparbuf_snrdb");
+
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_streaming)(pb, L, hop, W, bufLenMax,
+               &p) == LTFATERR_SUCCESS, "init_streaming");
+    mu_assert( LTFAT_NAME(slidgtrealmp_get_memusage)(p, &mem) == LTFATERR_SUCCESS,
+               "get_memusage");
+
+    mu_assert( TEST_NAME(slidgtrealmp_run)(p, f, Ls, W, bufLenMax, fout)
+               == LTFATERR_SUCCESS, "execute");
+
+    // The output is the approximation of the delayed input
+    ltfat_int d = LTFAT_NAME(slidgtrealmp_getprocdelay)(p);
+    mu_assert( d > 0 && d < L, "procdelay %td", d);
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        double err = 0, fnorm = 0;
+        for (ltfat_int l = d; l < Ls; l++)
+        {
+            double x = f[w * Ls + l - d], y = fout[w * Ls + l];
+            err += (x - y) * (x - y);
+            fnorm += x * x;
+        }
+        mu_assert( 10.0 * log10(fnorm / err) > snrdb - 6,
+                   "Streaming approximation, w=%td, snr=%g dB", w,
+                   10.0 * log10(fnorm / err));
+    }
+
+    // Timing and memory
+    mu_assert( LTFAT_NAME(slidgtrealmp_get_lastslicetime)(p, &lasttime)
+               == LTFATERR_SUCCESS, "get_lastslicetime");
+    mu_assert( LTFAT_NAME(slidgtrealmp_get_maxslicetime)(p, &maxtime)
+               == LTFATERR_SUCCESS, "get_maxslicetime");
+    mu_assert( lasttime >= 0 && maxtime >= lasttime && maxtime > 0,
+               "Step time last=%g, max=%g", lasttime, maxtime);
+    mu_assert( LTFAT_NAME(slidgtrealmp_get_memusage)(p, &mem2)
+               == LTFATERR_SUCCESS, "get_memusage");
+    mu_assert( mem == mem2 && mem > 0, "Memory usage is constant");
+
+    // After reset, the output does not depend on the chunk sizes
+    mu_assert( LTFAT_NAME(slidgtrealmp_reset)(p) == LTFATERR_SUCCESS, "reset");
+    mu_assert( LTFAT_NAME(slidgtrealmp_get_maxslicetime)(p, &maxtime)
+               == LTFATERR_SUCCESS && maxtime == 0, "reset maxslicetime");
+    mu_assert( TEST_NAME(slidgtrealmp_run)(p, f, Ls, W, 97, fout2)
+               == LTFATERR_SUCCESS, "execute after reset");
+    {
+        LTFAT_REAL maxdiff = 0;
+        for (ltfat_int l = 0; l < Ls * W; l++)
+            maxdiff = fmax(maxdiff, fabs(fout[l] - fout2[l]));
+        mu_assert( maxdiff == 0, "Output does not depend on chunk sizes, diff %g",
+                   maxdiff);
+    }
+    LTFAT_NAME(slidgtrealmp_done)(&p);
+
+    // Wrong parameters
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_streaming)(NULL, L, hop, W,
+               bufLenMax, &p) == LTFATERR_NULLPOINTER, "pb is NULL");
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_streaming)(pb, L, 0, W,
+               bufLenMax, &p) == LTFATERR_NOTPOSARG, "hop is zero");
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_streaming)(pb, L, hop, 0,
+               bufLenMax, &p) == LTFATERR_NOTPOSARG, "numChans is zero");
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_streaming)(pb, 1024, hop, W,
+               bufLenMax, &p) == LTFATERR_BADARG, "L is too short");
+
+    LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+    ltfat_free(f);
+    ltfat_free(fout);
+    ltfat_free(fout2);
+    return 0;
+}
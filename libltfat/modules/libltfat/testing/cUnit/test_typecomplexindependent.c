@@ -11,4 +11,6 @@
 #include "test_firwin.c"
 #include "test_gabdual_painless.c"
 #include "test_gabdual_long.c"
+#include "test_wfbt.c"
 
+#include "test_convsub_td.c"
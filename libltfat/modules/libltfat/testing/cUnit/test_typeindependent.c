@@ -9,3 +9,20 @@
 #include "test_idgtreal_fb.c"
 #include "test_dgtreal_long.c"
 #include "test_idgtreal_long.c"
+#include "test_dgt_long_nthreads.c"
+#include "test_nsdgtreal.c"
+#include "test_circularbuf.c"
+#include "test_block_processor.c"
+#include "test_slidgtrealmp.c"
+#include "test_dgtrealmp_atoms.c"
+#include "test_dgtrealmp_parmp.c"
+#include "test_heap.c"
+#include "test_wilson_fb.c"
+#include "test_rtdgtreal.c"
+#include "test_rtwmdct.c"
+#include "test_dgtreal_ola.c"
+#include "test_dgtreal_fb_stream.c"
+#include "test_dgtreal_blockfunc.c"
+#include "test_coeffile.c"
+#include "test_filterbank_fft.c"
+#include "test_fftplans.c"
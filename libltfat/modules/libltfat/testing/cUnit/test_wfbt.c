@@ -0,0 +1,220 @@
+/* Runs f through the analysis plan pa and the synthesis plan ps and
+ * returns the max. reconstruction error */
+LTFAT_REAL TEST_NAME(wfbt_recerr)(LTFAT_NAME(wfbt_plan)* pa,
+                                  LTFAT_NAME(wfbt_plan)* ps,
+                                  const LTFAT_TYPE* f, ltfat_int L, ltfat_int W)
+{
+    ltfat_int outno = LTFAT_NAME(wfbt_get_outno)(pa);
+    ltfat_int* Lc = LTFAT_NEWARRAY(ltfat_int, outno);
+    LTFAT_TYPE** c = LTFAT_NEWARRAY(LTFAT_TYPE*, outno);
+    LTFAT_TYPE* frec = LTFAT_NAME(malloc)(L * W);
+    LTFAT_REAL err = 0;
+
+    LTFAT_NAME(wfbt_get_outlens)(pa, Lc);
+    for (ltfat_int k = 0; k < outno; k++)
+        c[k] = LTFAT_NAME(malloc)(Lc[k] * W);
+
+    if (LTFAT_NAME(wfbt_execute)(pa, f, c) != LTFATERR_SUCCESS ||
+        LTFAT_NAME(iwfbt_execute)(ps, (const LTFAT_TYPE**)c, frec)
+        != LTFATERR_SUCCESS)
+        err = 1;
+
+    for (ltfat_int l = 0; l < L * W; l++)
+    {
+        LTFAT_REAL d = TEST_NAME(absDiff)(frec[l], f[l]);
+        if (d > err) err = d;
+    }
+
+    for (ltfat_int k = 0; k < outno; k++)
+        ltfat_free(c[k]);
+    ltfat_free(c);
+    ltfat_free(Lc);
+    ltfat_free(frec);
+    return err;
+}
+
+int TEST_NAME(test_wfbt)()
+{
+    ltfat_int L[] = { 64,  96, 128};
+    ltfat_int W[] = {  1,   2,   3};
+    ltfat_int J[] = {  1,   3,   5};
+    ltfatExtType ext[] = {PER, ZPD};
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // Haar filters are orthonormal, the synthesis filters are the same
+    LTFAT_TYPE h0[] = { 0.70710678118654752, 0.70710678118654752 };
+    LTFAT_TYPE h1[] = { 0.70710678118654752, -0.70710678118654752 };
+    const LTFAT_TYPE* g[] = { h0, h1 };
+    ltfat_int gl[] = { 2, 2 };
+    ltfat_int a[] = { 2, 2 };
+    ltfat_int offset[] = { 0, 0 };
+
+    for (unsigned int id = 0; id < ARRAYLEN(L); id++)
+    {
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id] * W[id]);
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+
+        for (unsigned int eid = 0; eid < ARRAYLEN(ext); eid++)
+        {
+            LTFAT_NAME(wfbt_tree)* tree = NULL;
+            LTFAT_NAME(wfbt_plan)* pa = NULL;
+            LTFAT_NAME(wfbt_plan)* ps = NULL;
+            LTFAT_NAME(wfbt_plan)* pp = NULL;
+
+            // Fast wavelet transform
+            mu_assert(
+                LTFAT_NAME(fwt_tree_init)(g, gl, a, offset, 2, J[id], &tree)
+                == LTFATERR_SUCCESS, "fwt_tree_init");
+            mu_assert(
+                LTFAT_NAME(wfbt_init)(tree, L[id], W[id], ext[eid], &pa)
+                == LTFATERR_SUCCESS, "wfbt_init fwt");
+            mu_assert(
+                LTFAT_NAME(iwfbt_init)(tree, L[id], W[id], ext[eid], &ps)
+                == LTFATERR_SUCCESS, "iwfbt_init fwt");
+            mu_assert(
+                LTFAT_NAME(wfbt_get_outno)(pa) == J[id] + 1, "fwt outno");
+
+            mu_assert( TEST_NAME(wfbt_recerr)(pa, ps, f, L[id], W[id]) < tol,
+                       "fwt perfect reconstruction, ext=%d", ext[eid]);
+
+            // The wavelet packet outputs of the fwt tree contain the fwt
+            // coefficients, see wpfbt_init for the ordering
+            mu_assert(
+                LTFAT_NAME(wpfbt_init)(tree, L[id], W[id], ext[eid], &pp)
+                == LTFATERR_SUCCESS, "wpfbt_init");
+            mu_assert(
+                LTFAT_NAME(wfbt_get_outno)(pp) == 2 * J[id], "wpfbt outno");
+            {
+                ltfat_int Lc[12], Lcp[12];
+                LTFAT_TYPE* c[12];
+                LTFAT_TYPE* cp[12];
+                LTFAT_REAL err = 0;
+                LTFAT_NAME(wfbt_get_outlens)(pa, Lc);
+                LTFAT_NAME(wfbt_get_outlens)(pp, Lcp);
+                for (ltfat_int k = 0; k <= J[id]; k++)
+                    c[k] = LTFAT_NAME(malloc)(Lc[k] * W[id]);
+                for (ltfat_int k = 0; k < 2 * J[id]; k++)
+                    cp[k] = LTFAT_NAME(malloc)(Lcp[k] * W[id]);
+
+                mu_assert( LTFAT_NAME(wfbt_execute)(pa, f, c)
+                           == LTFATERR_SUCCESS, "wfbt_execute");
+                mu_assert( LTFAT_NAME(wfbt_execute)(pp, f, cp)
+                           == LTFATERR_SUCCESS, "wpfbt_execute");
+
+                // Node j has outputs 2j and 2j+1, the details of level j+1
+                // are c[J-j] and the coarsest approximation is c[0]
+                for (ltfat_int j = 0; j < J[id]; j++)
+                {
+                    ltfat_int kk[2] = { 2 * j + 1, 2 * (J[id] - 1) };
+                    ltfat_int kc[2] = { J[id] - j, 0 };
+                    for (int i = 0; i < (j == J[id] - 1 ? 2 : 1); i++)
+                    {
+                        if (Lcp[kk[i]] != Lc[kc[i]]) err = 1;
+                        else
+                            for (ltfat_int l = 0; l < Lc[kc[i]] * W[id]; l++)
+                            {
+                                LTFAT_REAL d =
+                                    TEST_NAME(absDiff)(cp[kk[i]][l], c[kc[i]][l]);
+                                if (d > err) err = d;
+                            }
+                    }
+                }
+                mu_assert( err < tol, "wpfbt equals wfbt, ext=%d", ext[eid]);
+
+                for (ltfat_int k = 0; k <= J[id]; k++)
+                    ltfat_free(c[k]);
+                for (ltfat_int k = 0; k < 2 * J[id]; k++)
+                    ltfat_free(cp[k]);
+            }
+
+            LTFAT_NAME(wfbt_done)(&pa);
+            LTFAT_NAME(wfbt_done)(&ps);
+            LTFAT_NAME(wfbt_done)(&pp);
+            LTFAT_NAME(wfbt_tree_done)(&tree);
+
+            // General tree: full packet tree of depth 2
+            mu_assert( LTFAT_NAME(wfbt_tree_init)(&tree) == LTFATERR_SUCCESS,
+                       "wfbt_tree_init");
+            mu_assert(
+                LTFAT_NAME(wfbt_tree_addnode)(tree, -1, 0, g, gl, a, offset, 2)
+                == 0, "addnode root");
+            mu_assert(
+                LTFAT_NAME(wfbt_tree_addnode)(tree, 0, 0, g, gl, a, offset, 2)
+                == 1, "addnode 1");
+            mu_assert(
+                LTFAT_NAME(wfbt_tree_addnode)(tree, 0, 1, g, gl, a, offset, 2)
+                == 2, "addnode 2");
+            mu_assert(
+                LTFAT_NAME(wfbt_init)(tree, L[id], W[id], ext[eid], &pa)
+                == LTFATERR_SUCCESS, "wfbt_init");
+            mu_assert(
+                LTFAT_NAME(iwfbt_init)(tree, L[id], W[id], ext[eid], &ps)
+                == LTFATERR_SUCCESS, "iwfbt_init");
+            mu_assert( LTFAT_NAME(wfbt_get_outno)(pa) == 4, "wfbt outno");
+
+            mu_assert( TEST_NAME(wfbt_recerr)(pa, ps, f, L[id], W[id]) < tol,
+                       "wfbt perfect reconstruction, ext=%d", ext[eid]);
+
+            LTFAT_NAME(wfbt_done)(&pa);
+            LTFAT_NAME(wfbt_done)(&ps);
+            LTFAT_NAME(wfbt_tree_done)(&tree);
+        }
+
+        ltfat_free(f);
+    }
+
+    LTFAT_NAME(wfbt_tree)* tree = NULL;
+    LTFAT_NAME(wfbt_plan)* pa = NULL;
+    LTFAT_NAME(wfbt_plan)* ps = NULL;
+    LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[0]);
+    LTFAT_TYPE* c[2] = { LTFAT_NAME(malloc)(L[0]), LTFAT_NAME(malloc)(L[0]) };
+    TEST_NAME(fillRand)(f, L[0]);
+    ltfat_int badoffset[] = { 1, 0 };
+
+    mu_assert( LTFAT_NAME(wfbt_tree_init)(&tree) == LTFATERR_SUCCESS,
+               "wfbt_tree_init");
+
+    mu_assert( LTFAT_NAME(wfbt_init)(tree, L[0], 1, PER, &pa) == LTFATERR_EMPTY,
+               "Empty tree");
+
+    mu_assert(
+        LTFAT_NAME(wfbt_tree_addnode)(tree, 0, 0, g, gl, a, offset, 2)
+        == LTFATERR_BADARG, "Parent does not exist");
+
+    mu_assert(
+        LTFAT_NAME(wfbt_tree_addnode)(tree, -1, 0, g, gl, a, badoffset, 2) == 0,
+        "addnode root");
+
+    mu_assert(
+        LTFAT_NAME(wfbt_tree_addnode)(tree, 0, 2, g, gl, a, offset, 2)
+        == LTFATERR_NOTINRANGE, "Parent output out of range");
+
+    mu_assert( LTFAT_NAME(wfbt_init)(tree, L[0], 1, PER, &pa)
+               == LTFATERR_NOTINRANGE, "Offset outside of the filter");
+
+    mu_assert( LTFAT_NAME(wfbt_init)(tree, 0, 1, ZPD, &pa)
+               == LTFATERR_NOTPOSARG, "L is not positive");
+
+    mu_assert( LTFAT_NAME(wfbt_init)(tree, L[0], 1, ZPD, &pa)
+               == LTFATERR_SUCCESS, "wfbt_init");
+
+    mu_assert( LTFAT_NAME(iwfbt_init)(tree, L[0], 1, ZPD, &ps)
+               == LTFATERR_SUCCESS, "iwfbt_init");
+
+    mu_assert( LTFAT_NAME(wfbt_execute)(ps, f, c) == LTFATERR_BADARG,
+               "wfbt_execute with a synthesis plan");
+
+    mu_assert( LTFAT_NAME(iwfbt_execute)(pa, (const LTFAT_TYPE**)c, f)
+               == LTFATERR_BADARG, "iwfbt_execute with an analysis plan");
+
+    mu_assert( LTFAT_NAME(wfbt_execute)(pa, NULL, c) == LTFATERR_NULLPOINTER,
+               "Signal is null");
+
+    LTFAT_NAME(wfbt_done)(&pa);
+    LTFAT_NAME(wfbt_done)(&ps);
+    LTFAT_NAME(wfbt_tree_done)(&tree);
+    ltfat_free(f);
+    ltfat_free(c[0]);
+    ltfat_free(c[1]);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/* Returns the max. abs. difference of x and y relative to the max. of y */
+LTFAT_REAL TEST_NAME(wilson_reldiff)(const LTFAT_REAL* x, const LTFAT_REAL* y,
+                                     ltfat_int n)
+{
+    LTFAT_REAL err = 0, ymax = 0;
+    for (ltfat_int l = 0; l < n; l++)
+    {
+        if (fabs(x[l] - y[l]) > err) err = fabs(x[l] - y[l]);
+        if (fabs(y[l]) > ymax) ymax = fabs(y[l]);
+    }
+    return ymax > 0 ? err / ymax : err;
+}
+
+int TEST_NAME(test_wilson_fb)()
+{
+    ltfat_int L[]  = { 48, 96, 120, 160 };
+    ltfat_int gl[] = {  8, 23,  20,  80 };
+    ltfat_int M[]  = {  4,  6,  10,  40 };
+    ltfat_int W[]  = {  1,  3,   2,   1 };
+    LTFAT_REAL tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (unsigned int id = 0; id < ARRAYLEN(L); id++)
+    {
+        LTFAT_REAL* f = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_REAL* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_REAL* glong = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_REAL* c = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_REAL* cref = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_REAL* fout = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_REAL* fref = LTFAT_NAME(malloc)(L[id] * W[id]);
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+        TEST_NAME(fillRand)(g, gl[id]);
+        LTFAT_NAME(fir2long)(g, gl[id], L[id], glong);
+
+        // The _long functions are the reference
+        mu_assert(
+            LTFAT_NAME(dwilt_fb)(f, g, L[id], gl[id], W[id], M[id], c)
+            == LTFATERR_SUCCESS, "dwilt_fb returns success");
+        LTFAT_NAME(dwilt_long)(f, glong, L[id], W[id], M[id], cref);
+        mu_assert( TEST_NAME(wilson_reldiff)(c, cref, L[id] * W[id]) < tol,
+                   "dwilt_fb equals dwilt_long, L=%td, gl=%td, M=%td",
+                   L[id], gl[id], M[id]);
+
+        mu_assert(
+            LTFAT_NAME(idwilt_fb)(c, g, L[id], gl[id], W[id], M[id], fout)
+            == LTFATERR_SUCCESS, "idwilt_fb returns success");
+        LTFAT_NAME(idwilt_long)(c, glong, L[id], W[id], M[id], fref);
+        mu_assert( TEST_NAME(wilson_reldiff)(fout, fref, L[id] * W[id]) < tol,
+                   "idwilt_fb equals idwilt_long, L=%td, gl=%td, M=%td",
+                   L[id], gl[id], M[id]);
+
+        mu_assert(
+            LTFAT_NAME(dwiltiii_fb)(f, g, L[id], gl[id], W[id], M[id], c)
+            == LTFATERR_SUCCESS, "dwiltiii_fb returns success");
+        LTFAT_NAME(dwiltiii_long)(f, glong, L[id], W[id], M[id], cref);
+        mu_assert( TEST_NAME(wilson_reldiff)(c, cref, L[id] * W[id]) < tol,
+                   "dwiltiii_fb equals dwiltiii_long, L=%td, gl=%td, M=%td",
+                   L[id], gl[id], M[id]);
+
+        mu_assert(
+            LTFAT_NAME(idwiltiii_fb)(c, g, L[id], gl[id], W[id], M[id], fout)
+            == LTFATERR_SUCCESS, "idwiltiii_fb returns success");
+        LTFAT_NAME(idwiltiii_long)(c, glong, L[id], W[id], M[id], fref);
+        mu_assert( TEST_NAME(wilson_reldiff)(fout, fref, L[id] * W[id]) < tol,
+                   "idwiltiii_fb equals idwiltiii_long, L=%td, gl=%td, M=%td",
+                   L[id], gl[id], M[id]);
+
+        ltfat_free(f);
+        ltfat_free(g);
+        ltfat_free(glong);
+        ltfat_free(c);
+        ltfat_free(cref);
+        ltfat_free(fout);
+        ltfat_free(fref);
+    }
+
+    ltfat_int Lb = L[1], glb = gl[1], Mb = M[1];
+    LTFAT_REAL* f = LTFAT_NAME(malloc)(Lb);
+    LTFAT_REAL* g = LTFAT_NAME(malloc)(glb);
+    LTFAT_REAL* c = LTFAT_NAME(malloc)(Lb);
+    TEST_NAME(fillRand)(f, Lb);
+    TEST_NAME(fillRand)(g, glb);
+
+    // The wrappers report the errors of the plans
+    mu_assert( LTFAT_NAME(dwilt_fb)(f, NULL, Lb, glb, 1, Mb, c)
+               == LTFATERR_NULLPOINTER, "dwilt_fb, window is null");
+    mu_assert( LTFAT_NAME(dwilt_fb)(f, g, Lb, 0, 1, Mb, c)
+               == LTFATERR_BADSIZE, "dwilt_fb, gl is not positive");
+    mu_assert( LTFAT_NAME(dwilt_fb)(f, g, Lb + Mb, glb, 1, Mb, c)
+               == LTFATERR_BADTRALEN, "dwilt_fb, L is not divisible by 2M");
+    mu_assert( LTFAT_NAME(dwiltiii_fb)(f, g, Lb, glb, 1, 0, c)
+               == LTFATERR_NOTPOSARG, "dwiltiii_fb, M is not positive");
+    mu_assert( LTFAT_NAME(dwiltiii_fb)(NULL, g, Lb, glb, 1, Mb, c)
+               == LTFATERR_NULLPOINTER, "dwiltiii_fb, signal is null");
+    mu_assert( LTFAT_NAME(idwilt_fb)(c, g, Lb, glb, 1, Mb, NULL)
+               == LTFATERR_NULLPOINTER, "idwilt_fb, signal is null");
+    mu_assert( LTFAT_NAME(idwiltiii_fb)(c, g, 2 * Mb, glb, 1, Mb, f)
+               == LTFATERR_BADTRALEN, "idwiltiii_fb, L is shorter than gl");
+
+    ltfat_free(f);
+    ltfat_free(g);
+    ltfat_free(c);
+    return 0;
+}
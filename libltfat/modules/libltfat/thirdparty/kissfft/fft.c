@@ -295,10 +295,12 @@ void kf_work(
     const int m = *factors++; /* stage's fft length/p */
     const kiss_fft_cpx* Fout_end = Fout + p * m;
 
-#ifdef _OPENMP
+#if defined(_OPENMP) && defined(KISS_FFT_OPENMP)
     // use openmp extensions at the
     // top-level (not recursive)
-    if (fstride == 1 && p <= 5)
+    // libltfat: Disabled by default. The threading is done at the level of
+    // the plans and this branch recurses endlessly when m == 1.
+    if (fstride == 1 && p <= 5 && m > 1)
     {
         int k;
 
@@ -363,6 +363,41 @@ PHASERET_NAME(legla_execute_newarray)(PHASERET_NAME(legla_plan)* p,
 PHASERET_API int
 PHASERET_NAME(legla_done)(PHASERET_NAME(legla_plan)** p);
 
+/** Set number of threads used by the LEGLA plan
+ *
+ * If there are at least \a nthreads channels, the channels are distributed
+ * among the threads and each thread gets its own extended coefficient buffer.
+ * The result is then identical to the single-threaded one.
+ *
+ * Otherwise, the columns of each channel are split into 2*nthreads groups
+ * (but no narrower than half of the kernel width) and the even and odd
+ * groups are updated concurrently in two consecutive sweeps.
+ * With MOD_COEFFICIENTWISE or MOD_FRAMEWISE, this changes the order in which
+ * the columns are updated and the result differs slightly from the
+ * sequential one.
+ *
+ * \note Has no effect if libphaseret was compiled without OpenMP.
+ *
+ * \param[in]        p  LEGLA plan
+ * \param[in] nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_legla_setnthreads_d(phaseret_legla_plan_d* p, ltfat_int nthreads);
+ *
+ * phaseret_legla_setnthreads_s(phaseret_legla_plan_s* p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was not positive
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(legla_setnthreads)(PHASERET_NAME(legla_plan)* p, ltfat_int nthreads);
+
 /** Register status callback
  *
  *  \param[in]         p   LEGLA plan
@@ -432,6 +467,10 @@ PHASERET_NAME(leglaupdate_execute)(PHASERET_NAME(leglaupdate_plan)* plan,
 PHASERET_API void
 PHASERET_NAME(leglaupdate_done)(PHASERET_NAME(leglaupdate_plan)** plan);
 
+PHASERET_API int
+PHASERET_NAME(leglaupdate_setnthreads)(PHASERET_NAME(leglaupdate_plan)* p,
+                                       ltfat_int nthreads);
+
 /* Single col update */
 PHASERET_API int
 PHASERET_NAME(leglaupdate_col_init)(ltfat_int M, phaseret_size ksize, int flags,
@@ -101,8 +101,8 @@ PHASERET_NAME(pghi_withmask)(const LTFAT_COMPLEX cin[], const int mask[],
  * \param[in]        M  Number of frequency channels (FFT length)
  * \param[in]     tol1  Relative tolerance for the first pass, must be in range [0-1]
  * \param[in]     tol2  Relative tolernace for the second pass, must be in range [0-1] and
- *                      lower or equal to \a tol1. If \a tol2 is NAN or it is equal to
- *                      \a tol1, only the first pass will be done.
+ *                      lower than \a tol1. If \a tol2 is NAN, only the first pass
+ *                      will be done.
  * \param[out]       p  PGHI plan
  *
  * #### Versions #
@@ -153,6 +153,7 @@ PHASERET_NAME(pghi_init)(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
  * -------------------------|--------------------------------------------
  * LTFATERR_SUCCESS         | Indicates no error
  * LTFATERR_NULLPOINTER     | Indicates that at least one of the following was NULL: \a p, \a c, \a s
+ * LTFATERR_BADARG          | In-place execution was requested in the tiled mode
  */
 PHASERET_API int
 PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[], LTFAT_COMPLEX c[]);
@@ -163,10 +164,15 @@ PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[], L
  *
  * Nonzero values in \a mask represent known coefficient in \cin
  *
+ * The known coefficients seed the first pass. The second pass with \a tol2
+ * is seeded by all coefficients integrated in the first one, as in
+ * pghi_execute().
+ *
  * \param[in]      p  PGHI plan
  * \param[in]    cin  Coefficients with initial phase, size M2 x N X W
  * \param[in]   mask  Mask used to select coefficients with known phase, size  M2 x N X W
  * \param[in] buffer  Work buffer, size M2 x N. Internal heap allocation occurs if it is NULL
+ *                    or if the plan uses more than one thread.
  * \param[out]  cout  Output coefficients with reconstructed phase, size M2 x N X W
  *
  * #### Versions #
@@ -191,6 +197,134 @@ PHASERET_NAME(pghi_execute_withmask)(PHASERET_NAME(pghi_plan)* p,
                                      const LTFAT_COMPLEX cin[], const int mask[],
                                      LTFAT_REAL buffer[], LTFAT_COMPLEX c[]);
 
+/** Set number of threads used by the PGHI plan
+ *
+ * The channels are distributed among the threads. Each thread gets its own
+ * heap integration task and gradient buffers, which are (re)created by
+ * this function. The number of threads is limited to the number of channels.
+ * Channels are processed serially when the execution is in-place.
+ *
+ * \note Has no effect if libphaseret was compiled without OpenMP.
+ *
+ * \param[in]        p  PGHI plan
+ * \param[in] nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_pghi_setnthreads_d(phaseret_pghi_plan_d* p, ltfat_int nthreads);
+ *
+ * phaseret_pghi_setnthreads_s(phaseret_pghi_plan_s* p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was not positive
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(pghi_setnthreads)(PHASERET_NAME(pghi_plan)* p, ltfat_int nthreads);
+
+/** Choose the priority queue used by the heap integration
+ *
+ * The default LTFAT_HEAP_BINARY processes the coefficients in the strict order
+ * of decreasing magnitude. LTFAT_HEAP_BUCKET quantizes the magnitudes on
+ * a log scale (see LTFAT_HEAP_BUCKETBITS) and it is considerably faster for
+ * large M, but coefficients falling into the same bucket are processed
+ * in an arbitrary order.
+ *
+ * The heap integration tasks are recreated by this function.
+ *
+ * \param[in]         p  PGHI plan
+ * \param[in] queuetype  LTFAT_HEAP_BINARY or LTFAT_HEAP_BUCKET
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_pghi_set_queue_d(phaseret_pghi_plan_d* p, ltfat_heaptype queuetype);
+ *
+ * phaseret_pghi_set_queue_s(phaseret_pghi_plan_s* p, ltfat_heaptype queuetype);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a queuetype is not a valid queue type
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(pghi_set_queue)(PHASERET_NAME(pghi_plan)* p,
+                              ltfat_heaptype queuetype);
+
+/** Enable the tiled mode
+ *
+ * In the tiled mode, the phase is reconstructed in blocks of \a blocklen
+ * frames. Each block is integrated together with \a overlap frames on
+ * both sides. The preceding frames already hold the final phase and they
+ * seed the integration, similarly as the previous frame does in RTPGHI.
+ * The following frames are only used to improve the integration order
+ * close to the block end.
+ *
+ * The working memory is O(M2 x (blocklen + 2*overlap)) per thread instead of
+ * O(M2 x N). The tolerances are still relative to the maximum of the whole
+ * channel.
+ *
+ * The tiled mode is an approximation. The order of the integration differs
+ * from the full PGHI and the spectral convergence is typically up to 1 dB
+ * worse, more for components crossing 0 Hz or the Nyquist frequency. The
+ * gap grows for short overlaps, therefore \a overlap must be at
+ * least pghi_get_minoverlap() frames. Blocks shorter than 2*overlap are
+ * allowed, but they are slower and they widen the gap further.
+ *
+ * The tiled mode is not used if blocklen + 2*overlap >= N.
+ * pghi_execute cannot be executed in-place in the tiled mode and the
+ * \a buffer argument of pghi_execute_withmask is not used.
+ *
+ * The heap integration tasks are recreated by this function.
+ *
+ * \param[in]        p  PGHI plan
+ * \param[in] blocklen  Number of frames of the block, 0 disables the tiled mode
+ * \param[in]  overlap  Number of frames the integration window extends the block by
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_pghi_set_tiling_d(phaseret_pghi_plan_d* p, ltfat_int blocklen,
+ *                            ltfat_int overlap);
+ *
+ * phaseret_pghi_set_tiling_s(phaseret_pghi_plan_s* p, ltfat_int blocklen,
+ *                            ltfat_int overlap);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a blocklen was negative or \a overlap was shorter than pghi_get_minoverlap()
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(pghi_set_tiling)(PHASERET_NAME(pghi_plan)* p,
+                               ltfat_int blocklen, ltfat_int overlap);
+
+/** Minimum overlap of the tiled mode
+ *
+ * The overlap is twice the length of the Hann window with the same \a gamma
+ * in frames, i.e. 2*gl/a for the Hann window.
+ *
+ * \param[in]  p  PGHI plan
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_pghi_get_minoverlap_d(phaseret_pghi_plan_d* p);
+ *
+ * phaseret_pghi_get_minoverlap_s(phaseret_pghi_plan_s* p);
+ * </tt>
+ * \returns Minimum \a overlap accepted by pghi_set_tiling
+ */
+PHASERET_API ltfat_int
+PHASERET_NAME(pghi_get_minoverlap)(PHASERET_NAME(pghi_plan)* p);
+
 /** Destroy PGHI plan
  *
  * \param[in]   p  PGHI plan
@@ -211,6 +345,12 @@ PHASERET_API int
 PHASERET_NAME(pghi_done)(PHASERET_NAME(pghi_plan)** p);
 /** @} */
 
+/** Mask of the coefficients integrated in the last execution
+ *
+ * The mask belongs to the last channel processed by the first thread. It
+ * is only meaningful if the plan runs with a single thread, NULL is
+ * returned otherwise. In the tiled mode, it covers the last tile only.
+ */
 PHASERET_API int*
 PHASERET_NAME(pghi_get_mask)(PHASERET_NAME(pghi_plan)* p);
 
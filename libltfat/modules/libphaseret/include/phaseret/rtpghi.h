@@ -126,6 +126,29 @@ PHASERET_NAME(rtpghi_set_causal)(PHASERET_NAME(rtpghi_state)* p, int do_causal);
 PHASERET_API int
 PHASERET_NAME(rtpghi_set_tol)(PHASERET_NAME(rtpghi_state)* p, double tol);
 
+/** Change the priority queue used by the heap integration
+ *
+ * LTFAT_HEAP_BUCKET replaces the binary heap with a bucket queue over
+ * the quantized log-magnitude. It is faster for large M, but coefficients
+ * falling into the same bucket are processed in an arbitrary order.
+ *
+ * \note This is not thread safe
+ *
+ * \param[in] p          RTPGHI plan
+ * \param[in] queuetype  LTFAT_HEAP_BINARY (default) or LTFAT_HEAP_BUCKET
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtpghi_set_queue_d(phaseret_rtpghi_state_d* p, ltfat_heaptype queuetype);
+ *
+ * phaseret_rtpghi_set_queue_s(phaseret_rtpghi_state_s* p, ltfat_heaptype queuetype);
+ * </tt>
+ * \returns Status code
+ */
+PHASERET_API int
+PHASERET_NAME(rtpghi_set_queue)(PHASERET_NAME(rtpghi_state)* p,
+                                ltfat_heaptype queuetype);
+
 /** Execute RTPGHI plan for a single frame
  *
  *  The function is intedned to be called for consecutive stream of frames
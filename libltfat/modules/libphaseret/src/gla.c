@@ -22,8 +22,53 @@ struct PHASERET_NAME(gla_plan)
     int do_fast;
     double alpha;
     LTFAT_COMPLEX* t;
+// Valid during execution only, used by gla_blockfunc
+    const int* mask;
+    const LTFAT_COMPLEX* cknown;
+    ltfat_int M2N;
 };
 
+/* The per-coefficient part of a single GLA iteration fused into a single
+ * pass: magnitude forcing, resetting the known coefficients and the
+ * acceleration step. Called by the analysis on blocks of coefficients
+ * still in cache. */
+static void
+PHASERET_NAME(gla_blockfunc)(void* userdata, const LTFAT_COMPLEX cin[],
+                             ltfat_int offset, ltfat_int len, LTFAT_COMPLEX cout[])
+{
+    PHASERET_NAME(gla_plan)* p = (PHASERET_NAME(gla_plan)*) userdata;
+    const LTFAT_REAL* s = p->s + offset;
+    const LTFAT_REAL maglim = 1e-10;
+    const LTFAT_REAL alpha = (LTFAT_REAL) p->alpha;
+    LTFAT_COMPLEX* t = p->do_fast ? p->t + offset : NULL;
+    // The mask is shared by all channels
+    const int* mask = p->mask ? p->mask + offset % p->M2N : NULL;
+    const LTFAT_COMPLEX* cknown = p->cknown + offset;
+
+    for (ltfat_int ii = 0; ii < len; ii++)
+    {
+        LTFAT_COMPLEX cval = cin[ii];
+        LTFAT_REAL olds = ltfat_abs(cval);
+
+        if (olds < maglim)
+            cval = s[ii];
+        else
+            cval = s[ii] * cval / olds;
+
+        if (mask && mask[ii])
+            cval = cknown[ii];
+
+        if (t)
+        {
+            LTFAT_COMPLEX cold = cval;
+            cval = cval + alpha * (cval - t[ii]);
+            t[ii] = cold;
+        }
+
+        cout[ii] = cval;
+    }
+}
+
 PHASERET_API int
 PHASERET_NAME(gla)(const LTFAT_COMPLEX cinit[], const int mask[], const LTFAT_REAL g[],
                    ltfat_int L,
@@ -142,35 +187,32 @@ PHASERET_NAME(gla_execute_newarray)(PHASERET_NAME(gla_plan)* p,
     if (p->do_fast)
         memcpy(p->t, cout, (N * M2 * W) * sizeof * p->t );
 
+    p->mask = mask;
+    p->cknown = cinit2 ? cinit2 : cinit;
+    p->M2N = M2 * N;
+
     for (ltfat_int ii = 0; ii < iter; ii++)
     {
-        // Perform idgtreal
-        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, cout, p->f));
-
-        // Optional signal modification
         if (p->fmod_callback)
+        {
+            // Perform idgtreal
+            CHECKSTATUS( LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, cout, p->f));
+
+            // Optional signal modification
             CHECKSTATUS(
                 p->fmod_callback(p->fmod_callback_userdata, p->f, L, W, a, M));
 
-        // Perform dgtreal
-        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, p->f, cout));
-
-        PHASERET_NAME(force_magnitude)(cout, p->s, N * M2 * W, cout);
-
-        if(mask)
-            for(ltfat_int w = 0;w < W; w++)
-                for(ltfat_int jj = 0; jj < N * M2; jj++)
-                    if(mask[jj])
-                    {
-                        if(cinit2)
-                            cout[jj + w * M2 * N] = cinit2[jj + w * M2 * N];
-                        else
-                            cout[jj + w * M2 * N] = cinit[jj + w * M2 * N];
-                    }
-
-        // The acceleration step
-        if (p->do_fast)
-            PHASERET_NAME(fastupdate)(cout, p->t, p->alpha, N * M2 * W );
+            // Perform dgtreal, force magnitude, reset the known coefficients
+            // and do the acceleration step
+            CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_blockfunc)(
+                             p->p, p->f, &PHASERET_NAME(gla_blockfunc), p, cout));
+        }
+        else
+        {
+            // The same as above, without the signal modification
+            CHECKSTATUS( LTFAT_NAME(dgtreal_execute_proj_blockfunc)(
+                             p->p, cout, p->f, &PHASERET_NAME(gla_blockfunc), p, cout));
+        }
 
         // Optional coefficient modification
         if (p->cmod_callback)
@@ -201,6 +243,7 @@ PHASERET_NAME(gla_execute_newarray)(PHASERET_NAME(gla_plan)* p,
     }
 
 error:
+    if (p) { p->mask = NULL; p->cknown = NULL; }
     ltfat_safefree(cinit2);
     return status;
 }
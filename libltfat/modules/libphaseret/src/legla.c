@@ -28,7 +28,9 @@ struct PHASERET_NAME(leglaupdate_plan)
 {
     ltfat_int kNo;
     LTFAT_COMPLEX** k;
-    LTFAT_COMPLEX* buf;
+    LTFAT_COMPLEX** buf; // One extended coefficient buffer per channel thread
+    ltfat_int nbuf;
+    ltfat_int nthreads;
     ltfat_int a;
     ltfat_int N;
     ltfat_int W;
@@ -125,7 +127,7 @@ PHASERET_NAME(legla_init)(const LTFAT_COMPLEX cinit[], const LTFAT_REAL g[],
     ltfat_dgt_setpar_phaseconv(pLoc.dparams, LTFAT_FREQINV);
     /* pLoc.dparams->ptype = LTFAT_FREQINV; */
     CHECKMEM( p->s = LTFAT_NAME_REAL(malloc)(M2 * N * W));
-    CHECKMEM( p->f = LTFAT_NAME_REAL(malloc)(L));
+    CHECKMEM( p->f = LTFAT_NAME_REAL(malloc)(L * W));
 
     CHECKSTATUS(
         LTFAT_NAME(dgtreal_init)(g, gl, L, W, a, M, p->f, c, pLoc.dparams, &p->dgtplan));
@@ -390,7 +392,6 @@ PHASERET_NAME(leglaupdate_init)(const LTFAT_COMPLEX kern[], phaseret_size ksize,
                                 PHASERET_NAME(leglaupdate_plan)** pout)
 {
     ltfat_int N = L / a;
-    ltfat_int M2 = M / 2 + 1;
     ltfat_int kernh2;
     int status = LTFATERR_SUCCESS;
 
@@ -411,9 +412,7 @@ PHASERET_NAME(leglaupdate_init)(const LTFAT_COMPLEX kern[], phaseret_size ksize,
 
     CHECKMEM( p->k = (LTFAT_COMPLEX**) ltfat_malloc( p->kNo * sizeof * p->k));
 
-    CHECKMEM( p->buf =
-                  LTFAT_NAME_COMPLEX(malloc)( ((M2 + ksize.height - 1) * (p->N + ksize.width -
-                          1))));
+    CHECKSTATUS( PHASERET_NAME(leglaupdate_setnthreads)(p, 1));
 
     kernh2 = ksize.height / 2 + 1;
 
@@ -456,6 +455,11 @@ PHASERET_NAME(leglaupdate_done)(PHASERET_NAME(leglaupdate_plan)** plan)
         ltfat_safefree(pp->k[n]);
 
     ltfat_safefree(pp->k);
+
+    if (pp->buf)
+        for (ltfat_int t = 0; t < pp->nbuf; t++)
+            ltfat_safefree(pp->buf[t]);
+
     ltfat_safefree(pp->buf);
 
     if (pp->plan_col) PHASERET_NAME(leglaupdate_col_done)(&pp->plan_col);
@@ -463,6 +467,52 @@ PHASERET_NAME(leglaupdate_done)(PHASERET_NAME(leglaupdate_plan)** plan)
     pp = NULL;
 }
 
+PHASERET_API int
+PHASERET_NAME(leglaupdate_setnthreads)(PHASERET_NAME(leglaupdate_plan)* p,
+                                       ltfat_int nthreads)
+{
+    ltfat_int M2buf, Nbuf, nthreadsnew, nbufnew = 0;
+    LTFAT_COMPLEX** bufnew = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    M2buf = p->plan_col->M / 2 + 1 + p->plan_col->ksize.height - 1;
+    Nbuf = p->N + p->plan_col->ksize.width - 1;
+
+    nthreadsnew = LTFAT_OMP_NTHREADS(nthreads);
+    /* Channels get a buffer each only if there are enough of them to keep
+     * all threads busy. Otherwise, the threads share a single buffer and
+     * work on the column groups of one channel at a time. */
+    nbufnew = nthreadsnew > 1 && p->W >= nthreadsnew ? nthreadsnew : 1;
+
+    /* The plan is left untouched if the new buffers cannot be allocated */
+    CHECKMEM( bufnew = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nbufnew));
+    for (ltfat_int t = 0; t < nbufnew; t++)
+        CHECKMEM( bufnew[t] = LTFAT_NAME_COMPLEX(malloc)(M2buf * Nbuf));
+
+    if (p->buf)
+    {
+        for (ltfat_int t = 0; t < p->nbuf; t++)
+            ltfat_safefree(p->buf[t]);
+        ltfat_free(p->buf);
+    }
+
+    p->buf = bufnew;
+    p->nbuf = nbufnew;
+    p->nthreads = nthreadsnew;
+    return status;
+error:
+    if (bufnew)
+    {
+        for (ltfat_int t = 0; t < nbufnew; t++)
+            ltfat_safefree(bufnew[t]);
+        ltfat_free(bufnew);
+    }
+    return status;
+}
+
 void
 PHASERET_NAME(kernphasefi)(const LTFAT_COMPLEX kern[], phaseret_size ksize,
                            ltfat_int n, ltfat_int a, ltfat_int M, LTFAT_COMPLEX kernmod[])
@@ -491,57 +541,114 @@ PHASERET_NAME(kernphasefi)(const LTFAT_COMPLEX kern[], phaseret_size ksize,
     }
 }
 
-PHASERET_API void
-PHASERET_NAME(leglaupdate_execute)(PHASERET_NAME(leglaupdate_plan)* plan,
-                                   const LTFAT_REAL s[],
-                                   LTFAT_COMPLEX c[], LTFAT_COMPLEX cout[])
+static void
+PHASERET_NAME(leglaupdate_execute_cols)(PHASERET_NAME(leglaupdate_plan)* plan,
+                                        const LTFAT_REAL sChan[], LTFAT_COMPLEX buf[],
+                                        ltfat_int nstart, ltfat_int nend,
+                                        LTFAT_COMPLEX coutChan[])
+{
+    ltfat_int M2 = plan->plan_col->M / 2 + 1;
+    ltfat_int M2buf = M2 + plan->plan_col->ksize.height - 1;
+
+    for (ltfat_int n = nstart; n < nend; n++)
+    {
+        /* Pick the right kernel */
+        LTFAT_COMPLEX* actK = plan->k[n % plan->kNo];
+
+        PHASERET_NAME(leglaupdate_col_execute)(plan->plan_col, sChan + n * M2,
+                                               actK, buf + n * M2buf,
+                                               coutChan + n * M2);
+    }
+}
+
+static void
+PHASERET_NAME(leglaupdate_execute_chan)(PHASERET_NAME(leglaupdate_plan)* plan,
+                                        const LTFAT_REAL sChan[],
+                                        const LTFAT_COMPLEX cChan[],
+                                        LTFAT_COMPLEX buf[], ltfat_int nthreads,
+                                        LTFAT_COMPLEX coutChan[])
 {
     PHASERET_NAME(leglaupdate_plan_col)* p = plan->plan_col;
-    ltfat_int M2 = p->M / 2 + 1;
     ltfat_int N = plan->N;
-    ltfat_int W = plan->W;
-    //ltfat_int kernh2 = p->ksize2.height;
-    //ltfat_int kernw = p->ksize.width;
-    ltfat_int M2buf = M2 + p->ksize.height - 1;
+    ltfat_int M2 = p->M / 2 + 1;
     int do_onthefly = p->flags & MOD_COEFFICIENTWISE;
     int do_framewise = p->flags & MOD_FRAMEWISE;
-    //int do_revorder = p->flags & ORDER_REV;
 
-    LTFAT_COMPLEX** k = plan->k;
-    LTFAT_COMPLEX* buf = plan->buf;
+    PHASERET_NAME(extendborders)(p, cChan, N, buf);
 
-    ltfat_int nfirst;
-
-    for (ltfat_int w = 0; w < W; w++)
+    if (nthreads <= 1)
     {
-        const LTFAT_REAL* sChan =  s + w * M2 * N;
-        LTFAT_COMPLEX* cChan = c + w * M2 * N;
-        LTFAT_COMPLEX* coutChan = cout + w * M2 * N;
-
-        PHASERET_NAME(extendborders)(plan->plan_col, cChan, N, buf);
-
-        /* Outside loop over columns */
-        for (nfirst = 0; nfirst < N; nfirst++)
+        PHASERET_NAME(leglaupdate_execute_cols)(plan, sChan, buf, 0, N, coutChan);
+    }
+    else if (!do_onthefly && !do_framewise)
+    {
+        /* The buffer is not written to, all columns are independent */
+        LTFAT_OMP(parallel for num_threads(nthreads) schedule(static))
+        for (ltfat_int n = 0; n < N; n++)
+            PHASERET_NAME(leglaupdate_execute_cols)(plan, sChan, buf, n, n + 1,
+                                                    coutChan);
+    }
+    else
+    {
+        /* Column n reads the buffered columns n-kernw2+1,...,n+kernw2-1 and
+         * writes column n. Groups of at least kernw2-1 consecutive columns
+         * therefore do not interfere unless they are adjacent. The even
+         * groups are processed concurrently first, followed by the odd ones.
+         * Columns within a group are processed in order. */
+        ltfat_int reach = p->ksize2.width - 1;
+        ltfat_int G = ltfat_imax(reach, (N + 2 * nthreads - 1) / (2 * nthreads));
+        ltfat_int groups = G > 0 ? (N + G - 1) / G : 1;
+
+        if (groups < 2)
         {
-            /* Pick the right kernel */
-            LTFAT_COMPLEX* actK = k[nfirst % plan->kNo];
-            /* Go to the n-th col in output*/
-            LTFAT_COMPLEX* cColFirst = buf + nfirst * M2buf;
-            LTFAT_COMPLEX* coutCol = coutChan + nfirst * M2;
-
-            const LTFAT_REAL* sCol = sChan + nfirst * M2;
-
-            PHASERET_NAME(leglaupdate_col_execute)(plan->plan_col, sCol,
-                                                   actK, cColFirst, coutCol);
+            PHASERET_NAME(leglaupdate_execute_cols)(plan, sChan, buf, 0, N, coutChan);
         }
-
-        if (!do_onthefly && !do_framewise)
+        else
         {
-            /* Update the phase only after the projection has been done. */
-            for (ltfat_int n = 0; n < N * M2; n++)
-                coutChan[n] = sChan[n] * exp(I * ltfat_arg(coutChan[n]));
+            for (ltfat_int parity = 0; parity < 2; parity++)
+            {
+                LTFAT_OMP(parallel for num_threads(nthreads) schedule(static))
+                for (ltfat_int g = parity; g < groups; g += 2)
+                    PHASERET_NAME(leglaupdate_execute_cols)(
+                        plan, sChan, buf, g * G, ltfat_imin(N, (g + 1) * G), coutChan);
+            }
         }
     }
+
+    if (!do_onthefly && !do_framewise)
+    {
+        /* Update the phase only after the projection has been done. */
+        LTFAT_OMP(parallel for num_threads(nthreads) schedule(static) if(nthreads > 1))
+        for (ltfat_int n = 0; n < N * M2; n++)
+            coutChan[n] = sChan[n] * exp(I * ltfat_arg(coutChan[n]));
+    }
+}
+
+PHASERET_API void
+PHASERET_NAME(leglaupdate_execute)(PHASERET_NAME(leglaupdate_plan)* plan,
+                                   const LTFAT_REAL s[],
+                                   LTFAT_COMPLEX c[], LTFAT_COMPLEX cout[])
+{
+    ltfat_int M2 = plan->plan_col->M / 2 + 1;
+    ltfat_int N = plan->N;
+    ltfat_int W = plan->W;
+
+    if (plan->nbuf > 1)
+    {
+        /* Channels are processed in parallel, each with its own buffer */
+        LTFAT_OMP(parallel for num_threads(plan->nbuf) schedule(static))
+        for (ltfat_int w = 0; w < W; w++)
+            PHASERET_NAME(leglaupdate_execute_chan)(
+                plan, s + w * M2 * N, c + w * M2 * N,
+                plan->buf[LTFAT_OMP_THREADID], 1, cout + w * M2 * N);
+    }
+    else
+    {
+        for (ltfat_int w = 0; w < W; w++)
+            PHASERET_NAME(leglaupdate_execute_chan)(
+                plan, s + w * M2 * N, c + w * M2 * N,
+                plan->buf[0], plan->nthreads, cout + w * M2 * N);
+    }
 }
 
 PHASERET_API void
@@ -699,6 +806,16 @@ PHASERET_NAME(extendborders)(PHASERET_NAME(leglaupdate_plan_col)* plan,
 
 }
 
+PHASERET_API int
+PHASERET_NAME(legla_setnthreads)(PHASERET_NAME(legla_plan)* p, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKSTATUS( PHASERET_NAME(leglaupdate_setnthreads)(p->updateplan, nthreads));
+error:
+    return status;
+}
+
 PHASERET_API int
 PHASERET_NAME(legla_set_status_callback)(PHASERET_NAME(legla_plan)* p,
         PHASERET_NAME(legla_callback_status)* callback, void* userdata)
@@ -1,7 +1,23 @@
 #include "phaseret/pghi.h"
+#include "phaseret/rtpghi.h"
 #include "ltfat/macros.h"
 #include <float.h>
 
+/* Per-thread state. Every thread processes whole channels. */
+typedef struct
+{
+    LTFAT_NAME(heapinttask)* hit;
+    LTFAT_REAL* tgrad;
+    LTFAT_REAL* fgrad;
+    /* Tiled mode only, all of them are M2 x Ntile (logs has 2 extra frames) */
+    LTFAT_REAL* logs;
+    LTFAT_REAL* phase;
+    LTFAT_REAL* stile;
+    LTFAT_REAL* sfirst; // Magnitude driving the first pass
+    int* mask;
+    unsigned int seed; // Random phase generator state
+} PHASERET_NAME(pghi_workspace);
+
 struct PHASERET_NAME(pghi_plan)
 {
     double gamma;
@@ -11,9 +27,12 @@ struct PHASERET_NAME(pghi_plan)
     ltfat_int L;
     double tol1;
     double tol2;
-    LTFAT_NAME(heapinttask)* hit;
-    LTFAT_REAL* tgrad;
-    LTFAT_REAL* fgrad;
+    PHASERET_NAME(pghi_workspace)* ws;
+    ltfat_int nthreads;
+    ltfat_heaptype queuetype;
+    ltfat_int blocklen;
+    ltfat_int overlap;
+    ltfat_int Ntile; // Frames in the integration window, 0 if not tiled
     /* double* scratch; */
 };
 
@@ -64,7 +83,6 @@ PHASERET_NAME(pghi_init)(ltfat_int L, ltfat_int W,
                          double gamma, PHASERET_NAME(pghi_plan)** pout)
 {
     PHASERET_NAME(pghi_plan)* p = NULL;
-    ltfat_int M2, N;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(pout);
     CHECK(LTFATERR_BADARG, !isnan(gamma) && gamma > 0,
@@ -85,14 +103,7 @@ PHASERET_NAME(pghi_init)(ltfat_int L, ltfat_int W,
     p->gamma = gamma; p->a = a; p->M = M; p->W = W; p->L = L; p->tol1 = tol1;
     p->tol2 = tol2;
 
-    M2 = M / 2 + 1;
-    N = L / a;
-
-    CHECKMEM( p->tgrad = LTFAT_NAME_REAL(malloc)(M2 * N));
-    CHECKMEM( p->fgrad = LTFAT_NAME_REAL(malloc)(M2 * N));
-    /* CHECKMEM( p->scratch = malloc(M2 * N * sizeof * p->scratch)); */
-    // Not yet
-    p->hit = LTFAT_NAME(heapinttask_init)( M2, N, M2 * log((double)M2) , NULL, 1);
+    CHECKSTATUS( PHASERET_NAME(pghi_setnthreads)(p, 1));
 
     *pout = p;
     return status;
@@ -101,6 +112,337 @@ error:
     return status;
 }
 
+static void
+PHASERET_NAME(pghi_freeworkspaces)(PHASERET_NAME(pghi_workspace)* ws,
+                                   ltfat_int nthreads)
+{
+    if (!ws) return;
+
+    for (ltfat_int t = 0; t < nthreads; t++)
+    {
+        if (ws[t].hit) LTFAT_NAME(heapinttask_done)(ws[t].hit);
+        LTFAT_SAFEFREEALL(ws[t].tgrad, ws[t].fgrad, ws[t].logs, ws[t].phase,
+                          ws[t].stile, ws[t].sfirst, ws[t].mask);
+    }
+    ltfat_free(ws);
+}
+
+PHASERET_API int
+PHASERET_NAME(pghi_setnthreads)(PHASERET_NAME(pghi_plan)* p, ltfat_int nthreads)
+{
+    ltfat_int M2, N, Nw, Ntile;
+    PHASERET_NAME(pghi_workspace)* ws = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+    M2 = p->M / 2 + 1;
+    N = p->L / p->a;
+
+    /* Tiling only makes sense if the window is shorter than the signal */
+    Ntile = 0;
+    if (p->blocklen > 0 && p->blocklen + 2 * p->overlap < N)
+        Ntile = p->blocklen + 2 * p->overlap;
+
+    Nw = Ntile > 0 ? Ntile : N;
+
+    /* There is no point in having more threads than channels */
+    nthreads = ltfat_imin(LTFAT_OMP_NTHREADS(nthreads), p->W);
+
+    /* The new workspaces replace the old ones only if all allocations
+     * succeeded, the plan remains usable otherwise. */
+    CHECKMEM( ws = LTFAT_NEWARRAY(PHASERET_NAME(pghi_workspace), nthreads));
+
+    for (ltfat_int t = 0; t < nthreads; t++)
+    {
+        CHECKMEM( ws[t].tgrad = LTFAT_NAME_REAL(malloc)(M2 * Nw));
+        CHECKMEM( ws[t].fgrad = LTFAT_NAME_REAL(malloc)(M2 * Nw));
+        CHECKMEM( ws[t].hit = LTFAT_NAME(heapinttask_init_gen)(
+                                  M2, Nw, M2 * log((double)M2) , NULL, 1,
+                                  p->queuetype));
+
+        if (Ntile > 0)
+        {
+            CHECKMEM( ws[t].logs  = LTFAT_NAME_REAL(malloc)(M2 * (Nw + 2)));
+            CHECKMEM( ws[t].phase = LTFAT_NAME_REAL(malloc)(M2 * Nw));
+            CHECKMEM( ws[t].stile = LTFAT_NAME_REAL(malloc)(M2 * Nw));
+            CHECKMEM( ws[t].sfirst = LTFAT_NAME_REAL(malloc)(M2 * Nw));
+            CHECKMEM( ws[t].mask  = LTFAT_NEWARRAY(int, M2 * Nw));
+        }
+    }
+
+    PHASERET_NAME(pghi_freeworkspaces)(p->ws, p->nthreads);
+    p->ws = ws; p->nthreads = nthreads; p->Ntile = Ntile;
+    return status;
+error:
+    PHASERET_NAME(pghi_freeworkspaces)(ws, nthreads);
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(pghi_set_queue)(PHASERET_NAME(pghi_plan)* p,
+                              ltfat_heaptype queuetype)
+{
+    ltfat_heaptype queuetypeOld;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG,
+          queuetype == LTFAT_HEAP_BINARY || queuetype == LTFAT_HEAP_BUCKET,
+          "Unknown queue type (passed %d).", queuetype);
+
+    queuetypeOld = p->queuetype;
+    p->queuetype = queuetype;
+    status = PHASERET_NAME(pghi_setnthreads)(p, p->nthreads);
+    if (status != LTFATERR_SUCCESS) p->queuetype = queuetypeOld;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(pghi_set_tiling)(PHASERET_NAME(pghi_plan)* p,
+                               ltfat_int blocklen, ltfat_int overlap)
+{
+    ltfat_int blocklenOld, overlapOld, overlapMin;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, blocklen >= 0,
+          "blocklen must be nonnegative (passed %td).", blocklen);
+
+    overlapMin = PHASERET_NAME(pghi_get_minoverlap)(p);
+    CHECK(LTFATERR_BADARG, blocklen == 0 || overlap >= overlapMin,
+          "overlap must be at least %td frames (passed %td).", overlapMin, overlap);
+
+    blocklenOld = p->blocklen; overlapOld = p->overlap;
+    p->blocklen = blocklen;
+    p->overlap = overlap;
+    status = PHASERET_NAME(pghi_setnthreads)(p, p->nthreads);
+    if (status != LTFATERR_SUCCESS)
+    {
+        p->blocklen = blocklenOld; p->overlap = overlapOld;
+    }
+error:
+    return status;
+}
+
+PHASERET_API ltfat_int
+PHASERET_NAME(pghi_get_minoverlap)(PHASERET_NAME(pghi_plan)* p)
+{
+    /* Twice the length of the Hann window with the same gamma, in frames */
+    double gl = sqrt(p->gamma / phaseret_firwin2gamma(LTFAT_HANN, 1));
+    return ltfat_imax(1, (ltfat_int) (2.0 * gl / p->a + 0.5));
+}
+
+/* Random phase in [0, 2pi[ for the coefficients which were not integrated.
+ * rand() is not thread-safe, every workspace has its own generator
+ * (the LCG of rand_r) seeded per channel. */
+static LTFAT_REAL
+PHASERET_NAME(pghi_randphase)(PHASERET_NAME(pghi_workspace)* ws)
+{
+    ws->seed = ws->seed * 1103515245u + 12345u;
+    return 2.0 * M_PI * ((ws->seed >> 16) & 0x7fff) / 32768.0;
+}
+
+/* Reconstructs phase of channel w. The phase is stored in scratch
+ * and the gradients are computed from the log-magnitude in scratch. */
+static void
+PHASERET_NAME(pghi_execute_chan)(PHASERET_NAME(pghi_plan)* p,
+                                 PHASERET_NAME(pghi_workspace)* ws, ltfat_int w,
+                                 const int* maskchan, const LTFAT_REAL* schan,
+                                 LTFAT_REAL* scratch)
+{
+    ltfat_int M2 = p->M / 2 + 1;
+    ltfat_int N = p->L / p->a;
+
+    // The random phase does not depend on the thread the channel runs on
+    ws->seed = (unsigned int) w + 1;
+
+    PHASERET_NAME(pghilog)(schan, M2 * N, scratch);
+    PHASERET_NAME(pghitgrad)(scratch, p->gamma, p->a, p->M, N, ws->tgrad );
+    PHASERET_NAME(pghifgrad)(scratch, p->gamma, p->a, p->M, N, ws->fgrad );
+
+    memset(scratch, 0, M2 * N * sizeof * scratch);
+
+    if (maskchan)
+        LTFAT_NAME(heapinttask_resetmask)(ws->hit, maskchan, schan, p->tol1, 0);
+    else
+        LTFAT_NAME(heapinttask_resetmax)(ws->hit, schan, p->tol1);
+
+    LTFAT_NAME(heapint_execute)(ws->hit, schan, ws->tgrad, ws->fgrad, scratch);
+    int* donemask = LTFAT_NAME(heapinttask_get_mask)(ws->hit);
+
+    // pghi_init ensures tol2 < tol1
+    if (!isnan(p->tol2))
+    {
+        // Reuse the just computed mask
+        LTFAT_NAME(heapinttask_resetmask)(ws->hit, donemask, schan, p->tol2, 0);
+        LTFAT_NAME(heapint_execute)(ws->hit, schan, ws->tgrad, ws->fgrad, scratch);
+    }
+
+    // Assign random phase to unused coefficients
+    for (ltfat_int ii = 0; ii < M2 * N; ii++)
+        if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
+            scratch[ii] = PHASERET_NAME(pghi_randphase)(ws);
+}
+
+/* Tiled version of pghi_execute_chan writing directly to coutchan.
+ *
+ * The channel is processed in blocks of blocklen frames. Every block is
+ * integrated in a window of Ntile frames extending the block by overlap
+ * frames on both sides (the window is shifted at the signal ends). The
+ * frames preceding the block were already written to coutchan and their
+ * phase seeds the integration the same way the previous frame seeds it in
+ * rtpghi. The frames following the block are integrated, but discarded.
+ *
+ * Seeds below tol1 take part in the first pass too. Otherwise, a ridge
+ * rising above tol1 just after the block start would start anew with
+ * a phase unrelated to its already written beginning.
+ *
+ * The magnitude is taken either from schan or from cinchan.
+ * The tolerances are relative to the maximum of the whole channel.
+ */
+static void
+PHASERET_NAME(pghi_execute_chan_tiled)(PHASERET_NAME(pghi_plan)* p,
+                                       PHASERET_NAME(pghi_workspace)* ws,
+                                       ltfat_int w,
+                                       const LTFAT_COMPLEX* cinchan,
+                                       const int* maskchan,
+                                       const LTFAT_REAL* schan,
+                                       LTFAT_COMPLEX* coutchan)
+{
+    ltfat_int M2 = p->M / 2 + 1;
+    ltfat_int N = p->L / p->a;
+    ltfat_int T = p->Ntile;
+    const double fgradmul = -p->gamma / (2.0 * p->a * p->M);
+    int do_tol2 = !isnan(p->tol2);
+    LTFAT_REAL smax = 0.0, tol1abs, tol2abs;
+
+    ws->seed = (unsigned int) w + 1;
+
+    for (ltfat_int ii = 0; ii < M2 * N; ii++)
+    {
+        LTFAT_REAL sval = schan ? schan[ii] : ltfat_abs(cinchan[ii]);
+        if (sval > smax) smax = sval;
+    }
+
+    tol1abs = p->tol1 * smax;
+    tol2abs = do_tol2 ? p->tol2 * smax : tol1abs;
+
+    for (ltfat_int n0 = 0; n0 < N; n0 += p->blocklen)
+    {
+        ltfat_int n1 = ltfat_imin(n0 + p->blocklen, N);
+        ltfat_int nstart = ltfat_imin(ltfat_imax(n0 - p->overlap, 0), N - T);
+        ltfat_int seedLen = (n0 - nstart) * M2;
+        const LTFAT_REAL* stile = ws->stile;
+        LTFAT_COMPLEX* ctile = coutchan + nstart * M2;
+        LTFAT_REAL tmax = 0.0, tmax1, tmaxinv;
+        int* donemask;
+
+        if (schan)
+            stile = schan + nstart * M2;
+        else
+            for (ltfat_int ii = 0; ii < M2 * T; ii++)
+                ws->stile[ii] = ltfat_abs(cinchan[nstart * M2 + ii]);
+
+        for (ltfat_int ii = 0; ii < M2 * T; ii++)
+            if (stile[ii] > tmax) tmax = stile[ii];
+
+        /* heapinttask_reset* expect tolerance relative to the window max. */
+        tmaxinv = tmax > 0.0 ? 1.0 / tmax : 1.0;
+
+        /* Log-magnitude of the window with one more frame on both sides */
+        for (ltfat_int n = -1; n <= T; n++)
+        {
+            ltfat_int nn = (nstart + n + N) % N;
+            LTFAT_REAL* logsCol = ws->logs + (n + 1) * M2;
+
+            if (schan)
+                PHASERET_NAME(pghilog)(schan + nn * M2, M2, logsCol);
+            else
+                for (ltfat_int m = 0; m < M2; m++)
+                    logsCol[m] = log(ltfat_abs(cinchan[nn * M2 + m]) + DBL_MIN);
+        }
+
+        PHASERET_NAME(pghitgrad)(ws->logs + M2, p->gamma, p->a, p->M, T, ws->tgrad);
+
+        for (ltfat_int n = 0; n < T; n++)
+            for (ltfat_int m = 0; m < M2; m++)
+                ws->fgrad[n * M2 + m] = fgradmul * ( ws->logs[(n + 2) * M2 + m] -
+                                                     ws->logs[n * M2 + m]);
+
+        /* Seed by the already written frames. All coefficients above the
+         * final tolerance were integrated. */
+        for (ltfat_int ii = 0; ii < seedLen; ii++)
+        {
+            if (stile[ii] > tol2abs)
+            {
+                ws->mask[ii] = LTFAT_MASK_KNOWN;
+                ws->phase[ii] = ltfat_arg(ctile[ii]);
+            }
+            else
+            {
+                ws->mask[ii] = LTFAT_MASK_UNKNOWN;
+                ws->phase[ii] = 0.0;
+            }
+        }
+
+        for (ltfat_int ii = seedLen; ii < M2 * T; ii++)
+        {
+            if (maskchan && maskchan[nstart * M2 + ii] > LTFAT_MASK_UNKNOWN)
+            {
+                ws->mask[ii] = LTFAT_MASK_KNOWN;
+                ws->phase[ii] = ltfat_arg(cinchan[nstart * M2 + ii]);
+            }
+            else
+            {
+                ws->mask[ii] = LTFAT_MASK_UNKNOWN;
+                ws->phase[ii] = 0.0;
+            }
+        }
+
+        // Lift the weak seeds just above tol1 for the first pass
+        tmax1 = tmax;
+        for (ltfat_int ii = 0; ii < M2 * T; ii++)
+        {
+            ws->sfirst[ii] = stile[ii];
+            if (ii < seedLen && ws->mask[ii] == LTFAT_MASK_KNOWN &&
+                stile[ii] <= tol1abs)
+            {
+                ws->sfirst[ii] = 1.001 * tol1abs;
+                if (ws->sfirst[ii] > tmax1) tmax1 = ws->sfirst[ii];
+            }
+        }
+
+        LTFAT_NAME(heapinttask_resetmask)(ws->hit, ws->mask, ws->sfirst,
+                                          tmax1 > 0.0 ? tol1abs / tmax1 : 1.0, 0);
+        LTFAT_NAME(heapint_execute)(ws->hit, ws->sfirst, ws->tgrad, ws->fgrad,
+                                    ws->phase);
+        donemask = LTFAT_NAME(heapinttask_get_mask)(ws->hit);
+
+        if (do_tol2)
+        {
+            // Known coefficients below tol1 take part in the second pass
+            for (ltfat_int ii = 0; ii < M2 * T; ii++)
+                if (ws->mask[ii] == LTFAT_MASK_KNOWN && stile[ii] > tol2abs)
+                    donemask[ii] = LTFAT_MASK_KNOWN;
+
+            LTFAT_NAME(heapinttask_resetmask)(ws->hit, donemask, stile,
+                                              tol2abs * tmaxinv, 0);
+            LTFAT_NAME(heapint_execute)(ws->hit, stile, ws->tgrad, ws->fgrad,
+                                        ws->phase);
+        }
+
+        // Write the block, unused coefficients get random phase
+        for (ltfat_int ii = seedLen; ii < (n1 - nstart) * M2; ii++)
+        {
+            if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
+                ws->phase[ii] = PHASERET_NAME(pghi_randphase)(ws);
+
+            ctile[ii] = stile[ii] * exp(I * ws->phase[ii]);
+        }
+    }
+}
+
 PHASERET_API int
 PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
                             LTFAT_COMPLEX c[])
@@ -113,37 +455,34 @@ PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
     W = p->W;
     N = p->L / p->a;
 
-    for (ltfat_int w = W - 1; w >= 0; --w)
+    if (p->Ntile > 0)
     {
+        CHECK(LTFATERR_BADARG, (const void*) s != (const void*) c,
+              "In-place execution is not supported in the tiled mode.");
+
+        LTFAT_OMP(parallel for num_threads(p->nthreads) schedule(dynamic)
+                  if(p->nthreads > 1))
+        for (ltfat_int w = 0; w < W; w++)
+            PHASERET_NAME(pghi_execute_chan_tiled)(p, &p->ws[LTFAT_OMP_THREADID], w,
+                                                   NULL, NULL, s + w * M2 * N,
+                                                   c + w * M2 * N);
+        return status;
+    }
+
+    /* In-place, the output of a channel overwrites the magnitude of the
+     * channels with higher indices. They must be processed first. */
+    LTFAT_OMP(parallel for num_threads(p->nthreads) schedule(dynamic)
+              if(p->nthreads > 1 && (const void*) s != (const void*) c))
+    for (ltfat_int wrev = 0; wrev < W; wrev++)
+    {
+        ltfat_int w = W - 1 - wrev;
+        PHASERET_NAME(pghi_workspace)* ws = &p->ws[LTFAT_OMP_THREADID];
         const LTFAT_REAL* schan = s + w * M2 * N;
         LTFAT_COMPLEX* cchan = c + w * M2 * N;
-        const LTFAT_REAL* tgradwchan = p->tgrad + w * M2 * N;
-        const LTFAT_REAL* fgradwchan = p->fgrad + w * M2 * N;
         LTFAT_REAL* scratch = ((LTFAT_REAL*)cchan) + M2 *
                               N; // Second half of the output
 
-        PHASERET_NAME(pghilog)(schan, M2 * N, scratch);
-        PHASERET_NAME(pghitgrad)(scratch, p->gamma, p->a, p->M, N, p->tgrad );
-        PHASERET_NAME(pghifgrad)(scratch, p->gamma, p->a, p->M, N, p->fgrad );
-
-        memset(scratch, 0, M2 * N * sizeof * scratch);
-
-        // Start of without mask
-        LTFAT_NAME(heapinttask_resetmax)(p->hit, schan, p->tol1);
-        LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        int* donemask = LTFAT_NAME(heapinttask_get_mask)(p->hit);
-
-        if (!isnan(p->tol2) && p->tol2 < p->tol1)
-        {
-            // Reuse the just computed mask
-            LTFAT_NAME(heapinttask_resetmask)(p->hit, donemask, schan, p->tol2, 0);
-            LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        }
-
-        // Assign random phase to unused coefficients
-        for (ltfat_int ii = 0; ii < M2 * N; ii++)
-            if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
-                scratch[ii] = 2.0 * M_PI * ((double)rand()) / RAND_MAX;
+        PHASERET_NAME(pghi_execute_chan)(p, ws, w, NULL, schan, scratch);
 
         // Combine phase and magnitude
         if (schan != (LTFAT_REAL*) cchan)
@@ -153,8 +492,8 @@ PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
         else
         {
             // Copy the magnitude first to avoid overwriting it.
-            memcpy(p->tgrad, schan, M2 * N * sizeof * schan);
-            PHASERET_NAME(pghimagphase)(p->tgrad, scratch, M2 * N, cchan);
+            memcpy(ws->tgrad, schan, M2 * N * sizeof * schan);
+            PHASERET_NAME(pghimagphase)(ws->tgrad, scratch, M2 * N, cchan);
         }
     }
 error:
@@ -168,7 +507,6 @@ PHASERET_NAME(pghi_execute_withmask)(PHASERET_NAME(pghi_plan)* p,
 {
     LTFAT_REAL* bufferLoc = NULL;
     ltfat_int freeBufferLoc = 0, M2, W, N;
-    LTFAT_REAL* schan;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(cin); CHECKNULL(mask); CHECKNULL(cout); CHECKNULL(p);
 
@@ -176,55 +514,45 @@ PHASERET_NAME(pghi_execute_withmask)(PHASERET_NAME(pghi_plan)* p,
     W = p->W;
     N = p->L / p->a;
 
-    if (buffer)
+    if (p->Ntile > 0)
+    {
+        // The magnitude is computed tile by tile, the buffer is not needed
+        LTFAT_OMP(parallel for num_threads(p->nthreads) schedule(dynamic)
+                  if(p->nthreads > 1))
+        for (ltfat_int w = 0; w < W; w++)
+            PHASERET_NAME(pghi_execute_chan_tiled)(p, &p->ws[LTFAT_OMP_THREADID], w,
+                                                   cin + w * M2 * N, mask + w * M2 * N,
+                                                   NULL, cout + w * M2 * N);
+        return status;
+    }
+
+    // Every thread needs its own buffer
+    if (buffer && p->nthreads == 1)
         bufferLoc = buffer;
     else
     {
-        CHECKMEM( bufferLoc = LTFAT_NAME_REAL(malloc)(M2 * N) );
+        CHECKMEM( bufferLoc = LTFAT_NAME_REAL(malloc)(M2 * N * p->nthreads) );
         freeBufferLoc = 1;
     }
 
-    schan = bufferLoc;
-
+    LTFAT_OMP(parallel for num_threads(p->nthreads) schedule(dynamic) if(p->nthreads > 1))
     for (ltfat_int w = 0; w < W; ++w)
     {
+        ltfat_int t = LTFAT_OMP_THREADID;
         const LTFAT_COMPLEX* cinchan = cin + w * M2 * N;
         LTFAT_COMPLEX* coutchan = cout + w * M2 * N;
         const int* maskchan = mask + w * M2 * N;
-        const LTFAT_REAL* tgradwchan = p->tgrad + w * M2 * N;
-        const LTFAT_REAL* fgradwchan = p->fgrad + w * M2 * N;
+        LTFAT_REAL* schan = bufferLoc + t * M2 * N;
         LTFAT_REAL* scratch = ((LTFAT_REAL*)coutchan) + M2 *
                               N; // Second half of the output
 
         for (ltfat_int ii = 0; ii < M2 * N; ii++)
             schan[ii] = ltfat_abs(cinchan[ii]);
 
-        PHASERET_NAME(pghilog)(schan, M2 * N, scratch);
-        PHASERET_NAME(pghitgrad)(scratch, p->gamma, p->a, p->M, N, p->tgrad );
-        PHASERET_NAME(pghifgrad)(scratch, p->gamma, p->a, p->M, N, p->fgrad );
-
-        memset(scratch, 0, M2 * N * sizeof * scratch);
-
-        // Start of without mask
-        LTFAT_NAME(heapinttask_resetmask)(p->hit, maskchan, schan, p->tol1, 0);
-        LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        int* donemask = LTFAT_NAME(heapinttask_get_mask)(p->hit);
-
-        if (!isnan(p->tol2))
-        {
-            // Reuse the just computed mask
-            LTFAT_NAME(heapinttask_resetmask)(p->hit, donemask, schan, p->tol2, 0);
-            LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        }
-
-        // Assign random phase to unused coefficients
-        for (ltfat_int ii = 0; ii < M2 * N; ii++)
-            if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
-                scratch[ii] = 2.0 * M_PI * ((double)rand()) / RAND_MAX;
+        PHASERET_NAME(pghi_execute_chan)(p, &p->ws[t], w, maskchan, schan, scratch);
 
         // Combine phase and magnitude
         PHASERET_NAME(pghimagphase)(schan, scratch, M2 * N, coutchan);
-
     }
 error:
     if (freeBufferLoc) ltfat_free(bufferLoc);
@@ -238,9 +566,7 @@ PHASERET_NAME(pghi_done)(PHASERET_NAME(pghi_plan)** p)
     PHASERET_NAME(pghi_plan)* pp;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    if (pp->hit) LTFAT_NAME(heapinttask_done)(pp->hit);
-    ltfat_safefree(pp->fgrad);
-    ltfat_safefree(pp->tgrad);
+    PHASERET_NAME(pghi_freeworkspaces)(pp->ws, pp->nthreads);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -250,8 +576,9 @@ error:
 PHASERET_API int*
 PHASERET_NAME(pghi_get_mask)(PHASERET_NAME(pghi_plan)* p)
 {
-    if (p == NULL) return NULL;
-    return LTFAT_NAME(heapinttask_get_mask)(p->hit);
+    // With more threads, the channel the mask belongs to is not known
+    if (p == NULL || p->ws == NULL || p->nthreads > 1) return NULL;
+    return LTFAT_NAME(heapinttask_get_mask)(p->ws[0].hit);
 }
 
 void
@@ -28,6 +28,26 @@ error:
     return status;
 }
 
+PHASERET_API int
+PHASERET_NAME(rtpghi_set_queue)(PHASERET_NAME(rtpghi_state)* p,
+                                ltfat_heaptype queuetype)
+{
+    LTFAT_NAME(heap)* h = NULL;
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG,
+          queuetype == LTFAT_HEAP_BINARY || queuetype == LTFAT_HEAP_BUCKET,
+          "Unknown queue type (passed %d).", queuetype);
+
+    M2 = p->M / 2 + 1;
+    CHECKMEM( h = LTFAT_NAME(heap_init_gen)(2 * M2, NULL, queuetype, 1));
+    LTFAT_NAME(heap_done)(p->p->h);
+    p->p->h = h;
+error:
+    return status;
+}
+
 PHASERET_API int
 PHASERET_NAME(rtpghi_init)(ltfat_int W, ltfat_int a, ltfat_int M,
                            double gamma, double tol, int do_causal,
@@ -184,7 +204,7 @@ PHASERET_NAME(rtpghiupdate_init)(ltfat_int M, ltfat_int W, double tol,
     p->tol = tol;
     p->M = M;
     p->randphaseId = 0;
-    p->h = LTFAT_NAME(heap_init)(2 * M2, NULL);
+    CHECKMEM( p->h = LTFAT_NAME(heap_init_gen)(2 * M2, NULL, LTFAT_HEAP_BINARY, 1));
 
     *pout = p;
     return status;
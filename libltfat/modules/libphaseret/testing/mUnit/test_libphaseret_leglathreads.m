@@ -0,0 +1,83 @@
+function test_failed = test_libphaseret_leglathreads(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+if strcmp(flags.complexity,'double')
+    suffix = '_d';
+else
+    suffix = '_s';
+end
+
+a = 128;
+M = 1024;
+gl = 1024;
+N = 200;
+L = N*a;
+maxit = 20;
+g = cast(firwin('hann',gl),flags.complexity);
+% Maximum difference of the spectral convergence of the column-group mode in dB
+sctoldb = 0.5;
+
+l = (0:L-1)';
+f = sin(0.01*l + 1e-6*l.^2) + 0.1*(rand(L,1) - 0.5);
+f = [f, flipud(f), circshift(f,L/4), -f];
+
+% MOD_COEFFICIENTWISE | MOD_MODIFIEDUPDATE, MOD_FRAMEWISE, MOD_STEPWISE
+leglaflags = [4 + 16, 1, 0];
+
+for W = [1, 4]
+    s = cast(abs(dgtreal(f(:,1:W),g,a,M)),flags.complexity);
+    for flagId = 1:numel(leglaflags)
+        c1 = leglarun(s,g,L,a,M,maxit,leglaflags(flagId),1,suffix,dataPtr);
+        % The buffers are swapped on every call
+        c4 = leglarun(s,g,L,a,M,maxit,leglaflags(flagId),[2 4],suffix,dataPtr);
+
+        if W >= 4 || leglaflags(flagId) == 0
+            % Each channel is processed by a single thread or the columns
+            % are independent. The result is exactly the serial one.
+            [test_failed,fail]=ltfatdiditfail(any(c1(:) ~= c4(:)),test_failed,0);
+            fprintf('LEGLA THREADS W:%i, flags:%2i, equal to serial %s %s\n',...
+                    W,leglaflags(flagId),flags.complexity,fail);
+        else
+            % The column groups are updated in a different order
+            sc1 = leglasc(c1,s,g,a,M);
+            sc4 = leglasc(c4,s,g,a,M);
+            [test_failed,fail]=ltfatdiditfail(abs(sc1 - sc4) > sctoldb,test_failed,0);
+            fprintf('LEGLA THREADS W:%i, flags:%2i, SC diff %s dB %s %s\n',...
+                    W,leglaflags(flagId),num2str(sc4 - sc1),flags.complexity,fail);
+        end
+    end
+end
+
+
+function c = leglarun(s,g,L,a,M,maxit,leglaflags,nthreads,suffix,dataPtr)
+[M2,N,W] = size(s);
+gl = numel(g);
+cinitPtr = libpointer(dataPtr,complex2interleaved(s));
+coutPtr = libpointer(dataPtr,zeros(2*M2,N,W,class(s)));
+
+params = calllib('libphaseret','phaseret_legla_params_allocdef');
+calllib('libphaseret','phaseret_legla_params_set_leglaflags',params,leglaflags);
+
+plan = libpointer();
+calllib('libphaseret',['phaseret_legla_init',suffix],cinitPtr,g,L,gl,W,a,M,...
+        0.99,coutPtr,params,plan);
+for t = nthreads
+    calllib('libphaseret',['phaseret_legla_setnthreads',suffix],plan,t);
+end
+calllib('libphaseret',['phaseret_legla_execute',suffix],plan,maxit);
+c = interleaved2complex(coutPtr.Value);
+
+calllib('libphaseret',['phaseret_legla_done',suffix],plan);
+calllib('libphaseret','phaseret_legla_params_free',params);
+
+
+function sc = leglasc(c,s,g,a,M)
+% Spectral convergence in dB
+frec = idgtreal(c,{'dual',g},a,M);
+s2 = abs(dgtreal(frec,g,a,M));
+sc = 20*log10(norm(double(s(:)) - s2(:))/norm(double(s(:))));
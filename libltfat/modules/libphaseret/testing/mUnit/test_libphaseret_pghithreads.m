@@ -0,0 +1,111 @@
+function test_failed = test_libphaseret_pghithreads(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+if strcmp(flags.complexity,'double')
+    suffix = '_d';
+else
+    suffix = '_s';
+end
+
+a = 128;
+M = 1024;
+M2 = floor(M/2) + 1;
+gl = 1024;
+N = 96;
+L = N*a;
+gamma = gl^2*0.25645;
+
+l = (0:L-1)';
+t = l/L;
+f = [sin(2*pi*(0.01*l + 0.1*L*t.^2)), sin(2*pi*0.05*l).*sin(pi*t*7).^2,...
+     0.1*(rand(L,1) - 0.5), sin(2*pi*(0.2*l - 0.05*L*t.^2))];
+W = size(f,2);
+
+corig = cast(dgtreal(f,{'hann',gl},a,M,'timeinv'),flags.complexity);
+s = abs(corig);
+% Known phase of about 10% of the coefficients
+mask = int32(rand(M2,N,W) > 0.9);
+cin = complex2interleaved(corig);
+
+plan1 = libpointer();
+plan4 = libpointer();
+calllib('libphaseret',['phaseret_pghi_init',suffix],L,W,a,M,1e-1,1e-10,gamma,plan1);
+calllib('libphaseret',['phaseret_pghi_init',suffix],L,W,a,M,1e-1,1e-10,gamma,plan4);
+calllib('libphaseret',['phaseret_pghi_setnthreads',suffix],plan4,4);
+minoverlap = calllib('libphaseret',['phaseret_pghi_get_minoverlap',suffix],plan1);
+
+for blocklen = [0, 2*minoverlap]
+    calllib('libphaseret',['phaseret_pghi_set_tiling',suffix],plan1,blocklen,minoverlap);
+    calllib('libphaseret',['phaseret_pghi_set_tiling',suffix],plan4,blocklen,minoverlap);
+
+    % Every channel is processed by a single thread, the result is exactly
+    % the serial one
+    c1 = pghirun(plan1,s,[],[],suffix,dataPtr);
+    c4 = pghirun(plan4,s,[],[],suffix,dataPtr);
+    [test_failed,fail]=ltfatdiditfail(any(c1(:) ~= c4(:)),test_failed,0);
+    fprintf('PGHI THREADS blocklen:%3i, execute equal to serial %s %s\n',...
+            blocklen,flags.complexity,fail);
+
+    mask1 = pghimask(plan1,M2,N,blocklen,minoverlap,suffix);
+    [test_failed,fail]=ltfatdiditfail(isempty(mask1),test_failed,0);
+    fprintf('PGHI THREADS blocklen:%3i, mask of nthreads 1 %s %s\n',...
+            blocklen,flags.complexity,fail);
+
+    % The mask is NULL if the threads are used. Without OpenMP the plan
+    % runs on a single thread and it must return the serial mask.
+    mask4 = pghimask(plan4,M2,N,blocklen,minoverlap,suffix);
+    [test_failed,fail]=ltfatdiditfail(~isempty(mask4) && ~isequal(mask1,mask4),...
+                                      test_failed,0);
+    fprintf('PGHI THREADS blocklen:%3i, mask of nthreads 4 is NULL %s %s\n',...
+            blocklen,flags.complexity,fail);
+
+    c1 = pghirun(plan1,s,cin,mask,suffix,dataPtr);
+    c4 = pghirun(plan4,s,cin,mask,suffix,dataPtr);
+    [test_failed,fail]=ltfatdiditfail(any(c1(:) ~= c4(:)),test_failed,0);
+    fprintf('PGHI THREADS blocklen:%3i, execute_withmask equal to serial %s %s\n',...
+            blocklen,flags.complexity,fail);
+end
+
+% The number of threads is limited to the number of channels
+plan = libpointer();
+calllib('libphaseret',['phaseret_pghi_init',suffix],L,1,a,M,1e-1,1e-10,gamma,plan);
+calllib('libphaseret',['phaseret_pghi_setnthreads',suffix],plan,4);
+pghirun(plan,s(:,:,1),[],[],suffix,dataPtr);
+maskW1 = pghimask(plan,M2,N,0,minoverlap,suffix);
+[test_failed,fail]=ltfatdiditfail(isempty(maskW1),test_failed,0);
+fprintf('PGHI THREADS W:1, mask of nthreads 4 %s %s\n',flags.complexity,fail);
+calllib('libphaseret',['phaseret_pghi_done',suffix],plan);
+
+calllib('libphaseret',['phaseret_pghi_done',suffix],plan1);
+calllib('libphaseret',['phaseret_pghi_done',suffix],plan4);
+
+
+function c = pghirun(plan,s,cin,mask,suffix,dataPtr)
+[M2,N,W] = size(s);
+coutPtr = libpointer(dataPtr,zeros(2*M2,N,W,class(s)));
+if isempty(mask)
+    calllib('libphaseret',['phaseret_pghi_execute',suffix],plan,s,coutPtr);
+else
+    calllib('libphaseret',['phaseret_pghi_execute_withmask',suffix],plan,...
+            cin,mask,[],coutPtr);
+end
+c = interleaved2complex(coutPtr.Value);
+
+
+function mask = pghimask(plan,M2,N,blocklen,overlap,suffix)
+% Empty if NULL, the mask covers the last tile in the tiled mode
+maskPtr = calllib('libphaseret',['phaseret_pghi_get_mask',suffix],plan);
+if isNull(maskPtr)
+    mask = [];
+else
+    if blocklen > 0
+        N = min(N, blocklen + 2*overlap);
+    end
+    setdatatype(maskPtr,'int32Ptr',M2,N);
+    mask = maskPtr.Value;
+end
@@ -0,0 +1,86 @@
+function test_failed = test_libphaseret_pghitiled(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+if strcmp(flags.complexity,'double')
+    suffix = '_d';
+else
+    suffix = '_s';
+end
+
+a = 128;
+M = 1024;
+M2 = floor(M/2) + 1;
+gl = 1024;
+N = 512;
+L = N*a;
+gamma = gl^2*0.25645;
+% Maximum loss of the spectral convergence of the tiled mode in dB
+gaptoldb = 1;
+
+% Harmonics with a deep AM, chirped harmonics and a chirp
+l = (0:L-1)';
+t = l/L;
+f = zeros(L,3);
+for h = 1:5
+    f(:,1) = f(:,1) + sin(2*pi*0.013*h*l).*sin(pi*t*(3+2*h)).^2/h;
+end
+for h = 1:3
+    f(:,2) = f(:,2) + sin(2*pi*(0.02*h*l + 0.05*h*L*t.^2)).*sin(pi*t*(5+3*h)).^4;
+end
+f(:,3) = sin(2*pi*(0.01*l + 0.2*L*t.^2));
+W = size(f,2);
+
+s = cast(abs(dgtreal(f,{'hann',gl},a,M,'timeinv')),flags.complexity);
+
+plan = libpointer();
+calllib('libphaseret',['phaseret_pghi_init',suffix],L,W,a,M,1e-1,1e-10,gamma,plan);
+minoverlap = calllib('libphaseret',['phaseret_pghi_get_minoverlap',suffix],plan);
+
+[test_failed,fail]=ltfatdiditfail(minoverlap ~= 2*gl/a,test_failed);
+fprintf('PGHI TILED minoverlap %i %s %s\n',minoverlap,flags.complexity,fail);
+
+status = calllib('libphaseret',['phaseret_pghi_set_tiling',suffix],plan,4*minoverlap,minoverlap-1);
+[test_failed,fail]=ltfatdiditfail(status == 0,test_failed);
+fprintf('PGHI TILED overlap too short %s %s\n',flags.complexity,fail);
+
+scfull = pghitiledsc(plan,s,gl,a,M,suffix,dataPtr);
+
+blocklenArr = [2 4 2 4]*minoverlap;
+overlapArr  = [1 1 2 2]*minoverlap;
+
+for idx = 1:numel(blocklenArr)
+    status = calllib('libphaseret',['phaseret_pghi_set_tiling',suffix],plan,...
+                     blocklenArr(idx),overlapArr(idx));
+    sc = pghitiledsc(plan,s,gl,a,M,suffix,dataPtr);
+
+    [test_failed,fail]=ltfatdiditfail(status + any(sc > scfull + gaptoldb),test_failed,0);
+    fprintf('PGHI TILED blocklen:%3i, overlap:%3i, SC gap %s dB %s %s\n',...
+            blocklenArr(idx),overlapArr(idx),num2str(max(sc - scfull)),...
+            flags.complexity,fail);
+end
+
+calllib('libphaseret',['phaseret_pghi_done',suffix],plan);
+
+
+function sc = pghitiledsc(plan,s,gl,a,M,suffix,dataPtr)
+% Spectral convergence of every channel in dB
+[M2,N,W] = size(s);
+cout = zeros(2*M2,N,W,class(s));
+coutPtr = libpointer(dataPtr,cout);
+% Matlab automatically converts Ptr to PtrPtr
+calllib('libphaseret',['phaseret_pghi_execute',suffix],plan,s,coutPtr);
+c = interleaved2complex(coutPtr.Value);
+
+frec = idgtreal(c,{'dual',{'hann',gl}},a,M,'timeinv');
+s2 = abs(dgtreal(frec,{'hann',gl},a,M,'timeinv'));
+
+sc = zeros(W,1);
+for w = 1:W
+    sw = double(s(:,:,w));
+    sc(w) = 20*log10(norm(sw(:) - s2(:,:,w))/norm(sw(:)));
+end